@@ -60,9 +60,9 @@ struct CODA_OSS_API FileInputStreamOS : public SeekableInputStream
 {
 protected:
     sys::File mFile;
-    size_t mMaxReadThreads;
-    size_t mParallelChunkSize;
-    size_t mMinChunksForThreading;
+    size_t mMaxReadThreads = defaultNumThreads;
+    size_t mParallelChunkSize = defaultChunkSize;
+    size_t mMinChunksForThreading = defaultMinChunksForThreading;
 
 public:
 
@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "config/Exports.h"
+#include "coda_oss/span.h"
 #include "sys/Conf.h"
 #include "io/InputStream.h"
 
@@ -65,6 +66,17 @@ struct CODA_OSS_API StreamSplitter
      */
     bool getNext(std::string& substring);
 
+    /*!
+     * \brief Get the next substring from the stream without copying it.
+     *
+     * \param[out] substring Set to the substring if this call succeeds.
+     *             It points into the splitter's buffer (or, for a substring
+     *             longer than the buffer, into internal storage) and is only
+     *             valid until the next call to getNext().
+     * \return true if this call succeeded, false if this call failed.
+     */
+    bool getNext(coda_oss::span<const char>& substring);
+
     /*!
      * \brief Check if the stream has no more substrings to return.
      *
@@ -105,6 +117,18 @@ private:
                                           size_t& substringSize,
                                           sys::SSize_T bufferSegmentEnd);
 
+    /*!
+     * \brief Find the next delimiter in the buffer at or after bufferBegin.
+     *
+     * \return the buffer position of the delimiter, or -1 if there isn't one
+     */
+    sys::SSize_T findDelimiter(sys::SSize_T bufferBegin) const;
+
+    /*!
+     * \brief Move the valid section of the buffer to the front.
+     */
+    void shiftBuffer();
+
     /*!
      * \brief Read from the stream if it has more data and the buffer has space.
      */
@@ -121,6 +145,7 @@ private:
     sys::byte* const mBuffer;
     io::InputStream& mInputStream;
     bool mStreamEmpty;
+    std::string mSpill;  // substrings too long for the buffer
 };
 }
 
@@ -26,6 +26,7 @@
 #include <io/StreamSplitter.h>
 #include <except/Exception.h>
 #include <io/InputStream.h>
+#include <str/Split.h>
 
 namespace io
 {
@@ -78,23 +79,16 @@ bool StreamSplitter::getNext(std::string& substring)
         handleStreamRead();
 
         // search for delimiter in buffer
-        for (sys::SSize_T ii = mBufferValidBegin;
-             ii < mBufferValidEnd - static_cast<sys::SSize_T>(mDelimiter.size() - 1);
-             ++ii)
+        const sys::SSize_T ii = findDelimiter(mBufferValidBegin);
+        if (ii >= 0)
         {
-            if (0 == mDelimiter.compare(0,
-                                        mDelimiter.size(),
-                                        mBuffer + ii,
-                                        mDelimiter.size()))
-            {
-                // delimiter found starting at buffer position ii
-                // append the buffer contents preceding that point to output
-                transferBufferSegmentToSubstring(substring, substringSize, ii);
-                mNumDelimitersProcessed++;
-                mNumSubstringsReturned++;
-                mNumBytesReturned += substringSize;
-                return true;
-            }
+            // delimiter found starting at buffer position ii
+            // append the buffer contents preceding that point to output
+            transferBufferSegmentToSubstring(substring, substringSize, ii);
+            mNumDelimitersProcessed++;
+            mNumSubstringsReturned++;
+            mNumBytesReturned += substringSize;
+            return true;
         }
 
         // no delimiter found in buffer
@@ -117,6 +111,74 @@ bool StreamSplitter::getNext(std::string& substring)
     }
 }
 
+bool StreamSplitter::getNext(coda_oss::span<const char>& substring)
+{
+    if (isEnd())
+    {
+        return false;
+    }
+
+    if (mNumDelimitersProcessed > 0)
+    {
+        // discard the delimiter before the start of the next substring
+        mBufferValidBegin += mDelimiter.size();
+    }
+
+    // Leave the substring in the buffer, reading the rest of it in behind,
+    // unless it's too big to fit.  Bytes before mBufferValidBegin +
+    // searchOffset are known not to start a delimiter.
+    mSpill.clear();
+    sys::SSize_T searchOffset = 0;
+    while (true)
+    {
+        if (!mStreamEmpty && mBufferValidEnd == mBufferCapacity && mBufferValidBegin > 0)
+        {
+            shiftBuffer();
+        }
+        handleStreamRead();
+
+        const sys::SSize_T delimiter = findDelimiter(mBufferValidBegin + searchOffset);
+        if (delimiter >= 0 || mStreamEmpty)
+        {
+            const sys::SSize_T segmentEnd = delimiter >= 0 ? delimiter : mBufferValidEnd;
+            const char* const segment = reinterpret_cast<const char*>(mBuffer + mBufferValidBegin);
+            const size_t segmentSize = segmentEnd - mBufferValidBegin;
+            if (mSpill.empty())
+            {
+                substring = coda_oss::span<const char>(segment, segmentSize);
+            }
+            else
+            {
+                mSpill.append(segment, segmentSize);
+                substring = coda_oss::span<const char>(mSpill.data(), mSpill.size());
+            }
+            mBufferValidBegin = segmentEnd;
+            if (delimiter >= 0)
+            {
+                mNumDelimitersProcessed++;
+            }
+            mNumSubstringsReturned++;
+            mNumBytesReturned += substring.size();
+            return true;
+        }
+
+        // no delimiter yet; keep the bytes that might start one
+        const sys::SSize_T segmentEnd =
+                mBufferValidEnd - static_cast<sys::SSize_T>(mDelimiter.size() - 1);
+        if (mBufferValidBegin == 0 && mBufferValidEnd == mBufferCapacity)
+        {
+            // the substring is bigger than the buffer
+            mSpill.append(reinterpret_cast<const char*>(mBuffer), segmentEnd);
+            mBufferValidBegin = segmentEnd;
+            searchOffset = 0;
+        }
+        else
+        {
+            searchOffset = std::max<sys::SSize_T>(segmentEnd - mBufferValidBegin, 0);
+        }
+    }
+}
+
 bool StreamSplitter::isEnd() const
 {
     return mStreamEmpty && mBufferValidBegin >= mBufferValidEnd;
@@ -155,17 +217,30 @@ void StreamSplitter::transferBufferSegmentToSubstring(
     }
 }
 
+sys::SSize_T StreamSplitter::findDelimiter(sys::SSize_T bufferBegin) const
+{
+    const char* const first = reinterpret_cast<const char*>(mBuffer + bufferBegin);
+    const char* const last = reinterpret_cast<const char*>(mBuffer + mBufferValidEnd);
+    const char* const pos = str::find(first, last, mDelimiter.data(), mDelimiter.size());
+    return pos == last ? -1 : bufferBegin + (pos - first);
+}
+
+void StreamSplitter::shiftBuffer()
+{
+    std::copy(mBuffer + mBufferValidBegin,
+              mBuffer + mBufferValidEnd,
+              mBuffer);
+    mBufferValidEnd = mBufferValidEnd - mBufferValidBegin;
+    mBufferValidBegin = 0;
+}
+
 void StreamSplitter::handleStreamRead()
 {
     if (mBufferValidBegin > mBufferCapacity / 2)
     {
         // first half of buffer is no longer needed, shift the rest
         // down to make space for reading in more
-        std::copy(mBuffer + mBufferValidBegin,
-                  mBuffer + mBufferValidEnd,
-                  mBuffer);
-        mBufferValidEnd = mBufferValidEnd - mBufferValidBegin;
-        mBufferValidBegin = 0;
+        shiftBuffer();
     }
 
     // read more from stream if buffer has space
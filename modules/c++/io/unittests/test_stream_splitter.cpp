@@ -44,13 +44,29 @@ std::string getTestLine(size_t length)
     return lineTemplate.substr(0, length);
 }
 
+bool getNext(io::StreamSplitter& splitter, std::string& substring, bool useView)
+{
+    if (!useView)
+    {
+        return splitter.getNext(substring);
+    }
+    coda_oss::span<const char> view;
+    if (!splitter.getNext(view))
+    {
+        return false;
+    }
+    substring.assign(view.data(), view.size());
+    return true;
+}
+
 // join lines into StringStream and verify StreamSplitter produces the same
 // sequence of lines
 // return true for success, false for failure
 bool streamSplitterTestRunner(size_t numLines,
                               size_t lineLength,
                               const std::string& delimiter,
-                              size_t bufferSize)
+                              size_t bufferSize,
+                              bool useView = false)
 {
     std::vector<std::string> inputLines;
     io::StringStream stream;
@@ -95,7 +111,7 @@ bool streamSplitterTestRunner(size_t numLines,
         return false;
     }
 
-    while (splitter.getNext(substring))
+    while (getNext(splitter, substring, useView))
     {
         outputLines.push_back(substring);
 
@@ -118,7 +134,7 @@ bool streamSplitterTestRunner(size_t numLines,
         return false;
     }
 
-    if (splitter.getNext(substring))
+    if (getNext(splitter, substring, useView))
     {
         // stream should be empty
         return false;
@@ -189,6 +205,7 @@ TEST_CASE(testStreamSplitter)
                 {
                     const size_t bufferSize = bufferSizes[i_bufferSize];
                     TEST_ASSERT(streamSplitterTestRunner(lineCount, lineLength, delimiter, bufferSize));
+                    TEST_ASSERT(streamSplitterTestRunner(lineCount, lineLength, delimiter, bufferSize, true /*useView*/));
                 }
             }
         }
@@ -232,9 +249,40 @@ TEST_CASE(testStreamSplitterInputValidation)
     TEST_ASSERT(streamSplitterTestRunner(10, 10, "abc", 7));
 }
 
+TEST_CASE(testStreamSplitterView)
+{
+    // substrings that fit in the buffer aren't copied
+    io::StringStream stream;
+    const std::string text = "abc,de,,f";
+    stream.write(text.data(), text.length());
+    io::StreamSplitter splitter(stream, ",", 16);
+
+    std::vector<std::string> substrings;
+    coda_oss::span<const char> view;
+    while (splitter.getNext(view))
+    {
+        substrings.emplace_back(view.data(), view.size());
+    }
+    TEST_ASSERT(substrings == std::vector<std::string>({ "abc", "de", "", "f" }));
+    TEST_ASSERT(splitter.getNumBytesProcessed() == text.size());
+
+    // a substring longer than the buffer is still returned whole
+    io::StringStream longStream;
+    const std::string longLine(100, 'x');
+    longStream.write(longLine.data(), longLine.length());
+    longStream.write("\r\nyz", 4);
+    io::StreamSplitter longSplitter(longStream, "\r\n", 9);
+    TEST_ASSERT(longSplitter.getNext(view));
+    TEST_ASSERT(std::string(view.data(), view.size()) == longLine);
+    TEST_ASSERT(longSplitter.getNext(view));
+    TEST_ASSERT(std::string(view.data(), view.size()) == "yz");
+    TEST_ASSERT(!longSplitter.getNext(view));
+}
+
 int main(int, char**)
 {
     TEST_CHECK(testStreamSplitterEmpty);
     TEST_CHECK(testStreamSplitter);
     TEST_CHECK(testStreamSplitterInputValidation);
+    TEST_CHECK(testStreamSplitterView);
 }
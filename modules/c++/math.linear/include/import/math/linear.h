@@ -27,6 +27,10 @@
 #include "math/linear/VectorN.h"
 #include "math/linear/Matrix2D.h"
 #include "math/linear/Vector.h"
+#include "math/linear/Gemm.h"
+#include "math/linear/Decompositions.h"
+#include "math/linear/Expression.h"
+#include "math/linear/Batch.h"
 
 #endif  // __MATH_LINEAR_H__
 
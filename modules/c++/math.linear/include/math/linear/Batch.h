@@ -0,0 +1,232 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_linear_Batch_h_INCLUDED_
+#define CODA_OSS_math_linear_Batch_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <array>
+
+#include <coda_oss/span.h>
+#include <except/Exception.h>
+#include <math/linear/FixedKernels.h>
+#include <math/linear/MatrixMxN.h>
+
+/*!
+ *  \file Batch.h
+ *  \brief Transform, dot and cross many small vectors at once
+ *
+ *  The vectors are a structure of arrays: one array per component, so
+ *  {x, y, z} rather than an array of VectorN<3>.  Each step then works on
+ *  a whole register of vectors with no shuffling, and transforming N
+ *  vectors by one matrix runs about as fast as memory can supply them.
+ *
+ *  \code
+        std::vector<double> x(n), y(n), z(n);
+        ...
+        math::linear::transform(rotation, {x, y, z}, {x, y, z});
+ *  \endcode
+ */
+namespace math
+{
+namespace linear
+{
+//! The component arrays of a batch of _ND-vectors
+template <size_t _ND, typename _T>
+using ConstComponents = std::array<coda_oss::span<const _T>, _ND>;
+template <size_t _ND, typename _T>
+using Components = std::array<coda_oss::span<_T>, _ND>;
+
+namespace details
+{
+template <size_t _ND, typename _T>
+inline void checkComponents(const std::array<coda_oss::span<_T>, _ND>& components, size_t size)
+{
+    for (const auto& component : components)
+    {
+        if (component.size() != size)
+        {
+            throw except::Exception(Ctxt("Every component must have the same number of elements"));
+        }
+    }
+}
+}
+
+/*!
+ *  out = mx * in for every vector in the batch.  out can be the same
+ *  arrays as in.
+ *
+ *  \param mx An MxN matrix
+ *  \param in N arrays, one per component
+ *  \param out M arrays of the same size
+ *  \throws if the arrays aren't all the same size
+ */
+template <size_t _MD, size_t _ND, typename _T>
+void transform(const MatrixMxN<_MD, _ND, _T>& mx,
+               const ConstComponents<_ND, _T>& in,
+               const Components<_MD, _T>& out)
+{
+    const size_t size = in[0].size();
+    details::checkComponents(in, size);
+    details::checkComponents(out, size);
+
+    using Pack = details::Pack<_T>;
+    using Register_T = typename Pack::type;
+    Register_T m[_MD][_ND];
+    for (size_t i = 0; i < _MD; ++i)
+    {
+        for (size_t j = 0; j < _ND; ++j)
+        {
+            m[i][j] = Pack::broadcast(mx(i, j));
+        }
+    }
+
+    // Every component is loaded before any is stored, so in and out can
+    // be the same.
+    size_t k = 0;
+    for (; k + Pack::size <= size; k += Pack::size)
+    {
+        Register_T x[_ND];
+        for (size_t j = 0; j < _ND; ++j)
+        {
+            x[j] = Pack::load(in[j].data() + k);
+        }
+        for (size_t i = 0; i < _MD; ++i)
+        {
+            Register_T acc = Pack::multiply(m[i][0], x[0]);
+            for (size_t j = 1; j < _ND; ++j)
+            {
+                acc = details::multiplyAdd(m[i][j], x[j], acc);
+            }
+            Pack::store(out[i].data() + k, acc);
+        }
+    }
+    for (; k < size; ++k)
+    {
+        _T x[_ND];
+        for (size_t j = 0; j < _ND; ++j)
+        {
+            x[j] = in[j][k];
+        }
+        for (size_t i = 0; i < _MD; ++i)
+        {
+            _T acc = mx(i, 0) * x[0];
+            for (size_t j = 1; j < _ND; ++j)
+            {
+                acc += mx(i, j) * x[j];
+            }
+            out[i][k] = acc;
+        }
+    }
+}
+
+/*!
+ *  out[k] = a[k] . b[k] for every vector in the batch.  The element type
+ *  can't be deduced from braced lists, so name it:
+ *
+ *  \code
+        math::linear::dot<3, double>({x1, y1, z1}, {x2, y2, z2}, out);
+ *  \endcode
+ *
+ *  \throws if the arrays aren't all the same size
+ */
+template <size_t _ND, typename _T>
+void dot(const ConstComponents<_ND, _T>& a,
+         const ConstComponents<_ND, _T>& b,
+         coda_oss::span<_T> out)
+{
+    const size_t size = out.size();
+    details::checkComponents(a, size);
+    details::checkComponents(b, size);
+
+    using Pack = details::Pack<_T>;
+    size_t k = 0;
+    for (; k + Pack::size <= size; k += Pack::size)
+    {
+        auto acc = Pack::multiply(Pack::load(a[0].data() + k), Pack::load(b[0].data() + k));
+        for (size_t j = 1; j < _ND; ++j)
+        {
+            acc = details::multiplyAdd(Pack::load(a[j].data() + k), Pack::load(b[j].data() + k), acc);
+        }
+        Pack::store(out.data() + k, acc);
+    }
+    for (; k < size; ++k)
+    {
+        _T acc = a[0][k] * b[0][k];
+        for (size_t j = 1; j < _ND; ++j)
+        {
+            acc += a[j][k] * b[j][k];
+        }
+        out[k] = acc;
+    }
+}
+
+/*!
+ *  out = u x v for every 3-vector in the batch.  out can be the same
+ *  arrays as u or v.
+ *
+ *  \code
+        math::linear::cross<double>({ux, uy, uz}, {vx, vy, vz}, {x, y, z});
+ *  \endcode
+ *
+ *  \throws if the arrays aren't all the same size
+ */
+template <typename _T>
+void cross(const ConstComponents<3, _T>& u,
+           const ConstComponents<3, _T>& v,
+           const Components<3, _T>& out)
+{
+    const size_t size = u[0].size();
+    details::checkComponents(u, size);
+    details::checkComponents(v, size);
+    details::checkComponents(out, size);
+
+    using Pack = details::Pack<_T>;
+    size_t k = 0;
+    for (; k + Pack::size <= size; k += Pack::size)
+    {
+        const auto u0 = Pack::load(u[0].data() + k);
+        const auto u1 = Pack::load(u[1].data() + k);
+        const auto u2 = Pack::load(u[2].data() + k);
+        const auto v0 = Pack::load(v[0].data() + k);
+        const auto v1 = Pack::load(v[1].data() + k);
+        const auto v2 = Pack::load(v[2].data() + k);
+        Pack::store(out[0].data() + k, Pack::subtract(Pack::multiply(u1, v2), Pack::multiply(u2, v1)));
+        Pack::store(out[1].data() + k, Pack::subtract(Pack::multiply(u2, v0), Pack::multiply(u0, v2)));
+        Pack::store(out[2].data() + k, Pack::subtract(Pack::multiply(u0, v1), Pack::multiply(u1, v0)));
+    }
+    for (; k < size; ++k)
+    {
+        const _T u0 = u[0][k], u1 = u[1][k], u2 = u[2][k];
+        const _T v0 = v[0][k], v1 = v[1][k], v2 = v[2][k];
+        out[0][k] = u1 * v2 - u2 * v1;
+        out[1][k] = u2 * v0 - u0 * v2;
+        out[2][k] = u0 * v1 - u1 * v0;
+    }
+}
+}
+}
+
+#endif  // CODA_OSS_math_linear_Batch_h_INCLUDED_
@@ -0,0 +1,811 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_linear_Decompositions_h_INCLUDED_
+#define CODA_OSS_math_linear_Decompositions_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <cmath>
+#include <algorithm>
+#include <complex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <except/Exception.h>
+#include <coda_oss/span.h>
+#include <math/linear/Matrix2D.h>
+#include <math/linear/MatrixMxN.h>
+
+/*!
+ *  \file Decompositions.h
+ *  \brief Reusable LU, Cholesky and QR factorizations
+ *
+ *  Factoring a matrix once and solving against the factors is cheaper and
+ *  more accurate than inverting it, and the factors can be reused for any
+ *  number of right-hand sides.  Each class keeps its factors in row-major
+ *  storage that is reused, without reallocating, when another matrix of
+ *  the same size is factored, so one object can be kept around for a
+ *  stream of same-sized problems.
+ *
+ *  The factorizations work on blocks of columns at a time so that the
+ *  bulk of the arithmetic streams along contiguous rows.  The element type
+ *  can be real or std::complex.
+ *
+ *  Right-hand sides are passed to solve() as a row-major numRows x numRHS
+ *  span, and are overwritten with the solution.
+ */
+namespace math
+{
+namespace linear
+{
+namespace details
+{
+// Columns factored per block; a block of rows this tall stays in cache.
+constexpr size_t decompositionBlockSize = 32;
+
+template <typename T>
+inline T conjugate(const T& value)
+{
+    return value;
+}
+template <typename T>
+inline std::complex<T> conjugate(const std::complex<T>& value)
+{
+    return std::conj(value);
+}
+
+// to -= scale * from, over n contiguous values
+template <typename T>
+inline void subtractScaled(T* to, const T* from, T scale, size_t n)
+{
+    for (size_t jj = 0; jj < n; ++jj)
+    {
+        to[jj] -= scale * from[jj];
+    }
+}
+
+inline void checkSquare(size_t numRows, size_t numCols)
+{
+    if (numRows != numCols)
+    {
+        throw except::Exception(Ctxt(
+                "Expected square matrix but got rows = " + std::to_string(numRows) +
+                ", cols = " + std::to_string(numCols)));
+    }
+}
+
+inline void checkRows(size_t numRows, size_t expected)
+{
+    if (numRows != expected)
+    {
+        throw except::Exception(Ctxt(
+                "Expected " + std::to_string(expected) + " rows but got " +
+                std::to_string(numRows)));
+    }
+}
+
+inline void checkRHS(size_t size, size_t numRows, size_t numRHS)
+{
+    if (size != numRows * numRHS)
+    {
+        throw except::Exception(Ctxt(
+                "Expected " + std::to_string(numRows) + " x " + std::to_string(numRHS) +
+                " right-hand sides but got " + std::to_string(size) + " values"));
+    }
+}
+}
+
+/*!
+ *  \class LU
+ *  \brief LU factorization with partial pivoting, P A = L U
+ *
+ *  L is unit lower triangular and U is upper triangular.  The
+ *  factorization always succeeds; use isNonsingular() to tell whether it
+ *  can be used to solve.
+ */
+template <typename _T>
+class LU final
+{
+public:
+    LU() = default;
+
+    //! Factor the square matrix A
+    explicit LU(const Matrix2D<_T>& A)
+    {
+        factor(A);
+    }
+    template <size_t _N>
+    explicit LU(const MatrixMxN<_N, _N, _T>& A)
+    {
+        factor(A);
+    }
+
+    //! Factor the square matrix A, reusing this object's storage
+    void factor(const Matrix2D<_T>& A)
+    {
+        factor(A.get(), A.rows(), A.cols());
+    }
+    template <size_t _N>
+    void factor(const MatrixMxN<_N, _N, _T>& A)
+    {
+        factor(A[0], _N, _N);
+    }
+
+    //! The number of rows (and columns) of the factored matrix
+    size_t size() const
+    {
+        return mN;
+    }
+
+    //! Is the factored matrix nonsingular (U has no zeros on its diagonal)?
+    bool isNonsingular() const
+    {
+        return mNonsingular;
+    }
+
+    //! The determinant of the factored matrix
+    _T determinant() const
+    {
+        _T det(mSign);
+        for (size_t ii = 0; ii < mN; ++ii)
+        {
+            det *= mLU[ii * mN + ii];
+        }
+        return det;
+    }
+
+    /*!
+     *  Solve A X = B in place
+     *
+     *  \param b B, a row-major size() x numRHS matrix, which is
+     *   overwritten with X
+     *  \param numRHS The number of columns of B
+     */
+    void solve(coda_oss::span<_T> b, size_t numRHS = 1) const
+    {
+        if (!mNonsingular)
+        {
+            throw except::Exception(Ctxt("Matrix is singular"));
+        }
+        details::checkRHS(b.size(), mN, numRHS);
+
+        _T* const x = b.data();
+        for (size_t kk = 0; kk < mN; ++kk)
+        {
+            if (mPivots[kk] != kk)
+            {
+                std::swap_ranges(x + kk * numRHS, x + (kk + 1) * numRHS,
+                                 x + mPivots[kk] * numRHS);
+            }
+        }
+
+        // L y = P b, then U x = y
+        for (size_t ii = 1; ii < mN; ++ii)
+        {
+            const _T* const lu = &mLU[ii * mN];
+            for (size_t kk = 0; kk < ii; ++kk)
+            {
+                details::subtractScaled(x + ii * numRHS, x + kk * numRHS, lu[kk], numRHS);
+            }
+        }
+        for (size_t ii = mN; ii-- > 0;)
+        {
+            const _T* const lu = &mLU[ii * mN];
+            _T* const xi = x + ii * numRHS;
+            for (size_t kk = ii + 1; kk < mN; ++kk)
+            {
+                details::subtractScaled(xi, x + kk * numRHS, lu[kk], numRHS);
+            }
+            for (size_t jj = 0; jj < numRHS; ++jj)
+            {
+                xi[jj] /= lu[ii];
+            }
+        }
+    }
+
+    //! \return X where A X = B
+    Matrix2D<_T> solve(const Matrix2D<_T>& B) const
+    {
+        details::checkRows(B.rows(), mN);
+        Matrix2D<_T> X(B);
+        if (X.cols() != 0)
+        {
+            solve(coda_oss::span<_T>(&X(0, 0), X.rows() * X.cols()), X.cols());
+        }
+        return X;
+    }
+
+private:
+    void factor(const _T* A, size_t numRows, size_t numCols)
+    {
+        details::checkSquare(numRows, numCols);
+        const size_t N = numRows;
+        mN = N;
+        mLU.assign(A, A + N * N);
+        mPivots.resize(N);
+        mSign = 1;
+        mNonsingular = true;
+
+        // Right-looking blocked LU: factor a panel of columns, then update
+        // the rows to its right and the trailing matrix once per panel
+        // rather than once per column.
+        const size_t blockSize = details::decompositionBlockSize;
+        for (size_t k0 = 0; k0 < N; k0 += blockSize)
+        {
+            const size_t k1 = std::min(k0 + blockSize, N);
+            for (size_t kk = k0; kk < k1; ++kk)
+            {
+                factorColumn(kk, k1);
+            }
+
+            // U12 = L11^-1 A12
+            for (size_t kk = k0; kk < k1; ++kk)
+            {
+                for (size_t ii = kk + 1; ii < k1; ++ii)
+                {
+                    details::subtractScaled(&mLU[ii * N + k1], &mLU[kk * N + k1],
+                                            mLU[ii * N + kk], N - k1);
+                }
+            }
+
+            // A22 -= L21 U12
+            for (size_t ii = k1; ii < N; ++ii)
+            {
+                _T* const row = &mLU[ii * N];
+                for (size_t kk = k0; kk < k1; ++kk)
+                {
+                    details::subtractScaled(row + k1, &mLU[kk * N + k1], row[kk], N - k1);
+                }
+            }
+        }
+    }
+
+    // Pivot and eliminate column kk, updating only the panel columns < k1
+    void factorColumn(size_t kk, size_t k1)
+    {
+        const size_t N = mN;
+        size_t pivot = kk;
+        for (size_t ii = kk + 1; ii < N; ++ii)
+        {
+            if (std::abs(mLU[ii * N + kk]) > std::abs(mLU[pivot * N + kk]))
+            {
+                pivot = ii;
+            }
+        }
+        mPivots[kk] = pivot;
+        if (pivot != kk)
+        {
+            std::swap_ranges(&mLU[kk * N], &mLU[(kk + 1) * N], &mLU[pivot * N]);
+            mSign = -mSign;
+        }
+
+        const _T diagonal = mLU[kk * N + kk];
+        if (diagonal == _T(0))
+        {
+            mNonsingular = false;
+            return;
+        }
+        for (size_t ii = kk + 1; ii < N; ++ii)
+        {
+            _T* const row = &mLU[ii * N];
+            row[kk] /= diagonal;
+            details::subtractScaled(row + kk + 1, &mLU[kk * N + kk + 1], row[kk], k1 - kk - 1);
+        }
+    }
+
+    size_t mN = 0;
+    std::vector<_T> mLU;
+    std::vector<size_t> mPivots; // row kk was swapped with row mPivots[kk]
+    int mSign = 1;
+    bool mNonsingular = false;
+};
+
+/*!
+ *  \class Cholesky
+ *  \brief Cholesky factorization of a Hermitian positive definite matrix,
+ *  A = L L^H
+ *
+ *  Only the lower triangle of A is read.  The factorization stops as soon
+ *  as A turns out not to be positive definite; check isSPD() before
+ *  solving.
+ */
+template <typename _T>
+class Cholesky final
+{
+public:
+    Cholesky() = default;
+
+    //! Factor the square matrix A
+    explicit Cholesky(const Matrix2D<_T>& A)
+    {
+        factor(A);
+    }
+    template <size_t _N>
+    explicit Cholesky(const MatrixMxN<_N, _N, _T>& A)
+    {
+        factor(A);
+    }
+
+    //! Factor the square matrix A, reusing this object's storage
+    void factor(const Matrix2D<_T>& A)
+    {
+        factor(A.get(), A.rows(), A.cols());
+    }
+    template <size_t _N>
+    void factor(const MatrixMxN<_N, _N, _T>& A)
+    {
+        factor(A[0], _N, _N);
+    }
+
+    //! The number of rows (and columns) of the factored matrix
+    size_t size() const
+    {
+        return mN;
+    }
+
+    //! Is the factored matrix (Hermitian) positive definite?
+    bool isSPD() const
+    {
+        return mSPD;
+    }
+
+    //! The lower triangular factor L
+    Matrix2D<_T> getL() const
+    {
+        return Matrix2D<_T>(mN, mN, mL.data());
+    }
+
+    //! The determinant of the factored matrix
+    _T determinant() const
+    {
+        _T det(1);
+        for (size_t ii = 0; ii < mN; ++ii)
+        {
+            det *= mL[ii * mN + ii] * mL[ii * mN + ii];
+        }
+        return det;
+    }
+
+    /*!
+     *  Solve A X = B in place
+     *
+     *  \param b B, a row-major size() x numRHS matrix, which is
+     *   overwritten with X
+     *  \param numRHS The number of columns of B
+     */
+    void solve(coda_oss::span<_T> b, size_t numRHS = 1) const
+    {
+        if (!mSPD)
+        {
+            throw except::Exception(Ctxt("Matrix is not positive definite"));
+        }
+        details::checkRHS(b.size(), mN, numRHS);
+
+        // L y = b
+        _T* const x = b.data();
+        for (size_t ii = 0; ii < mN; ++ii)
+        {
+            const _T* const l = &mL[ii * mN];
+            _T* const xi = x + ii * numRHS;
+            for (size_t kk = 0; kk < ii; ++kk)
+            {
+                details::subtractScaled(xi, x + kk * numRHS, l[kk], numRHS);
+            }
+            for (size_t jj = 0; jj < numRHS; ++jj)
+            {
+                xi[jj] /= l[ii];
+            }
+        }
+
+        // L^H x = y, a row of L (a column of L^H) at a time
+        for (size_t ii = mN; ii-- > 0;)
+        {
+            const _T* const l = &mL[ii * mN];
+            _T* const xi = x + ii * numRHS;
+            for (size_t jj = 0; jj < numRHS; ++jj)
+            {
+                xi[jj] /= details::conjugate(l[ii]);
+            }
+            for (size_t kk = 0; kk < ii; ++kk)
+            {
+                details::subtractScaled(x + kk * numRHS, xi, details::conjugate(l[kk]), numRHS);
+            }
+        }
+    }
+
+    //! \return X where A X = B
+    Matrix2D<_T> solve(const Matrix2D<_T>& B) const
+    {
+        details::checkRows(B.rows(), mN);
+        Matrix2D<_T> X(B);
+        if (X.cols() != 0)
+        {
+            solve(coda_oss::span<_T>(&X(0, 0), X.rows() * X.cols()), X.cols());
+        }
+        return X;
+    }
+
+private:
+    void factor(const _T* A, size_t numRows, size_t numCols)
+    {
+        details::checkSquare(numRows, numCols);
+        const size_t N = numRows;
+        mN = N;
+        mL.resize(N * N);
+        for (size_t ii = 0; ii < N; ++ii)
+        {
+            std::copy(A + ii * N, A + ii * N + ii + 1, &mL[ii * N]);
+            std::fill(&mL[ii * N] + ii + 1, &mL[ii * N] + N, _T(0));
+        }
+        mSPD = true;
+
+        // Each L(i, j) is a dot product of rows i and j of L.  Working a
+        // tile at a time keeps the rows of the column tile in cache while
+        // every row of the row tile is dotted against them.
+        const size_t blockSize = details::decompositionBlockSize;
+        for (size_t i0 = 0; i0 < N; i0 += blockSize)
+        {
+            const size_t i1 = std::min(i0 + blockSize, N);
+            for (size_t j0 = 0; j0 <= i0; j0 += blockSize)
+            {
+                for (size_t ii = i0; ii < i1; ++ii)
+                {
+                    _T* const li = &mL[ii * N];
+                    const size_t j1 = std::min(j0 + blockSize, ii + 1);
+                    for (size_t jj = j0; jj < j1; ++jj)
+                    {
+                        const _T* const lj = &mL[jj * N];
+                        const _T sum = li[jj] - dot(li, lj, jj);
+                        if (jj < ii)
+                        {
+                            li[jj] = sum / lj[jj];
+                        }
+                        else
+                        {
+                            // The diagonal of a Hermitian matrix is real
+                            const auto diagonal = std::real(sum);
+                            if (!(diagonal > 0))
+                            {
+                                mSPD = false;
+                                return;
+                            }
+                            li[ii] = static_cast<_T>(std::sqrt(diagonal));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // sum over k < n of x[k] conj(y[k]), with independent partial sums
+    static _T dot(const _T* x, const _T* y, size_t n)
+    {
+        _T sum[4] = { _T(0), _T(0), _T(0), _T(0) };
+        size_t kk = 0;
+        for (; kk + 4 <= n; kk += 4)
+        {
+            sum[0] += x[kk] * details::conjugate(y[kk]);
+            sum[1] += x[kk + 1] * details::conjugate(y[kk + 1]);
+            sum[2] += x[kk + 2] * details::conjugate(y[kk + 2]);
+            sum[3] += x[kk + 3] * details::conjugate(y[kk + 3]);
+        }
+        for (; kk < n; ++kk)
+        {
+            sum[0] += x[kk] * details::conjugate(y[kk]);
+        }
+        return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+    }
+
+    size_t mN = 0;
+    std::vector<_T> mL;
+    bool mSPD = false;
+};
+
+/*!
+ *  \class QR
+ *  \brief Householder QR factorization, A = Q R, of an M x N matrix with
+ *  M >= N
+ *
+ *  Q is M x N with orthonormal columns and R is N x N upper triangular.
+ *  Q is kept as the Householder reflections that produced R, so solving
+ *  doesn't need it formed.  For M > N, solve() finds the least squares
+ *  solution.
+ */
+template <typename _T>
+class QR final
+{
+public:
+    QR() = default;
+
+    //! Factor A, which must have at least as many rows as columns
+    explicit QR(const Matrix2D<_T>& A)
+    {
+        factor(A);
+    }
+    template <size_t _M, size_t _N>
+    explicit QR(const MatrixMxN<_M, _N, _T>& A)
+    {
+        factor(A);
+    }
+
+    //! Factor A, reusing this object's storage
+    void factor(const Matrix2D<_T>& A)
+    {
+        factor(A.get(), A.rows(), A.cols());
+    }
+    template <size_t _M, size_t _N>
+    void factor(const MatrixMxN<_M, _N, _T>& A)
+    {
+        factor(A[0], _M, _N);
+    }
+
+    size_t rows() const
+    {
+        return mM;
+    }
+    size_t cols() const
+    {
+        return mN;
+    }
+
+    //! Does R have no zeros on its diagonal?
+    bool isFullRank() const
+    {
+        for (size_t kk = 0; kk < mN; ++kk)
+        {
+            if (mQR[kk * mN + kk] == _T(0))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! The upper triangular N x N factor R
+    Matrix2D<_T> getR() const
+    {
+        Matrix2D<_T> R(mN, mN, _T(0));
+        for (size_t ii = 0; ii < mN; ++ii)
+        {
+            for (size_t jj = ii; jj < mN; ++jj)
+            {
+                R(ii, jj) = mQR[ii * mN + jj];
+            }
+        }
+        return R;
+    }
+
+    //! The M x N factor Q, whose columns are orthonormal
+    Matrix2D<_T> getQ() const
+    {
+        Matrix2D<_T> Q(mM, mN, _T(0));
+        for (size_t ii = 0; ii < mN; ++ii)
+        {
+            Q(ii, ii) = _T(1);
+        }
+        if (mN != 0)
+        {
+            std::vector<_T> work(mN);
+            for (size_t kk = mN; kk-- > 0;)
+            {
+                applyReflector(kk, mTau[kk], &Q(0, 0), mN, kk, mN, work.data());
+            }
+        }
+        return Q;
+    }
+
+    //! The determinant of the factored matrix, which must be square
+    _T determinant() const
+    {
+        details::checkSquare(mM, mN);
+        _T det(1);
+        for (size_t kk = 0; kk < mN; ++kk)
+        {
+            // det(I - tau v v^H) = 1 - tau v^H v
+            double vNormSq = 1;
+            for (size_t ii = kk + 1; ii < mM; ++ii)
+            {
+                vNormSq += std::norm(mQR[ii * mN + kk]);
+            }
+            det *= (_T(1) - mTau[kk] * static_cast<_T>(vNormSq)) * mQR[kk * mN + kk];
+        }
+        return det;
+    }
+
+    /*!
+     *  Solve A X = B in place, in the least squares sense if A has more
+     *  rows than columns.
+     *
+     *  \param b B, a row-major rows() x numRHS matrix.  Its first cols()
+     *   rows are overwritten with X, and the rest with the components of
+     *   the residual orthogonal to the columns of A.
+     *  \param numRHS The number of columns of B
+     */
+    void solve(coda_oss::span<_T> b, size_t numRHS = 1) const
+    {
+        if (!isFullRank())
+        {
+            throw except::Exception(Ctxt("Matrix is rank deficient"));
+        }
+        details::checkRHS(b.size(), mM, numRHS);
+
+        // Q^H b, then R x = (Q^H b)[0:N]
+        _T* const x = b.data();
+        std::vector<_T> work(numRHS);
+        for (size_t kk = 0; kk < mN; ++kk)
+        {
+            applyReflector(kk, details::conjugate(mTau[kk]), x, numRHS, 0, numRHS, work.data());
+        }
+        for (size_t ii = mN; ii-- > 0;)
+        {
+            const _T* const r = &mQR[ii * mN];
+            _T* const xi = x + ii * numRHS;
+            for (size_t kk = ii + 1; kk < mN; ++kk)
+            {
+                details::subtractScaled(xi, x + kk * numRHS, r[kk], numRHS);
+            }
+            for (size_t jj = 0; jj < numRHS; ++jj)
+            {
+                xi[jj] /= r[ii];
+            }
+        }
+    }
+
+    //! \return X minimizing ||A X - B||
+    Matrix2D<_T> solve(const Matrix2D<_T>& B) const
+    {
+        details::checkRows(B.rows(), mM);
+        Matrix2D<_T> X(B);
+        if (X.cols() != 0)
+        {
+            solve(coda_oss::span<_T>(&X(0, 0), X.rows() * X.cols()), X.cols());
+        }
+
+        Matrix2D<_T> retval(mN, B.cols());
+        for (size_t ii = 0; ii < mN; ++ii)
+        {
+            for (size_t jj = 0; jj < B.cols(); ++jj)
+            {
+                retval(ii, jj) = X(ii, jj);
+            }
+        }
+        return retval;
+    }
+
+private:
+    void factor(const _T* A, size_t numRows, size_t numCols)
+    {
+        if (numRows < numCols)
+        {
+            throw except::Exception(Ctxt(
+                    "QR needs at least as many rows as columns but got rows = " +
+                    std::to_string(numRows) + ", cols = " + std::to_string(numCols)));
+        }
+        const size_t M = numRows;
+        const size_t N = numCols;
+        mM = M;
+        mN = N;
+        mQR.assign(A, A + M * N);
+        mTau.resize(N);
+        mWork.resize(N);
+
+        // Factor a panel of columns, applying each reflection only within
+        // the panel, then apply the panel's reflections to the columns to
+        // its right a chunk at a time so each chunk stays in cache for
+        // all of them.
+        const size_t blockSize = details::decompositionBlockSize;
+        const size_t chunkSize = 8 * blockSize;
+        for (size_t k0 = 0; k0 < N; k0 += blockSize)
+        {
+            const size_t k1 = std::min(k0 + blockSize, N);
+            for (size_t kk = k0; kk < k1; ++kk)
+            {
+                makeReflector(kk);
+                applyReflector(kk, details::conjugate(mTau[kk]), mQR.data(), N, kk + 1, k1,
+                               mWork.data());
+            }
+            for (size_t c0 = k1; c0 < N; c0 += chunkSize)
+            {
+                const size_t c1 = std::min(c0 + chunkSize, N);
+                for (size_t kk = k0; kk < k1; ++kk)
+                {
+                    applyReflector(kk, details::conjugate(mTau[kk]), mQR.data(), N, c0, c1,
+                                   mWork.data());
+                }
+            }
+        }
+    }
+
+    // Find I - tau v v^H taking column kk, from the diagonal down, to
+    // (beta, 0, ..., 0) with beta real.  beta goes on the diagonal and v,
+    // whose first element is an implicit 1, below it.
+    void makeReflector(size_t kk)
+    {
+        const size_t N = mN;
+        const _T alpha = mQR[kk * N + kk];
+        double normSq = 0;
+        for (size_t ii = kk + 1; ii < mM; ++ii)
+        {
+            normSq += std::norm(mQR[ii * N + kk]);
+        }
+        if (normSq == 0 && std::imag(alpha) == 0)
+        {
+            mTau[kk] = _T(0);
+            return;
+        }
+
+        const double norm = std::sqrt(std::norm(alpha) + normSq);
+        const double beta = std::real(alpha) >= 0 ? -norm : norm;
+        mTau[kk] = (static_cast<_T>(beta) - alpha) / static_cast<_T>(beta);
+        const _T scale = _T(1) / (alpha - static_cast<_T>(beta));
+        for (size_t ii = kk + 1; ii < mM; ++ii)
+        {
+            mQR[ii * N + kk] *= scale;
+        }
+        mQR[kk * N + kk] = static_cast<_T>(beta);
+    }
+
+    // A(kk:M, c0:c1) = (I - tau v v^H) A(kk:M, c0:c1), for reflector kk
+    // and an M-row row-major A with the given row stride
+    void applyReflector(size_t kk, _T tau, _T* A, size_t stride,
+                        size_t c0, size_t c1, _T* work) const
+    {
+        if (tau == _T(0) || c0 >= c1)
+        {
+            return;
+        }
+        const size_t n = c1 - c0;
+
+        // w = v^H A, a row at a time
+        std::copy(A + kk * stride + c0, A + kk * stride + c1, work);
+        for (size_t ii = kk + 1; ii < mM; ++ii)
+        {
+            const _T v = details::conjugate(mQR[ii * mN + kk]);
+            const _T* const row = A + ii * stride + c0;
+            for (size_t jj = 0; jj < n; ++jj)
+            {
+                work[jj] += v * row[jj];
+            }
+        }
+
+        // A -= tau v w
+        details::subtractScaled(A + kk * stride + c0, work, tau, n);
+        for (size_t ii = kk + 1; ii < mM; ++ii)
+        {
+            details::subtractScaled(A + ii * stride + c0, work, tau * mQR[ii * mN + kk], n);
+        }
+    }
+
+    size_t mM = 0;
+    size_t mN = 0;
+    std::vector<_T> mQR;
+    std::vector<_T> mTau;
+    std::vector<_T> mWork;
+};
+}
+}
+
+#endif  // CODA_OSS_math_linear_Decompositions_h_INCLUDED_
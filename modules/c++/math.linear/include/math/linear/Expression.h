@@ -0,0 +1,680 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_linear_Expression_h_INCLUDED_
+#define CODA_OSS_math_linear_Expression_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include <except/Exception.h>
+
+/*!
+ *  \file Expression.h
+ *  \brief Lazily evaluated element-wise Matrix2D and Vector arithmetic
+ *
+ *  The operators on Matrix2D and Vector compute a new Matrix2D or Vector
+ *  at every step.  Once one operand is wrapped with lazy(), the
+ *  element-wise operators (+, -, negation, scaling and, for Vector,
+ *  element-wise * and /) instead return a small object describing the
+ *  operation.  Assigning or converting that to a Matrix2D or Vector
+ *  evaluates the whole expression in one loop, into one allocation, so
+ *
+ *  \code
+        Vector<> y = lazy(A * x) + b - lazy(c) * 2.0;
+ *  \endcode
+ *
+ *  computes A * x (a product isn't element-wise, so it's evaluated
+ *  right away) and then makes a single pass to add b and subtract 2c.
+ *  Without the second lazy(), c * 2.0 would be a Vector of its own.
+ *
+ *  Operands that are temporaries are moved into the expression, so an
+ *  expression can safely outlive the full-expression that built it.
+ *  Named operands are referenced and must outlive the expression.
+ */
+namespace math
+{
+namespace linear
+{
+template <typename _T>
+class Matrix2D;
+template <typename _T>
+class Vector;
+
+namespace details
+{
+struct Add final
+{
+    template <typename L, typename R>
+    static auto apply(const L& lhs, const R& rhs) -> decltype(lhs + rhs)
+    {
+        return lhs + rhs;
+    }
+};
+struct Subtract final
+{
+    template <typename L, typename R>
+    static auto apply(const L& lhs, const R& rhs) -> decltype(lhs - rhs)
+    {
+        return lhs - rhs;
+    }
+};
+struct Multiply final
+{
+    template <typename L, typename R>
+    static auto apply(const L& lhs, const R& rhs) -> decltype(lhs * rhs)
+    {
+        return lhs * rhs;
+    }
+};
+struct Divide final
+{
+    template <typename L, typename R>
+    static auto apply(const L& lhs, const R& rhs) -> decltype(lhs / rhs)
+    {
+        return lhs / rhs;
+    }
+};
+
+inline const char* getSizeError(const Add*)
+{
+    return "Required to equally size matrices for element-wise add";
+}
+inline const char* getSizeError(const Subtract*)
+{
+    return "Matrices must be same size for element-wise subtract";
+}
+inline const char* getSizeError(const Multiply*)
+{
+    return "Vectors must be same size for element-wise multiply";
+}
+inline const char* getSizeError(const Divide*)
+{
+    return "Vectors must be same size for element-wise divide";
+}
+
+template <typename _T>
+inline const Matrix2D<_T>& getMatrix(const Matrix2D<_T>& mx)
+{
+    return mx;
+}
+template <typename _T>
+inline const Matrix2D<_T>& getMatrix(const Vector<_T>& vec)
+{
+    return vec.matrix();
+}
+
+/*
+ * The leaves of an expression: a Matrix2D or Vector that's either
+ * referenced (Container_T is const&) or owned (a temporary moved in),
+ * or a scalar that applies to every element.
+ */
+template <typename Container_T>
+class Terminal final
+{
+    Container_T mValue;
+
+public:
+    using value_type = typename std::decay<Container_T>::type::value_type;
+    static constexpr bool isScalar = false;
+
+    explicit Terminal(Container_T value) :
+        mValue(std::forward<Container_T>(value))
+    {
+    }
+
+    size_t rows() const
+    {
+        return getMatrix(mValue).rows();
+    }
+    size_t cols() const
+    {
+        return getMatrix(mValue).cols();
+    }
+    value_type at(size_t i) const
+    {
+        return getMatrix(mValue).get()[i];
+    }
+};
+
+template <typename _T>
+class Scalar final
+{
+    _T mValue;
+
+public:
+    using value_type = _T;
+    static constexpr bool isScalar = true;
+
+    explicit Scalar(_T value) :
+        mValue(value)
+    {
+    }
+
+    size_t rows() const
+    {
+        return 0;
+    }
+    size_t cols() const
+    {
+        return 0;
+    }
+    _T at(size_t) const
+    {
+        return mValue;
+    }
+};
+
+template <typename Op_T, typename Lhs_T, typename Rhs_T>
+class BinaryExpression final
+{
+    Lhs_T mLhs;
+    Rhs_T mRhs;
+
+public:
+    using value_type = typename Lhs_T::value_type;
+    static constexpr bool isScalar = false;
+
+    BinaryExpression(Lhs_T lhs, Rhs_T rhs) :
+        mLhs(std::move(lhs)), mRhs(std::move(rhs))
+    {
+        if (!Lhs_T::isScalar && !Rhs_T::isScalar &&
+            (mLhs.rows() != mRhs.rows() || mLhs.cols() != mRhs.cols()))
+        {
+            throw except::Exception(Ctxt(getSizeError(static_cast<const Op_T*>(nullptr))));
+        }
+    }
+
+    size_t rows() const
+    {
+        return Lhs_T::isScalar ? mRhs.rows() : mLhs.rows();
+    }
+    size_t cols() const
+    {
+        return Lhs_T::isScalar ? mRhs.cols() : mLhs.cols();
+    }
+    value_type at(size_t i) const
+    {
+        return Op_T::apply(mLhs.at(i), mRhs.at(i));
+    }
+};
+
+template <typename Node_T>
+class NegateExpression final
+{
+    Node_T mNode;
+
+public:
+    using value_type = typename Node_T::value_type;
+    static constexpr bool isScalar = false;
+
+    explicit NegateExpression(Node_T node) :
+        mNode(std::move(node))
+    {
+    }
+
+    size_t rows() const
+    {
+        return mNode.rows();
+    }
+    size_t cols() const
+    {
+        return mNode.cols();
+    }
+    value_type at(size_t i) const
+    {
+        return -mNode.at(i);
+    }
+};
+}
+
+/*!
+ *  \class MatrixExpression
+ *  \brief An unevaluated element-wise Matrix2D expression
+ *
+ *  Convert or assign it to a Matrix2D to evaluate it.  Elements can also
+ *  be read one at a time, which evaluates just that element.
+ */
+template <typename Node_T>
+class MatrixExpression final
+{
+    Node_T mNode;
+
+public:
+    using value_type = typename Node_T::value_type;
+
+    explicit MatrixExpression(Node_T node) :
+        mNode(std::move(node))
+    {
+    }
+
+    size_t rows() const
+    {
+        return mNode.rows();
+    }
+    size_t cols() const
+    {
+        return mNode.cols();
+    }
+    size_t size() const
+    {
+        return rows() * cols();
+    }
+    value_type operator()(size_t i, size_t j) const
+    {
+        return mNode.at(i * cols() + j);
+    }
+
+    //! Element i in row-major order
+    value_type at(size_t i) const
+    {
+        return mNode.at(i);
+    }
+
+    const Node_T& node() const &
+    {
+        return mNode;
+    }
+    Node_T&& node() &&
+    {
+        return std::move(mNode);
+    }
+};
+
+/*!
+ *  \class VectorExpression
+ *  \brief An unevaluated element-wise Vector expression
+ *
+ *  Convert or assign it to a Vector to evaluate it.  Elements can also
+ *  be read one at a time, which evaluates just that element.
+ */
+template <typename Node_T>
+class VectorExpression final
+{
+    Node_T mNode;
+
+public:
+    using value_type = typename Node_T::value_type;
+
+    explicit VectorExpression(Node_T node) :
+        mNode(std::move(node))
+    {
+    }
+
+    size_t size() const
+    {
+        return mNode.rows() * mNode.cols();
+    }
+    value_type operator[](size_t i) const
+    {
+        return mNode.at(i);
+    }
+    value_type at(size_t i) const
+    {
+        return mNode.at(i);
+    }
+
+    const Node_T& node() const &
+    {
+        return mNode;
+    }
+    Node_T&& node() &&
+    {
+        return std::move(mNode);
+    }
+};
+
+namespace details
+{
+// Which arguments each family of operators accepts
+template <typename T>
+struct IsMatrixOperand : std::false_type
+{
+};
+template <typename _T>
+struct IsMatrixOperand<Matrix2D<_T> > : std::true_type
+{
+};
+template <typename Node_T>
+struct IsMatrixOperand<MatrixExpression<Node_T> > : std::true_type
+{
+};
+
+template <typename T>
+struct IsVectorOperand : std::false_type
+{
+};
+template <typename _T>
+struct IsVectorOperand<Vector<_T> > : std::true_type
+{
+};
+template <typename Node_T>
+struct IsVectorOperand<VectorExpression<Node_T> > : std::true_type
+{
+};
+
+template <typename T>
+struct IsExpression : std::false_type
+{
+};
+template <typename Node_T>
+struct IsExpression<MatrixExpression<Node_T> > : std::true_type
+{
+};
+template <typename Node_T>
+struct IsExpression<VectorExpression<Node_T> > : std::true_type
+{
+};
+
+// Named containers are referenced, temporaries are moved in, and
+// expressions contribute their nodes.
+template <typename _T>
+inline Terminal<const Matrix2D<_T>&> makeNode(const Matrix2D<_T>& mx)
+{
+    return Terminal<const Matrix2D<_T>&>(mx);
+}
+template <typename _T>
+inline Terminal<Matrix2D<_T> > makeNode(Matrix2D<_T>&& mx)
+{
+    return Terminal<Matrix2D<_T> >(std::move(mx));
+}
+template <typename _T>
+inline Terminal<const Vector<_T>&> makeNode(const Vector<_T>& vec)
+{
+    return Terminal<const Vector<_T>&>(vec);
+}
+template <typename _T>
+inline Terminal<Vector<_T> > makeNode(Vector<_T>&& vec)
+{
+    return Terminal<Vector<_T> >(std::move(vec));
+}
+template <typename Node_T>
+inline Node_T makeNode(const MatrixExpression<Node_T>& expr)
+{
+    return expr.node();
+}
+template <typename Node_T>
+inline Node_T makeNode(MatrixExpression<Node_T>&& expr)
+{
+    return std::move(expr).node();
+}
+template <typename Node_T>
+inline Node_T makeNode(const VectorExpression<Node_T>& expr)
+{
+    return expr.node();
+}
+template <typename Node_T>
+inline Node_T makeNode(VectorExpression<Node_T>&& expr)
+{
+    return std::move(expr).node();
+}
+
+template <typename T>
+using Decay = typename std::decay<T>::type;
+
+template <typename T>
+using NodeOf = decltype(makeNode(std::declval<T>()));
+
+template <typename T>
+using ValueOf = typename NodeOf<T>::value_type;
+
+// Matrix2D and Vector have their own (eager) operators; these only
+// take over once an expression is involved.
+template <typename L, typename R>
+using EnableIfMatrices = typename std::enable_if<
+        IsMatrixOperand<Decay<L> >::value && IsMatrixOperand<Decay<R> >::value &&
+        (IsExpression<Decay<L> >::value || IsExpression<Decay<R> >::value)>::type;
+
+template <typename L, typename R>
+using EnableIfVectors = typename std::enable_if<
+        IsVectorOperand<Decay<L> >::value && IsVectorOperand<Decay<R> >::value &&
+        (IsExpression<Decay<L> >::value || IsExpression<Decay<R> >::value)>::type;
+
+template <typename T>
+using EnableIfExpression = typename std::enable_if<IsExpression<Decay<T> >::value>::type;
+
+// An expression and a scalar that converts to its elements
+template <typename Operand_T, typename Scalar_T>
+using EnableIfScalar = typename std::enable_if<
+        IsExpression<Decay<Operand_T> >::value &&
+        std::is_convertible<Scalar_T, ValueOf<Operand_T> >::value>::type;
+
+// lazy() starts from a Matrix2D or Vector
+template <typename T>
+using EnableIfContainer = typename std::enable_if<
+        (IsMatrixOperand<Decay<T> >::value || IsVectorOperand<Decay<T> >::value) &&
+        !IsExpression<Decay<T> >::value>::type;
+
+template <typename Operand_T, typename Node_T>
+using ExpressionFor = typename std::conditional<IsMatrixOperand<Decay<Operand_T> >::value,
+                                                MatrixExpression<Node_T>,
+                                                VectorExpression<Node_T> >::type;
+
+template <typename Op_T, typename L, typename R>
+using BinaryNode = BinaryExpression<Op_T, NodeOf<L>, NodeOf<R> >;
+
+template <typename L>
+using ScaleNode = BinaryExpression<Multiply, NodeOf<L>, Scalar<ValueOf<L> > >;
+
+template <typename Expression_T, typename Op_T, typename L, typename R>
+inline Expression_T makeBinary(L&& lhs, R&& rhs)
+{
+    using Node = BinaryExpression<Op_T, NodeOf<L>, NodeOf<R> >;
+    return Expression_T(Node(makeNode(std::forward<L>(lhs)), makeNode(std::forward<R>(rhs))));
+}
+
+template <typename Expression_T, typename L>
+inline Expression_T makeScale(L&& lhs, ValueOf<L> scalar)
+{
+    using Value = ValueOf<L>;
+    return Expression_T(ScaleNode<L>(makeNode(std::forward<L>(lhs)), Scalar<Value>(scalar)));
+}
+
+//! out[i] = expr.at(i) for every element, in one pass
+template <typename _T, typename Expression_T>
+inline void evaluate(const Expression_T& expr, _T* out, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        out[i] = expr.at(i);
+    }
+}
+
+// Products aren't element-wise, so their operands are evaluated first
+template <typename _T>
+inline const Matrix2D<_T>& evaluated(const Matrix2D<_T>& mx)
+{
+    return mx;
+}
+template <typename Node_T>
+inline Matrix2D<typename Node_T::value_type> evaluated(const MatrixExpression<Node_T>& expr)
+{
+    return Matrix2D<typename Node_T::value_type>(expr);
+}
+template <typename _T>
+inline const Vector<_T>& evaluated(const Vector<_T>& vec)
+{
+    return vec;
+}
+template <typename Node_T>
+inline Vector<typename Node_T::value_type> evaluated(const VectorExpression<Node_T>& expr)
+{
+    return Vector<typename Node_T::value_type>(expr);
+}
+
+template <typename L, typename R>
+using EnableIfProduct = typename std::enable_if<
+        IsMatrixOperand<L>::value && (IsMatrixOperand<R>::value || IsVectorOperand<R>::value) &&
+        (IsExpression<L>::value || IsExpression<R>::value)>::type;
+
+template <typename L, typename R>
+using ProductOf = typename std::conditional<IsMatrixOperand<R>::value,
+                                            Matrix2D<ValueOf<const L&> >,
+                                            Vector<ValueOf<const L&> > >::type;
+}
+
+/*!
+ *  Start an element-wise expression from a Matrix2D or Vector.  A
+ *  named operand is referenced and must outlive the expression; a
+ *  temporary is moved in.
+ *
+ *  \code
+        Matrix2D<> C = lazy(A) + B - D * 2.0;
+ *  \endcode
+ */
+template <typename T, typename = details::EnableIfContainer<T> >
+inline details::ExpressionFor<T, details::NodeOf<T> > lazy(T&& operand)
+{
+    return details::ExpressionFor<T, details::NodeOf<T> >(details::makeNode(std::forward<T>(operand)));
+}
+
+/*!
+ *  Element-wise sum of two Matrix2D (or two Vector) operands, at least
+ *  one of them an expression
+ */
+template <typename L, typename R, typename = details::EnableIfMatrices<L, R> >
+inline MatrixExpression<details::BinaryNode<details::Add, L, R> > operator+(L&& lhs, R&& rhs)
+{
+    return details::makeBinary<MatrixExpression<details::BinaryNode<details::Add, L, R> >, details::Add>(
+            std::forward<L>(lhs), std::forward<R>(rhs));
+}
+template <typename L, typename R, typename = details::EnableIfVectors<L, R>, typename = void>
+inline VectorExpression<details::BinaryNode<details::Add, L, R> > operator+(L&& lhs, R&& rhs)
+{
+    return details::makeBinary<VectorExpression<details::BinaryNode<details::Add, L, R> >, details::Add>(
+            std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/*!
+ *  Element-wise difference of two Matrix2D (or two Vector) operands,
+ *  at least one of them an expression
+ */
+template <typename L, typename R, typename = details::EnableIfMatrices<L, R> >
+inline MatrixExpression<details::BinaryNode<details::Subtract, L, R> > operator-(L&& lhs, R&& rhs)
+{
+    return details::makeBinary<MatrixExpression<details::BinaryNode<details::Subtract, L, R> >,
+                               details::Subtract>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+template <typename L, typename R, typename = details::EnableIfVectors<L, R>, typename = void>
+inline VectorExpression<details::BinaryNode<details::Subtract, L, R> > operator-(L&& lhs, R&& rhs)
+{
+    return details::makeBinary<VectorExpression<details::BinaryNode<details::Subtract, L, R> >,
+                               details::Subtract>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/*!
+ *  Element-wise product and quotient of two Vector operands, at least
+ *  one of them an expression.  (For Matrix2D, * is the matrix product.)
+ */
+template <typename L, typename R, typename = details::EnableIfVectors<L, R> >
+inline VectorExpression<details::BinaryNode<details::Multiply, L, R> > operator*(L&& lhs, R&& rhs)
+{
+    return details::makeBinary<VectorExpression<details::BinaryNode<details::Multiply, L, R> >,
+                               details::Multiply>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+template <typename L, typename R, typename = details::EnableIfVectors<L, R> >
+inline VectorExpression<details::BinaryNode<details::Divide, L, R> > operator/(L&& lhs, R&& rhs)
+{
+    return details::makeBinary<VectorExpression<details::BinaryNode<details::Divide, L, R> >,
+                               details::Divide>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/*!
+ *  Negate every element of an expression
+ */
+template <typename T, typename = details::EnableIfExpression<T> >
+inline details::ExpressionFor<T, details::NegateExpression<details::NodeOf<T> > > operator-(T&& operand)
+{
+    using Node = details::NegateExpression<details::NodeOf<T> >;
+    return details::ExpressionFor<T, Node>(Node(details::makeNode(std::forward<T>(operand))));
+}
+
+/*!
+ *  Scale every element of an expression
+ */
+template <typename T, typename Scalar_T, typename = details::EnableIfScalar<T, Scalar_T> >
+inline details::ExpressionFor<T, details::ScaleNode<T> > operator*(T&& operand, Scalar_T scalar)
+{
+    return details::makeScale<details::ExpressionFor<T, details::ScaleNode<T> > >(
+            std::forward<T>(operand), static_cast<details::ValueOf<T> >(scalar));
+}
+template <typename Scalar_T, typename T, typename = details::EnableIfScalar<T, Scalar_T> >
+inline details::ExpressionFor<T, details::ScaleNode<T> > operator*(Scalar_T scalar, T&& operand)
+{
+    return std::forward<T>(operand) * scalar;
+}
+
+/*!
+ *  Matrix-matrix and matrix-vector products where either side is an
+ *  expression.  The product itself is computed eagerly.
+ */
+template <typename L, typename R, typename = details::EnableIfProduct<L, R> >
+inline details::ProductOf<L, R> operator*(const L& lhs, const R& rhs)
+{
+    return details::evaluated(lhs) * details::evaluated(rhs);
+}
+
+/*!
+ *  Compare an evaluated expression with a Matrix2D, Vector or another
+ *  expression, using the containers' own equality
+ */
+template <typename L, typename R, typename = typename std::enable_if<details::IsExpression<L>::value>::type>
+inline auto operator==(const L& lhs, const R& rhs) -> decltype(details::evaluated(lhs) == rhs)
+{
+    return details::evaluated(lhs) == rhs;
+}
+template <typename L, typename R, typename = typename std::enable_if<details::IsExpression<L>::value>::type>
+inline auto operator!=(const L& lhs, const R& rhs) -> decltype(details::evaluated(lhs) == rhs)
+{
+    return !(details::evaluated(lhs) == rhs);
+}
+
+//!  Print the evaluated expression
+template <typename Node_T>
+inline std::ostream& operator<<(std::ostream& os, const MatrixExpression<Node_T>& expr)
+{
+    return os << details::evaluated(expr);
+}
+template <typename Node_T>
+inline std::ostream& operator<<(std::ostream& os, const VectorExpression<Node_T>& expr)
+{
+    return os << details::evaluated(expr);
+}
+
+/*!
+ *  Multiply every element of an expression by 1 / scalar
+ */
+template <typename T, typename Scalar_T, typename = details::EnableIfScalar<T, Scalar_T> >
+inline details::ExpressionFor<T, details::ScaleNode<T> > operator/(T&& operand, Scalar_T scalar)
+{
+    using Value = details::ValueOf<T>;
+    return std::forward<T>(operand) * (Value(1) / static_cast<Value>(scalar));
+}
+}
+}
+
+#endif  // CODA_OSS_math_linear_Expression_h_INCLUDED_
@@ -0,0 +1,561 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_linear_FixedKernels_h_INCLUDED_
+#define CODA_OSS_math_linear_FixedKernels_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <sys/AbstractOS.h>
+
+/*!
+ *  \file FixedKernels.h
+ *  \brief Kernels behind MatrixMxN and VectorN for 2x2, 3x3 and 4x4
+ *
+ *  A row of four floats is one SSE register, and a row of four doubles is
+ *  one AVX register (two with SSE2), so 4x4 products are done a whole row
+ *  at a time.  Rows of two or three don't fill a register; those products
+ *  are written out in full instead.  Other sizes use the generic loops.
+ *
+ *  Pack<T> is the widest register of T, which the batch functions in
+ *  Batch.h use to work on many vectors at once.
+ *
+ *  Build with CODA_OSS_DISABLE_SIMD to use plain C++ everywhere.
+ */
+
+// sys/AbstractOS.h works out CODA_OSS_ENABLE_SIMD, honoring CODA_OSS_DISABLE_SIMD
+#if CODA_OSS_ENABLE_SIMD
+    #if defined(__SSE2__) || defined(_M_X64)
+        #define CODA_OSS_math_linear_SSE2 1
+        #include <emmintrin.h>
+    #endif
+    #if defined(__AVX__)
+        #define CODA_OSS_math_linear_AVX 1
+        #include <immintrin.h>
+    #endif
+#endif
+
+namespace math
+{
+namespace linear
+{
+namespace details
+{
+template <typename T>
+inline T multiplyAdd(T a, T b, T c)
+{
+    return a * b + c;
+}
+#ifdef CODA_OSS_math_linear_SSE2
+inline __m128 multiplyAdd(__m128 a, __m128 b, __m128 c)
+{
+    #ifdef __FMA__
+    return _mm_fmadd_ps(a, b, c);
+    #else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+    #endif
+}
+inline __m128d multiplyAdd(__m128d a, __m128d b, __m128d c)
+{
+    #ifdef __FMA__
+    return _mm_fmadd_pd(a, b, c);
+    #else
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+    #endif
+}
+#endif
+#ifdef CODA_OSS_math_linear_AVX
+inline __m256 multiplyAdd(__m256 a, __m256 b, __m256 c)
+{
+    #ifdef __FMA__
+    return _mm256_fmadd_ps(a, b, c);
+    #else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+    #endif
+}
+inline __m256d multiplyAdd(__m256d a, __m256d b, __m256d c)
+{
+    #ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+    #else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+    #endif
+}
+#endif
+
+/*
+ * The widest register of T; a single T where there isn't one.  Loads and
+ * stores are unaligned.
+ */
+template <typename T>
+struct Pack final
+{
+    using type = T;
+    static constexpr size_t size = 1;
+
+    static type load(const T* p)
+    {
+        return *p;
+    }
+    static void store(T* p, type v)
+    {
+        *p = v;
+    }
+    static type broadcast(T value)
+    {
+        return value;
+    }
+    static type multiply(type a, type b)
+    {
+        return a * b;
+    }
+    static type subtract(type a, type b)
+    {
+        return a - b;
+    }
+};
+
+#if defined(CODA_OSS_math_linear_AVX)
+template <>
+struct Pack<float> final
+{
+    using type = __m256;
+    static constexpr size_t size = 8;
+
+    static type load(const float* p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+    static void store(float* p, type v)
+    {
+        _mm256_storeu_ps(p, v);
+    }
+    static type broadcast(float value)
+    {
+        return _mm256_set1_ps(value);
+    }
+    static type multiply(type a, type b)
+    {
+        return _mm256_mul_ps(a, b);
+    }
+    static type subtract(type a, type b)
+    {
+        return _mm256_sub_ps(a, b);
+    }
+};
+template <>
+struct Pack<double> final
+{
+    using type = __m256d;
+    static constexpr size_t size = 4;
+
+    static type load(const double* p)
+    {
+        return _mm256_loadu_pd(p);
+    }
+    static void store(double* p, type v)
+    {
+        _mm256_storeu_pd(p, v);
+    }
+    static type broadcast(double value)
+    {
+        return _mm256_set1_pd(value);
+    }
+    static type multiply(type a, type b)
+    {
+        return _mm256_mul_pd(a, b);
+    }
+    static type subtract(type a, type b)
+    {
+        return _mm256_sub_pd(a, b);
+    }
+};
+#elif defined(CODA_OSS_math_linear_SSE2)
+template <>
+struct Pack<float> final
+{
+    using type = __m128;
+    static constexpr size_t size = 4;
+
+    static type load(const float* p)
+    {
+        return _mm_loadu_ps(p);
+    }
+    static void store(float* p, type v)
+    {
+        _mm_storeu_ps(p, v);
+    }
+    static type broadcast(float value)
+    {
+        return _mm_set1_ps(value);
+    }
+    static type multiply(type a, type b)
+    {
+        return _mm_mul_ps(a, b);
+    }
+    static type subtract(type a, type b)
+    {
+        return _mm_sub_ps(a, b);
+    }
+};
+template <>
+struct Pack<double> final
+{
+    using type = __m128d;
+    static constexpr size_t size = 2;
+
+    static type load(const double* p)
+    {
+        return _mm_loadu_pd(p);
+    }
+    static void store(double* p, type v)
+    {
+        _mm_storeu_pd(p, v);
+    }
+    static type broadcast(double value)
+    {
+        return _mm_set1_pd(value);
+    }
+    static type multiply(type a, type b)
+    {
+        return _mm_mul_pd(a, b);
+    }
+    static type subtract(type a, type b)
+    {
+        return _mm_sub_pd(a, b);
+    }
+};
+#endif
+
+// C = A * B, all 4x4 and row-major
+template <typename T>
+inline void multiply4x4(const T* A, const T* B, T* C)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const T* const a = A + i * 4;
+        for (size_t j = 0; j < 4; ++j)
+        {
+            C[i * 4 + j] = a[0] * B[j] + a[1] * B[4 + j] + a[2] * B[8 + j] + a[3] * B[12 + j];
+        }
+    }
+}
+#ifdef CODA_OSS_math_linear_SSE2
+inline void multiply4x4(const float* A, const float* B, float* C)
+{
+    const __m128 b0 = _mm_loadu_ps(B);
+    const __m128 b1 = _mm_loadu_ps(B + 4);
+    const __m128 b2 = _mm_loadu_ps(B + 8);
+    const __m128 b3 = _mm_loadu_ps(B + 12);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const float* const a = A + i * 4;
+        __m128 c = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+        c = multiplyAdd(_mm_set1_ps(a[1]), b1, c);
+        c = multiplyAdd(_mm_set1_ps(a[2]), b2, c);
+        c = multiplyAdd(_mm_set1_ps(a[3]), b3, c);
+        _mm_storeu_ps(C + i * 4, c);
+    }
+}
+#endif
+#if defined(CODA_OSS_math_linear_AVX)
+inline void multiply4x4(const double* A, const double* B, double* C)
+{
+    const __m256d b0 = _mm256_loadu_pd(B);
+    const __m256d b1 = _mm256_loadu_pd(B + 4);
+    const __m256d b2 = _mm256_loadu_pd(B + 8);
+    const __m256d b3 = _mm256_loadu_pd(B + 12);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const double* const a = A + i * 4;
+        __m256d c = _mm256_mul_pd(_mm256_set1_pd(a[0]), b0);
+        c = multiplyAdd(_mm256_set1_pd(a[1]), b1, c);
+        c = multiplyAdd(_mm256_set1_pd(a[2]), b2, c);
+        c = multiplyAdd(_mm256_set1_pd(a[3]), b3, c);
+        _mm256_storeu_pd(C + i * 4, c);
+    }
+}
+#elif defined(CODA_OSS_math_linear_SSE2)
+inline void multiply4x4(const double* A, const double* B, double* C)
+{
+    // Each row is split into a low and a high pair
+    __m128d lo[4];
+    __m128d hi[4];
+    for (size_t k = 0; k < 4; ++k)
+    {
+        lo[k] = _mm_loadu_pd(B + k * 4);
+        hi[k] = _mm_loadu_pd(B + k * 4 + 2);
+    }
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const double* const a = A + i * 4;
+        __m128d a0 = _mm_set1_pd(a[0]);
+        __m128d cLo = _mm_mul_pd(a0, lo[0]);
+        __m128d cHi = _mm_mul_pd(a0, hi[0]);
+        for (size_t k = 1; k < 4; ++k)
+        {
+            const __m128d ak = _mm_set1_pd(a[k]);
+            cLo = multiplyAdd(ak, lo[k], cLo);
+            cHi = multiplyAdd(ak, hi[k], cHi);
+        }
+        _mm_storeu_pd(C + i * 4, cLo);
+        _mm_storeu_pd(C + i * 4 + 2, cHi);
+    }
+}
+#endif
+
+// y = A * x for a row-major 4x4 A
+template <typename T>
+inline void multiply4x1(const T* A, const T* x, T* y)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const T* const a = A + i * 4;
+        y[i] = a[0] * x[0] + a[1] * x[1] + a[2] * x[2] + a[3] * x[3];
+    }
+}
+#ifdef CODA_OSS_math_linear_SSE2
+inline void multiply4x1(const float* A, const float* x, float* y)
+{
+    // Multiply every row by x, then transpose so the sums are vertical
+    const __m128 v = _mm_loadu_ps(x);
+    __m128 p0 = _mm_mul_ps(_mm_loadu_ps(A), v);
+    __m128 p1 = _mm_mul_ps(_mm_loadu_ps(A + 4), v);
+    __m128 p2 = _mm_mul_ps(_mm_loadu_ps(A + 8), v);
+    __m128 p3 = _mm_mul_ps(_mm_loadu_ps(A + 12), v);
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    _mm_storeu_ps(y, _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+}
+#endif
+#if defined(CODA_OSS_math_linear_AVX)
+inline void multiply4x1(const double* A, const double* x, double* y)
+{
+    const __m256d v = _mm256_loadu_pd(x);
+    const __m256d p0 = _mm256_mul_pd(_mm256_loadu_pd(A), v);
+    const __m256d p1 = _mm256_mul_pd(_mm256_loadu_pd(A + 4), v);
+    const __m256d p2 = _mm256_mul_pd(_mm256_loadu_pd(A + 8), v);
+    const __m256d p3 = _mm256_mul_pd(_mm256_loadu_pd(A + 12), v);
+
+    // [p0 01, p1 01, p0 23, p1 23] and the same for p2, p3
+    const __m256d s01 = _mm256_hadd_pd(p0, p1);
+    const __m256d s23 = _mm256_hadd_pd(p2, p3);
+    const __m256d lo = _mm256_permute2f128_pd(s01, s23, 0x20);
+    const __m256d hi = _mm256_permute2f128_pd(s01, s23, 0x31);
+    _mm256_storeu_pd(y, _mm256_add_pd(lo, hi));
+}
+#elif defined(CODA_OSS_math_linear_SSE2)
+inline void multiply4x1(const double* A, const double* x, double* y)
+{
+    const __m128d xLo = _mm_loadu_pd(x);
+    const __m128d xHi = _mm_loadu_pd(x + 2);
+    for (size_t i = 0; i < 4; i += 2)
+    {
+        const double* const a = A + i * 4;
+        const __m128d p0 = multiplyAdd(_mm_loadu_pd(a + 2), xHi, _mm_mul_pd(_mm_loadu_pd(a), xLo));
+        const __m128d p1 = multiplyAdd(_mm_loadu_pd(a + 6), xHi, _mm_mul_pd(_mm_loadu_pd(a + 4), xLo));
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_unpacklo_pd(p0, p1), _mm_unpackhi_pd(p0, p1)));
+    }
+}
+#endif
+
+// C = A * B for an MxN A and an NxP B
+template <size_t M, size_t N, size_t P, typename T>
+struct FixedMultiply final
+{
+    static void apply(const T (&A)[M][N], const T (&B)[N][P], T (&C)[M][P])
+    {
+        for (size_t i = 0; i < M; i++)
+        {
+            for (size_t j = 0; j < P; j++)
+            {
+                T acc(0);
+                for (size_t k = 0; k < N; k++)
+                {
+                    acc += A[i][k] * B[k][j];
+                }
+                C[i][j] = acc;
+            }
+        }
+    }
+};
+template <typename T>
+struct FixedMultiply<2, 2, 2, T> final
+{
+    static void apply(const T (&A)[2][2], const T (&B)[2][2], T (&C)[2][2])
+    {
+        const T c00 = A[0][0] * B[0][0] + A[0][1] * B[1][0];
+        const T c01 = A[0][0] * B[0][1] + A[0][1] * B[1][1];
+        const T c10 = A[1][0] * B[0][0] + A[1][1] * B[1][0];
+        const T c11 = A[1][0] * B[0][1] + A[1][1] * B[1][1];
+        C[0][0] = c00;
+        C[0][1] = c01;
+        C[1][0] = c10;
+        C[1][1] = c11;
+    }
+};
+template <typename T>
+struct FixedMultiply<2, 2, 1, T> final
+{
+    static void apply(const T (&A)[2][2], const T (&x)[2][1], T (&y)[2][1])
+    {
+        const T y0 = A[0][0] * x[0][0] + A[0][1] * x[1][0];
+        const T y1 = A[1][0] * x[0][0] + A[1][1] * x[1][0];
+        y[0][0] = y0;
+        y[1][0] = y1;
+    }
+};
+template <typename T>
+struct FixedMultiply<3, 3, 3, T> final
+{
+    static void apply(const T (&A)[3][3], const T (&B)[3][3], T (&C)[3][3])
+    {
+        // Rows of B are loaded once; writing a whole row of C at the end
+        // means C can't alias the inputs.
+        const T b00 = B[0][0], b01 = B[0][1], b02 = B[0][2];
+        const T b10 = B[1][0], b11 = B[1][1], b12 = B[1][2];
+        const T b20 = B[2][0], b21 = B[2][1], b22 = B[2][2];
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const T a0 = A[i][0], a1 = A[i][1], a2 = A[i][2];
+            const T c0 = a0 * b00 + a1 * b10 + a2 * b20;
+            const T c1 = a0 * b01 + a1 * b11 + a2 * b21;
+            const T c2 = a0 * b02 + a1 * b12 + a2 * b22;
+            C[i][0] = c0;
+            C[i][1] = c1;
+            C[i][2] = c2;
+        }
+    }
+};
+template <typename T>
+struct FixedMultiply<3, 3, 1, T> final
+{
+    static void apply(const T (&A)[3][3], const T (&x)[3][1], T (&y)[3][1])
+    {
+        const T x0 = x[0][0], x1 = x[1][0], x2 = x[2][0];
+        const T y0 = A[0][0] * x0 + A[0][1] * x1 + A[0][2] * x2;
+        const T y1 = A[1][0] * x0 + A[1][1] * x1 + A[1][2] * x2;
+        const T y2 = A[2][0] * x0 + A[2][1] * x1 + A[2][2] * x2;
+        y[0][0] = y0;
+        y[1][0] = y1;
+        y[2][0] = y2;
+    }
+};
+template <typename T>
+struct FixedMultiply<4, 4, 4, T> final
+{
+    static void apply(const T (&A)[4][4], const T (&B)[4][4], T (&C)[4][4])
+    {
+        multiply4x4(&A[0][0], &B[0][0], &C[0][0]);
+    }
+};
+template <typename T>
+struct FixedMultiply<4, 4, 1, T> final
+{
+    static void apply(const T (&A)[4][4], const T (&x)[4][1], T (&y)[4][1])
+    {
+        multiply4x1(&A[0][0], &x[0][0], &y[0][0]);
+    }
+};
+
+// Closed-form determinants
+template <typename T>
+inline T determinant2x2(const T (&a)[2][2])
+{
+    return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+}
+template <typename T>
+inline T determinant3x3(const T (&a)[3][3])
+{
+    return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+           a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+           a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+}
+
+/*
+ * The adjugate of a 4x4 (the inverse times the determinant) from the
+ * 2x2 minors of the top two and bottom two rows; returns the determinant.
+ */
+template <typename T>
+inline T adjugate4x4(const T (&a)[4][4], T (&adj)[4][4])
+{
+    const T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+    const T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+    const T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+    const T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+    const T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+    const T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+    const T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+    const T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+    const T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+    const T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+    const T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+    const T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+    adj[0][0] =  a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3;
+    adj[0][1] = -a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3;
+    adj[0][2] =  a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3;
+    adj[0][3] = -a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3;
+
+    adj[1][0] = -a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1;
+    adj[1][1] =  a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1;
+    adj[1][2] = -a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1;
+    adj[1][3] =  a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1;
+
+    adj[2][0] =  a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0;
+    adj[2][1] = -a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0;
+    adj[2][2] =  a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0;
+    adj[2][3] = -a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0;
+
+    adj[3][0] = -a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0;
+    adj[3][1] =  a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0;
+    adj[3][2] = -a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0;
+    adj[3][3] =  a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0;
+
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+template <typename T>
+inline T determinant4x4(const T (&a)[4][4])
+{
+    const T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+    const T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+    const T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+    const T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+    const T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+    const T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+    const T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+    const T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+    const T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+    const T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+    const T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+    const T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+}
+}
+}
+
+#endif  // CODA_OSS_math_linear_FixedKernels_h_INCLUDED_
@@ -0,0 +1,103 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_linear_Gemm_h_INCLUDED_
+#define CODA_OSS_math_linear_Gemm_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <complex>
+#include <type_traits>
+
+#include "config/Exports.h"
+
+namespace math
+{
+namespace linear
+{
+/*!
+ *  Compute C = A B for row-major matrices, where A is MxN, B is NxP and
+ *  C is MxP.  C must not overlap A or B.
+ *
+ *  A and B are copied, a block at a time, into contiguous panels sized
+ *  to stay in cache, and each small tile of C is accumulated in
+ *  registers by a kernel the compiler can vectorize for whichever SIMD
+ *  instruction set the build targets.  Complex values are split into
+ *  real and imaginary panels so the kernel is plain real arithmetic.
+ *
+ *  \param numThreads The number of threads to spread the rows of C
+ *   over.  0 picks a count based on the size of the problem and the
+ *   number of CPUs available.
+ */
+CODA_OSS_API void gemm(size_t M, size_t N, size_t P,
+                       const float* A, const float* B, float* C,
+                       size_t numThreads = 0);
+CODA_OSS_API void gemm(size_t M, size_t N, size_t P,
+                       const double* A, const double* B, double* C,
+                       size_t numThreads = 0);
+CODA_OSS_API void gemm(size_t M, size_t N, size_t P,
+                       const std::complex<float>* A,
+                       const std::complex<float>* B,
+                       std::complex<float>* C,
+                       size_t numThreads = 0);
+CODA_OSS_API void gemm(size_t M, size_t N, size_t P,
+                       const std::complex<double>* A,
+                       const std::complex<double>* B,
+                       std::complex<double>* C,
+                       size_t numThreads = 0);
+
+namespace details
+{
+//! The element types gemm() is available for
+template <typename T>
+struct IsGemmType : std::false_type
+{
+};
+template <>
+struct IsGemmType<float> : std::true_type
+{
+};
+template <>
+struct IsGemmType<double> : std::true_type
+{
+};
+template <>
+struct IsGemmType<std::complex<float> > : std::true_type
+{
+};
+template <>
+struct IsGemmType<std::complex<double> > : std::true_type
+{
+};
+
+/*!
+ *  Below this many multiply-adds, packing costs more than it saves and
+ *  Matrix2D::multiply() uses a simple loop instead of gemm().
+ */
+constexpr size_t gemmMinOps = 16 * 16 * 16;
+}
+}
+}
+
+#endif  // CODA_OSS_math_linear_Gemm_h_INCLUDED_
@@ -33,6 +33,8 @@
 #include <mem/ScopedArray.h>
 #include <mem/SharedPtr.h>
 #include <math/linear/MatrixMxN.h>
+#include <math/linear/Gemm.h>
+#include <math/linear/Expression.h>
 
 namespace math
 {
@@ -90,6 +92,10 @@ class Matrix2D
     }
 
 public:
+    #ifndef SWIG
+    using value_type = _T;
+    #endif // SWIG
+
     Matrix2D() = default;
 
     /*!
@@ -163,6 +169,43 @@ public:
     {
         std::copy(mx.mRaw, mx.mRaw+mMN, mRaw);
     }
+
+    #ifndef SWIG
+    /*!
+     *  Take over mx's storage, leaving it empty.  If mx is decorating a
+     *  pointer it doesn't own, the values are copied instead, just as
+     *  the copy constructor would.
+     */
+    Matrix2D(Matrix2D&& mx) :
+        mM(mx.mM), mN(mx.mN), mMN(mx.mMN)
+    {
+        if (mx.mStorage == nullptr && mx.mRaw != nullptr)
+        {
+            reset();
+            std::copy(mx.mRaw, mx.mRaw+mMN, mRaw);
+            return;
+        }
+        mStorage = std::move(mx.mStorage);
+        mRaw = mx.mRaw;
+        mx.mM = mx.mN = mx.mMN = 0;
+        mx.mRaw = nullptr;
+    }
+
+    /*!
+     *  Evaluate an element-wise expression (see Expression.h) in a
+     *  single pass.
+     *
+     *  \code
+          Matrix2D<> C = lazy(A) + B * 2.0 - D;
+     *  \endcode
+     */
+    template <typename Node_T>
+    Matrix2D(const MatrixExpression<Node_T>& expr) :
+        Matrix2D(expr.rows(), expr.cols(), nullptr)
+    {
+        details::evaluate(expr, mRaw, mMN);
+    }
+    #endif // SWIG
     /*!
      *  Supports use of the class as a decorator
      *  for an existing pointer. The object
@@ -222,6 +265,55 @@ public:
         return *this;
     }
 
+    #ifndef SWIG
+    Matrix2D& operator=(Matrix2D&& mx)
+    {
+        if (mx.mStorage == nullptr && mx.mRaw != nullptr)
+        {
+            // Not ours to take; see the move constructor
+            return *this = static_cast<const Matrix2D&>(mx);
+        }
+        if (this != &mx)
+        {
+            mM = mx.mM;
+            mN = mx.mN;
+            mMN = mx.mMN;
+            mStorage = std::move(mx.mStorage);
+            mRaw = mx.mRaw;
+            mx.mM = mx.mN = mx.mMN = 0;
+            mx.mRaw = nullptr;
+        }
+        return *this;
+    }
+
+    /*!
+     *  Evaluate an element-wise expression into this matrix.  The storage
+     *  is reused if it's already the right size, and the expression may
+     *  refer to this matrix.
+     *
+     *  \code
+          A = lazy(A) * 0.5 + B;
+     *  \endcode
+     */
+    template <typename Node_T>
+    Matrix2D& operator=(const MatrixExpression<Node_T>& expr)
+    {
+        if (mStorage == nullptr || mMN != expr.size())
+        {
+            // Evaluate first in case the expression refers to this
+            Matrix2D evaluated(expr);
+            *this = std::move(evaluated);
+        }
+        else
+        {
+            mM = expr.rows();
+            mN = expr.cols();
+            details::evaluate(expr, mRaw, mMN);
+        }
+        return *this;
+    }
+    #endif // SWIG
+
     /*!
      *  Set a matrix to a single element containing the contents
      *  of a scalar value.  Note that this behavior differs (drastically)
@@ -600,8 +692,9 @@ public:
      *  Multiply an NxP matrix to a MxN matrix (this) to
      *  produce an MxP matrix output.
      *
-     *  This function accesses the inner arrays for
-     *  (potential, though slight) performance reasons.
+     *  For larger float, double and complex matrices this uses
+     *  gemm(), which blocks the product for cache and SIMD and spreads
+     *  large ones over the available CPUs.
      *
      *  \param mx An NxP matrix
      *  \param out An MxP matrix
@@ -618,7 +711,6 @@ public:
     multiply(const Matrix2D& mx, Matrix2D &out) const
     {
         const auto  M(mM);
-        const auto N(mN);
         const auto P(mx.mN);
 
         if (mN != mx.mM)
@@ -631,6 +723,28 @@ public:
             throw except::Exception(Ctxt(
                 "Invalid output column size for multiply"));
 
+        multiply(mx, out, details::IsGemmType<_T>());
+    }
+
+private:
+    // Large float, double and complex matrices go through the blocked
+    // gemm(); everything else (and small problems) use the simple loop.
+    void multiply(const Matrix2D& mx, Matrix2D& out, std::true_type) const
+    {
+        if (mM * mN * mx.mN < details::gemmMinOps || &out == this || &out == &mx)
+        {
+            multiply(mx, out, std::false_type());
+            return;
+        }
+        gemm(mM, mN, mx.mN, mRaw, mx.mRaw, out.mRaw);
+    }
+
+    void multiply(const Matrix2D& mx, Matrix2D& out, std::false_type) const
+    {
+        const auto  M(mM);
+        const auto N(mN);
+        const auto P(mx.mN);
+
         for (size_t i = 0; i < M; i++)
         {
             for (size_t j = 0; j < P; j++)
@@ -645,6 +759,7 @@ public:
         }
     }
 
+public:
 
     /*!
      *  Take in a matrix that is NxN and apply each diagonal
@@ -790,6 +905,36 @@ public:
 
     }
 
+    #ifndef SWIG
+    //! Add an element-wise expression to this, in a single pass
+    template <typename Node_T>
+    Matrix2D& operator+=(const MatrixExpression<Node_T>& expr)
+    {
+        if (mM != expr.rows() || mN != expr.cols())
+            throw except::Exception(Ctxt("Required to equally size matrices for element-wise add"));
+
+        for (size_t i = 0; i < mMN; ++i)
+        {
+            mRaw[i] += expr.at(i);
+        }
+        return *this;
+    }
+
+    //! Subtract an element-wise expression from this, in a single pass
+    template <typename Node_T>
+    Matrix2D& operator-=(const MatrixExpression<Node_T>& expr)
+    {
+        if (mM != expr.rows() || mN != expr.cols())
+            throw except::Exception(Ctxt("Matrices must be same size for element-wise subtract"));
+
+        for (size_t i = 0; i < mMN; ++i)
+        {
+            mRaw[i] -= expr.at(i);
+        }
+        return *this;
+    }
+    #endif // SWIG
+
     /*!
      *  Add an MxN matrix to another and return a third
      *  that is the sum.  This operation does not mutate this.
@@ -30,6 +30,8 @@
 
 #include <import/sys.h>
 
+#include <math/linear/FixedKernels.h>
+
 namespace math
 {
 namespace linear
@@ -211,16 +213,7 @@ public:
           MatrixMxN<3, 3> At(A.transpose());
      *  \endcode
      */
-    MatrixMxN(const MatrixMxN& mx)
-    {
-        for (size_t i = 0; i < rows(); i++)
-        {
-            for (size_t j = 0; j < cols(); j++)
-            {
-                mRaw[i][j] = mx.mRaw[i][j];
-            }
-        }
-    }
+    MatrixMxN(const MatrixMxN& mx) = default;
     /*!
      *  Assign a matrix from a 1D raw M*N pointer.
      *  Assumes that the pointer is of correct size.
@@ -272,18 +265,7 @@ public:
      *  \param mx The source matrix
      *  \return this (the copy)
      */
-    MatrixMxN& operator=(const MatrixMxN& mx)
-    {
-        if (this != &mx)
-        for (size_t i = 0; i < rows(); i++)
-        {
-            for (size_t j = 0; j < cols(); j++)
-            {
-                mRaw[i][j] = mx.mRaw[i][j];
-            }
-        }
-        return *this;
-    }
+    MatrixMxN& operator=(const MatrixMxN& mx) = default;
 
     /*!
      *  Set a matrix (each element) to the contents
@@ -709,21 +691,10 @@ public:
     template<size_t _PD> MatrixMxN<_MD, _PD, _T>
         multiply(const MatrixMxN<_ND, _PD, _T>& mx) const
     {
-        MatrixMxN<_MD, _PD, _T> newM{};
-
-        for (size_t i = 0; i < rows(); i++)
-        {
-            for (size_t j = 0; j < _PD; j++)
-            {
-                newM.mRaw[i][j] = 0;
-                for (size_t k = 0; k < cols(); k++)
-                {
-                    newM.mRaw[i][j] += mRaw[i][k] * mx.mRaw[k][j];
-                }
-            }
-        }
+        // 2x2, 3x3 and 4x4 products have their own kernels
+        MatrixMxN<_MD, _PD, _T> newM;
+        details::FixedMultiply<_MD, _ND, _PD, _T>::apply(mRaw, mx.mRaw, newM.mRaw);
         return newM;
-
     }
 
 
@@ -1356,6 +1327,67 @@ template<> inline
 template<> inline
     MatrixMxN<3, 3, float> inverse<3, float>(const MatrixMxN<3, 3, float>& mx);
 
+/*!
+ *  Full specializations for 4x4 matrices, from the adjugate.
+ */
+template<> inline
+    MatrixMxN<4, 4, double> inverse<4, double>(const MatrixMxN<4, 4, double>& mx);
+
+template<> inline
+    MatrixMxN<4, 4, float> inverse<4, float>(const MatrixMxN<4, 4, float>& mx);
+
+/*!
+ *  Determinant of a square matrix, from its LU decomposition.  2x2, 3x3
+ *  and 4x4 matrices have closed-form overloads.
+ *
+ *  \code
+         const double det = determinant(A);
+ *  \endcode
+ */
+template<size_t _ND, typename _T> inline
+    _T determinant(const MatrixMxN<_ND, _ND, _T>& mx)
+{
+    std::vector<size_t> pivots(_ND);
+    const MatrixMxN<_ND, _ND, _T> lu = mx.decomposeLU(pivots);
+
+    _T det(1);
+    for (size_t i = 0; i < _ND; i++)
+    {
+        det *= lu(i, i);
+    }
+
+    // A cycle of n rows in the permutation took n - 1 swaps
+    std::vector<bool> visited(_ND, false);
+    bool odd = false;
+    for (size_t i = 0; i < _ND; i++)
+    {
+        for (size_t j = i; !visited[j]; j = pivots[j])
+        {
+            visited[j] = true;
+            odd = (j != i) ? !odd : odd;
+        }
+    }
+    return odd ? -det : det;
+}
+
+template<typename _T> inline
+    _T determinant(const MatrixMxN<2, 2, _T>& mx)
+{
+    return details::determinant2x2(mx.mRaw);
+}
+
+template<typename _T> inline
+    _T determinant(const MatrixMxN<3, 3, _T>& mx)
+{
+    return details::determinant3x3(mx.mRaw);
+}
+
+template<typename _T> inline
+    _T determinant(const MatrixMxN<4, 4, _T>& mx)
+{
+    return details::determinant4x4(mx.mRaw);
+}
+
 /*!
  *  Could possibly be more clever here, and template the actual matrix
  */
@@ -1506,6 +1538,44 @@ math::linear::inverse<3, float>(const math::linear::MatrixMxN<3, 3, float>& mx)
     return inv;
 }
 
+template<> inline
+math::linear::MatrixMxN<4, 4, double>
+math::linear::inverse<4, double>(const math::linear::MatrixMxN<4, 4, double>& mx)
+{
+    math::linear::MatrixMxN<4, 4, double> inv;
+    const double determinant = math::linear::details::adjugate4x4(mx.mRaw, inv.mRaw);
+
+    // The determinant scales with the fourth power of the entries, so a tiny
+    // one doesn't mean the matrix is singular (e.g., 1e-4 * I); let the
+    // pivoted LU decide, as the generic inverse() would.
+    if (math::linear::almostZero(determinant))
+    {
+        return math::linear::inverseLU<4, double>(mx);
+    }
+
+    inv.scale( 1.0 / determinant );
+    return inv;
+}
+
+template<> inline
+math::linear::MatrixMxN<4, 4, float>
+math::linear::inverse<4, float>(const math::linear::MatrixMxN<4, 4, float>& mx)
+{
+    math::linear::MatrixMxN<4, 4, float> inv;
+    const float determinant = math::linear::details::adjugate4x4(mx.mRaw, inv.mRaw);
+
+    // The determinant scales with the fourth power of the entries, so a tiny
+    // one doesn't mean the matrix is singular (e.g., 1e-4 * I); let the
+    // pivoted LU decide, as the generic inverse() would.
+    if (math::linear::almostZero(determinant))
+    {
+        return math::linear::inverseLU<4, float>(mx);
+    }
+
+    inv.scale( 1.0f / determinant );
+    return inv;
+}
+
 /*!
  *  This method "cleans" a Matrix of unknown type.  Concrete instantiations could
  *  include MatrixMxN or Matrix2D, or any other type that has a rows() and cols(),
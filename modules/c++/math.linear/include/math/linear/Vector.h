@@ -48,6 +48,9 @@ template<typename _T=double> class Vector
 {
     Matrix2D<_T> mRaw;
 public:
+    #ifndef SWIG
+    using value_type = _T;
+    #endif // SWIG
 
     //!  Default constructor (no initialization)
     Vector() {}
@@ -88,6 +91,29 @@ public:
         mRaw = v.mRaw;
     }
 
+    #ifndef SWIG
+    //!  Take over v's storage, leaving it empty
+    Vector(Vector&& v) :
+        mRaw(std::move(v.mRaw))
+    {
+    }
+
+    /*!
+     *  Evaluate an element-wise expression (see Expression.h) in a
+     *  single pass, straight into this vector's storage.
+     *
+     *  \code
+          Vector<> y = lazy(A * x) + b - c * 2.0;
+     *  \endcode
+     */
+    template <typename Node_T>
+    Vector(const VectorExpression<Node_T>& expr) :
+        mRaw(expr.size(), 1, nullptr)
+    {
+        details::evaluate(expr, mRaw.mRaw, mRaw.mMN);
+    }
+    #endif // SWIG
+
     /*!
      *  Copy the contents from a std::vector
      *  into our Vector object
@@ -114,6 +140,16 @@ public:
         mRaw = Matrix2D<_T>(mx.size(), 1, mx.mRaw);
     }
 
+    #ifndef SWIG
+    //!  As above, but a temporary's storage is reused, e.g., for A * x
+    Vector(Matrix2D<_T>&& mx) :
+        mRaw(std::move(mx))
+    {
+        mRaw.mM = mRaw.mMN;
+        mRaw.mN = 1;
+    }
+    #endif // SWIG
+
     /*!
      *  Copy the contents from one Vector
      *  to another.
@@ -130,6 +166,36 @@ public:
         return *this;
     }
 
+    #ifndef SWIG
+    Vector& operator=(Vector&& v)
+    {
+        mRaw = std::move(v.mRaw);
+        return *this;
+    }
+
+    /*!
+     *  Evaluate an element-wise expression into this vector, reusing
+     *  its storage if it's already the right size.  The expression may
+     *  refer to this vector.
+     */
+    template <typename Node_T>
+    Vector& operator=(const VectorExpression<Node_T>& expr)
+    {
+        if (mRaw.mStorage == nullptr || mRaw.mMN != expr.size())
+        {
+            Vector evaluated(expr);
+            *this = std::move(evaluated);
+        }
+        else
+        {
+            mRaw.mM = mRaw.mMN;
+            mRaw.mN = 1;
+            details::evaluate(expr, mRaw.mRaw, mRaw.mMN);
+        }
+        return *this;
+    }
+    #endif // SWIG
+
     /*!
      *  Copy the contents of a Matrix into
      *  memory.  This effectively will
@@ -287,6 +353,36 @@ public:
         return *this;
     }
 
+    #ifndef SWIG
+    //!  Add an element-wise expression to this, in a single pass
+    template <typename Node_T>
+    Vector& operator+=(const VectorExpression<Node_T>& expr)
+    {
+        if (size() != expr.size())
+            throw except::Exception(Ctxt("Required to equally size matrices for element-wise add"));
+
+        for (size_t i = 0; i < expr.size(); ++i)
+        {
+            mRaw.mRaw[i] += expr.at(i);
+        }
+        return *this;
+    }
+
+    //!  Subtract an element-wise expression from this, in a single pass
+    template <typename Node_T>
+    Vector& operator-=(const VectorExpression<Node_T>& expr)
+    {
+        if (size() != expr.size())
+            throw except::Exception(Ctxt("Matrices must be same size for element-wise subtract"));
+
+        for (size_t i = 0; i < expr.size(); ++i)
+        {
+            mRaw.mRaw[i] -= expr.at(i);
+        }
+        return *this;
+    }
+    #endif // SWIG
+
     //!  Add this to another vector and return a copy
     Vector add(const Vector& v) const
     {
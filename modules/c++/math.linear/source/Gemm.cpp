@@ -0,0 +1,377 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <math/linear/Gemm.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <sys/AbstractOS.h>
+#include <sys/OS.h>
+#include <mt/Runnable1D.h>
+
+namespace
+{
+// Width of the SIMD registers the build targets; the register tile below
+// is sized so its accumulators fit in the register file.
+constexpr size_t getVectorBytes()
+{
+    return sys::getSIMDInstructionSet() == sys::SIMDInstructionSet::AVX512F ? 64 :
+           sys::getSIMDInstructionSet() == sys::SIMDInstructionSet::AVX2 ? 32 : 16;
+}
+
+// Only thread when there's enough work to pay for starting the threads.
+constexpr size_t minOpsToThread = 1 << 21;
+
+/*
+ * Register, cache and panel sizes for an element type T, whose real and
+ * (for complex types) imaginary parts are of type R.
+ *
+ * A is packed MC rows by KC columns at a time, into slivers MR rows tall;
+ * B is packed KC rows by NC columns at a time, into slivers NR columns
+ * wide.  Within a sliver, the NumParts planes of each k are adjacent so
+ * the kernel reads both panels strictly sequentially.
+ */
+template <typename T>
+struct GemmTraits
+{
+    using R = T;
+    static constexpr size_t NumParts = 1;
+};
+template <typename R_T>
+struct GemmTraits<std::complex<R_T> >
+{
+    using R = R_T;
+    static constexpr size_t NumParts = 2;
+};
+
+template <typename T>
+struct GemmBlocking
+{
+    using R = typename GemmTraits<T>::R;
+    static constexpr size_t NumParts = GemmTraits<T>::NumParts;
+
+    static constexpr size_t MR = 4;
+    static constexpr size_t NR = 2 * getVectorBytes() / sizeof(R) / NumParts;
+    static constexpr size_t KC = 2048 / sizeof(T);
+    static constexpr size_t MC = 24 * MR;
+    static constexpr size_t NC = 128 * NR;
+};
+
+// Copy A(row0:row0+mc, col0:col0+kc) into MR-tall slivers, zero padding
+// the last one.
+template <typename T>
+void packA(const typename GemmTraits<T>::R* A, size_t N,
+           size_t row0, size_t mc, size_t col0, size_t kc,
+           typename GemmTraits<T>::R* packed)
+{
+    using Blocking = GemmBlocking<T>;
+    constexpr size_t MR = Blocking::MR;
+    constexpr size_t NumParts = Blocking::NumParts;
+
+    for (size_t ir = 0; ir < mc; ir += MR)
+    {
+        const size_t mr = std::min(mc - ir, MR);
+        for (size_t kk = 0; kk < kc; ++kk)
+        {
+            for (size_t part = 0; part < NumParts; ++part, packed += MR)
+            {
+                size_t ii = 0;
+                for (; ii < mr; ++ii)
+                {
+                    packed[ii] = A[((row0 + ir + ii) * N + col0 + kk) * NumParts + part];
+                }
+                for (; ii < MR; ++ii)
+                {
+                    packed[ii] = 0;
+                }
+            }
+        }
+    }
+}
+
+// Copy B(row0:row0+kc, col0:col0+nc) into NR-wide slivers, zero padding
+// the last one.
+template <typename T>
+void packB(const typename GemmTraits<T>::R* B, size_t P,
+           size_t row0, size_t kc, size_t col0, size_t nc,
+           typename GemmTraits<T>::R* packed)
+{
+    using Blocking = GemmBlocking<T>;
+    constexpr size_t NR = Blocking::NR;
+    constexpr size_t NumParts = Blocking::NumParts;
+
+    for (size_t jr = 0; jr < nc; jr += NR)
+    {
+        const size_t nr = std::min(nc - jr, NR);
+        for (size_t kk = 0; kk < kc; ++kk)
+        {
+            const auto* const row = B + ((row0 + kk) * P + col0 + jr) * NumParts;
+            for (size_t part = 0; part < NumParts; ++part, packed += NR)
+            {
+                size_t jj = 0;
+                for (; jj < nr; ++jj)
+                {
+                    packed[jj] = row[jj * NumParts + part];
+                }
+                for (; jj < NR; ++jj)
+                {
+                    packed[jj] = 0;
+                }
+            }
+        }
+    }
+}
+
+// c += a b for one SIMD register's worth of a row of the tile.  With W
+// fixed at the register width the loop becomes a single multiply-add.
+template <typename R, size_t W>
+inline void multiplyAdd(R (&c)[W], R a, const R* b)
+{
+    for (size_t jj = 0; jj < W; ++jj)
+    {
+        c[jj] += a * b[jj];
+    }
+}
+template <typename R, size_t W>
+inline void multiplyAdd(R (&cRe)[W], R (&cIm)[W], R aRe, R aIm, const R* bRe, const R* bIm)
+{
+    for (size_t jj = 0; jj < W; ++jj)
+    {
+        cRe[jj] += aRe * bRe[jj] - aIm * bIm[jj];
+        cIm[jj] += aRe * bIm[jj] + aIm * bRe[jj];
+    }
+}
+
+/*
+ * acc = a b for one MR x NR tile: four rows, each two registers wide.  The
+ * tile is spelled out as separate register-sized locals, which a and b
+ * can't alias, so the compiler keeps all of it in registers.
+ */
+template <typename R, size_t MR, size_t NR>
+void kernel(size_t kc, const R* a, const R* b, R (&acc)[1][MR][NR])
+{
+    static_assert(MR == 4 && NR % 2 == 0, "kernel() is unrolled for a 4 x 2 register tile");
+    constexpr size_t W = NR / 2;
+    R c00[W] = {}, c01[W] = {};
+    R c10[W] = {}, c11[W] = {};
+    R c20[W] = {}, c21[W] = {};
+    R c30[W] = {}, c31[W] = {};
+    for (size_t kk = 0; kk < kc; ++kk, a += MR, b += NR)
+    {
+        multiplyAdd(c00, a[0], b);
+        multiplyAdd(c01, a[0], b + W);
+        multiplyAdd(c10, a[1], b);
+        multiplyAdd(c11, a[1], b + W);
+        multiplyAdd(c20, a[2], b);
+        multiplyAdd(c21, a[2], b + W);
+        multiplyAdd(c30, a[3], b);
+        multiplyAdd(c31, a[3], b + W);
+    }
+    std::copy(c00, c00 + W, acc[0][0]);
+    std::copy(c01, c01 + W, acc[0][0] + W);
+    std::copy(c10, c10 + W, acc[0][1]);
+    std::copy(c11, c11 + W, acc[0][1] + W);
+    std::copy(c20, c20 + W, acc[0][2]);
+    std::copy(c21, c21 + W, acc[0][2] + W);
+    std::copy(c30, c30 + W, acc[0][3]);
+    std::copy(c31, c31 + W, acc[0][3] + W);
+}
+
+// Complex tiles are four rows, one register wide, for each of the real and
+// imaginary parts.
+template <typename R, size_t MR, size_t NR>
+void kernel(size_t kc, const R* a, const R* b, R (&acc)[2][MR][NR])
+{
+    static_assert(MR == 4, "kernel() is unrolled for 4 rows");
+    constexpr size_t W = NR;
+    R re0[W] = {}, im0[W] = {};
+    R re1[W] = {}, im1[W] = {};
+    R re2[W] = {}, im2[W] = {};
+    R re3[W] = {}, im3[W] = {};
+    for (size_t kk = 0; kk < kc; ++kk, a += 2 * MR, b += 2 * NR)
+    {
+        multiplyAdd(re0, im0, a[0], a[MR], b, b + NR);
+        multiplyAdd(re1, im1, a[1], a[MR + 1], b, b + NR);
+        multiplyAdd(re2, im2, a[2], a[MR + 2], b, b + NR);
+        multiplyAdd(re3, im3, a[3], a[MR + 3], b, b + NR);
+    }
+    std::copy(re0, re0 + W, acc[0][0]);
+    std::copy(re1, re1 + W, acc[0][1]);
+    std::copy(re2, re2 + W, acc[0][2]);
+    std::copy(re3, re3 + W, acc[0][3]);
+    std::copy(im0, im0 + W, acc[1][0]);
+    std::copy(im1, im1 + W, acc[1][1]);
+    std::copy(im2, im2 + W, acc[1][2]);
+    std::copy(im3, im3 + W, acc[1][3]);
+}
+
+/*
+ * Computes one MC-row block of C per call.  Each thread gets its own copy
+ * so the packing buffers aren't shared.
+ */
+template <typename T>
+class GemmRowBlock final
+{
+    using Blocking = GemmBlocking<T>;
+    using R = typename Blocking::R;
+    static constexpr size_t NumParts = Blocking::NumParts;
+    using Tile = R[NumParts][Blocking::MR][Blocking::NR];
+
+public:
+    GemmRowBlock(size_t M, size_t N, size_t P,
+                 const T* A, const T* B, T* C) :
+        mM(M), mN(N), mP(P),
+        mA(reinterpret_cast<const R*>(A)),
+        mB(reinterpret_cast<const R*>(B)),
+        mC(reinterpret_cast<R*>(C))
+    {
+    }
+
+    void operator()(size_t block) const
+    {
+        const size_t MR = Blocking::MR;
+        const size_t NR = Blocking::NR;
+        const size_t KC = Blocking::KC;
+        const size_t MC = Blocking::MC;
+        const size_t NC = Blocking::NC;
+
+        const size_t row0 = block * MC;
+        const size_t mc = std::min(mM - row0, MC);
+        std::fill_n(mC + row0 * mP * NumParts, mc * mP * NumParts, R(0));
+
+        mPackedA.resize(((mc + MR - 1) / MR) * MR * KC * NumParts);
+        mPackedB.resize(((std::min(mP, NC) + NR - 1) / NR) * NR * KC * NumParts);
+
+        for (size_t col0 = 0; col0 < mP; col0 += NC)
+        {
+            const size_t nc = std::min(mP - col0, NC);
+            for (size_t k0 = 0; k0 < mN; k0 += KC)
+            {
+                const size_t kc = std::min(mN - k0, KC);
+                packB<T>(mB, mP, k0, kc, col0, nc, mPackedB.data());
+                packA<T>(mA, mN, row0, mc, k0, kc, mPackedA.data());
+
+                for (size_t jr = 0; jr < nc; jr += NR)
+                {
+                    const R* const b = mPackedB.data() + jr * kc * NumParts;
+                    for (size_t ir = 0; ir < mc; ir += MR)
+                    {
+                        const R* const a = mPackedA.data() + ir * kc * NumParts;
+                        Tile acc = {};
+                        kernel(kc, a, b, acc);
+                        store(acc, row0 + ir, std::min(mc - ir, MR),
+                              col0 + jr, std::min(nc - jr, NR));
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    void store(const Tile& acc,
+               size_t row0, size_t mr, size_t col0, size_t nr) const
+    {
+        for (size_t ii = 0; ii < mr; ++ii)
+        {
+            R* const out = mC + ((row0 + ii) * mP + col0) * NumParts;
+            for (size_t jj = 0; jj < nr; ++jj)
+            {
+                for (size_t part = 0; part < NumParts; ++part)
+                {
+                    out[jj * NumParts + part] += acc[part][ii][jj];
+                }
+            }
+        }
+    }
+
+    const size_t mM;
+    const size_t mN;
+    const size_t mP;
+    const R* const mA;
+    const R* const mB;
+    R* const mC;
+
+    mutable std::vector<R> mPackedA;
+    mutable std::vector<R> mPackedB;
+};
+
+template <typename T>
+void gemmImpl(size_t M, size_t N, size_t P,
+              const T* A, const T* B, T* C, size_t numThreads)
+{
+    if (M == 0 || P == 0)
+    {
+        return;
+    }
+
+    const size_t numBlocks = (M + GemmBlocking<T>::MC - 1) / GemmBlocking<T>::MC;
+    if (numThreads == 0)
+    {
+        numThreads = M * N * P < minOpsToThread ? 1 :
+                sys::OS().getNumCPUsAvailable();
+    }
+    numThreads = std::max<size_t>(std::min(numThreads, numBlocks), 1);
+
+    const GemmRowBlock<T> op(M, N, P, A, B, C);
+    mt::run1DWithCopies(numBlocks, numThreads, op);
+}
+}
+
+namespace math
+{
+namespace linear
+{
+void gemm(size_t M, size_t N, size_t P,
+          const float* A, const float* B, float* C,
+          size_t numThreads)
+{
+    gemmImpl(M, N, P, A, B, C, numThreads);
+}
+
+void gemm(size_t M, size_t N, size_t P,
+          const double* A, const double* B, double* C,
+          size_t numThreads)
+{
+    gemmImpl(M, N, P, A, B, C, numThreads);
+}
+
+void gemm(size_t M, size_t N, size_t P,
+          const std::complex<float>* A,
+          const std::complex<float>* B,
+          std::complex<float>* C,
+          size_t numThreads)
+{
+    gemmImpl(M, N, P, A, B, C, numThreads);
+}
+
+void gemm(size_t M, size_t N, size_t P,
+          const std::complex<double>* A,
+          const std::complex<double>* B,
+          std::complex<double>* C,
+          size_t numThreads)
+{
+    gemmImpl(M, N, P, A, B, C, numThreads);
+}
+}
+}
@@ -0,0 +1,210 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <import/math/linear.h>
+#include <import/sys.h>
+#include <import/str.h>
+#include <import/except.h>
+
+namespace
+{
+// The matrix benchmarks cycle through a pool small enough to stay in cache,
+// so they time the arithmetic rather than memory
+constexpr size_t poolSize = 1024;
+
+template <size_t N, typename T>
+math::linear::MatrixMxN<N, N, T> makeMatrix(size_t seed)
+{
+    math::linear::MatrixMxN<N, N, T> mx;
+    for (size_t i = 0; i < N; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            mx(i, j) = static_cast<T>((seed * 7 + i * 5 + j * 3) % 11) / 11 + (i == j ? 2 : 0);
+        }
+    }
+    return mx;
+}
+
+// How multiply() used to work, for comparison
+template <size_t M, size_t N, size_t P, typename T>
+math::linear::MatrixMxN<M, P, T> multiplyLoop(const math::linear::MatrixMxN<M, N, T>& A,
+                                              const math::linear::MatrixMxN<N, P, T>& B)
+{
+    math::linear::MatrixMxN<M, P, T> C;
+    for (size_t i = 0; i < M; i++)
+    {
+        for (size_t j = 0; j < P; j++)
+        {
+            C.mRaw[i][j] = 0;
+            for (size_t k = 0; k < N; k++)
+            {
+                C.mRaw[i][j] += A.mRaw[i][k] * B.mRaw[k][j];
+            }
+        }
+    }
+    return C;
+}
+
+void printResult(const std::string& name, double timeMS, size_t count)
+{
+    std::cout << std::setw(40) << std::left << name << " "
+              << std::setw(12) << std::right << std::fixed << std::setprecision(1) << timeMS << " "
+              << std::setw(10) << std::right << std::setprecision(2) << timeMS * 1e6 / count
+              << std::endl;
+}
+
+template <typename Function_T>
+void run(const std::string& name, size_t count, Function_T function)
+{
+    sys::RealTimeStopWatch sw;
+    sw.start();
+    function();
+    printResult(name, sw.stop(), count);
+}
+
+template <size_t N, typename T>
+void benchmarkMatrices(const std::string& typeName, size_t count)
+{
+    const std::string suffix = "<" + std::to_string(N) + "x" + std::to_string(N) + ", " + typeName + ">";
+
+    std::vector<math::linear::MatrixMxN<N, N, T> > A(poolSize), B(poolSize), C(poolSize);
+    std::vector<math::linear::MatrixMxN<N, 1, T> > x(poolSize), y(poolSize);
+    std::vector<T> d(poolSize);
+    for (size_t ii = 0; ii < poolSize; ++ii)
+    {
+        A[ii] = makeMatrix<N, T>(ii);
+        B[ii] = makeMatrix<N, T>(ii + 1);
+        x[ii] = makeMatrix<N, T>(ii + 2).col(0);
+    }
+
+    run("BM_MultiplyLoop" + suffix, count, [&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            C[ii % poolSize] = multiplyLoop(A[ii % poolSize], B[ii % poolSize]);
+    });
+    run("BM_Multiply" + suffix, count, [&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            C[ii % poolSize] = A[ii % poolSize] * B[ii % poolSize];
+    });
+    run("BM_MultiplyVectorLoop" + suffix, count, [&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            y[ii % poolSize] = multiplyLoop(A[ii % poolSize], x[ii % poolSize]);
+    });
+    run("BM_MultiplyVector" + suffix, count, [&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            y[ii % poolSize] = A[ii % poolSize] * x[ii % poolSize];
+    });
+    run("BM_InverseLU" + suffix, count, [&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            C[ii % poolSize] = math::linear::inverseLU(A[ii % poolSize]);
+    });
+    run("BM_Inverse" + suffix, count, [&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            C[ii % poolSize] = math::linear::inverse(A[ii % poolSize]);
+    });
+    run("BM_Determinant" + suffix, count, [&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            d[ii % poolSize] = math::linear::determinant(A[ii % poolSize]);
+    });
+}
+
+template <typename T>
+void benchmarkBatch(const std::string& typeName, size_t count)
+{
+    const auto R = makeMatrix<3, T>(0);
+
+    // An array of structures ...
+    std::vector<math::linear::VectorN<3, T> > vectors(count);
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        vectors[ii][0] = static_cast<T>(ii % 7);
+        vectors[ii][1] = static_cast<T>(ii % 5);
+        vectors[ii][2] = static_cast<T>(ii % 3);
+    }
+    run("BM_TransformVectorN<" + typeName + ">", count, [&]() {
+        for (auto& v : vectors)
+            v = R * v;
+    });
+
+    // ... versus a structure of arrays
+    std::vector<T> x(count), y(count), z(count);
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        x[ii] = vectors[ii][0];
+        y[ii] = vectors[ii][1];
+        z[ii] = vectors[ii][2];
+    }
+    run("BM_TransformBatch<" + typeName + ">", count, [&]() {
+        math::linear::transform(R, { x, y, z }, { x, y, z });
+    });
+
+    std::vector<T> dots(count);
+    run("BM_DotBatch<" + typeName + ">", count, [&]() {
+        math::linear::dot<3, T>({ x, y, z }, { z, y, x }, dots);
+    });
+    run("BM_CrossBatch<" + typeName + ">", count, [&]() {
+        math::linear::cross<T>({ x, y, z }, { z, y, x }, { x, y, z });
+    });
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        size_t count = 1000000;
+        if (argc > 1)
+        {
+            count = str::toType<size_t>(argv[1]);
+        }
+
+        std::cout << std::setw(40) << std::left << "Benchmark" << " "
+                  << std::setw(12) << std::right << "Time (ms)" << " "
+                  << std::setw(10) << std::right << "ns/op" << std::endl;
+        std::cout << std::string(64, '-') << std::endl;
+
+        benchmarkMatrices<3, double>("double", count);
+        benchmarkMatrices<4, double>("double", count);
+        benchmarkMatrices<3, float>("float", count);
+        benchmarkMatrices<4, float>("float", count);
+        benchmarkBatch<double>("double", count);
+        benchmarkBatch<float>("float", count);
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.toString() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
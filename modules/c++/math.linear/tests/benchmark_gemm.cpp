@@ -0,0 +1,154 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include <import/math/linear.h>
+#include <import/sys.h>
+#include <import/str.h>
+#include <import/except.h>
+
+namespace
+{
+template <typename T>
+math::linear::Matrix2D<T> makeMatrix(size_t M, size_t N)
+{
+    math::linear::Matrix2D<T> mx(M, N);
+    for (size_t ii = 0; ii < M; ++ii)
+    {
+        for (size_t jj = 0; jj < N; ++jj)
+        {
+            mx(ii, jj) = T(static_cast<float>((ii * 31 + jj * 17) % 23) / 23.0f);
+        }
+    }
+    return mx;
+}
+
+// How multiply() used to work: the i-j-k loop, striding down columns of B
+template <typename T>
+void multiplyTripleLoop(const math::linear::Matrix2D<T>& A,
+                        const math::linear::Matrix2D<T>& B,
+                        math::linear::Matrix2D<T>& C)
+{
+    for (size_t i = 0; i < A.rows(); i++)
+    {
+        for (size_t j = 0; j < B.cols(); j++)
+        {
+            C(i, j) = 0;
+            for (size_t k = 0; k < A.cols(); k++)
+            {
+                C(i, j) += A(i, k) * B(k, j);
+            }
+        }
+    }
+}
+
+// A complex multiply-add is 8 real flops
+template <typename T>
+double getFlops(size_t n)
+{
+    const double flopsPerMultiplyAdd = std::is_floating_point<T>::value ? 2 : 8;
+    return flopsPerMultiplyAdd * n * n * n;
+}
+
+void printResult(const std::string& name, size_t n, double timeMS, double flops)
+{
+    std::cout << std::setw(36) << std::left << name << " "
+              << std::setw(6) << std::right << n << " "
+              << std::setw(12) << std::right << std::fixed << std::setprecision(1) << timeMS << " "
+              << std::setw(10) << std::right << std::setprecision(2) << flops / (timeMS * 1e6)
+              << std::endl;
+}
+
+template <typename T>
+void benchmark(const std::string& typeName, size_t n, bool runTripleLoop)
+{
+    const auto A = makeMatrix<T>(n, n);
+    const auto B = makeMatrix<T>(n, n);
+    math::linear::Matrix2D<T> C(n, n);
+
+    if (runTripleLoop)
+    {
+        sys::RealTimeStopWatch sw;
+        sw.start();
+        multiplyTripleLoop(A, B, C);
+        printResult("BM_TripleLoop<" + typeName + ">", n, sw.stop(), getFlops<T>(n));
+    }
+
+    std::vector<size_t> threads{ 1 };
+    const size_t numCPUs = sys::OS().getNumCPUsAvailable();
+    if (numCPUs > 1)
+    {
+        threads.push_back(numCPUs);
+    }
+    for (const auto numThreads : threads)
+    {
+        sys::RealTimeStopWatch sw;
+        sw.start();
+        math::linear::gemm(n, n, n, A.get(), B.get(), &C(0, 0), numThreads);
+        printResult("BM_Gemm<" + typeName + "> (" + std::to_string(numThreads) + " threads)",
+                    n, sw.stop(), getFlops<T>(n));
+    }
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        size_t n = 1024;
+        if (argc > 1)
+        {
+            n = str::toType<size_t>(argv[1]);
+        }
+        // The triple loop takes minutes on big matrices; skip it if asked.
+        const bool runTripleLoop = argc <= 2 || str::toType<bool>(argv[2]);
+
+        std::cout << std::setw(36) << std::left << "Benchmark" << " "
+                  << std::setw(6) << std::right << "N" << " "
+                  << std::setw(12) << std::right << "Time (ms)" << " "
+                  << std::setw(10) << std::right << "GFLOP/s" << std::endl;
+        std::cout << std::string(67, '-') << std::endl;
+
+        benchmark<float>("float", n, runTripleLoop);
+        benchmark<double>("double", n, runTripleLoop);
+        benchmark<std::complex<float> >("complex<float>", n, runTripleLoop);
+        benchmark<std::complex<double> >("complex<double>", n, runTripleLoop);
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.toString() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
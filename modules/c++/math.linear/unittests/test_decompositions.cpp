@@ -0,0 +1,273 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stddef.h>
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <import/math/linear.h>
+#include <math/linear/Decompositions.h>
+#include "TestCase.h"
+
+namespace
+{
+using Complex = std::complex<double>;
+
+template <typename T>
+T makeValue(std::minstd_rand& generator)
+{
+    return static_cast<T>(2.0 * generator() / std::minstd_rand::max() - 1.0);
+}
+template <>
+Complex makeValue(std::minstd_rand& generator)
+{
+    const double real = makeValue<double>(generator);
+    return Complex(real, makeValue<double>(generator));
+}
+
+template <typename T>
+math::linear::Matrix2D<T> makeMatrix(size_t M, size_t N, size_t seed)
+{
+    std::minstd_rand generator(static_cast<std::minstd_rand::result_type>(seed + 1));
+    math::linear::Matrix2D<T> mx(M, N);
+    for (size_t ii = 0; ii < M; ++ii)
+    {
+        for (size_t jj = 0; jj < N; ++jj)
+        {
+            mx(ii, jj) = makeValue<T>(generator);
+        }
+    }
+    return mx;
+}
+
+template <typename T>
+math::linear::Matrix2D<T> conjugateTranspose(const math::linear::Matrix2D<T>& A)
+{
+    math::linear::Matrix2D<T> retval(A.cols(), A.rows());
+    for (size_t ii = 0; ii < A.rows(); ++ii)
+    {
+        for (size_t jj = 0; jj < A.cols(); ++jj)
+        {
+            retval(jj, ii) = math::linear::details::conjugate(A(ii, jj));
+        }
+    }
+    return retval;
+}
+
+// A^H A + N I is Hermitian positive definite
+template <typename T>
+math::linear::Matrix2D<T> makeSPD(size_t N, size_t seed)
+{
+    const auto A = makeMatrix<T>(N, N, seed);
+    auto retval = conjugateTranspose(A) * A;
+    for (size_t ii = 0; ii < N; ++ii)
+    {
+        retval(ii, ii) += static_cast<T>(N);
+    }
+    return retval;
+}
+
+template <typename T>
+double maxDifference(const math::linear::Matrix2D<T>& A, const math::linear::Matrix2D<T>& B)
+{
+    double retval = 0;
+    for (size_t ii = 0; ii < A.rows(); ++ii)
+    {
+        for (size_t jj = 0; jj < A.cols(); ++jj)
+        {
+            retval = std::max(retval, std::abs(A(ii, jj) - B(ii, jj)));
+        }
+    }
+    return retval;
+}
+
+// Solve A X = A X0 for a size that spans several blocks
+template <typename T, typename Decomposition_T>
+void testSolve(const std::string& testName, const math::linear::Matrix2D<T>& A,
+               Decomposition_T& decomposition)
+{
+    const auto X0 = makeMatrix<T>(A.cols(), 3, 1234);
+    const auto B = A * X0;
+
+    decomposition.factor(A);
+    const auto X = decomposition.solve(B);
+    TEST_ASSERT_EQ(X.rows(), X0.rows());
+    TEST_ASSERT_EQ(X.cols(), X0.cols());
+    TEST_ASSERT_LESSER(maxDifference(X, X0), 1e-10);
+
+    // One column at a time through the span interface
+    std::vector<T> b(B.rows());
+    for (size_t ii = 0; ii < B.rows(); ++ii)
+    {
+        b[ii] = B(ii, 1);
+    }
+    decomposition.solve(coda_oss::span<T>(b.data(), b.size()));
+    for (size_t ii = 0; ii < X0.rows(); ++ii)
+    {
+        TEST_ASSERT_LESSER(std::abs(b[ii] - X0(ii, 1)), 1e-10);
+    }
+
+    TEST_EXCEPTION(decomposition.solve(coda_oss::span<T>(b.data(), b.size()), 2));
+}
+}
+
+TEST_CASE(testLU)
+{
+    math::linear::LU<double> lu;
+    testSolve(testName, makeMatrix<double>(70, 70, 0), lu);
+    TEST_ASSERT(lu.isNonsingular());
+
+    // Refactoring reuses the object
+    testSolve(testName, makeMatrix<double>(70, 70, 99), lu);
+    testSolve(testName, makeMatrix<double>(5, 5, 7), lu);
+
+    math::linear::LU<Complex> complexLU;
+    testSolve(testName, makeMatrix<Complex>(45, 45, 3), complexLU);
+}
+
+TEST_CASE(testLUDeterminant)
+{
+    const double values[] = { 2, -1, 0,
+                              -1, 2, -1,
+                              0, -1, 2 };
+    const math::linear::MatrixMxN<3, 3> A(values);
+    const math::linear::LU<double> lu(A);
+    TEST_ASSERT_ALMOST_EQ(lu.determinant(), 4.0);
+
+    // A row swap flips the sign
+    const double swapped[] = { 0, -1, 2,
+                               -1, 2, -1,
+                               2, -1, 0 };
+    const math::linear::LU<double> luSwapped(math::linear::Matrix2D<double>(3, 3, swapped));
+    TEST_ASSERT_ALMOST_EQ(luSwapped.determinant(), -4.0);
+}
+
+TEST_CASE(testLUSingular)
+{
+    math::linear::Matrix2D<double> A = makeMatrix<double>(40, 40, 0);
+    for (size_t jj = 0; jj < A.cols(); ++jj)
+    {
+        A(37, jj) = A(3, jj);
+    }
+    const math::linear::LU<double> lu(A);
+    TEST_ASSERT_FALSE(lu.isNonsingular());
+    TEST_ASSERT_EQ(lu.determinant(), 0.0);
+    TEST_EXCEPTION(lu.solve(A));
+
+    TEST_EXCEPTION(math::linear::LU<double>(math::linear::Matrix2D<double>(3, 2)));
+}
+
+TEST_CASE(testCholesky)
+{
+    math::linear::Cholesky<double> cholesky;
+    testSolve(testName, makeSPD<double>(70, 0), cholesky);
+    TEST_ASSERT(cholesky.isSPD());
+
+    const auto A = makeSPD<double>(70, 0);
+    const auto L = cholesky.getL();
+    TEST_ASSERT_LESSER(maxDifference(L * conjugateTranspose(L), A), 1e-10);
+    TEST_ASSERT_LESSER(std::abs(cholesky.determinant() / math::linear::LU<double>(A).determinant() - 1.0),
+                       1e-10);
+
+    math::linear::Cholesky<Complex> complexCholesky;
+    testSolve(testName, makeSPD<Complex>(50, 3), complexCholesky);
+}
+
+TEST_CASE(testCholeskyNotSPD)
+{
+    auto A = makeSPD<double>(40, 0);
+    A(35, 35) = -1;
+    const math::linear::Cholesky<double> cholesky(A);
+    TEST_ASSERT_FALSE(cholesky.isSPD());
+    TEST_EXCEPTION(cholesky.solve(A));
+}
+
+TEST_CASE(testQR)
+{
+    math::linear::QR<double> qr;
+    testSolve(testName, makeMatrix<double>(70, 70, 0), qr);
+
+    const auto A = makeMatrix<double>(90, 70, 5);
+    qr.factor(A);
+    TEST_ASSERT(qr.isFullRank());
+    const auto Q = qr.getQ();
+    const auto R = qr.getR();
+    TEST_ASSERT_LESSER(maxDifference(Q * R, A), 1e-12);
+    TEST_ASSERT_LESSER(maxDifference(conjugateTranspose(Q) * Q,
+                                     math::linear::identityMatrix<double>(70)), 1e-12);
+
+    math::linear::QR<Complex> complexQR;
+    testSolve(testName, makeMatrix<Complex>(45, 45, 3), complexQR);
+    const auto complexA = makeMatrix<Complex>(60, 45, 8);
+    complexQR.factor(complexA);
+    TEST_ASSERT_LESSER(maxDifference(complexQR.getQ() * complexQR.getR(), complexA), 1e-12);
+
+    TEST_EXCEPTION(math::linear::QR<double>(math::linear::Matrix2D<double>(2, 3)));
+}
+
+TEST_CASE(testQRLeastSquares)
+{
+    // Fit y = 0.5 + 2 x to points off the line; same answer as the
+    // normal equations
+    const double x[] = { 0, 1, 2, 3, 4 };
+    const double y[] = { 0.7, 2.3, 4.6, 6.4, 8.6 };
+    math::linear::Matrix2D<double> A(5, 2);
+    math::linear::Matrix2D<double> b(5, 1);
+    for (size_t ii = 0; ii < 5; ++ii)
+    {
+        A(ii, 0) = 1;
+        A(ii, 1) = x[ii];
+        b(ii, 0) = y[ii];
+    }
+    const math::linear::QR<double> qr(A);
+    const auto c = qr.solve(b);
+    const auto expected = math::linear::inverse(A.transpose() * A) * (A.transpose() * b);
+    TEST_ASSERT_EQ(c.rows(), static_cast<size_t>(2));
+    TEST_ASSERT_ALMOST_EQ(c(0, 0), expected(0, 0));
+    TEST_ASSERT_ALMOST_EQ(c(1, 0), expected(1, 0));
+}
+
+TEST_CASE(testQRDeterminant)
+{
+    const auto A = makeMatrix<double>(50, 50, 11);
+    const double expected = math::linear::LU<double>(A).determinant();
+    const double actual = math::linear::QR<double>(A).determinant();
+    TEST_ASSERT_LESSER(std::abs(actual / expected - 1.0), 1e-10);
+
+    const auto complexA = makeMatrix<Complex>(30, 30, 2);
+    const Complex complexExpected = math::linear::LU<Complex>(complexA).determinant();
+    const Complex complexActual = math::linear::QR<Complex>(complexA).determinant();
+    TEST_ASSERT_LESSER(std::abs(complexActual / complexExpected - 1.0), 1e-10);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testLU);
+    TEST_CHECK(testLUDeterminant);
+    TEST_CHECK(testLUSingular);
+    TEST_CHECK(testCholesky);
+    TEST_CHECK(testCholeskyNotSPD);
+    TEST_CHECK(testQR);
+    TEST_CHECK(testQRLeastSquares);
+    TEST_CHECK(testQRDeterminant);
+    )
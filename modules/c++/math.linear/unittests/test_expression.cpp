@@ -0,0 +1,255 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <new>
+#include <type_traits>
+
+#include <import/math/linear.h>
+#include "TestCase.h"
+
+// Count allocations, to check that expressions don't copy their operands
+static size_t numAllocations = 0;
+void* operator new(size_t size)
+{
+    ++numAllocations;
+    if (void* p = malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+void operator delete[](void* p) noexcept
+{
+    free(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+void operator delete[](void* p, size_t) noexcept
+{
+    free(p);
+}
+
+namespace
+{
+using Matrix = math::linear::Matrix2D<double>;
+using Vector = math::linear::Vector<double>;
+using math::linear::lazy;
+
+Matrix makeMatrix(size_t M, size_t N, double offset)
+{
+    Matrix mx(M, N);
+    for (size_t ii = 0; ii < M; ++ii)
+    {
+        for (size_t jj = 0; jj < N; ++jj)
+        {
+            mx(ii, jj) = static_cast<double>(ii * N + jj) / 3.0 + offset;
+        }
+    }
+    return mx;
+}
+
+Vector makeVector(size_t N, double offset)
+{
+    Vector vec(N);
+    for (size_t ii = 0; ii < N; ++ii)
+    {
+        vec[ii] = static_cast<double>(ii) * 0.75 + offset;
+    }
+    return vec;
+}
+}
+
+TEST_CASE(testMatrixExpression)
+{
+    const auto A = makeMatrix(3, 4, 1.0);
+    const auto B = makeMatrix(3, 4, -2.0);
+    const auto C = makeMatrix(3, 4, 0.5);
+
+    // Nothing is evaluated until the expression is assigned
+    const auto sum = lazy(A) + lazy(B) * 2.0 - lazy(C) / 4.0;
+    static_assert(!std::is_same<std::decay<decltype(sum)>::type, Matrix>::value,
+                  "lazy() operands should give expressions");
+    TEST_ASSERT_EQ(sum.rows(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(sum.cols(), static_cast<size_t>(4));
+
+    const Matrix result = sum;
+    const Matrix expected = A.add(B.multiply(2.0)).subtract(C.multiply(0.25));
+    TEST_ASSERT(result == expected);
+    TEST_ASSERT_ALMOST_EQ(sum(2, 3), expected(2, 3));
+
+    const Matrix negated = -lazy(A) + 2.0 * B;
+    TEST_ASSERT(negated == B.multiply(2.0).subtract(A));
+}
+
+TEST_CASE(testVectorExpression)
+{
+    const auto x = makeVector(5, 1.0);
+    const auto y = makeVector(5, 2.0);
+    const auto z = makeVector(5, -3.0);
+
+    const Vector result = lazy(x) * y - lazy(z) / y + 3.0 * lazy(x);
+    for (size_t ii = 0; ii < result.size(); ++ii)
+    {
+        TEST_ASSERT_ALMOST_EQ(result[ii], x[ii] * y[ii] - z[ii] / y[ii] + 3.0 * x[ii]);
+    }
+
+    // A product is evaluated eagerly, the rest in one pass
+    const auto A = makeMatrix(5, 5, 0.25);
+    const Vector affine = lazy(A * x) + y - lazy(z) * 2.0;
+    const Vector Ax = A * x;
+    for (size_t ii = 0; ii < affine.size(); ++ii)
+    {
+        TEST_ASSERT_ALMOST_EQ(affine[ii], Ax[ii] + y[ii] - z[ii] * 2.0);
+    }
+    const Vector product = (lazy(A) + A) * (lazy(x) - y);
+    const Vector expected = A.multiply(2.0) * x.subtract(y);
+    TEST_ASSERT(product == expected);
+}
+
+TEST_CASE(testAssignment)
+{
+    auto A = makeMatrix(4, 4, 1.0);
+    const auto B = makeMatrix(4, 4, 3.0);
+    const double* const storage = A.get();
+
+    // Same-sized assignment reuses the storage, even when A is an operand
+    const Matrix expected = A.multiply(0.5).add(B);
+    A = lazy(A) * 0.5 + B;
+    TEST_ASSERT(A == expected);
+    TEST_ASSERT_EQ(A.get(), storage);
+
+    A += lazy(B) - lazy(B) * 2.0;
+    TEST_ASSERT(A == expected.subtract(B));
+    A -= -lazy(B);
+    TEST_ASSERT(A == expected);
+
+    Matrix C;
+    C = lazy(A) - B;
+    TEST_ASSERT(C == expected.subtract(B));
+
+    auto x = makeVector(6, 1.0);
+    const auto y = makeVector(6, -1.0);
+    const Vector expectedX = x.add(y.subtract(x));
+    x = x + (lazy(y) - x);
+    TEST_ASSERT(x == expectedX);
+    x -= lazy(y) * 1.0;
+    TEST_ASSERT(x == Vector(6, 0.0));
+}
+
+TEST_CASE(testTemporaries)
+{
+    // Temporaries are moved into the expression so it can outlive them
+    const auto sum = lazy(makeMatrix(2, 3, 1.0)) + makeMatrix(2, 3, 2.0);
+    const Matrix result = sum;
+    TEST_ASSERT(result == makeMatrix(2, 3, 1.0).add(makeMatrix(2, 3, 2.0)));
+
+    const auto lazyVector = -lazy(makeVector(4, 1.0)) * 2.0;
+    const Vector vec = lazyVector;
+    auto expected = makeVector(4, 1.0);
+    expected *= -2.0;
+    TEST_ASSERT(vec == expected);
+
+    // Nodes are moved, not copied, as the expression is built: only the
+    // product and the result allocate.
+    const auto A = makeMatrix(6, 6, 0.5);
+    const auto x = makeVector(6, 1.0);
+    const auto b = makeVector(6, 2.0);
+    const auto c = makeVector(6, 3.0);
+    const auto d = makeVector(6, 4.0);
+    const Vector Ax = A * x;
+    const auto before = numAllocations;
+    const Vector y = lazy(A * x) + b - c + d;
+    TEST_ASSERT_EQ(numAllocations - before, static_cast<size_t>(2));
+    for (size_t ii = 0; ii < y.size(); ++ii)
+    {
+        TEST_ASSERT_ALMOST_EQ(y[ii], Ax[ii] + b[ii] - c[ii] + d[ii]);
+    }
+}
+
+TEST_CASE(testEagerOperators)
+{
+    // Without lazy(), the operators give a Matrix2D or Vector as always
+    const auto a = makeVector(3, 1.0);
+    const auto b = makeVector(3, -2.0);
+    TEST_ASSERT_ALMOST_EQ((a - b).norm(), a.subtract(b).norm());
+    static_assert(std::is_same<decltype(a + b), Vector>::value, "a + b should be a Vector");
+
+    const auto A = makeMatrix(3, 3, 1.0);
+    Matrix B(3, 3, 0.0);
+    B(0, 0) = B(1, 1) = B(2, 2) = 4.0;
+    const Matrix inverseSum = math::linear::inverse(A + B);
+    TEST_ASSERT(inverseSum == math::linear::inverse(A.add(B)));
+    TEST_ASSERT((A + B).transpose() == A.add(B).transpose());
+    TEST_ASSERT(-A == A.multiply(-1.0));
+    TEST_ASSERT(2.0 * A / 4.0 == A.multiply(0.5));
+
+    auto C = A + B;
+    C(0, 0) = 42.0;
+    TEST_ASSERT_ALMOST_EQ(C(0, 0), 42.0);
+    TEST_ASSERT_ALMOST_EQ(C(1, 1), A(1, 1) + 4.0);
+
+    // A temporary decorating someone else's memory is copied, not taken
+    std::vector<double> raw(4, 1.0);
+    Matrix D;
+    D = Matrix(2, 2, raw.data(), false /*adopt*/);
+    D(0, 0) = 2.0;
+    TEST_ASSERT_ALMOST_EQ(raw[0], 1.0);
+    TEST_ASSERT(D.get() != raw.data());
+}
+
+TEST_CASE(testSizeMismatch)
+{
+    const auto A = makeMatrix(3, 4, 1.0);
+    const auto B = makeMatrix(4, 3, 1.0);
+    TEST_EXCEPTION(lazy(A) + B);
+    TEST_EXCEPTION(A - lazy(B) * 2.0);
+
+    Matrix C(3, 4);
+    TEST_EXCEPTION(C += lazy(B) * 1.0);
+
+    const auto x = makeVector(3, 1.0);
+    const auto y = makeVector(4, 1.0);
+    TEST_EXCEPTION(lazy(x) * y);
+    TEST_EXCEPTION(x / lazy(y));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testMatrixExpression);
+    TEST_CHECK(testVectorExpression);
+    TEST_CHECK(testAssignment);
+    TEST_CHECK(testTemporaries);
+    TEST_CHECK(testEagerOperators);
+    TEST_CHECK(testSizeMismatch);
+    )
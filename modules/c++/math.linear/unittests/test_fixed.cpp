@@ -0,0 +1,288 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stddef.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <import/math/linear.h>
+#include "TestCase.h"
+
+namespace
+{
+// Diagonally dominant, so invertible
+template <size_t M, size_t N, typename T>
+math::linear::MatrixMxN<M, N, T> makeMatrix(size_t seed)
+{
+    math::linear::MatrixMxN<M, N, T> mx;
+    for (size_t i = 0; i < M; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            mx(i, j) = static_cast<T>((seed * 7 + i * 5 + j * 3) % 11) / 11 + (i == j ? 2 : 0);
+        }
+    }
+    return mx;
+}
+
+// The generic loop, for comparison
+template <size_t M, size_t N, size_t P, typename T>
+math::linear::MatrixMxN<M, P, T> multiplyLoop(const math::linear::MatrixMxN<M, N, T>& A,
+                                              const math::linear::MatrixMxN<N, P, T>& B)
+{
+    math::linear::MatrixMxN<M, P, T> C(static_cast<T>(0));
+    for (size_t i = 0; i < M; ++i)
+    {
+        for (size_t j = 0; j < P; ++j)
+        {
+            for (size_t k = 0; k < N; ++k)
+            {
+                C(i, j) += A(i, k) * B(k, j);
+            }
+        }
+    }
+    return C;
+}
+
+template <size_t M, size_t N, typename T>
+bool isNear(const math::linear::MatrixMxN<M, N, T>& A, const math::linear::MatrixMxN<M, N, T>& B, T eps)
+{
+    for (size_t i = 0; i < M; ++i)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            if (std::abs(A(i, j) - B(i, j)) > eps)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <size_t N, typename T>
+bool checkMultiply(T eps)
+{
+    const auto A = makeMatrix<N, N, T>(1);
+    const auto B = makeMatrix<N, N, T>(2);
+    const auto x = makeMatrix<N, 1, T>(3);
+    return isNear(A * B, multiplyLoop(A, B), eps) && isNear(A * x, multiplyLoop(A, x), eps);
+}
+
+template <size_t N, typename T>
+bool checkInverse(T eps)
+{
+    const auto A = makeMatrix<N, N, T>(4);
+    const auto identity = math::linear::identityMatrix<N, T>();
+    return isNear(math::linear::inverse(A) * A, identity, eps) &&
+           isNear(math::linear::inverse(A), math::linear::inverseLU(A), eps);
+}
+
+template <size_t N>
+bool checkDeterminant()
+{
+    // The generic LU determinant, up to sign, is the product of the pivots
+    const auto A = makeMatrix<N, N, double>(5);
+    std::vector<size_t> pivots(N);
+    const auto lu = A.decomposeLU(pivots);
+    double product = 1;
+    for (size_t i = 0; i < N; ++i)
+    {
+        product *= lu(i, i);
+    }
+    return std::abs(std::abs(math::linear::determinant(A)) - std::abs(product)) < 1e-10;
+}
+}
+
+TEST_CASE(testMultiply)
+{
+    TEST_ASSERT(checkMultiply<2>(1e-12));
+    TEST_ASSERT(checkMultiply<3>(1e-12));
+    TEST_ASSERT(checkMultiply<4>(1e-12));
+    TEST_ASSERT(checkMultiply<5>(1e-12));
+    TEST_ASSERT(checkMultiply<2>(1e-5f));
+    TEST_ASSERT(checkMultiply<3>(1e-5f));
+    TEST_ASSERT(checkMultiply<4>(1e-5f));
+    TEST_ASSERT(checkMultiply<5>(1e-5f));
+
+    // Through VectorN too
+    const auto A = makeMatrix<4, 4, float>(6);
+    const math::linear::VectorN<4, float> x(makeMatrix<4, 1, float>(7));
+    const math::linear::VectorN<4, float> y = A * x;
+    const auto expected = multiplyLoop(A, x.matrix());
+    for (size_t i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(y[i], expected(i, 0), 1e-5f);
+    }
+    TEST_ASSERT_ALMOST_EQ_EPS(x.dot(x), (x.matrix().transpose() * x.matrix())(0, 0), 1e-5f);
+}
+
+TEST_CASE(testDeterminant)
+{
+    using namespace math::linear;
+
+    const double raw[] = { 1, 2, 3, 4, 0, 1, 4, 2, 5, 6, 0, 1, 2, 0, 1, 3 };
+    TEST_ASSERT_ALMOST_EQ(determinant(MatrixMxN<2, 2>(raw)), -2.0);
+    TEST_ASSERT_ALMOST_EQ(determinant(MatrixMxN<3, 3>(raw)), -10.0);
+    TEST_ASSERT_ALMOST_EQ(determinant(MatrixMxN<4, 4>(raw)), 124.0);
+
+    // Swapping two rows flips the sign
+    MatrixMxN<5, 5> A = makeMatrix<5, 5, double>(8);
+    const double det = determinant(A);
+    for (size_t j = 0; j < 5; ++j)
+    {
+        std::swap(A(0, j), A(3, j));
+    }
+    TEST_ASSERT_ALMOST_EQ(determinant(A), -det);
+
+    TEST_ASSERT(checkDeterminant<2>());
+    TEST_ASSERT(checkDeterminant<3>());
+    TEST_ASSERT(checkDeterminant<4>());
+    TEST_ASSERT(checkDeterminant<6>());
+    TEST_ASSERT_ALMOST_EQ(determinant(identityMatrix<6, double>()), 1.0);
+}
+
+TEST_CASE(testInverse)
+{
+    TEST_ASSERT(checkInverse<4>(1e-12));
+    TEST_ASSERT(checkInverse<4>(1e-5f));
+
+    // A tiny determinant alone doesn't make a matrix singular
+    auto small = math::linear::identityMatrix<4, double>();
+    small.scale(1e-4);
+    const auto smallInv = math::linear::inverse(small);
+    auto smallFloat = math::linear::identityMatrix<4, float>();
+    smallFloat.scale(1e-2f);
+    const auto smallFloatInv = math::linear::inverse(smallFloat);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(smallInv(i, i), 1e4, 1e-8);
+        TEST_ASSERT_ALMOST_EQ_EPS(smallFloatInv(i, i), 1e2f, 1e-4f);
+    }
+
+    math::linear::MatrixMxN<4, 4> singular(1.0);
+    TEST_EXCEPTION(math::linear::inverse(singular));
+    math::linear::MatrixMxN<4, 4, float> singularFloat(1.0f);
+    TEST_EXCEPTION(math::linear::inverse(singularFloat));
+}
+
+TEST_CASE(testTransform)
+{
+    // Not a multiple of any register width, to exercise the tail
+    const size_t size = 13;
+    std::vector<double> x(size), y(size), z(size);
+    for (size_t k = 0; k < size; ++k)
+    {
+        x[k] = static_cast<double>(k);
+        y[k] = static_cast<double>(k % 3) - 1;
+        z[k] = 0.5 * static_cast<double>(k);
+    }
+
+    const auto R = makeMatrix<3, 3, double>(9);
+    std::vector<double> outX(size), outY(size), outZ(size);
+    math::linear::transform(R, { x, y, z }, { outX, outY, outZ });
+    for (size_t k = 0; k < size; ++k)
+    {
+        math::linear::VectorN<3> v;
+        v[0] = x[k];
+        v[1] = y[k];
+        v[2] = z[k];
+        const auto expected = R * v;
+        TEST_ASSERT_ALMOST_EQ_EPS(outX[k], expected[0], 1e-12);
+        TEST_ASSERT_ALMOST_EQ_EPS(outY[k], expected[1], 1e-12);
+        TEST_ASSERT_ALMOST_EQ_EPS(outZ[k], expected[2], 1e-12);
+    }
+
+    // In place, and to a different dimension
+    math::linear::transform(R, { x, y, z }, { x, y, z });
+    TEST_ASSERT(x == outX);
+    TEST_ASSERT(y == outY);
+    TEST_ASSERT(z == outZ);
+
+    const auto P = makeMatrix<2, 3, double>(10);
+    std::vector<double> u(size), v(size);
+    math::linear::transform(P, { x, y, z }, { u, v });
+    for (size_t k = 0; k < size; ++k)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(u[k], P(0, 0) * x[k] + P(0, 1) * y[k] + P(0, 2) * z[k], 1e-12);
+        TEST_ASSERT_ALMOST_EQ_EPS(v[k], P(1, 0) * x[k] + P(1, 1) * y[k] + P(1, 2) * z[k], 1e-12);
+    }
+
+    std::vector<double> shortZ(size - 1);
+    TEST_EXCEPTION(math::linear::transform(R, { x, y, shortZ }, { outX, outY, outZ }));
+    TEST_EXCEPTION(math::linear::transform(R, { x, y, z }, { outX, outY, shortZ }));
+}
+
+TEST_CASE(testDotCross)
+{
+    const size_t size = 11;
+    std::vector<float> ux(size), uy(size), uz(size), vx(size), vy(size), vz(size);
+    for (size_t k = 0; k < size; ++k)
+    {
+        ux[k] = static_cast<float>(k);
+        uy[k] = 1.0f;
+        uz[k] = static_cast<float>(k % 4);
+        vx[k] = -2.0f;
+        vy[k] = static_cast<float>(k) / 2;
+        vz[k] = static_cast<float>(k % 3);
+    }
+
+    std::vector<float> dots(size);
+    math::linear::dot<3, float>({ ux, uy, uz }, { vx, vy, vz }, dots);
+
+    std::vector<float> x(size), y(size), z(size);
+    math::linear::cross<float>({ ux, uy, uz }, { vx, vy, vz }, { x, y, z });
+
+    for (size_t k = 0; k < size; ++k)
+    {
+        math::linear::VectorN<3, float> u, v;
+        u[0] = ux[k];
+        u[1] = uy[k];
+        u[2] = uz[k];
+        v[0] = vx[k];
+        v[1] = vy[k];
+        v[2] = vz[k];
+        TEST_ASSERT_ALMOST_EQ_EPS(dots[k], u.dot(v), 1e-4f);
+
+        const auto expected = math::linear::cross(u, v);
+        TEST_ASSERT_ALMOST_EQ_EPS(x[k], expected[0], 1e-4f);
+        TEST_ASSERT_ALMOST_EQ_EPS(y[k], expected[1], 1e-4f);
+        TEST_ASSERT_ALMOST_EQ_EPS(z[k], expected[2], 1e-4f);
+    }
+
+    // u x u = 0, in place
+    math::linear::cross<float>({ ux, uy, uz }, { ux, uy, uz }, { ux, uy, uz });
+    TEST_ASSERT(ux == std::vector<float>(size, 0.0f));
+
+    std::vector<float> shortDots(size - 1);
+    TEST_EXCEPTION((math::linear::dot<3, float>({ x, y, z }, { x, y, z }, shortDots)));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testMultiply);
+    TEST_CHECK(testDeterminant);
+    TEST_CHECK(testInverse);
+    TEST_CHECK(testTransform);
+    TEST_CHECK(testDotCross);
+    )
@@ -0,0 +1,171 @@
+/* =========================================================================
+ * This file is part of math.linear-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.linear-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stddef.h>
+
+#include <complex>
+#include <vector>
+
+#include <import/math/linear.h>
+#include "TestCase.h"
+
+namespace
+{
+template <typename T>
+T makeValue(size_t ii)
+{
+    return static_cast<T>(static_cast<double>((ii * 7919) % 101) / 50.0 - 1.0);
+}
+template <>
+std::complex<float> makeValue(size_t ii)
+{
+    return std::complex<float>(makeValue<float>(ii), makeValue<float>(ii * 31 + 5));
+}
+template <>
+std::complex<double> makeValue(size_t ii)
+{
+    return std::complex<double>(makeValue<double>(ii), makeValue<double>(ii * 31 + 5));
+}
+
+template <typename T>
+math::linear::Matrix2D<T> makeMatrix(size_t M, size_t N, size_t seed)
+{
+    math::linear::Matrix2D<T> mx(M, N);
+    for (size_t ii = 0; ii < M; ++ii)
+    {
+        for (size_t jj = 0; jj < N; ++jj)
+        {
+            mx(ii, jj) = makeValue<T>(ii * N + jj + seed);
+        }
+    }
+    return mx;
+}
+
+// The product the textbook way, accumulated in double precision
+template <typename T>
+std::vector<std::complex<double> > reference(const math::linear::Matrix2D<T>& A,
+                                             const math::linear::Matrix2D<T>& B)
+{
+    std::vector<std::complex<double> > C(A.rows() * B.cols());
+    for (size_t ii = 0; ii < A.rows(); ++ii)
+    {
+        for (size_t jj = 0; jj < B.cols(); ++jj)
+        {
+            std::complex<double> sum(0);
+            for (size_t kk = 0; kk < A.cols(); ++kk)
+            {
+                sum += std::complex<double>(A(ii, kk)) * std::complex<double>(B(kk, jj));
+            }
+            C[ii * B.cols() + jj] = sum;
+        }
+    }
+    return C;
+}
+
+template <typename T>
+double maxError(const math::linear::Matrix2D<T>& actual,
+                const std::vector<std::complex<double> >& expected)
+{
+    double error = 0;
+    for (size_t ii = 0; ii < expected.size(); ++ii)
+    {
+        error = std::max(error, std::abs(std::complex<double>(actual.get()[ii]) - expected[ii]));
+    }
+    return error;
+}
+
+template <typename T>
+void testMultiply(const std::string& testName, double tolerance)
+{
+    // Sizes straddling the register tile and (for N) the cache blocks
+    const size_t sizes[][3] = { { 1, 1, 1 }, { 3, 2, 4 }, { 17, 16, 16 },
+                                { 37, 53, 29 }, { 101, 300, 75 }, { 5, 600, 130 } };
+    for (const auto& size : sizes)
+    {
+        const auto A = makeMatrix<T>(size[0], size[1], 0);
+        const auto B = makeMatrix<T>(size[1], size[2], 17);
+        const auto expected = reference(A, B);
+
+        const auto C = A.multiply(B);
+        TEST_ASSERT_EQ(C.rows(), size[0]);
+        TEST_ASSERT_EQ(C.cols(), size[2]);
+        TEST_ASSERT_LESSER(maxError(C, expected), tolerance * size[1]);
+
+        // Results don't depend on how many threads split up the work
+        for (size_t numThreads = 1; numThreads <= 3; ++numThreads)
+        {
+            math::linear::Matrix2D<T> threaded(size[0], size[2], T(42));
+            math::linear::gemm(size[0], size[1], size[2], A.get(), B.get(),
+                               &threaded(0, 0), numThreads);
+            TEST_ASSERT(threaded == C);
+        }
+    }
+}
+}
+
+TEST_CASE(testMultiplyFloat)
+{
+    testMultiply<float>(testName, 1e-6);
+}
+
+TEST_CASE(testMultiplyDouble)
+{
+    testMultiply<double>(testName, 1e-14);
+}
+
+TEST_CASE(testMultiplyComplexFloat)
+{
+    testMultiply<std::complex<float> >(testName, 1e-6);
+}
+
+TEST_CASE(testMultiplyComplexDouble)
+{
+    testMultiply<std::complex<double> >(testName, 1e-14);
+}
+
+TEST_CASE(testMultiplyInt)
+{
+    // Types gemm() doesn't cover still go through the simple loop.
+    const auto A = makeMatrix<int>(20, 30, 0);
+    const auto B = makeMatrix<int>(30, 25, 3);
+    const auto C = A * B;
+    const auto expected = reference(A, B);
+    TEST_ASSERT_EQ(maxError(C, expected), 0.0);
+}
+
+TEST_CASE(testMultiplyEmpty)
+{
+    const auto A = makeMatrix<double>(20, 0, 0);
+    const auto B = makeMatrix<double>(0, 25, 0);
+    math::linear::Matrix2D<double> C(20, 25, 1.0);
+    A.multiply(B, C);
+    TEST_ASSERT(C == math::linear::Matrix2D<double>(20, 25, 0.0));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testMultiplyFloat);
+    TEST_CHECK(testMultiplyDouble);
+    TEST_CHECK(testMultiplyComplexFloat);
+    TEST_CHECK(testMultiplyComplexDouble);
+    TEST_CHECK(testMultiplyInt);
+    TEST_CHECK(testMultiplyEmpty);
+    )
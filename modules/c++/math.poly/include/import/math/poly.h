@@ -28,5 +28,7 @@
 #include "math/poly/Fixed1D.h"
 #include "math/poly/Fixed2D.h"
 #include "math/poly/Fit.h"
+#include "math/poly/Horner.h"
+#include "math/poly/LeastSquares.h"
 
 #endif  // __MATH_POLY_H__
@@ -1,15 +1,20 @@
 #ifndef __MATH_POLY_FIT_H__
 #define __MATH_POLY_FIT_H__
 
+#include <math/poly/LeastSquares.h>
 #include <math/poly/OneD.h>
 #include <math/poly/TwoD.h>
 #include <math/linear/Matrix2D.h>
 #include <math/linear/VectorN.h>
+#include <mt/Runnable1D.h>
 #include <sys/Conf.h>
 #include <except/Exception.h>
+#include <coda_oss/span.h>
 
+#include <algorithm>
 #include <numeric>
 #include <sstream>
+#include <utility>
 
 namespace math
 {
@@ -33,6 +38,328 @@ namespace poly
         return compute_mean_value_(x);
     }
 
+namespace details
+{
+// The mean of `values`, and the reciprocal of their RMS about it; fit()
+// centers and scales its inputs with these so that the powers it takes
+// stay near 1.
+inline std::pair<double, double> getNormalization(coda_oss::span<const double> values)
+{
+    const auto count = static_cast<double>(values.size());
+    const double mean = std::accumulate(values.begin(), values.end(), 0.0) / count;
+    double sumSq = 0.0;
+    for (const auto value : values)
+    {
+        sumSq += (value - mean) * (value - mean);
+    }
+    // If they're all the same, any scale will do (and the fit will fail)
+    return std::make_pair(mean, sumSq == 0.0 ? 1.0 : 1.0 / std::sqrt(sumSq / count));
+}
+
+/*
+ * Builds [A | b] for fit() a block of samples at a time, and adds it to a
+ * LeastSquares.  The columns of A are the normalized monomials x^i y^j,
+ * and everything is scaled by the square root of the sample's weight.
+ * Each thread needs its own copy.
+ */
+class FitBlocks final
+{
+public:
+    static constexpr size_t blockSize = 256;
+
+    FitBlocks(coda_oss::span<const double> x,
+              coda_oss::span<const double> y,  // empty for a 1D fit
+              coda_oss::span<const double> z,
+              coda_oss::span<const double> weights,  // empty for all 1
+              std::pair<double, double> xNormalization,
+              std::pair<double, double> yNormalization,
+              size_t nx,
+              size_t ny) :
+        mX(x), mY(y), mZ(z), mWeights(weights),
+        mXNormalization(xNormalization), mYNormalization(yNormalization),
+        mNX(nx), mNY(ny),
+        mProblem((nx + 1) * (ny + 1)),
+        mBlock(((nx + 1) * (ny + 1) + 1) * blockSize),
+        mNormalized(2 * blockSize)
+    {
+    }
+
+    void operator()(size_t blockIndex) const
+    {
+        const size_t begin = blockIndex * blockSize;
+        const size_t remaining = mZ.size() - begin;
+        const size_t count = remaining < blockSize ? remaining : blockSize;
+        double* const xn = mNormalized.data();
+        double* const yn = xn + blockSize;
+        for (size_t r = 0; r < count; ++r)
+        {
+            xn[r] = (mX[begin + r] - mXNormalization.first) * mXNormalization.second;
+        }
+        if (!mY.empty())
+        {
+            for (size_t r = 0; r < count; ++r)
+            {
+                yn[r] = (mY[begin + r] - mYNormalization.first) * mYNormalization.second;
+            }
+        }
+
+        // Column (i, j) is x^i y^j, stored by column, with b last
+        const auto column = [&](size_t i, size_t j)
+        {
+            return mBlock.data() + (i * (mNY + 1) + j) * count;
+        };
+        double* const first = column(0, 0);
+        double* const b = column(mNX + 1, 0);
+        for (size_t r = 0; r < count; ++r)
+        {
+            first[r] = mWeights.empty() ? 1.0 : std::sqrt(mWeights[begin + r]);
+            b[r] = first[r] * mZ[begin + r];
+        }
+        for (size_t i = 0; i <= mNX; ++i)
+        {
+            if (i > 0)
+            {
+                const double* const prev = column(i - 1, 0);
+                double* const col = column(i, 0);
+                for (size_t r = 0; r < count; ++r)
+                {
+                    col[r] = prev[r] * xn[r];
+                }
+            }
+            for (size_t j = 1; j <= mNY; ++j)
+            {
+                const double* const prev = column(i, j - 1);
+                double* const col = column(i, j);
+                for (size_t r = 0; r < count; ++r)
+                {
+                    col[r] = prev[r] * yn[r];
+                }
+            }
+        }
+
+        mProblem.add(mBlock.data(), count);
+    }
+
+    const LeastSquares& getProblem() const
+    {
+        return mProblem;
+    }
+
+private:
+    const coda_oss::span<const double> mX;
+    const coda_oss::span<const double> mY;
+    const coda_oss::span<const double> mZ;
+    const coda_oss::span<const double> mWeights;
+    const std::pair<double, double> mXNormalization;
+    const std::pair<double, double> mYNormalization;
+    const size_t mNX;
+    const size_t mNY;
+    mutable LeastSquares mProblem;
+    mutable std::vector<double> mBlock;
+    mutable std::vector<double> mNormalized;
+};
+
+// Fits the normalized coefficients, splitting the samples over threads
+inline std::vector<double> fitNormalized(const FitBlocks& blocks,
+                                         size_t numSamples,
+                                         size_t numThreads)
+{
+    const size_t numBlocks = (numSamples + FitBlocks::blockSize - 1) / FitBlocks::blockSize;
+    numThreads = std::max<size_t>(std::min(numThreads, numBlocks), 1);
+    const std::vector<FitBlocks> ops(numThreads, blocks);
+    mt::run1D(numBlocks, numThreads, ops);
+
+    LeastSquares problem = ops[0].getProblem();
+    for (size_t ii = 1; ii < ops.size(); ++ii)
+    {
+        problem.add(ops[ii].getProblem());
+    }
+    return problem.solve();
+}
+
+/*
+ * Turns the coefficients of p(t), t = (x - mean) * scale, into those of the
+ * polynomial in x: scaling, then a Taylor shift.  The coefficients in x can
+ * be far larger than the values the polynomial takes (when the mean is far
+ * from 0), so this is done in extended precision to keep the low digits.
+ * The coefficients are coef[0], coef[stride], ...
+ */
+inline void unnormalize(long double* coef, size_t stride, size_t count,
+                        std::pair<double, double> normalization)
+{
+    long double power = 1.0L;
+    for (size_t i = 0; i < count; ++i)
+    {
+        coef[i * stride] *= power;
+        power *= normalization.second;
+    }
+
+    const long double shift = -static_cast<long double>(normalization.first);
+    for (size_t i = 0; i + 1 < count; ++i)
+    {
+        for (size_t j = count - 1; j-- > i;)
+        {
+            coef[j * stride] += shift * coef[(j + 1) * stride];
+        }
+    }
+}
+
+inline void checkWeights(coda_oss::span<const double> weights, size_t numSamples)
+{
+    if (weights.empty())
+    {
+        return;
+    }
+    if (weights.size() != numSamples)
+    {
+        throw except::Exception(Ctxt("Got " + std::to_string(weights.size()) + " weights for " +
+                                     std::to_string(numSamples) + " samples"));
+    }
+    if (std::any_of(weights.begin(), weights.end(), [](double w) { return !(w >= 0.0); }))
+    {
+        throw except::Exception(Ctxt("Weights must not be negative"));
+    }
+}
+}
+
+/*!
+ *  Weighted linear least squares fit of a 1D polynomial, minimizing
+ *  sum(weights[i] * (poly(x[i]) - y[i])^2)
+ *
+ *  The x values are centered and normalized, and the problem is solved
+ *  with a Householder QR factorization built up a block of samples at a
+ *  time, so it's well conditioned even at high orders and uses memory
+ *  independent of the number of samples.
+ *
+ *  \param x The observed x points
+ *  \param y The observed y values
+ *  \param weights The weight of each observation, or empty for all 1
+ *  \param order The desired order of the polynomial fit
+ *  \throw Exception if there are fewer than order+1 points or the sizes
+ *         don't match
+ *  \return A one dimensional polynomial that fits the curve
+ */
+inline OneD<double> fit(coda_oss::span<const double> x,
+                        coda_oss::span<const double> y,
+                        coda_oss::span<const double> weights,
+                        size_t order)
+{
+    const auto sizeX = x.size();
+    if (y.size() != sizeX)
+    {
+        throw except::Exception(Ctxt("Got " + std::to_string(sizeX) + " x values but " +
+                                     std::to_string(y.size()) + " y values"));
+    }
+    if (sizeX <= order)
+    {
+        std::ostringstream excSS;
+        excSS << "Not enough points for a unique fit solution ("
+              << sizeX << " points for an order-" << order
+              << "fit)!  You should really have at least (order+1) = "
+              << (order+1) << " points for this to do what you expect.";
+        throw except::Exception(Ctxt(excSS));
+    }
+    details::checkWeights(weights, sizeX);
+
+    const auto xNormalization = details::getNormalization(x);
+    const details::FitBlocks blocks(x, coda_oss::span<const double>(), y, weights,
+                                    xNormalization, xNormalization, order, 0);
+    const auto c = details::fitNormalized(blocks, sizeX, 1);
+
+    // Remove the normalization scaling and shift the polynomial back
+    // from its centered offset
+    std::vector<long double> coef(c.begin(), c.end());
+    details::unnormalize(coef.data(), 1, coef.size(), xNormalization);
+
+    math::poly::OneD<double> poly(order);
+    for (size_t i = 0; i <= order; i++)
+    {
+        poly[i] = static_cast<double>(coef[i]);
+    }
+    return poly.truncateToNonZeros();
+}
+
+/*!
+ *  Weighted linear least squares fit of a 2D polynomial to scattered
+ *  samples, minimizing sum(weights[i] * (poly(x[i], y[i]) - z[i])^2)
+ *
+ *  As with the 1D fit, x and y are centered and normalized, and the
+ *  samples are streamed a block at a time through a Householder QR
+ *  factorization rather than forming the normal equations.  The blocks
+ *  can be split over threads.
+ *
+ *  \param x The x coordinate of each sample
+ *  \param y The y coordinate of each sample
+ *  \param z The observed value of each sample
+ *  \param weights The weight of each sample, or empty for all 1
+ *  \param nx The requested order X of the output poly
+ *  \param ny The requested order Y of the output poly
+ *  \param numThreads The number of threads to split the samples over
+ *  \throw Exception if the sizes don't match, there are fewer samples
+ *         than coefficients or the samples don't determine them
+ *  \return A polynomial, f(x, y) = z
+ */
+inline math::poly::TwoD<double> fit(coda_oss::span<const double> x,
+                                    coda_oss::span<const double> y,
+                                    coda_oss::span<const double> z,
+                                    coda_oss::span<const double> weights,
+                                    size_t nx,
+                                    size_t ny,
+                                    size_t numThreads = 1)
+{
+    const auto numSamples = z.size();
+    if (x.size() != numSamples || y.size() != numSamples)
+    {
+        throw except::Exception(Ctxt("Got " + std::to_string(x.size()) + " x, " +
+                                     std::to_string(y.size()) + " y and " +
+                                     std::to_string(numSamples) + " z values"));
+    }
+
+    const auto acols = (nx+1) * (ny+1);
+    if (numSamples < acols)
+    {
+        std::ostringstream excSS;
+        excSS << "Not enough points for a unique fit solution ("
+              <<  numSamples << " points for a " << acols << "-coefficient fit)!"
+              << " You should really have at least (orderX+1)*(orderY+1) = "
+              << acols << " points for this to do what you expect.";
+        throw except::Exception(Ctxt(excSS));
+    }
+    details::checkWeights(weights, numSamples);
+
+    // To make sure that one dimension does not dominate the other,
+    // we normalize x and y.
+    const auto xNormalization = details::getNormalization(x);
+    const auto yNormalization = details::getNormalization(y);
+    const details::FitBlocks blocks(x, y, z, weights, xNormalization, yNormalization, nx, ny);
+    const auto C = details::fitNormalized(blocks, numSamples, numThreads);
+
+    // Remove the normalization scaling and shift the polynomial back
+    // from its centered offset, in x and then in y; C is stored by x power.
+    std::vector<long double> coef(C.begin(), C.end());
+    for (size_t j = 0; j <= ny; j++)
+    {
+        details::unnormalize(&coef[j], ny + 1, nx + 1, xNormalization);
+    }
+    for (size_t i = 0; i <= nx; i++)
+    {
+        details::unnormalize(&coef[i * (ny + 1)], 1, ny + 1, yNormalization);
+    }
+
+    // Now we need the NX+1 components out for our x coeffs
+    // and NY+1 components out for our y coeffs
+    math::poly::TwoD<double> coeffs(nx, ny);
+    size_t p = 0;
+    for (size_t i = 0; i <= nx; i++)
+    {
+        for (size_t j = 0; j <= ny; j++)
+        {
+            coeffs[i][j] = static_cast<double>(coef[p++]);
+        }
+    }
+    return coeffs.truncateToNonZeros();
+}
+
 /*!
  *  Templated function to perform a linear least squares fit for the data.
  *  This algorithm is fairly straightforward.
@@ -60,6 +387,9 @@ namespace poly
  *
  *  x = inv(A' * A) * A' * b
  *
+ *  though rather than forming A' * A, this is solved with a QR
+ *  factorization of A; see the weighted overload.
+ *
  *  \param x The observable x points
  *  \param y The observable y solutions
  *  \param order The desired order of the polynomial fit
@@ -70,68 +400,11 @@ template<typename Vector_T> OneD<double> fit(const Vector_T& x,
                                              const Vector_T& y,
                                              size_t order)
 {
-    math::linear::Vector<double> vx(x);
-    math::linear::Vector<double> vy(y);
-    // n is polynomial order
-    const auto sizeX = vx.size();
-
-    if (sizeX <= order)
-    {
-        std::ostringstream excSS;
-        excSS << "Not enough points for a unique fit solution ("
-              << sizeX << " points for an order-" << order
-              << "fit)!  You should really have at least (order+1) = "
-              << (order+1) << " points for this to do what you expect.";
-        throw except::Exception(Ctxt(excSS));
-    }
-    
-    // Compute mean value
-    const auto mean = compute_mean_value(vx);
-
-    // Shift the vector values by mean to center around zero
-    const math::linear::Vector<double> offv(sizeX, mean);
-    auto xp = vx - offv;
-
-    // Normalize the values in the vector using standard deviation
-    const double rxrms = 1.0 / std::sqrt(xp.normSq() / static_cast<double>(sizeX));
-    xp.scale(rxrms);
-
-    math::linear::Matrix2D<double> A(sizeX, order + 1);
-
-    for (size_t i = 0; i < sizeX; i++)
-    {
-        // The c0 coefficient is a freebie
-        A(i, 0) = 1;
-        double v = xp[i];
-        A(i, 1) = v;
-        for (size_t j = 2; j <= order; j++)
-        {
-            A(i, j) = std::pow(v, static_cast<double>(j));
-        }
-    }
-    
-    const auto At = A.transpose();
-    const auto inv = inverse(At * A);
-    const auto B = inv * At;
-    const math::linear::Vector<double> c(B * vy.matrix());
-
-    // Now we need the order+1 components out for our poly
-    math::poly::OneD<double> poly(c.size());
-
-    // Remove the normalization scaling
-    double xacc = 1;
-    for (size_t i = 0; i < c.size(); i++)
-    {
-        poly[i] = c[i] * xacc;
-        xacc *= rxrms;
-    }
-
-    // Shift the polynomial back from its centered offset
-    math::poly::OneD<double> shift(1);
-    shift[0] = -mean;
-    shift[1] = 1;
-
-    return poly.transformInput(shift);
+    const math::linear::Vector<double> vx(x);
+    const math::linear::Vector<double> vy(y);
+    return fit(coda_oss::span<const double>(vx.get(), vx.size()),
+               coda_oss::span<const double>(vy.get(), vy.size()),
+               coda_oss::span<const double>(), order);
 }
 
 
@@ -179,127 +452,13 @@ inline math::poly::TwoD<double> fit(const math::linear::Matrix2D<double>& x,
     if (n != y.cols())
         throw except::Exception(Ctxt("Matrices must be equally sized"));
 
-    // Compute mean values
-    const auto xoff = compute_mean_value(x);
-    const auto yoff = compute_mean_value(y);
-
-    // Shift the matrix values by mean to center around zero
-    const math::linear::Matrix2D<double> xoffm(m, n, xoff);
-    const math::linear::Matrix2D<double> yoffm(m, n, yoff);
-
-    math::linear::Matrix2D<double> xp = x - xoffm;
-    math::linear::Matrix2D<double> yp = y - yoffm;
-
-    // Normalize the values in the matrix using standard deviation
-    const auto mxn = static_cast<double>(x.size());
-    const auto rxrms = 1.0 / std::sqrt(xp.normSq() / mxn);
-    const auto ryrms = 1.0 / std::sqrt(yp.normSq() / mxn);
-    xp.scale(rxrms);
-    yp.scale(ryrms);
-
-    const auto acols = (nx+1) * (ny+1);
-
-    if (x.size() < acols)
-    {
-        std::ostringstream excSS;
-        excSS << "Not enough points for a unique fit solution ("
-              <<  x.size() << " points for a " << acols << "-coefficient fit)!"
-              << " You should really have at least (orderX+1)*(orderY+1) = "
-              << acols << " points for this to do what you expect.";
-        throw except::Exception(Ctxt(excSS));
-    }
-    
-
-    // R = M x N
-    // C = NX+1 x NY+1
-
-    // size(A) = R x P
-    math::linear::Matrix2D<double> A(x.size(), acols);
-    
-    for (size_t i = 0; i < m; i++)
-    {
-        size_t xidx = i*n;
-        for (size_t j = 0; j < n; j++, xidx++)
-        {
-            // We are doing an accumulation of pow()s to get this
-
-            // Pre-calculate these
-            const auto xij = xp(i, j);
-            const auto yij = yp(i, j);
-
-            double xacc = 1;
-
-            for (size_t k = 0; k <= nx; k++)
-            {
-                size_t yidx = k * (ny + 1);
-                double yacc = 1;
-                
-                for (size_t l = 0; l <= ny; l++)
-                {
-
-                    A(xidx, yidx) = xacc * yacc;
-                    yacc *= yij;
-                    ++yidx;
-                }
-                xacc *= xij;
-            }
-        }
-    }
-    
-    // size(tmp) = R x 1
-    math::linear::Matrix2D<double> tmp(x.size(), 1);
-
-    for (size_t i = 0; i < m; i++)
-    {
-        size_t xidx = i*n;
-        for (size_t j = 0; j < n; j++, xidx++)
-        {
-            tmp(xidx, 0) = z(i, j);
-        }
-    }
-    
-   const auto At = A.transpose();
-
-    //       T
-    // size(A  A) = (P x R) (R x P) = (P x P)
-    // size(inv) = (P x P)
-   const auto inv = math::linear::inverse<double>(At * A);
-
-    // size(C) = ((P x P) (P x R))(R x 1)
-    //         =   (P x R)(R x 1)
-    //         =   (P x 1)
-    //         =   (NX+1xNY+1 x 1)
-
-    const auto C = inv * At * tmp;
-
-    // Now we need the NX+1 components out for our x coeffs
-    // and NY+1 components out for our y coeffs
-    math::poly::TwoD<double> coeffs(nx, ny);
-
-    // Remove the normalization scaling
-    double xacc = 1;
-    size_t p = 0;
-    for (size_t i = 0; i <= nx; i++)
-    {
-        double yacc = 1;
-        for (size_t j = 0; j <= ny; j++)
-        {
-            coeffs[i][j] = C(p, 0)*(xacc * yacc);
-            ++p;
-            yacc *= ryrms;
-        }
-        xacc *= rxrms;
-    }
-
-    // Shift the polynomial back from its centered offset
-    math::poly::TwoD<double> xShift(1, 1);
-    math::poly::TwoD<double> yShift(1, 1);
-    xShift[0][0] = -xoff;
-    xShift[1][0] = 1;
-    yShift[0][0] = -yoff;
-    yShift[0][1] = 1;
+    if (m != z.rows() || n != z.cols())
+        throw except::Exception(Ctxt("Matrices must be equally sized"));
 
-    return coeffs.transformInput(xShift, yShift);
+    return fit(coda_oss::span<const double>(x.get(), x.size()),
+               coda_oss::span<const double>(y.get(), y.size()),
+               coda_oss::span<const double>(z.get(), z.size()),
+               coda_oss::span<const double>(), nx, ny);
 }
 
 inline math::poly::TwoD<double> fit(size_t numRows,
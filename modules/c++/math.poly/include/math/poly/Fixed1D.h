@@ -27,6 +27,7 @@
 
 #include <import/except.h>
 #include <import/sys.h>
+#include <math/poly/Horner.h>
 #include <math/poly/OneD.h>
 #include <math/poly/Utils.h>
 
@@ -60,13 +61,8 @@ public:
     *  Default constructor clears memory
     *
     */
-    Fixed1D()
+    constexpr Fixed1D() : mCoef{}
     {
-        // Initialize coefficents;
-        for (size_t i = 0; i < _Order+1; i++)
-        {
-            mCoef[i] = _T{};
-        }
     }
 
     /*!
@@ -95,6 +91,14 @@ public:
         }
     }
 
+    /*!
+    * Construct from exactly the right number of coefficients; this can
+    * be used in constant expressions.
+    */
+    constexpr Fixed1D(const std::array<_T, _Order+1>& coeffs) : mCoef(coeffs)
+    {
+    }
+
     /*!
     * Construct from std::array
     */
@@ -173,47 +177,25 @@ public:
      *  Evaluate our polynomial at 'at'
      *
      */
-    _T operator() (double at) const
+    constexpr _T operator() (double at) const
     {
-        _T rv{};
-        double atPower = 1;
-
-        for (size_t i = 0; i <= _Order; i++)
-        {
-            rv += mCoef[i]*atPower;
-            atPower *= at;
-        }
-        return rv;
+        return horner(mCoef, at);
     }
 
     /*!
      *  Evaluate the 1st derivative of our polynomial at 'at'
      */
-    _T velocity(double at) const
+    constexpr _T velocity(double at) const
     {
-        _T rv{};
-        double atPower = 1;
-        for (size_t i = 1; i <= _Order; i++)
-        {
-            rv += static_cast<double>(i) * mCoef[i]*atPower;
-            atPower *= at;
-        }
-        return rv;
+        return horner<1>(mCoef, at);
     }
 
     /*!
      *  Evaluate the 2nd derivative of our polynomial at 'at'
      */
-    _T acceleration(double at) const
+    constexpr _T acceleration(double at) const
     {
-        _T rv{};
-        double atPower = 1;
-        for (size_t i = 2; i <= _Order; i++)
-        {
-            rv += static_cast<double>((i - 1) * i) * mCoef[i]*atPower;
-            atPower *= at;
-        }
-        return rv;
+        return horner<2>(mCoef, at);
     }
 
     /*!
@@ -281,7 +263,7 @@ public:
         return mCoef[i];
 
     }
-    inline const std::array<_T, _Order+1>& coeffs() const
+    constexpr const std::array<_T, _Order+1>& coeffs() const
     {
         return mCoef;
     }
@@ -486,6 +468,58 @@ template<size_t _Order, typename _T>
     }
     return out;
 }
+
+//! The highest order visitFixed() converts to a Fixed1D or Fixed2D
+constexpr size_t maxVisitFixedOrder = 10;
+
+namespace details
+{
+template<size_t _Order>
+struct VisitFixed1D final
+{
+    template<typename _T, typename Func_T>
+    static bool visit(const OneD<_T>& poly, Func_T& func)
+    {
+        if (poly.order() != _Order)
+        {
+            return VisitFixed1D<_Order + 1>::visit(poly, func);
+        }
+        const Fixed1D<_Order, _T> fixed(poly);
+        func(fixed);
+        return true;
+    }
+};
+template<>
+struct VisitFixed1D<maxVisitFixedOrder + 1> final
+{
+    template<typename _T, typename Func_T>
+    static bool visit(const OneD<_T>&, Func_T&)
+    {
+        return false;
+    }
+};
+}
+
+/*!
+ *  Calls func() with `poly` converted to the Fixed1D of the same order,
+ *  so that a polynomial whose order is only known at runtime still gets
+ *  the unrolled evaluation:
+ *  \code
+ *  visitFixed(poly, [&](const auto& fixed)
+ *  {
+ *      for (size_t ii = 0; ii < x.size(); ++ii)
+ *          out[ii] = fixed(x[ii]);
+ *  });
+ *  \endcode
+ *
+ *  \return false, without calling func(), if `poly` is empty or its
+ *  order is more than maxVisitFixedOrder
+ */
+template<typename _T, typename Func_T>
+bool visitFixed(const OneD<_T>& poly, Func_T&& func)
+{
+    return !poly.empty() && details::VisitFixed1D<0>::visit(poly, func);
+}
 }
 }
 
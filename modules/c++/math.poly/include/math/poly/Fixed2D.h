@@ -24,6 +24,8 @@
 #define __MATH_POLY_FIXED_2D_H__
 
 #include <array>
+#include <utility>
+
 #include <math/poly/Fixed1D.h>
 #include <math/poly/TwoD.h>
 #include <math/poly/Utils.h>
@@ -42,8 +44,18 @@ template<size_t _OrderX, size_t _OrderY, typename _T=double> class Fixed2D
 {
 protected:
     std::array<Fixed1D<_OrderY, _T>, _OrderX+1> mCoef;
+
+    // Horner's method in x, where each coefficient is a polynomial in y
+    template<size_t... _I>
+    constexpr _T evaluate(double atX, double atY, std::index_sequence<_I...>) const
+    {
+        return horner(std::array<_T, _OrderX+1>{{ mCoef[_I](atY)... }}, atX);
+    }
+
 public:
-    Fixed2D() {}
+    constexpr Fixed2D() : mCoef{}
+    {
+    }
 
     template<size_t _OtherOrderX, size_t _OtherOrderY>
         Fixed2D(const Fixed2D<_OtherOrderX, _OtherOrderY, _T>& coeff)
@@ -66,9 +78,9 @@ public:
         }
     }
 
-    Fixed2D(const std::array<Fixed1D<_OrderY, _T>, _OrderX + 1>& coeff)
+    constexpr Fixed2D(const std::array<Fixed1D<_OrderY, _T>, _OrderX + 1>& coeff) :
+        mCoef(coeff)
     {
-        mCoef = coeff;
     }
 
     Fixed2D<_OrderX, _OrderY, _T>& operator=(const TwoD<_T>& coeff)
@@ -100,7 +112,7 @@ public:
     constexpr size_t sizeX() const { return _OrderX + 1; }
     constexpr size_t sizeY() const { return _OrderY + 1; }
 
-    inline const std::array<Fixed1D<_OrderY, _T>, _OrderX+1>& coeffs() const
+    constexpr const std::array<Fixed1D<_OrderY, _T>, _OrderX+1>& coeffs() const
     {
         return mCoef;
     }
@@ -110,18 +122,9 @@ public:
         return mCoef;
     }
 
-    inline _T operator()(double atX, double atY) const
+    constexpr _T operator()(double atX, double atY) const
     {
-        _T rv{};
-        double atXPower(1);
-
-        for (size_t i = 0; i <= _OrderX; i++)
-        {
-            rv += mCoef[i](atY)*atXPower;
-            atXPower *= atX;
-
-        }
-        return rv;
+        return evaluate(atX, atY, std::make_index_sequence<_OrderX+1>());
     }
     _T integrate(double startX, double endX, double startY, double endY) const
     {
@@ -419,6 +422,51 @@ operator << (std::ostream& out, const Fixed2D<_OtherOrderX, _OtherOrderY, _T>& p
     }
     return out;
 }
+
+namespace details
+{
+template<size_t _Order>
+struct VisitFixed2D final
+{
+    template<typename _T, typename Func_T>
+    static bool visit(const TwoD<_T>& poly, size_t order, Func_T& func)
+    {
+        if (order != _Order)
+        {
+            return VisitFixed2D<_Order + 1>::visit(poly, order, func);
+        }
+        const Fixed2D<_Order, _Order, _T> fixed(poly);
+        func(fixed);
+        return true;
+    }
+};
+template<>
+struct VisitFixed2D<maxVisitFixedOrder + 1> final
+{
+    template<typename _T, typename Func_T>
+    static bool visit(const TwoD<_T>&, size_t, Func_T&)
+    {
+        return false;
+    }
+};
+}
+
+/*!
+ *  Calls func() with `poly` converted to a Fixed2D, so that a polynomial
+ *  whose order is only known at runtime still gets the unrolled
+ *  evaluation.  To keep the number of instantiations down, the Fixed2D
+ *  has the same order in x and y (the larger of the two), padded with
+ *  zeros; this doesn't change the values it computes for finite x and y.
+ *
+ *  \return false, without calling func(), if `poly` is empty or either
+ *  order is more than maxVisitFixedOrder
+ */
+template<typename _T, typename Func_T>
+bool visitFixed(const TwoD<_T>& poly, Func_T&& func)
+{
+    return !poly.empty() &&
+        details::VisitFixed2D<0>::visit(poly, std::max(poly.orderX(), poly.orderY()), func);
+}
 }
 }
 
@@ -0,0 +1,85 @@
+/* =========================================================================
+ * This file is part of math.poly-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.poly-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_poly_Horner_h_INCLUDED_
+#define CODA_OSS_math_poly_Horner_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <array>
+
+namespace math
+{
+namespace poly
+{
+namespace details
+{
+// i * (i-1) * ... * (i-n+1): the factor that differentiating x^i n times
+// leaves on x^(i-n)
+constexpr double fallingFactorial(size_t i, size_t n)
+{
+    return n == 0 ? 1.0 : static_cast<double>(i) * fallingFactorial(i - 1, n - 1);
+}
+
+// Horner's method from coefficient _I up, one instantiation per term so
+// that the whole evaluation is unrolled at compile time.
+template <size_t _Deriv, size_t _I, size_t _N, bool _Last = (_I + 1 >= _N)>
+struct Horner final
+{
+    template <typename _T>
+    static constexpr _T eval(const std::array<_T, _N>& coef, double x)
+    {
+        return coef[_I] * fallingFactorial(_I, _Deriv) + Horner<_Deriv, _I + 1, _N>::eval(coef, x) * x;
+    }
+};
+template <size_t _Deriv, size_t _I, size_t _N>
+struct Horner<_Deriv, _I, _N, true> final
+{
+    template <typename _T>
+    static constexpr _T eval(const std::array<_T, _N>& coef, double)
+    {
+        return _I < _N ? static_cast<_T>(coef[_I] * fallingFactorial(_I, _Deriv)) : _T{};
+    }
+};
+}
+
+/*!
+ * Evaluates the _Deriv'th derivative of the polynomial
+ * coef[0] + coef[1]*x + ... + coef[_N-1]*x^(_N-1)
+ * at x, using Horner's method fully unrolled.  This can be used in
+ * constant expressions:
+ * \code
+ * static_assert(horner(std::array<double, 3>{{1, 2, 3}}, 2.0) == 17.0, "");
+ * \endcode
+ */
+template <size_t _Deriv = 0, typename _T, size_t _N>
+constexpr _T horner(const std::array<_T, _N>& coef, double x)
+{
+    return details::Horner<_Deriv, std::min(_Deriv, _N), _N>::eval(coef, x);
+}
+}
+}
+
+#endif  // CODA_OSS_math_poly_Horner_h_INCLUDED_
@@ -0,0 +1,227 @@
+/* =========================================================================
+ * This file is part of math.poly-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.poly-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_math_poly_LeastSquares_h_INCLUDED_
+#define CODA_OSS_math_poly_LeastSquares_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <import/except.h>
+#include <import/sys.h>
+
+namespace math
+{
+namespace poly
+{
+/*!
+ *  \class LeastSquares
+ *  \brief Solves min ||A c - b|| without forming A or the normal equations.
+ *
+ *  Rows of [A | b] are added a block at a time, and folded into the
+ *  triangular factor R of a Householder QR factorization of everything
+ *  added so far.  Only R, (numUnknowns + 1)^2 values, is kept, so any
+ *  number of rows can be streamed through, and solving with R doesn't
+ *  square the condition number the way inverting A'A does.
+ *
+ *  Rows can be split between several LeastSquares objects (e.g. one per
+ *  thread) and combined with add() before solving.  Weighted problems
+ *  are handled by scaling each row of [A | b] by the square root of its
+ *  weight.
+ */
+class LeastSquares final
+{
+public:
+    explicit LeastSquares(size_t numUnknowns = 0) :
+        mNumUnknowns(numUnknowns),
+        mR((numUnknowns + 1) * (numUnknowns + 1), 0.0)
+    {
+    }
+
+    size_t numUnknowns() const
+    {
+        return mNumUnknowns;
+    }
+
+    /*!
+     *  Adds rows of [A | b] to the problem.
+     *
+     *  \param block The rows, stored by column: element (row, col) is
+     *         block[col * numRows + row], with column numUnknowns() being
+     *         b.  It is overwritten.
+     *  \param numRows The number of rows in `block`
+     */
+    void add(double* block, size_t numRows)
+    {
+        const size_t numCols = mNumUnknowns + 1;
+        for (size_t j = 0; j < numCols; ++j)
+        {
+            // The Householder reflection that zeros column j of the block
+            // against the diagonal of R.  Rows of R below j are already
+            // zero in column j, so they don't take part.
+            double* const v = block + j * numRows;
+            const double sigma = dot(v, v, numRows);
+            if (sigma == 0.0)
+            {
+                continue;
+            }
+
+            double& diagonal = mR[j * numCols + j];
+            const double alpha = diagonal;
+            const double norm = std::sqrt(alpha * alpha + sigma);
+            const double beta = alpha > 0.0 ? -norm : norm;
+            const double tau = (beta - alpha) / beta;
+            const double scale = 1.0 / (alpha - beta);
+            for (size_t r = 0; r < numRows; ++r)
+            {
+                v[r] *= scale;
+            }
+            diagonal = beta;
+
+            // Apply it to the columns to the right; v[0], for R, is 1.
+            for (size_t c = j + 1; c < numCols; ++c)
+            {
+                double* const col = block + c * numRows;
+                double& top = mR[j * numCols + c];
+                const double projection = tau * (top + dot(v, col, numRows));
+                top -= projection;
+                for (size_t r = 0; r < numRows; ++r)
+                {
+                    col[r] -= projection * v[r];
+                }
+            }
+        }
+        mNumRows += numRows;
+    }
+
+    /*!
+     *  Adds all of the rows that were added to `other`
+     */
+    void add(const LeastSquares& other)
+    {
+        if (other.mNumUnknowns != mNumUnknowns)
+        {
+            throw except::Exception(Ctxt("Can't combine problems with " + std::to_string(mNumUnknowns) +
+                                         " and " + std::to_string(other.mNumUnknowns) + " unknowns"));
+        }
+
+        // other's R, by column, is a block like any other
+        const size_t numCols = mNumUnknowns + 1;
+        std::vector<double> block(numCols * numCols);
+        for (size_t r = 0; r < numCols; ++r)
+        {
+            for (size_t c = 0; c < numCols; ++c)
+            {
+                block[c * numCols + r] = other.mR[r * numCols + c];
+            }
+        }
+        const size_t numRows = mNumRows + other.mNumRows;
+        add(block.data(), numCols);
+        mNumRows = numRows;
+    }
+
+    //! The number of rows added so far
+    size_t numRows() const
+    {
+        return mNumRows;
+    }
+
+    /*!
+     *  \return ||A c - b|| for the least squares solution c
+     */
+    double residualNorm() const
+    {
+        return std::abs(mR.back());
+    }
+
+    /*!
+     *  \return The c that minimizes ||A c - b||
+     *  \throw except::Exception if A doesn't have full column rank
+     */
+    std::vector<double> solve() const
+    {
+        const size_t numCols = mNumUnknowns + 1;
+        double maxDiagonal = 0.0;
+        for (size_t j = 0; j < mNumUnknowns; ++j)
+        {
+            maxDiagonal = std::max(maxDiagonal, std::abs(mR[j * numCols + j]));
+        }
+        const double tolerance = maxDiagonal * static_cast<double>(numCols) *
+                std::numeric_limits<double>::epsilon();
+
+        // Back substitution: R c = Q'b, which is R's last column
+        std::vector<double> c(mNumUnknowns);
+        for (size_t j = mNumUnknowns; j-- > 0;)
+        {
+            const double* const row = &mR[j * numCols];
+            if (!(std::abs(row[j]) > tolerance))  // also catches NaN
+            {
+                throw except::Exception(Ctxt("Least squares problem is rank deficient (column " +
+                                             std::to_string(j) + " of " + std::to_string(mNumUnknowns) + ")"));
+            }
+            double sum = row[mNumUnknowns];
+            for (size_t k = j + 1; k < mNumUnknowns; ++k)
+            {
+                sum -= row[k] * c[k];
+            }
+            c[j] = sum / row[j];
+        }
+        return c;
+    }
+
+private:
+    // Separate partial sums, so the compiler can vectorize this without
+    // reordering floating point operations itself
+    static double dot(const double* a, const double* b, size_t size)
+    {
+        double sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+        size_t ii = 0;
+        for (; ii + 4 <= size; ii += 4)
+        {
+            sums[0] += a[ii] * b[ii];
+            sums[1] += a[ii + 1] * b[ii + 1];
+            sums[2] += a[ii + 2] * b[ii + 2];
+            sums[3] += a[ii + 3] * b[ii + 3];
+        }
+        for (; ii < size; ++ii)
+        {
+            sums[0] += a[ii] * b[ii];
+        }
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+
+    size_t mNumUnknowns;
+    size_t mNumRows = 0;
+
+    // R of [A | b], upper triangular and stored by row
+    std::vector<double> mR;
+};
+}
+}
+
+#endif  // CODA_OSS_math_poly_LeastSquares_h_INCLUDED_
@@ -28,6 +28,7 @@
 #include <vector>
 #include <iterator>
 #include <math/linear/Vector.h>
+#include <coda_oss/span.h>
 
 namespace math
 {
@@ -196,6 +197,16 @@ public:
     void copyFrom(const OneD<_T>& p);
 
     _T operator ()(double at) const;
+
+    /*!
+     * Evaluates the polynomial at each point; this is the same as calling
+     * operator() for each, but vectorizes across the points.
+     *
+     * \param at The points
+     * \param out The values, one for each point
+     */
+    void evaluate(coda_oss::span<const double> at, coda_oss::span<_T> out) const;
+
     _T integrate(double start, double end) const;
     OneD<_T>derivative() const;
     _T velocity(double x) const;
@@ -46,6 +46,18 @@ OneD<_T>::operator () (double at) const
    return ret;
 }
 
+template<typename _T>
+void
+OneD<_T>::evaluate(coda_oss::span<const double> at, coda_oss::span<_T> out) const
+{
+    if (at.size() != out.size())
+    {
+        throw except::Exception(Ctxt("Got " + std::to_string(at.size()) + " points but " +
+                                     std::to_string(out.size()) + " outputs"));
+    }
+    details::horner(mCoef.data(), mCoef.size(), at.data(), out.data(), at.size());
+}
+
 template<typename _T>
 _T
 OneD<_T>::integrate(double start, double end) const
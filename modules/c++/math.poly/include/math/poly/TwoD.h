@@ -25,6 +25,7 @@
 
 #include <math/poly/OneD.h>
 #include <math/linear/Matrix2D.h>
+#include <coda_oss/span.h>
 
 namespace math
 {
@@ -102,6 +103,38 @@ public:
         return mCoef[0].order();
     }
     _T operator () (double atX, double atY) const;
+
+    /*!
+     * Evaluates the polynomial at each (x[i], y[i]); this is the same as
+     * calling operator() for each, but vectorizes across the points.
+     *
+     * \param x The x value of each point
+     * \param y The y value of each point
+     * \param out The values, one for each point
+     */
+    void evaluate(coda_oss::span<const double> x,
+                  coda_oss::span<const double> y,
+                  coda_oss::span<_T> out) const;
+
+    /*!
+     * Evaluates the polynomial over a grid, so that
+     * out[row * cols.size() + col] = (*this)(rows[row], cols[col])
+     *
+     * Each row collapses x once, leaving a polynomial in y which is then
+     * evaluated across the row.  This is much cheaper than evaluating each
+     * point separately.
+     *
+     * \param rows The x value of each row
+     * \param cols The y value of each column
+     * \param out The values, stored by row
+     * \param numThreads The number of threads to split the rows over; 0
+     *        uses all available CPUs for large grids and one thread otherwise
+     */
+    void evaluateGrid(coda_oss::span<const double> rows,
+                      coda_oss::span<const double> cols,
+                      coda_oss::span<_T> out,
+                      size_t numThreads = 0) const;
+
     _T integrate(double xStart, double xEnd, double yStart, double yEnd) const;
 
     //! Must check the size of the OneD coming in because
@@ -25,6 +25,7 @@
 
 #include <import/except.h>
 #include <import/sys.h>
+#include <mt/Runnable1D.h>
 #include <math/poly/OneD.h>
 #include <math/poly/Utils.h>
 
@@ -48,6 +49,140 @@ TwoD<_T>::operator () (double atX, double atY) const
     return ret;
 }
 
+template<typename _T>
+void
+TwoD<_T>::evaluate(coda_oss::span<const double> x,
+                   coda_oss::span<const double> y,
+                   coda_oss::span<_T> out) const
+{
+    const size_t numPoints = out.size();
+    if (x.size() != numPoints || y.size() != numPoints)
+    {
+        throw except::Exception(Ctxt("Got " + std::to_string(x.size()) + " x values and " +
+                                     std::to_string(y.size()) + " y values but " +
+                                     std::to_string(numPoints) + " outputs"));
+    }
+    if (empty())
+    {
+        std::fill(out.begin(), out.end(), static_cast<_T>(0.0));
+        return;
+    }
+
+    // Horner's method in x, where each coefficient is a polynomial in y
+    constexpr size_t blockSize = 512;
+    std::vector<_T> atY(std::min(numPoints, blockSize));
+    for (size_t begin = 0; begin < numPoints; begin += blockSize)
+    {
+        const size_t count = std::min(blockSize, numPoints - begin);
+        const double* const xx = x.data() + begin;
+        const double* const yy = y.data() + begin;
+        _T* const ret = out.data() + begin;
+
+        details::horner(mCoef.back().coeffs().data(), mCoef.back().size(), yy, ret, count);
+        for (size_t i = mCoef.size() - 1; i > 0; --i)
+        {
+            details::horner(mCoef[i - 1].coeffs().data(), mCoef[i - 1].size(), yy, atY.data(), count);
+            for (size_t k = 0; k < count; ++k)
+            {
+                ret[k] = ret[k] * xx[k] + atY[k];
+            }
+        }
+    }
+}
+
+namespace details
+{
+// Evaluates one row of TwoD::evaluateGrid(); `atX` is scratch space, so
+// each thread needs its own copy.
+template<typename _T>
+struct GridRowEvaluator final
+{
+    GridRowEvaluator(const std::vector<OneD<_T> >& coef,
+                     coda_oss::span<const double> rows,
+                     coda_oss::span<const double> cols,
+                     coda_oss::span<_T> out) :
+        mCoef(coef), mRows(rows), mCols(cols), mOut(out),
+        mAtX(maxOrderY(coef))
+    {
+    }
+
+    void operator()(size_t row) const
+    {
+        // Collapse x, leaving the coefficients of a polynomial in y.  Rows
+        // needn't all be the same length; missing terms are zero.
+        const double x = mRows[row];
+        std::fill(mAtX.begin(), mAtX.end(), static_cast<_T>(0.0));
+        for (size_t i = mCoef.size(); i > 0; --i)
+        {
+            const std::vector<_T>& coef = mCoef[i - 1].coeffs();
+            for (size_t j = 0; j < mAtX.size(); ++j)
+            {
+                mAtX[j] = mAtX[j] * x;
+            }
+            for (size_t j = 0; j < coef.size(); ++j)
+            {
+                mAtX[j] += coef[j];
+            }
+        }
+        details::horner(mAtX.data(), mAtX.size(), mCols.data(),
+                        mOut.data() + row * mCols.size(), mCols.size());
+    }
+
+private:
+    static size_t maxOrderY(const std::vector<OneD<_T> >& coef)
+    {
+        size_t retval = 0;
+        for (const auto& poly : coef)
+        {
+            retval = std::max(retval, poly.coeffs().size());
+        }
+        return retval;
+    }
+
+    const std::vector<OneD<_T> >& mCoef;
+    const coda_oss::span<const double> mRows;
+    const coda_oss::span<const double> mCols;
+    const coda_oss::span<_T> mOut;
+    mutable std::vector<_T> mAtX;
+};
+}
+
+template<typename _T>
+void
+TwoD<_T>::evaluateGrid(coda_oss::span<const double> rows,
+                       coda_oss::span<const double> cols,
+                       coda_oss::span<_T> out,
+                       size_t numThreads) const
+{
+    const size_t numPoints = rows.size() * cols.size();
+    if (out.size() != numPoints)
+    {
+        throw except::Exception(Ctxt("Got a " + std::to_string(rows.size()) + " x " +
+                                     std::to_string(cols.size()) + " grid but " +
+                                     std::to_string(out.size()) + " outputs"));
+    }
+    if (numPoints == 0)
+    {
+        return;
+    }
+    if (empty())
+    {
+        std::fill(out.begin(), out.end(), static_cast<_T>(0.0));
+        return;
+    }
+
+    if (numThreads == 0)
+    {
+        // Not worth starting threads for small grids
+        constexpr size_t minPointsToThread = 1 << 16;
+        numThreads = numPoints < minPointsToThread ? 1 : sys::OS().getNumCPUsAvailable();
+    }
+    numThreads = std::max<size_t>(std::min(numThreads, rows.size()), 1);
+
+    const details::GridRowEvaluator<_T> op(mCoef, rows, cols, out);
+    mt::run1DWithCopies(rows.size(), numThreads, op);
+}
+
 template<typename _T>
 _T
 TwoD<_T>::integrate(double xStart, double xEnd,
@@ -23,6 +23,10 @@
 #ifndef __MATH_POLY_UTILS_H__
 #define __MATH_POLY_UTILS_H__
 
+#include <stddef.h>
+
+#include <algorithm>
+
 namespace math
 {
 namespace poly
@@ -90,6 +94,39 @@ PolyT scaleVariable(const PolyT& poly,
     }
     return newP;
 }
+
+namespace details
+{
+/*!
+ * Horner's method, for many points at once: out[k] = sum_j coef[j] * x[k]^j
+ *
+ * The loop over points is innermost so that it vectorizes; points are done
+ * in blocks that stay in cache across the passes over the coefficients.
+ */
+template <typename _T>
+void horner(const _T* coef, size_t numCoef, const double* x, _T* out, size_t numPoints)
+{
+    constexpr size_t blockSize = 512;
+    for (size_t begin = 0; begin < numPoints; begin += blockSize)
+    {
+        const size_t end = std::min(begin + blockSize, numPoints);
+        if (numCoef == 0)
+        {
+            std::fill(out + begin, out + end, static_cast<_T>(0.0));
+            continue;
+        }
+        std::fill(out + begin, out + end, coef[numCoef - 1]);
+        for (size_t jj = numCoef - 1; jj > 0; --jj)
+        {
+            const _T c = coef[jj - 1];
+            for (size_t kk = begin; kk < end; ++kk)
+            {
+                out[kk] = out[kk] * x[kk] + c;
+            }
+        }
+    }
+}
+}
 }
 }
 #endif
@@ -0,0 +1,207 @@
+/* =========================================================================
+ * This file is part of math.poly-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math.poly-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <import/math/linear.h>
+#include <import/math/poly.h>
+#include <import/sys.h>
+#include <import/str.h>
+#include <import/except.h>
+
+namespace
+{
+struct Samples final
+{
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> weights;
+};
+
+Samples makeSamples(const math::poly::TwoD<double>& truth, size_t numSamples)
+{
+    Samples retval;
+    retval.x.resize(numSamples);
+    retval.y.resize(numSamples);
+    retval.z.resize(numSamples);
+    retval.weights.resize(numSamples);
+    srand(42);
+    for (size_t ii = 0; ii < numSamples; ++ii)
+    {
+        // Image coordinates, with a little noise on the values
+        retval.x[ii] = 10000.0 * rand() / RAND_MAX;
+        retval.y[ii] = 20000.0 * rand() / RAND_MAX;
+        const double noise = 1e-3 * (static_cast<double>(rand()) / RAND_MAX - 0.5);
+        retval.z[ii] = truth(retval.x[ii], retval.y[ii]) + noise;
+        retval.weights[ii] = 0.5 + static_cast<double>(rand()) / RAND_MAX;
+    }
+    return retval;
+}
+
+// How the fit used to be done: the normal equations, A'A c = A'b, solved
+// by inverting A'A (accumulated per sample here, as the full A won't fit)
+math::poly::TwoD<double> fitNormalEquations(const Samples& samples, size_t nx, size_t ny)
+{
+    const size_t numCoeffs = (nx + 1) * (ny + 1);
+    math::linear::Matrix2D<double> AtA(numCoeffs, numCoeffs, 0.0);
+    math::linear::Matrix2D<double> Atb(numCoeffs, 1, 0.0);
+    std::vector<double> row(numCoeffs);
+    for (size_t ii = 0; ii < samples.z.size(); ++ii)
+    {
+        double xacc = 1.0;
+        for (size_t i = 0; i <= nx; ++i)
+        {
+            double yacc = 1.0;
+            for (size_t j = 0; j <= ny; ++j)
+            {
+                row[i * (ny + 1) + j] = xacc * yacc;
+                yacc *= samples.y[ii];
+            }
+            xacc *= samples.x[ii];
+        }
+        const double w = samples.weights[ii];
+        for (size_t r = 0; r < numCoeffs; ++r)
+        {
+            for (size_t c = 0; c < numCoeffs; ++c)
+            {
+                AtA(r, c) += w * row[r] * row[c];
+            }
+            Atb(r, 0) += w * row[r] * samples.z[ii];
+        }
+    }
+    const auto c = math::linear::inverse<double>(AtA) * Atb;
+
+    math::poly::TwoD<double> poly(nx, ny);
+    for (size_t i = 0; i <= nx; ++i)
+    {
+        for (size_t j = 0; j <= ny; ++j)
+        {
+            poly[i][j] = c(i * (ny + 1) + j, 0);
+        }
+    }
+    return poly;
+}
+
+// The largest difference from the truth, relative to its range
+double getMaxError(const math::poly::TwoD<double>& poly, const math::poly::TwoD<double>& truth,
+                   const Samples& samples)
+{
+    double maxError = 0.0;
+    double maxValue = 0.0;
+    for (size_t ii = 0; ii < samples.z.size(); ii += 1009)
+    {
+        const double expected = truth(samples.x[ii], samples.y[ii]);
+        maxError = std::max(maxError, std::abs(poly(samples.x[ii], samples.y[ii]) - expected));
+        maxValue = std::max(maxValue, std::abs(expected));
+    }
+    return maxError / maxValue;
+}
+
+void printResult(const std::string& name, double timeMS, size_t numSamples, double maxError)
+{
+    std::cout << std::setw(28) << std::left << name << " "
+              << std::setw(12) << std::right << std::fixed << std::setprecision(1) << timeMS << " "
+              << std::setw(16) << std::right << std::setprecision(1) << numSamples / (timeMS * 1e3) << " "
+              << std::setw(14) << std::right << std::scientific << std::setprecision(2) << maxError
+              << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        size_t numSamples = 10000000;
+        size_t order = 3;
+        if (argc > 1)
+        {
+            numSamples = str::toType<size_t>(argv[1]);
+        }
+        if (argc > 2)
+        {
+            order = str::toType<size_t>(argv[2]);
+        }
+
+        math::poly::TwoD<double> truth(order, order);
+        for (size_t i = 0; i <= order; ++i)
+        {
+            for (size_t j = 0; j <= order; ++j)
+            {
+                truth[i][j] = (i + j) % 2 ? 1.0 / (1 + i + j) : -2.0 / (1 + i * j);
+                truth[i][j] /= std::pow(10000.0, static_cast<double>(i + j));
+            }
+        }
+        const Samples samples = makeSamples(truth, numSamples);
+
+        std::cout << numSamples << " samples, order " << order << " x " << order << std::endl;
+        std::cout << std::setw(28) << std::left << "Benchmark" << " "
+                  << std::setw(12) << std::right << "Time (ms)" << " "
+                  << std::setw(16) << std::right << "Msamples/s" << " "
+                  << std::setw(14) << std::right << "Max rel error" << std::endl;
+        std::cout << std::string(73, '-') << std::endl;
+
+        {
+            sys::RealTimeStopWatch sw;
+            sw.start();
+            const auto poly = fitNormalEquations(samples, order, order);
+            const double elapsed = sw.stop();
+            printResult("BM_FitNormalEquations", elapsed, numSamples, getMaxError(poly, truth, samples));
+        }
+
+        std::vector<size_t> threads{ 1 };
+        const size_t numCPUs = sys::OS().getNumCPUsAvailable();
+        if (numCPUs > 1)
+        {
+            threads.push_back(numCPUs);
+        }
+        for (const auto numThreads : threads)
+        {
+            sys::RealTimeStopWatch sw;
+            sw.start();
+            const auto poly = math::poly::fit(samples.x, samples.y, samples.z, samples.weights,
+                                              order, order, numThreads);
+            const double elapsed = sw.stop();
+            printResult("BM_FitQR (" + std::to_string(numThreads) + " threads)", elapsed, numSamples,
+                        getMaxError(poly, truth, samples));
+        }
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.toString() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -218,6 +218,29 @@ TEST_CASE(testAcceleration)
     }
 }
 
+TEST_CASE(testEvaluate)
+{
+    std::vector<double> values;
+    getRandValues(values);
+    values.resize(1000, 0.5);  // more than one block
+
+    const math::poly::OneD<double> poly(getRandPoly(5));
+    std::vector<double> out(values.size());
+    poly.evaluate(values, out);
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+        const double expectedValue(poly(values[ii]));
+        TEST_ASSERT_ALMOST_EQ_EPS(out[ii], expectedValue, std::abs(1e-12 * expectedValue));
+    }
+
+    const math::poly::OneD<double> empty;
+    empty.evaluate(values, out);
+    TEST_ASSERT_EQ(out[0], 0.0);
+
+    out.resize(values.size() - 1);
+    TEST_EXCEPTION(poly.evaluate(values, out));
+}
+
 TEST_MAIN(
     TEST_CHECK(testScaleVariable);
     TEST_CHECK(testTruncateTo);
@@ -225,4 +248,5 @@ TEST_MAIN(
     TEST_CHECK(testTransformInput);
     TEST_CHECK(testVelocity);
     TEST_CHECK(testAcceleration);
+    TEST_CHECK(testEvaluate);
 )
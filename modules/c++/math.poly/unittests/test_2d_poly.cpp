@@ -489,6 +489,88 @@ TEST_CASE(testAtY)
     TEST_ASSERT_EQ(p4.flipXY().atY(4)(5), p4(4, 5));
 }
 
+TEST_CASE(testEvaluate)
+{
+    std::vector<double> xValues;
+    std::vector<double> yValues;
+    getRandValues(xValues, yValues);
+    xValues.resize(1000, 0.5);  // more than one block
+    yValues.resize(xValues.size(), -0.25);
+
+    const math::poly::TwoD<double> poly(getRandPoly(4, 3));
+    std::vector<double> out(xValues.size());
+    poly.evaluate(xValues, yValues, out);
+    for (size_t ii = 0; ii < xValues.size(); ++ii)
+    {
+        const double expectedValue(poly(xValues[ii], yValues[ii]));
+        TEST_ASSERT_ALMOST_EQ_EPS(out[ii], expectedValue, std::abs(1e-12 * expectedValue));
+    }
+
+    const math::poly::TwoD<double> empty;
+    empty.evaluate(xValues, yValues, out);
+    TEST_ASSERT_EQ(out[0], 0.0);
+
+    yValues.pop_back();
+    TEST_EXCEPTION(poly.evaluate(xValues, yValues, out));
+}
+
+TEST_CASE(testEvaluateGrid)
+{
+    std::vector<double> rows(37);
+    std::vector<double> cols(53);
+    for (auto& row : rows)
+    {
+        row = getRand();
+    }
+    for (auto& col : cols)
+    {
+        col = getRand();
+    }
+
+    const math::poly::TwoD<double> poly(getRandPoly(3, 5));
+    for (size_t numThreads = 0; numThreads <= 4; ++numThreads)
+    {
+        std::vector<double> out(rows.size() * cols.size());
+        poly.evaluateGrid(rows, cols, out, numThreads);
+        for (size_t row = 0; row < rows.size(); ++row)
+        {
+            for (size_t col = 0; col < cols.size(); ++col)
+            {
+                const double expectedValue(poly(rows[row], cols[col]));
+                TEST_ASSERT_ALMOST_EQ_EPS(out[row * cols.size() + col], expectedValue,
+                                          std::abs(1e-12 * expectedValue));
+            }
+        }
+    }
+
+    // A polynomial with only one coefficient in y
+    const math::poly::TwoD<double> poly2(getRandPoly(2, 0));
+    std::vector<double> out(rows.size() * cols.size());
+    poly2.evaluateGrid(rows, cols, out);
+    TEST_ASSERT_ALMOST_EQ_EPS(out[cols.size() + 2], poly2(rows[1], cols[2]),
+                              std::abs(1e-12 * out[cols.size() + 2]));
+
+    // Rows of different lengths, longer and shorter than the first
+    const std::vector<math::poly::OneD<double> > ragged{
+        std::vector<double>{ 1.0, 2.0 },
+        std::vector<double>{ -0.5, 0.25, 3.0, -1.0 },
+        std::vector<double>{ 2.0 } };
+    const math::poly::TwoD<double> poly3(ragged);
+    poly3.evaluateGrid(rows, cols, out);
+    for (size_t row = 0; row < rows.size(); ++row)
+    {
+        for (size_t col = 0; col < cols.size(); ++col)
+        {
+            const double expectedValue(poly3(rows[row], cols[col]));
+            TEST_ASSERT_ALMOST_EQ_EPS(out[row * cols.size() + col], expectedValue,
+                                      std::abs(1e-12 * expectedValue));
+        }
+    }
+
+    out.pop_back();
+    TEST_EXCEPTION(poly.evaluateGrid(rows, cols, out));
+}
+
 TEST_MAIN(
     TEST_CHECK(testScaleVariable);
     TEST_CHECK(testTruncateTo);
@@ -497,5 +579,7 @@ TEST_MAIN(
     TEST_CHECK(testOperators);
     TEST_CHECK(testIsScalar);
     TEST_CHECK(testAtY);
+    TEST_CHECK(testEvaluate);
+    TEST_CHECK(testEvaluateGrid);
     )
 
@@ -153,8 +153,55 @@ TEST_CASE(testAcceleration)
     }
 }
 
+TEST_CASE(testConstexpr)
+{
+    // 1 + 2x + 3x^2
+    constexpr Fixed1D<2> poly(std::array<double, 3>{{ 1, 2, 3 }});
+    static_assert(poly(2.0) == 17.0, "poly(2.0)");
+    static_assert(poly.velocity(2.0) == 14.0, "poly.velocity(2.0)");
+    static_assert(poly.acceleration(2.0) == 6.0, "poly.acceleration(2.0)");
+    static_assert(Fixed1D<2>()(2.0) == 0.0, "Fixed1D<2>()(2.0)");
+    static_assert(math::poly::horner<3>(std::array<double, 3>{{ 1, 2, 3 }}, 2.0) == 0.0, "horner<3>");
+    static_assert(math::poly::horner(std::array<double, 0>{}, 2.0) == 0.0, "horner()");
+    TEST_ASSERT_EQ(poly(-1.0), 2.0);
+}
+
+TEST_CASE(testVisitFixed)
+{
+    std::vector<double> values;
+    getRandValues(values);
+
+    for (size_t order = 0; order <= math::poly::maxVisitFixedOrder; ++order)
+    {
+        math::poly::OneD<double> poly(order);
+        for (size_t ii = 0; ii <= order; ++ii)
+        {
+            poly[ii] = getRand();
+        }
+
+        size_t visitedOrder = 0;
+        const bool visited = math::poly::visitFixed(poly, [&](const auto& fixed)
+        {
+            visitedOrder = fixed.order();
+            for (const auto& val : values)
+            {
+                const double expectedValue(poly(val));
+                TEST_ASSERT_ALMOST_EQ_EPS(fixed(val), expectedValue, std::abs(1e-12 * expectedValue));
+            }
+        });
+        TEST_ASSERT(visited);
+        TEST_ASSERT_EQ(visitedOrder, order);
+    }
+
+    const math::poly::OneD<double> tooBig(math::poly::maxVisitFixedOrder + 1);
+    TEST_ASSERT_FALSE(math::poly::visitFixed(tooBig, [](const auto&) {}));
+    TEST_ASSERT_FALSE(math::poly::visitFixed(math::poly::OneD<double>(), [](const auto&) {}));
+}
+
 TEST_MAIN(
     TEST_CHECK(testScaleVariable);
     TEST_CHECK(testVelocity);
     TEST_CHECK(testAcceleration);
+    TEST_CHECK(testConstexpr);
+    TEST_CHECK(testVisitFixed);
 )
@@ -104,6 +104,53 @@ TEST_CASE(testScaleVariable)
     }
 }
 
+TEST_CASE(testConstexpr)
+{
+    // (1 + 2y) + x(3 + 4y)
+    constexpr math::poly::Fixed2D<1, 1> poly(std::array<math::poly::Fixed1D<1>, 2>{{
+        math::poly::Fixed1D<1>(std::array<double, 2>{{ 1, 2 }}),
+        math::poly::Fixed1D<1>(std::array<double, 2>{{ 3, 4 }}) }});
+    static_assert(poly(2.0, 3.0) == 37.0, "poly(2.0, 3.0)");
+    TEST_ASSERT_EQ(poly(-1.0, 1.0), -4.0);
+}
+
+TEST_CASE(testVisitFixed)
+{
+    std::vector<double> xValues;
+    std::vector<double> yValues;
+    getRandValues(xValues, yValues);
+
+    const std::vector<std::pair<size_t, size_t> > orders{ {0, 0}, {3, 1}, {0, 5}, {10, 2} };
+    for (const auto& order : orders)
+    {
+        math::poly::TwoD<double> poly(order.first, order.second);
+        for (size_t ii = 0; ii <= order.first; ++ii)
+        {
+            for (size_t jj = 0; jj <= order.second; ++jj)
+            {
+                poly[ii][jj] = getRand();
+            }
+        }
+
+        const bool visited = math::poly::visitFixed(poly, [&](const auto& fixed)
+        {
+            TEST_ASSERT_EQ(fixed.orderX(), std::max(order.first, order.second));
+            for (size_t ii = 0; ii < xValues.size(); ++ii)
+            {
+                const double expectedValue(poly(xValues[ii], yValues[ii]));
+                TEST_ASSERT_ALMOST_EQ_EPS(fixed(xValues[ii], yValues[ii]), expectedValue,
+                                          std::abs(1e-12 * expectedValue));
+            }
+        });
+        TEST_ASSERT(visited);
+    }
+
+    const math::poly::TwoD<double> tooBig(1, math::poly::maxVisitFixedOrder + 1);
+    TEST_ASSERT_FALSE(math::poly::visitFixed(tooBig, [](const auto&) {}));
+}
+
 TEST_MAIN(
     TEST_CHECK(testScaleVariable);
+    TEST_CHECK(testConstexpr);
+    TEST_CHECK(testVisitFixed);
 )
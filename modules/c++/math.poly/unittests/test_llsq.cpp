@@ -348,10 +348,138 @@ TEST_CASE(testVectorValuedOrderChange)
     }
 }
 
+TEST_CASE(testLeastSquares)
+{
+    using namespace math::poly;
+
+    // Fit c0 + c1*t to (0, 1), (1, 3), (2, 4), (3, 8); rows stored by column
+    const std::vector<double> rows{ 1, 1, 1, 1,
+                                    0, 1, 2, 3,
+                                    1, 3, 4, 8 };
+    LeastSquares problem(2);
+    std::vector<double> block(rows);
+    problem.add(block.data(), 4);
+    TEST_ASSERT_EQ(problem.numRows(), static_cast<size_t>(4));
+    auto c = problem.solve();
+    TEST_ASSERT_EQ(c.size(), static_cast<size_t>(2));
+    TEST_ASSERT_ALMOST_EQ(c[0], 0.7);
+    TEST_ASSERT_ALMOST_EQ(c[1], 2.2);
+    // residuals: 0.3, 0.1, -1.1, 0.7
+    TEST_ASSERT_ALMOST_EQ(problem.residualNorm(), std::sqrt(1.8));
+
+    // The same rows split between two problems
+    LeastSquares first(2);
+    LeastSquares second(2);
+    block = { 1, 1, 0, 1, 1, 3 };
+    first.add(block.data(), 2);
+    block = { 1, 1, 2, 3, 4, 8 };
+    second.add(block.data(), 2);
+    first.add(second);
+    TEST_ASSERT_EQ(first.numRows(), static_cast<size_t>(4));
+    c = first.solve();
+    TEST_ASSERT_ALMOST_EQ(c[0], 0.7);
+    TEST_ASSERT_ALMOST_EQ(c[1], 2.2);
+    TEST_ASSERT_ALMOST_EQ(first.residualNorm(), std::sqrt(1.8));
+
+    // The second column is twice the first
+    LeastSquares deficient(2);
+    block = { 1, 2, 3, 2, 4, 6, 1, 1, 1 };
+    deficient.add(block.data(), 3);
+    TEST_EXCEPTION(deficient.solve());
+    TEST_EXCEPTION(deficient.add(LeastSquares(3)));
+}
+
+TEST_CASE(testWeightedFit)
+{
+    using namespace math::poly;
+
+    const double truthCoeffs[] = { 5, -4, 3, -1 };
+    const OneD<double> truth(3, truthCoeffs);
+
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> weights;
+    for (int ii = -10; ii <= 10; ++ii)
+    {
+        x.push_back(ii + 100.0);
+        y.push_back(truth(ii + 100.0));
+        weights.push_back(ii % 3 == 0 ? 0.5 : 2.0);
+    }
+
+    // Outliers, which don't count
+    x.push_back(95.5);
+    y.push_back(1e6);
+    weights.push_back(0.0);
+    x.push_back(101.5);
+    y.push_back(-1e6);
+    weights.push_back(0.0);
+
+    const OneD<double> poly = fit(x, y, weights, 3);
+    for (int ii = -10; ii <= 10; ++ii)
+    {
+        const double expected = truth(ii + 100.0);
+        TEST_ASSERT_ALMOST_EQ_EPS(poly(ii + 100.0), expected, 1e-9 * std::abs(expected));
+    }
+
+    weights.pop_back();
+    TEST_EXCEPTION(fit(x, y, weights, 3));
+    weights.push_back(-1.0);
+    TEST_EXCEPTION(fit(x, y, weights, 3));
+}
+
+TEST_CASE(test2DPolyfitThreaded)
+{
+    using namespace math::poly;
+
+    const double coeffs[] =
+    {
+        1.5,  -2.0, 0.25,
+        0.75,  3.0, -0.5,
+        -1.0,  0.1, 0.02,
+        0.3,  -0.2, 0.01
+    };
+    const TwoD<double> truth(3, 2, coeffs);
+
+    // Scattered samples, more than one block's worth per thread, and
+    // with the samples at one corner weighted more heavily
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> weights;
+    for (size_t ii = 0; ii < 3001; ++ii)
+    {
+        x.push_back(1000.0 + static_cast<double>((ii * 37) % 101) * 0.5);
+        y.push_back(-200.0 + static_cast<double>((ii * 53) % 97) * 0.25);
+        z.push_back(truth(x.back(), y.back()));
+        weights.push_back(x.back() > 1040.0 ? 4.0 : 1.0);
+    }
+
+    TEST_EXCEPTION(fit(x, y, z, weights, 60, 60));
+    weights.pop_back();
+    TEST_EXCEPTION(fit(x, y, z, weights, 3, 2));
+    weights.push_back(1.0);
+
+    for (size_t numThreads = 1; numThreads <= 4; ++numThreads)
+    {
+        const TwoD<double> poly = fit(x, y, z, weights, 3, 2, numThreads);
+        for (size_t ii = 0; ii < x.size(); ii += 11)
+        {
+            TEST_ASSERT_ALMOST_EQ_EPS(poly(x[ii], y[ii]), z[ii], 1e-8 * std::abs(z[ii]));
+        }
+    }
+
+    // x only takes one value, so its powers can't be told apart
+    const std::vector<double> constant(x.size(), 1.0);
+    TEST_EXCEPTION(fit(constant, y, z, std::vector<double>(), 1, 1));
+}
+
 TEST_MAIN(
     TEST_CHECK(test1DPolyfit);
     TEST_CHECK(test1DPolyfitLarge);
     TEST_CHECK(test2DPolyfit);
     TEST_CHECK(test2DPolyfitLarge);
     TEST_CHECK(testVectorValuedOrderChange);
+    TEST_CHECK(testLeastSquares);
+    TEST_CHECK(testWeightedFit);
+    TEST_CHECK(test2DPolyfitThreaded);
     )
\ No newline at end of file
@@ -24,8 +24,10 @@
 #define __MATH_BESSEL_H
 
 #include <cstddef>
+#include <vector>
 
 #include "config/Exports.h"
+#include "coda_oss/span.h"
 
 namespace math
 {
@@ -49,6 +51,64 @@ CODA_OSS_API double besselIOrderOne(double x);
  * Modified Bessel function of the first kind, order n > 1
  */
 CODA_OSS_API double besselIOrderN(size_t order, double x);
+
+/*!
+ * Array forms of the above: result[i] = besselI(order, x[i]).
+ *
+ * Orders zero and one use the same polynomial fits as the scalar
+ * functions (Abramowitz and Stegun 9.8.1 - 9.8.4, relative error below
+ * 2.2e-7), evaluated a vector at a time.  Order n > 1 runs the
+ * recurrence for several values at once.  Either way, the results agree
+ * with the scalar functions to within 1e-14 relative.
+ *
+ * result may be x.
+ * \throw if x and result are different sizes
+ */
+CODA_OSS_API void besselI(size_t order, coda_oss::span<const double> x, coda_oss::span<double> result);
+CODA_OSS_API void besselIOrderZero(coda_oss::span<const double> x, coda_oss::span<double> result);
+CODA_OSS_API void besselIOrderOne(coda_oss::span<const double> x, coda_oss::span<double> result);
+CODA_OSS_API void besselIOrderN(size_t order, coda_oss::span<const double> x, coda_oss::span<double> result);
+
+/*!
+ * \class BesselIOrderZeroTable
+ * \brief besselIOrderZero() sampled once on [0, maxX] and interpolated.
+ *
+ * Meant for building windows (e.g. Kaiser) and interpolation kernels
+ * over and over again with the same shape parameter: a lookup and a
+ * cubic costs much less than evaluating the fit.  The cubic Hermite
+ * interpolant uses besselIOrderOne() for the slope, so with
+ * maxX / (size - 1) <= 0.01 it is within 1e-9 relative of
+ * besselIOrderZero().  The exception is the interval containing 3.75,
+ * where besselIOrderZero() itself jumps by 2e-8 from one fit to the
+ * other.  Arguments beyond maxX are evaluated directly.
+ */
+class CODA_OSS_API BesselIOrderZeroTable final
+{
+public:
+    /*!
+     * \param maxX Largest |x| that is looked up rather than computed
+     * \param size Number of samples
+     * \throw if maxX isn't positive or there are fewer than two samples
+     */
+    BesselIOrderZeroTable(double maxX, size_t size = 4096);
+
+    double maxX() const noexcept
+    {
+        return mMaxX;
+    }
+
+    double operator()(double x) const;
+
+    //! result may be x. \throw if x and result are different sizes
+    void operator()(coda_oss::span<const double> x, coda_oss::span<double> result) const;
+
+private:
+    double mMaxX;
+    double mScale; // samples per unit x
+
+    // Value and slope (scaled by the sample spacing) at each sample
+    std::vector<double> mTable;
+};
 }
 
 #endif
@@ -27,6 +27,7 @@
 #include <stddef.h>
 
 #include "config/Exports.h"
+#include "coda_oss/span.h"
 
 namespace math
 {
@@ -78,6 +79,17 @@ template<typename T> inline T round(T value_, size_t fractionalDigits)
     return static_cast<T>(result);
 }
 
+/*!
+ *  round() over an array: result[i] = round(values[i]), evaluated a vector
+ *  at a time.  The results are identical to the scalar form.
+ *
+ *  \param values Numbers to evaluate
+ *  \param result The rounded numbers; may be values
+ *  \throw if values and result are different sizes
+ */
+CODA_OSS_API void round(coda_oss::span<const float> values, coda_oss::span<float> result);
+CODA_OSS_API void round(coda_oss::span<const double> values, coda_oss::span<double> result);
+
 /*!
  * Equivalent to ceil((float)numerator / denominator)
  *
@@ -29,6 +29,7 @@
 
 #include <sys/Conf.h>
 #include "config/Exports.h"
+#include "coda_oss/span.h"
 
 namespace math
 {
@@ -43,6 +44,14 @@ inline constexpr int sign(T val) noexcept
     return val < 0 ? -1 : val > 0 ? 1 : 0;
 }
 
+/*!
+ * sign() over an array: result[i] = sign(values[i]), evaluated a vector at
+ * a time.
+ * \throw if values and result are different sizes
+ */
+CODA_OSS_API void sign(coda_oss::span<const float> values, coda_oss::span<int> result);
+CODA_OSS_API void sign(coda_oss::span<const double> values, coda_oss::span<int> result);
+
 inline constexpr double square(double val) noexcept
 {
     return val * val;
@@ -78,6 +87,18 @@ CODA_OSS_API void SinCos(long double angle, long double& sin, long double& cos)
  * \return n choose k
  */
 CODA_OSS_API sys::Uint64_T nChooseK(size_t n, size_t k);
+
+/*
+ * A row of Pascal's triangle: result[k] = nChooseK(n, k) for every k less
+ * than result.size().  Each coefficient is found from the one before, so
+ * the whole row costs about as much as one call to nChooseK(n, n / 2).
+ * Only coefficients that are themselves too big overflow.
+ *
+ * \param n number of possibilities
+ * \param result n choose 0, n choose 1, ...
+ * \throw if result has more than n + 1 elements
+ */
+CODA_OSS_API void nChooseK(size_t n, coda_oss::span<sys::Uint64_T> result);
 }
 
 #endif
@@ -20,11 +20,253 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <string>
 #include <tuple>
 
+#include <except/Exception.h>
 #include <math/Bessel.h>
+#include <sys/AbstractOS.h>
+#include <sys/Conf.h>
+
+// The array forms evaluate two values at a time with SSE2, the x86-64
+// baseline; elsewhere they loop over the scalar functions.
+#if CODA_OSS_ENABLE_SIMD
+    #if defined(__SSE2__) || defined(_M_X64)
+        #define CODA_OSS_math_Bessel_SSE2 1
+        #include <emmintrin.h>
+    #endif
+#endif
+
+namespace
+{
+// Abramowitz and Stegun 9.8.1 - 9.8.4, lowest order first
+constexpr double orderZeroSmall[] = { 1.0, 3.5156229, 3.0899424, 1.2067492,
+                                      0.2659732, 0.360768e-1, 0.45813e-2 };
+constexpr double orderZeroLarge[] = { 0.39894228, 0.1328592e-1, 0.225319e-2,
+                                      -0.157565e-2, 0.916281e-2, -0.2057706e-1,
+                                      0.2635537e-1, -0.1647633e-1, 0.392377e-2 };
+constexpr double orderOneSmall[] = { 0.5, 0.87890594, 0.51498869, 0.15084934,
+                                     0.2658733e-1, 0.301532e-2, 0.32411e-3 };
+constexpr double orderOneLarge[] = { 0.39894228, -0.3988024e-1, -0.362018e-2,
+                                     0.163801e-2, -0.1031555e-1, 0.2282967e-1,
+                                     -0.2895312e-1, 0.1787654e-1, -0.420059e-2 };
+
+// The fits switch over at |x| = 3.75
+constexpr double crossover = 3.75;
+
+// c[K] + y * (c[K + 1] + y * (...)), unrolled at compile time
+template <size_t K, size_t N, bool Last = (K + 1 >= N)>
+struct Horner final
+{
+    static double apply(double y, const double (&c)[N])
+    {
+        return c[K] + y * Horner<K + 1, N>::apply(y, c);
+    }
+};
+template <size_t K, size_t N>
+struct Horner<K, N, true> final
+{
+    static double apply(double, const double (&c)[N])
+    {
+        return c[K];
+    }
+};
+
+template <size_t N>
+inline double horner(double y, const double (&c)[N])
+{
+    return Horner<0, N>::apply(y, c);
+}
+
+void checkSizes(coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    if (x.size() != result.size())
+    {
+        throw except::Exception(Ctxt("Expected " + std::to_string(x.size()) +
+                " results, got " + std::to_string(result.size())));
+    }
+}
+
+#ifdef CODA_OSS_math_Bessel_SSE2
+// Beyond this, exp() is getting close to overflow; those are left to the
+// scalar functions
+constexpr double maxSIMDArgument = 700.0;
+
+// c[K] + y2 * (c[K + 2] + y2 * (...)), unrolled at compile time
+template <size_t K, size_t N, bool Last = (K + 2 >= N)>
+struct EveryOther final
+{
+    static __m128d apply(__m128d y2, const double (&c)[N])
+    {
+        return _mm_add_pd(_mm_set1_pd(c[K]), _mm_mul_pd(y2, EveryOther<K + 2, N>::apply(y2, c)));
+    }
+};
+template <size_t K, size_t N>
+struct EveryOther<K, N, true> final
+{
+    static __m128d apply(__m128d, const double (&c)[N])
+    {
+        return _mm_set1_pd(c[K]);
+    }
+};
+
+// Horner's rule on the even and odd powers separately: two independent
+// chains have half the latency of one.
+template <size_t N>
+inline __m128d polynomial(__m128d y, const double (&c)[N])
+{
+    const __m128d y2 = _mm_mul_pd(y, y);
+    return _mm_add_pd(EveryOther<0, N>::apply(y2, c), _mm_mul_pd(y, EveryOther<1, N>::apply(y2, c)));
+}
+
+inline __m128d abs(__m128d x)
+{
+    return _mm_andnot_pd(_mm_set1_pd(-0.0), x);
+}
+
+inline __m128d select(__m128d mask, __m128d ifTrue, __m128d ifFalse)
+{
+    return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+
+// e^x for 0 <= x <= maxSIMDArgument.  With x = n ln(2) + r, |r| <= ln(2) / 2,
+// e^r is its Taylor series to within 2e-16 and 2^n is built directly.
+inline __m128d exp(__m128d x)
+{
+    constexpr double taylor[] = { 1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120,
+                                  1.0 / 720, 1.0 / 5040, 1.0 / 40320, 1.0 / 362880,
+                                  1.0 / 3628800, 1.0 / 39916800, 1.0 / 479001600 };
+
+    const __m128i n = _mm_cvtpd_epi32(_mm_mul_pd(x, _mm_set1_pd(1.4426950408889634)));
+    const __m128d nd = _mm_cvtepi32_pd(n);
+
+    // ln(2) in two pieces so that n * ln2Hi is exact
+    __m128d r = _mm_sub_pd(x, _mm_mul_pd(nd, _mm_set1_pd(6.93145751953125e-1)));
+    r = _mm_sub_pd(r, _mm_mul_pd(nd, _mm_set1_pd(1.42860682030941723212e-6)));
+
+    __m128i exponent = _mm_add_epi32(n, _mm_set1_epi32(1023));
+    exponent = _mm_slli_epi64(_mm_unpacklo_epi32(exponent, _mm_setzero_si128()), 52);
+    return _mm_mul_pd(polynomial(r, taylor), _mm_castsi128_pd(exponent));
+}
+
+// e^|x| / sqrt(|x|) * P(y), y = 3.75 / |x|, for the large-argument fits;
+// 1 / sqrt(|x|) is sqrt(y / 3.75), which saves a division.  |x| is clamped
+// to the crossover so the lanes that don't use this stay finite.
+template <size_t N>
+inline __m128d largeArgument(__m128d ax, const double (&c)[N])
+{
+    ax = _mm_max_pd(ax, _mm_set1_pd(crossover));
+    const __m128d y = _mm_div_pd(_mm_set1_pd(crossover), ax);
+    const __m128d inverseRoot = _mm_sqrt_pd(_mm_mul_pd(y, _mm_set1_pd(1 / crossover)));
+    return _mm_mul_pd(_mm_mul_pd(polynomial(y, c), inverseRoot), exp(ax));
+}
+#endif
+
+struct OrderZero final
+{
+    static double scalar(double x)
+    {
+        return math::besselIOrderZero(x);
+    }
+
+#ifdef CODA_OSS_math_Bessel_SSE2
+    static __m128d small(__m128d x, __m128d)
+    {
+        __m128d y = _mm_div_pd(x, _mm_set1_pd(crossover));
+        y = _mm_mul_pd(y, y);
+        return polynomial(y, orderZeroSmall);
+    }
+
+    static __m128d large(__m128d, __m128d ax)
+    {
+        return largeArgument(ax, orderZeroLarge);
+    }
+
+    static __m128d sign(__m128d, __m128d ans)
+    {
+        return ans;
+    }
+#endif
+};
+
+struct OrderOne final
+{
+    static double scalar(double x)
+    {
+        return math::besselIOrderOne(x);
+    }
+
+#ifdef CODA_OSS_math_Bessel_SSE2
+    static __m128d small(__m128d x, __m128d ax)
+    {
+        __m128d y = _mm_div_pd(x, _mm_set1_pd(crossover));
+        y = _mm_mul_pd(y, y);
+        return _mm_mul_pd(ax, polynomial(y, orderOneSmall));
+    }
+
+    static __m128d large(__m128d, __m128d ax)
+    {
+        return largeArgument(ax, orderOneLarge);
+    }
+
+    // Odd function
+    static __m128d sign(__m128d x, __m128d ans)
+    {
+        const __m128d negative = _mm_cmplt_pd(x, _mm_setzero_pd());
+        return _mm_xor_pd(ans, _mm_and_pd(negative, _mm_set1_pd(-0.0)));
+    }
+#endif
+};
+
+template <typename Order_T>
+void evaluate(coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    checkSizes(x, result);
+
+    size_t ii = 0;
+#ifdef CODA_OSS_math_Bessel_SSE2
+    const __m128d maxArgument = _mm_set1_pd(maxSIMDArgument);
+    for (; ii + 2 <= x.size(); ii += 2)
+    {
+        const __m128d values = _mm_loadu_pd(x.data() + ii);
+
+        // NaNs fail the comparison too
+        const __m128d ax = abs(values);
+        if (_mm_movemask_pd(_mm_cmple_pd(ax, maxArgument)) == 3)
+        {
+            // Only work out both fits if the pair straddles the crossover
+            const __m128d isSmall = _mm_cmplt_pd(ax, _mm_set1_pd(crossover));
+            __m128d ans;
+            switch (_mm_movemask_pd(isSmall))
+            {
+                case 0:
+                    ans = Order_T::large(values, ax);
+                    break;
+                case 3:
+                    ans = Order_T::small(values, ax);
+                    break;
+                default:
+                    ans = select(isSmall, Order_T::small(values, ax), Order_T::large(values, ax));
+                    break;
+            }
+            _mm_storeu_pd(result.data() + ii, Order_T::sign(values, ans));
+        }
+        else
+        {
+            result[ii] = Order_T::scalar(x[ii]);
+            result[ii + 1] = Order_T::scalar(x[ii + 1]);
+        }
+    }
+#endif
+    for (; ii < x.size(); ++ii)
+    {
+        result[ii] = Order_T::scalar(x[ii]);
+    }
+}
+}
 
 namespace math
 {
@@ -56,31 +298,17 @@ double besselIOrderZero(double x)
     double ans;
     double y;
 
-    if (ax < 3.75)
+    if (ax < crossover)
     {
         //Polynomial fit
-        y = x / 3.75;
+        y = x / crossover;
         y *= y;
-        ans = 1.0 + y * (3.5156229 +
-            y * (3.0899424 +
-                y*(1.2067492 +
-                    y * (0.2659732 +
-                        y * (0.360768e-1 +
-                            y * (0.45813e-2))))));
+        ans = horner(y, orderZeroSmall);
     }
     else
     {
-        y = 3.75 / ax;
-        ans = (std::exp(ax) / std::sqrt(ax)) *
-            (0.39894228 +
-                y * (0.1328592e-1 +
-                    y * (0.225319e-2 +
-                        y * (-0.157565e-2 +
-                            y * (0.916281e-2 +
-                                y * (-0.2057706e-1 +
-                                    y * (0.2635537e-1 +
-                                        y * (-0.1647633e-1 +
-                                            y * (0.392377e-2)))))))));
+        y = crossover / ax;
+        ans = horner(y, orderZeroLarge) * (std::exp(ax) / std::sqrt(ax));
     }
     return ans;
 }
@@ -94,38 +322,19 @@ double besselIOrderOne(double x)
     double ans;
     double y;
 
-    if (ax < 3.75)
+    if (ax < crossover)
     {
         // polynomial fit
-        y = x / 3.75;
+        y = x / crossover;
         y *= y;
-        ans = ax * (0.5 +
-            y * (0.87890594 +
-                 y * (0.51498869 +
-                     y * (0.15084934 +
-                         y * (0.2658733e-1 +
-                             y * (0.301532e-2 +
-                                 y * (0.32411e-3)))))));
-     }
-     else
-     {
-         y = 3.75 / ax;
-         ans = 0.2282967e-1 +
-             y * (-0.2895312e-1 +
-                 y * (0.1787654e-1 -
-                     y * 0.420059e-2));
-
-         // Note that ans is a term at the very end of this expression
-         ans = 0.39894228 +
-             y * (-0.3988024e-1 +
-                 y * (-0.362018e-2 +
-                     y * (0.163801e-2 +
-                         y * (-0.1031555e-1 +
-                             y * ans))));
-
-         ans *= (std::exp(ax) / std::sqrt(ax));
-     }
-     return x < 0.0 ? -ans : ans;
+        ans = ax * horner(y, orderOneSmall);
+    }
+    else
+    {
+        y = crossover / ax;
+        ans = horner(y, orderOneLarge) * (std::exp(ax) / std::sqrt(ax));
+    }
+    return x < 0.0 ? -ans : ans;
 }
 
 /*!
@@ -171,5 +380,151 @@ double besselIOrderN(size_t order, double x)
     ans *= besselIOrderZero(x) / bi;
     return x < 0 && (order & 1) ? -ans : ans;
 }
+
+void besselI(size_t order, coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    switch (order)
+    {
+        case 0:
+            besselIOrderZero(x, result);
+            break;
+
+        case 1:
+            besselIOrderOne(x, result);
+            break;
+
+        default:
+            besselIOrderN(order, x, result);
+            break;
+    }
+}
+
+void besselIOrderZero(coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    evaluate<OrderZero>(x, result);
+}
+
+void besselIOrderOne(coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    evaluate<OrderOne>(x, result);
+}
+
+void besselIOrderN(size_t order, coda_oss::span<const double> x, coda_oss::span<double> result)
+{
+    checkSizes(x, result);
+
+    const double ACC = 200;
+    const int IEXP = std::numeric_limits<double>::max_exponent / 2;
+    const size_t start = 2 * (order + int(std::sqrt(ACC * static_cast<double>(order))));
+
+    // frexp() puts the exponent above IEXP from here on
+    const double renormalizeAt = std::ldexp(1.0, IEXP);
+    const double renormalizeBy = std::ldexp(1.0, -IEXP);
+
+    // Every value takes the same number of steps, so a block of them can
+    // go through the recurrence together.  This is the scalar loop with
+    // the renormalization done branch-free.
+    constexpr size_t blockSize = 8;
+    double values[blockSize];
+    double tox[blockSize];
+    double bip[blockSize];
+    double bi[blockSize];
+    double ans[blockSize];
+    double i0[blockSize];
+    for (size_t ii = 0; ii < x.size(); ii += blockSize)
+    {
+        const size_t count = std::min(blockSize, x.size() - ii);
+        for (size_t kk = 0; kk < blockSize; ++kk)
+        {
+            // Pad short blocks; zeros get a stand-in and are fixed up below
+            const double value = kk < count ? x[ii + kk] : 1.0;
+            values[kk] = value * value <= 8.0 * std::numeric_limits<double>::min() ? 0.0 : value;
+            tox[kk] = values[kk] == 0.0 ? 1.0 : 2.0 / std::abs(values[kk]);
+            bip[kk] = 0;
+            ans[kk] = 0;
+            bi[kk] = 1.0;
+        }
+
+        //Downward recurrence from even n
+        for (size_t jj = start; jj > 0; jj--)
+        {
+            for (size_t kk = 0; kk < blockSize; ++kk)
+            {
+                const double bim = bip[kk] + (static_cast<double>(jj) * tox[kk] * bi[kk]);
+                bip[kk] = bi[kk];
+                bi[kk] = bim;
+
+                //Renormalize to prevent overflow
+                const double scale = bim >= renormalizeAt ? renormalizeBy : 1.0;
+                ans[kk] *= scale;
+                bi[kk] *= scale;
+                bip[kk] *= scale;
+            }
+            if (jj == order)
+            {
+                std::copy(bip, bip + blockSize, ans);
+            }
+        }
+
+        //Normalize
+        besselIOrderZero(values, i0);
+        for (size_t kk = 0; kk < count; ++kk)
+        {
+            const double value = ans[kk] * (i0[kk] / bi[kk]);
+            result[ii + kk] = values[kk] == 0.0 ? 0.0 :
+                    values[kk] < 0 && (order & 1) ? -value : value;
+        }
+    }
+}
+
+BesselIOrderZeroTable::BesselIOrderZeroTable(double maxX, size_t size) :
+    mMaxX(maxX),
+    mScale(0),
+    mTable(2 * size)
+{
+    if (!(maxX > 0) || size < 2)
+    {
+        throw except::Exception(Ctxt("A table needs maxX > 0 and at least two samples, got maxX " +
+                std::to_string(maxX) + " and " + std::to_string(size) + " samples"));
+    }
+
+    const double spacing = maxX / static_cast<double>(size - 1);
+    mScale = 1 / spacing;
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        const double x = static_cast<double>(ii) * spacing;
+        mTable[2 * ii] = besselIOrderZero(x);
+        mTable[2 * ii + 1] = spacing * besselIOrderOne(x);
+    }
+}
+
+double BesselIOrderZeroTable::operator()(double x) const
+{
+    const double ax = std::abs(x);
+    if (!(ax <= mMaxX))
+    {
+        return besselIOrderZero(x);
+    }
+
+    // t is at most size - 1, and converting to a signed integer is cheaper
+    const double t = ax * mScale;
+    const auto ii = std::min(static_cast<size_t>(static_cast<std::ptrdiff_t>(t)), mTable.size() / 2 - 2);
+    const double u = t - static_cast<double>(ii);
+    const double v = 1 - u;
+    const double* const sample = &mTable[2 * ii];
+
+    // Cubic Hermite basis
+    return v * v * (1 + 2 * u) * sample[0] + u * v * v * sample[1] +
+            u * u * (3 - 2 * u) * sample[2] - u * u * v * sample[3];
+}
+
+void BesselIOrderZeroTable::operator()(coda_oss::span<const double> x, coda_oss::span<double> result) const
+{
+    checkSizes(x, result);
+    for (size_t ii = 0; ii < x.size(); ++ii)
+    {
+        result[ii] = (*this)(x[ii]);
+    }
+}
 }
 
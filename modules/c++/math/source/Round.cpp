@@ -20,10 +20,61 @@
  *
  */
 
+#include <string>
+
 #include <except/Exception.h>
 #include <math/Round.h>
+#include <sys/AbstractOS.h>
 #include <sys/Conf.h>
 
+// Two doubles at a time with SSE2, the x86-64 baseline
+#if CODA_OSS_ENABLE_SIMD
+    #if defined(__SSE2__) || defined(_M_X64)
+        #define CODA_OSS_math_Round_SSE2 1
+        #include <emmintrin.h>
+    #endif
+#endif
+
+namespace
+{
+template <typename T>
+void checkSizes(coda_oss::span<const T> values, coda_oss::span<T> result)
+{
+    if (values.size() != result.size())
+    {
+        throw except::Exception(Ctxt("Expected " + std::to_string(values.size()) +
+                " results, got " + std::to_string(result.size())));
+    }
+}
+
+#ifdef CODA_OSS_math_Round_SSE2
+inline __m128d select(__m128d mask, __m128d ifTrue, __m128d ifFalse)
+{
+    return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+
+// math::round(): floor(value + 0.5) and ceil(value - 0.5) both truncate,
+// since value + 0.5 > 0 exactly when value > 0.  SSE2 has no truncate:
+// adding and subtracting 2^52 rounds |a| to an integer, which is pulled
+// back down if it went up.  Anything at least 2^52 is already integral.
+inline __m128d roundPair(__m128d value)
+{
+    const __m128d signBit = _mm_set1_pd(-0.0);
+    const __m128d twoToThe52 = _mm_set1_pd(4503599627370496.0);
+
+    const __m128d a = _mm_add_pd(value, select(_mm_cmpgt_pd(value, _mm_setzero_pd()),
+                                               _mm_set1_pd(0.5), _mm_set1_pd(-0.5)));
+    const __m128d ax = _mm_andnot_pd(signBit, a);
+    __m128d t = _mm_sub_pd(_mm_add_pd(ax, twoToThe52), twoToThe52);
+    t = _mm_sub_pd(t, _mm_and_pd(_mm_cmpgt_pd(t, ax), _mm_set1_pd(1.0)));
+    t = _mm_or_pd(t, _mm_and_pd(signBit, a));
+
+    // NaNs fail the comparison too
+    return select(_mm_cmplt_pd(ax, twoToThe52), t, a);
+}
+#endif
+}
+
 namespace math
 {
 size_t ceilingDivide(size_t numerator, size_t denominator)
@@ -34,4 +85,42 @@ size_t ceilingDivide(size_t numerator, size_t denominator)
     }
     return (numerator / denominator) + (numerator % denominator != 0);
 }
+
+void round(coda_oss::span<const float> values, coda_oss::span<float> result)
+{
+    checkSizes(values, result);
+
+    size_t ii = 0;
+#ifdef CODA_OSS_math_Round_SSE2
+    // round<float>() works in double, so this does too
+    for (; ii + 4 <= values.size(); ii += 4)
+    {
+        const __m128 v = _mm_loadu_ps(values.data() + ii);
+        const __m128 low = _mm_cvtpd_ps(roundPair(_mm_cvtps_pd(v)));
+        const __m128 high = _mm_cvtpd_ps(roundPair(_mm_cvtps_pd(_mm_movehl_ps(v, v))));
+        _mm_storeu_ps(result.data() + ii, _mm_movelh_ps(low, high));
+    }
+#endif
+    for (; ii < values.size(); ++ii)
+    {
+        result[ii] = round(values[ii]);
+    }
+}
+
+void round(coda_oss::span<const double> values, coda_oss::span<double> result)
+{
+    checkSizes(values, result);
+
+    size_t ii = 0;
+#ifdef CODA_OSS_math_Round_SSE2
+    for (; ii + 2 <= values.size(); ii += 2)
+    {
+        _mm_storeu_pd(result.data() + ii, roundPair(_mm_loadu_pd(values.data() + ii)));
+    }
+#endif
+    for (; ii < values.size(); ++ii)
+    {
+        result[ii] = round(values[ii]);
+    }
+}
 }
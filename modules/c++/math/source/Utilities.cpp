@@ -30,9 +30,19 @@
 
 #include <math.h>
 #include <cmath>
+#include <string>
 
 #include <except/Exception.h>
 #include <str/Convert.h>
+#include <sys/AbstractOS.h>
+
+// A vector of signs at a time with SSE2, the x86-64 baseline
+#if CODA_OSS_ENABLE_SIMD
+    #if defined(__SSE2__) || defined(_M_X64)
+        #define CODA_OSS_math_Utilities_SSE2 1
+        #include <emmintrin.h>
+    #endif
+#endif
 
 namespace math
 {
@@ -55,6 +65,93 @@ sys::Uint64_T nChooseK(size_t n, size_t k)
     }
     return coefficient;
 }
+
+void nChooseK(size_t n, coda_oss::span<sys::Uint64_T> result)
+{
+    if (result.size() > n + 1)
+    {
+        throw except::Exception(Ctxt("n Choose k undefined for n < k.\n"
+                "n: " + std::to_string(n) + " k: " + std::to_string(result.size() - 1)));
+    }
+
+    // n choose k + 1 = (n choose k) * (n - k) / (k + 1).  Dividing out what
+    // (n choose k) and k + 1 have in common first leaves a divisor of n - k,
+    // so nothing overflows that isn't itself too big.
+    sys::Uint64_T coefficient = 1;
+    for (size_t k = 0; k < result.size(); ++k)
+    {
+        result[k] = coefficient;
+
+        sys::Uint64_T common = coefficient;
+        sys::Uint64_T divisor = k + 1;
+        while (divisor != 0)
+        {
+            const sys::Uint64_T remainder = common % divisor;
+            common = divisor;
+            divisor = remainder;
+        }
+        coefficient = (coefficient / common) * ((n - k) / ((k + 1) / common));
+    }
+}
+
+template <typename T>
+static void checkSizes(coda_oss::span<const T> values, coda_oss::span<int> result)
+{
+    if (values.size() != result.size())
+    {
+        throw except::Exception(Ctxt("Expected " + std::to_string(values.size()) +
+                " results, got " + std::to_string(result.size())));
+    }
+}
+
+// The comparisons give all ones (-1) where true, so sign is less - greater
+void sign(coda_oss::span<const float> values, coda_oss::span<int> result)
+{
+    checkSizes(values, result);
+
+    size_t ii = 0;
+#ifdef CODA_OSS_math_Utilities_SSE2
+    for (; ii + 4 <= values.size(); ii += 4)
+    {
+        const __m128 v = _mm_loadu_ps(values.data() + ii);
+        const __m128i less = _mm_castps_si128(_mm_cmplt_ps(v, _mm_setzero_ps()));
+        const __m128i greater = _mm_castps_si128(_mm_cmpgt_ps(v, _mm_setzero_ps()));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result.data() + ii), _mm_sub_epi32(less, greater));
+    }
+#endif
+    for (; ii < values.size(); ++ii)
+    {
+        result[ii] = sign(values[ii]);
+    }
+}
+
+void sign(coda_oss::span<const double> values, coda_oss::span<int> result)
+{
+    checkSizes(values, result);
+
+    size_t ii = 0;
+#ifdef CODA_OSS_math_Utilities_SSE2
+    for (; ii + 4 <= values.size(); ii += 4)
+    {
+        // Two 64-bit masks from each comparison, whose low halves are packed
+        // together into four 32-bit ones
+        const __m128d v0 = _mm_loadu_pd(values.data() + ii);
+        const __m128d v1 = _mm_loadu_pd(values.data() + ii + 2);
+        const __m128 less = _mm_shuffle_ps(_mm_castpd_ps(_mm_cmplt_pd(v0, _mm_setzero_pd())),
+                                           _mm_castpd_ps(_mm_cmplt_pd(v1, _mm_setzero_pd())),
+                                           _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 greater = _mm_shuffle_ps(_mm_castpd_ps(_mm_cmpgt_pd(v0, _mm_setzero_pd())),
+                                              _mm_castpd_ps(_mm_cmpgt_pd(v1, _mm_setzero_pd())),
+                                              _MM_SHUFFLE(2, 0, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result.data() + ii),
+                         _mm_sub_epi32(_mm_castps_si128(less), _mm_castps_si128(greater)));
+    }
+#endif
+    for (; ii < values.size(); ++ii)
+    {
+        result[ii] = sign(values[ii]);
+    }
+}
 }
 
 inline void sincosf_(float x, float& sin, float& cos)
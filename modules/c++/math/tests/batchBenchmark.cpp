@@ -0,0 +1,295 @@
+/* =========================================================================
+ * This file is part of math-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * math-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Times the array forms of the math special functions against loops over
+   the scalar ones, and reports how far apart they are.  The Bessel
+   functions are also checked against their power series, summed in long
+   double, which is what "max rel error" means for those rows; for the
+   others it is the largest difference from the scalar function.
+
+   ./batchBenchmark [count]
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <import/math.h>
+#include <import/sys.h>
+#include <import/str.h>
+#include <import/except.h>
+
+namespace
+{
+// Kaiser windows usually have a shape parameter somewhere below this
+constexpr double maxBeta = 20.0;
+
+// I_n(x) = sum (x/2)^(2k + n) / (k! (k + n)!)
+double besselISeries(size_t order, double x)
+{
+    const long double half = static_cast<long double>(x) / 2;
+    long double term = 1;
+    for (size_t k = 1; k <= order; ++k)
+    {
+        term *= half / k;
+    }
+    long double sum = term;
+    for (size_t k = 1; term > sum * 1e-21L; ++k)
+    {
+        term *= half * half / (k * (k + order));
+        sum += term;
+    }
+    return static_cast<double>(x < 0 && (order & 1) ? -sum : sum);
+}
+
+double maxRelativeError(const std::vector<double>& actual, const std::vector<double>& expected)
+{
+    double result = 0;
+    for (size_t ii = 0; ii < actual.size(); ++ii)
+    {
+        if (expected[ii] != 0)
+        {
+            result = std::max(result, std::abs(actual[ii] / expected[ii] - 1));
+        }
+    }
+    return result;
+}
+
+template <typename T>
+double maxDifference(const std::vector<T>& actual, const std::vector<T>& expected)
+{
+    double result = 0;
+    for (size_t ii = 0; ii < actual.size(); ++ii)
+    {
+        result = std::max(result, std::abs(static_cast<double>(actual[ii]) - static_cast<double>(expected[ii])));
+    }
+    return result;
+}
+
+void printResult(const std::string& name, double timeMS, size_t count, double error)
+{
+    std::cout << std::setw(32) << std::left << name << " "
+              << std::setw(10) << std::right << std::fixed << std::setprecision(1) << timeMS << " "
+              << std::setw(8) << std::right << std::setprecision(2) << timeMS * 1e6 / count << " "
+              << std::setw(16) << std::right << std::scientific << std::setprecision(2) << error
+              << std::endl;
+}
+
+template <typename Function_T>
+double time(Function_T function)
+{
+    sys::RealTimeStopWatch sw;
+    sw.start();
+    function();
+    return sw.stop();
+}
+
+void benchmarkBessel(size_t count)
+{
+    // Kaiser window arguments: beta * sqrt(1 - t^2)
+    std::vector<double> x(count);
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        const double t = 2.0 * static_cast<double>(ii) / static_cast<double>(count) - 1.0;
+        x[ii] = maxBeta * std::sqrt(1.0 - t * t);
+    }
+
+    // The series is slow, so it's only summed for every so many values
+    const size_t stride = std::max<size_t>(count / 10000, 1);
+    const auto sampled = [&](const std::vector<double>& values) {
+        std::vector<double> result;
+        for (size_t ii = 0; ii < values.size(); ii += stride)
+        {
+            result.push_back(values[ii]);
+        }
+        return result;
+    };
+    std::vector<double> result(count);
+
+    for (size_t order : { 0, 1, 5 })
+    {
+        const std::string suffix = "<" + std::to_string(order) + ">";
+        std::vector<double> expected;
+        for (size_t ii = 0; ii < count; ii += stride)
+        {
+            expected.push_back(besselISeries(order, x[ii]));
+        }
+
+        auto timeMS = time([&]() {
+            for (size_t ii = 0; ii < count; ++ii)
+                result[ii] = math::besselI(order, x[ii]);
+        });
+        printResult("BM_BesselIScalar" + suffix, timeMS, count, maxRelativeError(sampled(result), expected));
+
+        timeMS = time([&]() { math::besselI(order, x, result); });
+        printResult("BM_BesselIArray" + suffix, timeMS, count, maxRelativeError(sampled(result), expected));
+
+        if (order == 0)
+        {
+            const math::BesselIOrderZeroTable table(maxBeta);
+            timeMS = time([&]() { table(x, result); });
+            printResult("BM_BesselITable<0>", timeMS, count, maxRelativeError(sampled(result), expected));
+        }
+    }
+
+    // Building the same window again and again: w = I0(beta sqrt(1 - t^2)) / I0(beta)
+    const double beta = 8.0;
+    const size_t taps = 1024;
+    const size_t windows = std::max<size_t>(count / taps, 1);
+    std::vector<double> arguments(taps);
+    std::vector<double> window(taps);
+    std::vector<double> expected(taps);
+    for (size_t ii = 0; ii < taps; ++ii)
+    {
+        const double t = 2.0 * static_cast<double>(ii) / static_cast<double>(taps - 1) - 1.0;
+        arguments[ii] = beta * std::sqrt(std::max(1.0 - t * t, 0.0));
+        expected[ii] = besselISeries(0, arguments[ii]) / besselISeries(0, beta);
+    }
+
+    auto timeMS = time([&]() {
+        for (size_t ww = 0; ww < windows; ++ww)
+        {
+            const double scale = 1 / math::besselIOrderZero(beta);
+            for (size_t ii = 0; ii < taps; ++ii)
+                window[ii] = math::besselIOrderZero(arguments[ii]) * scale;
+        }
+    });
+    printResult("BM_KaiserScalar", timeMS, windows * taps, maxRelativeError(window, expected));
+
+    timeMS = time([&]() {
+        for (size_t ww = 0; ww < windows; ++ww)
+        {
+            const double scale = 1 / math::besselIOrderZero(beta);
+            math::besselIOrderZero(arguments, window);
+            for (auto& w : window)
+                w *= scale;
+        }
+    });
+    printResult("BM_KaiserArray", timeMS, windows * taps, maxRelativeError(window, expected));
+
+    const math::BesselIOrderZeroTable table(beta);
+    timeMS = time([&]() {
+        for (size_t ww = 0; ww < windows; ++ww)
+        {
+            const double scale = 1 / table(beta);
+            table(arguments, window);
+            for (auto& w : window)
+                w *= scale;
+        }
+    });
+    printResult("BM_KaiserTable", timeMS, windows * taps, maxRelativeError(window, expected));
+}
+
+template <typename T>
+void benchmarkRoundAndSign(const std::string& typeName, size_t count)
+{
+    const std::string suffix = "<" + typeName + ">";
+
+    std::vector<T> values(count);
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        values[ii] = static_cast<T>((static_cast<double>(ii % 2001) - 1000.0) / 7.0);
+    }
+
+    std::vector<T> expected(count);
+    std::vector<T> result(count);
+    auto timeMS = time([&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            expected[ii] = math::round(values[ii]);
+    });
+    printResult("BM_RoundScalar" + suffix, timeMS, count, 0);
+
+    timeMS = time([&]() { math::round(values, result); });
+    printResult("BM_RoundArray" + suffix, timeMS, count, maxDifference(result, expected));
+
+    std::vector<int> expectedSigns(count);
+    std::vector<int> signs(count);
+    timeMS = time([&]() {
+        for (size_t ii = 0; ii < count; ++ii)
+            expectedSigns[ii] = math::sign(values[ii]);
+    });
+    printResult("BM_SignScalar" + suffix, timeMS, count, 0);
+
+    timeMS = time([&]() { math::sign(values, signs); });
+    printResult("BM_SignArray" + suffix, timeMS, count, maxDifference(signs, expectedSigns));
+}
+
+void benchmarkNChooseK(size_t count)
+{
+    const size_t n = 60;
+    const size_t rows = std::max<size_t>(count / (n + 1), 1);
+    std::vector<sys::Uint64_T> expected(n + 1);
+    std::vector<sys::Uint64_T> row(n + 1);
+
+    auto timeMS = time([&]() {
+        for (size_t rr = 0; rr < rows; ++rr)
+            for (size_t k = 0; k <= n; ++k)
+                expected[k] = math::nChooseK(n, k);
+    });
+    printResult("BM_NChooseKScalar", timeMS, rows * (n + 1), 0);
+
+    timeMS = time([&]() {
+        for (size_t rr = 0; rr < rows; ++rr)
+            math::nChooseK(n, row);
+    });
+    printResult("BM_NChooseKRow", timeMS, rows * (n + 1), maxDifference(row, expected));
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        size_t count = 1000000;
+        if (argc > 1)
+        {
+            count = str::toType<size_t>(argv[1]);
+        }
+
+        std::cout << std::setw(32) << std::left << "Benchmark" << " "
+                  << std::setw(10) << std::right << "Time (ms)" << " "
+                  << std::setw(8) << std::right << "ns/op" << " "
+                  << std::setw(16) << std::right << "max rel error" << std::endl;
+        std::cout << std::string(69, '-') << std::endl;
+
+        benchmarkBessel(count);
+        benchmarkRoundAndSign<float>("float", count);
+        benchmarkRoundAndSign<double>("double", count);
+        benchmarkNChooseK(count);
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.toString() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
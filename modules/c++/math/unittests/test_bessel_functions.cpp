@@ -20,9 +20,27 @@
  *
  */
 
+#include <cmath>
+#include <vector>
+
 #include <TestCase.h>
 #include <math/Bessel.h>
 
+static std::vector<double> arguments()
+{
+    // Both sides of the crossover at 3.75, zero, and an odd count so the
+    // array forms have a tail
+    std::vector<double> x;
+    for (double value = -30.0; value <= 30.0; value += 0.0625)
+    {
+        x.push_back(value);
+    }
+    x.push_back(3.75);
+    x.push_back(-3.75);
+    x.push_back(1e-160);
+    return x;
+}
+
 TEST_CASE(orderZero)
 {
     TEST_ASSERT_ALMOST_EQ(math::besselI(0, 1), 1.266065878);
@@ -44,9 +62,72 @@ TEST_CASE(orderFive)
     TEST_ASSERT_ALMOST_EQ(math::besselI(5, 1), 2.71463156e-4);
 }
 
+TEST_CASE(arrays)
+{
+    const auto x = arguments();
+    std::vector<double> result(x.size());
+    for (size_t order : { 0, 1, 2, 5, 12 })
+    {
+        math::besselI(order, x, result);
+        for (size_t ii = 0; ii < x.size(); ++ii)
+        {
+            const auto expected = math::besselI(order, x[ii]);
+            TEST_ASSERT_ALMOST_EQ_EPS(result[ii], expected, 1e-14 * std::abs(expected));
+        }
+    }
+
+    // In place
+    auto inPlace = x;
+    math::besselIOrderOne(inPlace, inPlace);
+    math::besselIOrderOne(x, result);
+    TEST_ASSERT(inPlace == result);
+
+    // Too big for the vectorized exp(), so computed one at a time
+    const std::vector<double> large{ 705.0, -705.0, 720.0 };
+    result.resize(large.size());
+    math::besselIOrderZero(large, result);
+    TEST_ASSERT_EQ(result[0], math::besselIOrderZero(large[0]));
+    TEST_ASSERT_EQ(result[1], math::besselIOrderZero(large[1]));
+    TEST_ASSERT_EQ(result[2], math::besselIOrderZero(large[2]));
+
+    result.resize(2);
+    TEST_EXCEPTION(math::besselI(0, large, result));
+    TEST_EXCEPTION(math::besselI(3, large, result));
+}
+
+TEST_CASE(table)
+{
+    const math::BesselIOrderZeroTable table(20.0, 2048);
+    TEST_ASSERT_EQ(table.maxX(), 20.0);
+
+    const auto x = arguments();
+    std::vector<double> result(x.size());
+    table(x, result);
+    for (size_t ii = 0; ii < x.size(); ++ii)
+    {
+        // besselIOrderZero() switches fits at 3.75
+        const auto expected = math::besselIOrderZero(x[ii]);
+        const auto tolerance = std::abs(std::abs(x[ii]) - 3.75) < 0.01 ? 5e-8 : 1e-9;
+        TEST_ASSERT_ALMOST_EQ_EPS(result[ii], expected, tolerance * expected);
+        TEST_ASSERT_EQ(table(x[ii]), result[ii]);
+    }
+    TEST_ASSERT_EQ(table(0.0), 1.0);
+    TEST_ASSERT_ALMOST_EQ_EPS(table(20.0), math::besselIOrderZero(20.0), 1e-12 * table(20.0));
+
+    // Past the end is computed
+    TEST_ASSERT_EQ(table(25.0), math::besselIOrderZero(25.0));
+
+    TEST_EXCEPTION(math::BesselIOrderZeroTable(0.0));
+    TEST_EXCEPTION(math::BesselIOrderZeroTable(1.0, 1));
+    result.resize(1);
+    TEST_EXCEPTION(table(x, result));
+}
+
 TEST_MAIN(
     TEST_CHECK(orderZero);
     TEST_CHECK(orderOne);
     TEST_CHECK(orderFive);
+    TEST_CHECK(arrays);
+    TEST_CHECK(table);
     )
 
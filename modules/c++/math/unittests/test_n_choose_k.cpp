@@ -20,6 +20,8 @@
  *
  */
 
+#include <vector>
+
 #include <TestCase.h>
 #include <math/Utilities.h>
 
@@ -45,8 +47,35 @@ TEST_CASE(testNLessThanK)
     TEST_ASSERT(exceptionCaught);
 }
 
+TEST_CASE(testRow)
+{
+    for (size_t n = 0; n <= 60; ++n)
+    {
+        std::vector<sys::Uint64_T> row(n + 1);
+        math::nChooseK(n, row);
+        for (size_t k = 0; k <= n; ++k)
+        {
+            TEST_ASSERT_EQ(row[k], math::nChooseK(n, k));
+        }
+    }
+
+    // Part of a row
+    std::vector<sys::Uint64_T> row(4);
+    math::nChooseK(10, row);
+    TEST_ASSERT_EQ(row[3], static_cast<sys::Uint64_T>(120));
+
+    // Only as far as the coefficients themselves fit
+    row.resize(34);
+    math::nChooseK(67, row);
+    TEST_ASSERT_EQ(row[33], static_cast<sys::Uint64_T>(14226520737620288370ull));
+
+    row.resize(5);
+    TEST_EXCEPTION(math::nChooseK(3, row));
+}
+
 TEST_MAIN(
     TEST_CHECK(testNChooseK);
     TEST_CHECK(testNLessThanK);
+    TEST_CHECK(testRow);
     )
 
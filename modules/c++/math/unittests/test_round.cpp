@@ -24,6 +24,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <cmath>
+#include <limits>
+#include <vector>
 #include <TestCase.h>
 #include <math/Round.h>
 
@@ -175,9 +178,59 @@ TEST_CASE(testCeilingDivide)
     TEST_THROWS(math::ceilingDivide(n3, d3));
 }
 
+template <typename T>
+static std::vector<T> roundingCases()
+{
+    std::vector<T> values{ T(0), -T(0), T(0.5), T(-0.5), T(1.5), T(-2.5),
+                           T(0.49999999999999994), T(-0.49999999999999994),
+                           std::nextafter(T(0.5), T(0)), T(8388607.5), T(8388609),
+                           T(4503599627370497.0), T(-4503599627370497.0), T(1e30),
+                           std::numeric_limits<T>::infinity(),
+                           -std::numeric_limits<T>::infinity() };
+    for (int ii = -1000; ii <= 1000; ++ii)
+    {
+        values.push_back(static_cast<T>(ii) / 8);
+        values.push_back(static_cast<T>(ii) * T(1.37));
+    }
+    return values;
+}
+
+template <typename T>
+static void testRoundArray(const std::string& testName)
+{
+    auto values = roundingCases<T>();
+    values.push_back(std::numeric_limits<T>::quiet_NaN());
+
+    std::vector<T> result(values.size());
+    math::round(values, result);
+    for (size_t ii = 0; ii < values.size() - 1; ++ii)
+    {
+        const auto expected = math::round(values[ii]);
+        TEST_ASSERT_EQ(result[ii], expected);
+        TEST_ASSERT_EQ(std::signbit(result[ii]), std::signbit(expected));
+    }
+    TEST_ASSERT(std::isnan(result.back()));
+
+    // In place
+    math::round(values, values);
+    values.pop_back();
+    result.pop_back();
+    TEST_ASSERT(values == result);
+
+    result.resize(1);
+    TEST_EXCEPTION(math::round(values, result));
+}
+
+TEST_CASE(testRoundArray)
+{
+    testRoundArray<float>(testName);
+    testRoundArray<double>(testName);
+}
+
 TEST_MAIN(
     TEST_CHECK(testFix);
     TEST_CHECK(testRound);
     TEST_CHECK(testRoundDigits);
     TEST_CHECK(testCeilingDivide);
+    TEST_CHECK(testRoundArray);
     )
@@ -23,6 +23,7 @@
 #include <TestCase.h>
 #include <math/Utilities.h>
 #include <limits>
+#include <vector>
 #include <std/numbers>
 
 TEST_CASE(testZero)
@@ -44,6 +45,34 @@ TEST_CASE(testNegative)
     TEST_ASSERT_EQ(math::sign(-0.1), -1);
 }
 
+template <typename T>
+static void testArray(const std::string& testName)
+{
+    std::vector<T> values{ T(0), -T(0), T(1), T(-1), std::numeric_limits<T>::epsilon(),
+                           -std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::infinity(),
+                           -std::numeric_limits<T>::infinity(), std::numeric_limits<T>::quiet_NaN() };
+    for (int ii = -50; ii <= 50; ++ii)
+    {
+        values.push_back(static_cast<T>(ii) / 3);
+    }
+
+    std::vector<int> result(values.size());
+    math::sign(values, result);
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(result[ii], math::sign(values[ii]));
+    }
+
+    result.pop_back();
+    TEST_EXCEPTION(math::sign(values, result));
+}
+
+TEST_CASE(testArray)
+{
+    testArray<float>(testName);
+    testArray<double>(testName);
+}
+
 TEST_CASE(testConstants)
 {
     static auto pi = std::numbers::pi; // "Conditional expression is constant"
@@ -57,6 +86,7 @@ TEST_MAIN(
     TEST_CHECK(testZero);
     TEST_CHECK(testPositive);
     TEST_CHECK(testNegative);
+    TEST_CHECK(testArray);
     TEST_CHECK(testConstants);
     )
 
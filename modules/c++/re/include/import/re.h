@@ -26,5 +26,6 @@
 #include "re/RegexException.h"
 #include "re/Regex.h"
 #include "re/RegexPredicate.h"
+#include "re/RegexSet.h"
 
 #endif
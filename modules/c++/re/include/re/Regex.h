@@ -23,10 +23,15 @@
 #ifndef __RE_REGEX_H__
 #define __RE_REGEX_H__
 
+#include <string.h>
+
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "config/Exports.h"
+#include "coda_oss/span.h"
 
 #if !defined(RE_ENABLE_STD_REGEX)
 #include <re/re_config.h>
@@ -57,6 +62,11 @@ typedef std::vector<std::string> RegexMatch;
  *  significantly slower than PCRE so PCRE is the default.  For further
  *  documentation regarding the underlying PCRE library, especially for flag
  *  information, see http://www.pcre.org.
+ *
+ *  PCRE patterns are JIT compiled when PCRE2 supports it.  Compiled
+ *  patterns are kept in a process-wide cache of the most recently used
+ *  ones and shared between Regex objects, so compiling (or copying) the
+ *  same pattern again is just a lookup.
  */
 class CODA_OSS_API Regex
 {
@@ -121,6 +131,21 @@ public:
 
     bool matches(const std::string& str) const;
 
+    /*!
+     *  As above, without needing the input in a std::string
+     */
+    bool match(coda_oss::span<const char> str,
+               RegexMatch& matchObject);
+    bool match(const char* str, RegexMatch& matchObject)
+    {
+        return match(coda_oss::span<const char>(str, strlen(str)), matchObject);
+    }
+    bool matches(coda_oss::span<const char> str) const;
+    bool matches(const char* str) const
+    {
+        return matches(coda_oss::span<const char>(str, strlen(str)));
+    }
+
     /*!
      *  Search the matchString
      *  \param matchString  The string to try and match
@@ -170,7 +195,22 @@ public:
     static
     std::string escape(const std::string& str);
 
+    /*!
+     *  Set the maximum number of compiled patterns cached; 0 turns the
+     *  cache off.  The default is 256.
+     */
+    static void setCacheCapacity(size_t capacity);
+    static size_t getCacheCapacity();
+
 private:
+    /*!
+     *  Look up `key` in the cache of compiled patterns, calling
+     *  `compile` (and caching the result) if it isn't there.
+     */
+    static std::shared_ptr<const void> getCompiled(
+            const std::string& key,
+            const std::function<std::shared_ptr<const void>()>& compile);
+
     std::string mPattern;
 
 #ifdef RE_ENABLE_STD_REGEX
@@ -182,6 +222,12 @@ private:
      */
     std::string replaceDot(const std::string& str) const;
 
+    /*!
+     *  Throw if mPattern uses '^' or '$' in ways that gcc and VS2015
+     *  don't handle the same.
+     */
+    void validate() const;
+
     /*!
      *  Search using std::regex appropriately based on input string:
      *   regexps starting with ^ are forced to match at beginning
@@ -197,13 +243,14 @@ private:
      *  \return  True on success, otherwise False
      *  \throw  RegexException on error
      */
-    bool searchWithContext(std::string::const_iterator inputIterBegin,
-                           std::string::const_iterator inputIterEnd,
-                           std::smatch& match,
+    template <typename TIterator>
+    bool searchWithContext(TIterator inputIterBegin,
+                           TIterator inputIterEnd,
+                           std::match_results<TIterator>& match,
                            bool matchBeginning=true) const;
 
-    //! The regex object
-    std::regex mRegex;
+    //! The regex object, shared with the cache
+    std::shared_ptr<const std::regex> mRegex;
 
 #else
     // Internal function for passing flags to pcre2_match()
@@ -213,8 +260,8 @@ private:
                        size_t& begin,
                        size_t& end);
 
-    //! The pcre object
-    pcre2_code* mPCRE = nullptr;
+    //! The pcre object, shared with the cache
+    std::shared_ptr<const pcre2_code> mPCRE;
 #endif
 };
 }
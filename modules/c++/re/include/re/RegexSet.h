@@ -0,0 +1,126 @@
+/* =========================================================================
+ * This file is part of re-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * re-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_re_RegexSet_h_INCLUDED_
+#define CODA_OSS_re_RegexSet_h_INCLUDED_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "config/Exports.h"
+#include "coda_oss/span.h"
+#include "re/Regex.h"
+
+namespace re
+{
+/*!
+ *  \class RegexSet
+ *  \brief Finds which of many patterns match a string.
+ *
+ *  Calling Regex::matches() for each pattern runs every pattern over the
+ *  whole input.  Instead, RegexSet pulls a literal that every match must
+ *  contain out of each pattern (e.g. "error" from "error [0-9]+:"), and
+ *  looks for all of them at once, in a single pass, with an Aho-Corasick
+ *  automaton.  Only patterns whose literal was found, or that have no
+ *  usable literal (such as those with a top-level '|'), are then run.
+ *
+ *  A RegexSet isn't changed by matching, so can be shared between threads.
+ */
+class CODA_OSS_API RegexSet final
+{
+public:
+    RegexSet() = default;
+
+    /*!
+     *  Compile the patterns
+     *  \param patterns  The patterns, in the order matches() reports them
+     *  \throw  RegexException if any pattern doesn't compile
+     */
+    explicit RegexSet(const std::vector<std::string>& patterns);
+
+    //! The number of patterns
+    size_t size() const
+    {
+        return mRegexes.size();
+    }
+
+    //! The compiled pattern at `index`
+    const Regex& operator[](size_t index) const
+    {
+        return mRegexes[index];
+    }
+
+    /*!
+     *  Match the input against every pattern
+     *  \param str  The string to match
+     *  \return  The indices of the patterns that match, in increasing order
+     */
+    std::vector<size_t> matches(coda_oss::span<const char> str) const;
+    std::vector<size_t> matches(const std::string& str) const
+    {
+        return matches(coda_oss::span<const char>(str.data(), str.length()));
+    }
+    std::vector<size_t> matches(const char* str) const
+    {
+        return matches(coda_oss::span<const char>(str, strlen(str)));
+    }
+
+    /*!
+     *  \return  true if any pattern matches the input
+     */
+    bool matchesAny(coda_oss::span<const char> str) const;
+    bool matchesAny(const std::string& str) const
+    {
+        return matchesAny(coda_oss::span<const char>(str.data(), str.length()));
+    }
+    bool matchesAny(const char* str) const
+    {
+        return matchesAny(coda_oss::span<const char>(str, strlen(str)));
+    }
+
+    /*!
+     *  The longest literal that any match of `pattern` must contain, or
+     *  an empty string if one can't be found.
+     */
+    static std::string getRequiredLiteral(const std::string& pattern);
+
+private:
+    // Mark the patterns whose literal is in `str`; returns how many were marked.
+    size_t findCandidates(coda_oss::span<const char> str, std::vector<bool>& candidates) const;
+
+    std::vector<Regex> mRegexes;
+    std::vector<size_t> mUnfiltered;  // patterns without a literal; always run
+
+    // Aho-Corasick automaton over the literals, as a DFA: the state after
+    // state s sees byte b is mTransitions[s * 256 + b].
+    std::vector<uint32_t> mTransitions;
+    std::vector<std::vector<size_t>> mOutputs;  // patterns found on reaching each state
+};
+}
+
+#endif  // CODA_OSS_re_RegexSet_h_INCLUDED_
@@ -22,8 +22,112 @@
 
 #include <re/Regex.h>
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+// Least-recently-used cache of compiled patterns; the entries are only
+// ever read once they're compiled, so can be shared between threads.
+class RegexCache final
+{
+    using Entry = std::pair<std::string, std::shared_ptr<const void>>;
+
+    std::mutex mMutex;
+    size_t mCapacity = 256;
+    std::list<Entry> mEntries;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+
+    void trim()
+    {
+        while (mEntries.size() > mCapacity)
+        {
+            mIndex.erase(mEntries.back().first);
+            mEntries.pop_back();
+        }
+    }
+
+public:
+    std::shared_ptr<const void> find(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const auto it = mIndex.find(key);
+        if (it == mIndex.end())
+        {
+            return nullptr;
+        }
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return it->second->second;
+    }
+
+    // Returns what's cached for `key`, which might have been added by
+    // another thread since find().
+    std::shared_ptr<const void> insert(const std::string& key, std::shared_ptr<const void> compiled)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const auto it = mIndex.find(key);
+        if (it != mIndex.end())
+        {
+            mEntries.splice(mEntries.begin(), mEntries, it->second);
+            return it->second->second;
+        }
+        if (mCapacity > 0)
+        {
+            mEntries.emplace_front(key, compiled);
+            mIndex[key] = mEntries.begin();
+            trim();
+        }
+        return compiled;
+    }
+
+    void setCapacity(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCapacity = capacity;
+        trim();
+    }
+    size_t getCapacity()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCapacity;
+    }
+};
+
+RegexCache& getCache()
+{
+    static RegexCache cache;
+    return cache;
+}
+}
+
 namespace re
 {
+std::shared_ptr<const void> Regex::getCompiled(
+        const std::string& key,
+        const std::function<std::shared_ptr<const void>()>& compile)
+{
+    auto& cache = getCache();
+    auto retval = cache.find(key);
+    if (retval == nullptr)
+    {
+        // Compile without holding the lock; it's slow, and might throw.
+        retval = cache.insert(key, compile());
+    }
+    return retval;
+}
+
+void Regex::setCacheCapacity(size_t capacity)
+{
+    getCache().setCapacity(capacity);
+}
+
+size_t Regex::getCacheCapacity()
+{
+    return getCache().getCapacity();
+}
+
 std::string Regex::escape(const std::string& str)
 {
     std::string r;
@@ -44,36 +44,79 @@ std::string getErrorMessage(int errorCode)
     return reinterpret_cast<char*>(buffer);
 }
 
-class ScopedMatchData
+// Per-thread JIT stack and match data, reused by every match on the thread
+class ThreadState final
 {
+    pcre2_jit_stack* mJitStack = nullptr;
+    pcre2_match_context* mMatchContext = nullptr;
+    pcre2_match_data* mMatchData = nullptr;
+    uint32_t mMatchDataSize = 0;
+
 public:
-    // NOTE: If the reallocation is too expensive, can call
-    //       pcre2_match_data_create() and pass in the count.  In this case,
-    //       can we reuse a match data object between calls?  We then need to
-    //       handle more cases below where numMatches == 0 which indicates the
-    //       output vector wasn't large enough like the old PCRE 5.0 code used
-    //       to do.
-    ScopedMatchData(const pcre2_code* code) :
-        mCode(code),
-        mMatchData(pcre2_match_data_create_from_pattern(code, nullptr))
+    ThreadState()
     {
-        if (mMatchData == nullptr)
+        // Without a JIT stack (if PCRE2 was built without JIT) matching
+        // just uses the default context.
+        mJitStack = pcre2_jit_stack_create(32 * 1024, 1024 * 1024, nullptr);
+        if (mJitStack != nullptr)
         {
-            throw re::RegexException(Ctxt(
-                    "pcre2_match_data_create_from_pattern() failed to "
-                    "allocate memory"));
+            mMatchContext = pcre2_match_context_create(nullptr);
+            if (mMatchContext != nullptr)
+            {
+                pcre2_jit_stack_assign(mMatchContext, nullptr, mJitStack);
+            }
         }
     }
-
-    ~ScopedMatchData()
+    ~ThreadState()
     {
         pcre2_match_data_free(mMatchData);
+        pcre2_match_context_free(mMatchContext);
+        pcre2_jit_stack_free(mJitStack);
+    }
+    ThreadState(const ThreadState&) = delete;
+    ThreadState& operator=(const ThreadState&) = delete;
+
+    pcre2_match_context* getMatchContext()
+    {
+        return mMatchContext;
     }
 
-    pcre2_match_data* get()
+    pcre2_match_data* getMatchData(uint32_t size)
     {
+        if (size > mMatchDataSize)
+        {
+            pcre2_match_data_free(mMatchData);
+            mMatchDataSize = 0;
+            mMatchData = pcre2_match_data_create(size, nullptr);
+            if (mMatchData == nullptr)
+            {
+                throw re::RegexException(Ctxt(
+                        "pcre2_match_data_create() failed to "
+                        "allocate memory"));
+            }
+            mMatchDataSize = size;
+        }
         return mMatchData;
     }
+};
+
+ThreadState& getThreadState()
+{
+    thread_local ThreadState state;
+    return state;
+}
+
+class ScopedMatchData
+{
+public:
+    // The match data is reused by every match on this thread, so it's only
+    // valid until the next ScopedMatchData.
+    ScopedMatchData(const pcre2_code* code) :
+        mCode(code),
+        mNumMatches(getCaptureCount(code) + 1),
+        mMatchData(getThreadState().getMatchData(mNumMatches))
+    {
+    }
 
     const PCRE2_SIZE* getOutputVector() const
     {
@@ -81,7 +124,7 @@ public:
     }
 
     // Returns the number of matches
-    size_t match(const std::string& subject,
+    size_t match(coda_oss::span<const char> subject,
                  PCRE2_SIZE startOffset = 0,
                  sys::Uint32_T options = 0)
     {
@@ -90,15 +133,16 @@ public:
         // Other return codes less than 0 indicate an error
         const int returnCode =
                 pcre2_match(mCode,
-                            reinterpret_cast<PCRE2_SPTR>(subject.c_str()),
-                            subject.length(),
+                            reinterpret_cast<PCRE2_SPTR>(subject.data()),
+                            subject.size(),
                             startOffset,
                             options,
                             mMatchData,
-                            nullptr); // Match context
+                            getThreadState().getMatchContext());
 
         if (returnCode == PCRE2_ERROR_NOMATCH)
         {
+            mNumSet = 0;
             return 0;
         }
         else if (returnCode < 0)
@@ -111,12 +155,20 @@ public:
             // The returnCode value won't include trailing empty
             // matches. By returning the actual size including empty matches
             // we now match the STL and Python versions of regex.
-            return pcre2_get_ovector_count(mMatchData);
+            mNumSet = static_cast<size_t>(returnCode);
+            return mNumMatches;
         }
     }
 
-    std::string getMatch(const std::string& str, size_t idx) const
+    std::string getMatch(coda_oss::span<const char> str, size_t idx) const
     {
+        // The match data may be bigger than this pattern needs; anything
+        // past what pcre2_match() set is left over from another match.
+        if (idx >= mNumSet)
+        {
+            return "";
+        }
+
         const PCRE2_SIZE* const outVector = getOutputVector();
 
         const size_t index = outVector[idx * 2];
@@ -130,33 +182,47 @@ public:
             return "";
         }
 
-        if (end > str.length())
+        if (end > str.size())
         {
             // Presumably this never happens
             std::ostringstream ostr;
             ostr << "Match: Match substring out of range ("
                  << index << ", " << end << ") for string of length "
-                 << str.length();
+                 << str.size();
             throw re::RegexException(Ctxt(ostr));
         }
 
         const size_t subStringLength = end - index;
-        return str.substr(index, subStringLength);
+        return std::string(str.data() + index, subStringLength);
     }
 
     ScopedMatchData(const ScopedMatchData&) = delete;
     ScopedMatchData& operator=(const ScopedMatchData&) = delete;
 
 private:
+    static uint32_t getCaptureCount(const pcre2_code* code)
+    {
+        uint32_t retval = 0;
+        pcre2_pattern_info(code, PCRE2_INFO_CAPTURECOUNT, &retval);
+        return retval;
+    }
+
     const pcre2_code* const mCode;
+    const uint32_t mNumMatches;
     pcre2_match_data* const mMatchData;
+    size_t mNumSet = 0;
 };
+
+coda_oss::span<const char> make_span(const std::string& str)
+{
+    return coda_oss::span<const char>(str.data(), str.length());
+}
 }
 
 namespace re
 {
 Regex::Regex(const std::string& pattern) :
-    mPattern(pattern), mPCRE(nullptr)
+    mPattern(pattern)
 {
     if (!mPattern.empty())
     {
@@ -166,11 +232,7 @@ Regex::Regex(const std::string& pattern) :
 
 void Regex::destroy()
 {
-    if (mPCRE != nullptr)
-    {
-        pcre2_code_free(mPCRE);
-        mPCRE = nullptr;
-    }
+    mPCRE.reset();
 }
 
 Regex::~Regex()
@@ -178,21 +240,18 @@ Regex::~Regex()
     destroy();
 }
 
+// The compiled pattern is never modified, so can be shared
 Regex::Regex(const Regex& rhs) :
-    mPattern(rhs.mPattern), mPCRE(nullptr)
+    mPattern(rhs.mPattern), mPCRE(rhs.mPCRE)
 {
-    compile(mPattern);
 }
 
 Regex& Regex::operator=(const Regex& rhs)
 {
     if (this != &rhs)
     {
-        destroy();
-
         mPattern = rhs.mPattern;
-
-        compile(mPattern);
+        mPCRE = rhs.mPCRE;
     }
 
     return *this;
@@ -204,42 +263,58 @@ Regex& Regex::compile(const std::string& pattern)
 
     destroy();
 
-    // TODO: So, I would like an RAII object for this.  But, this object would
-    //       need to call pcre2_compile() in its constructor rather than take
-    //       ownership of a pointer (so that it has access to the error code
-    //       information on failure) and its copy constructor / assignment
-    //       operator would need to hold onto mPattern.  At that point the
-    //       class is close to being this Regex class itself.
     static const int FLAGS = PCRE2_DOTALL;
-    int errorCode;
-    PCRE2_SIZE errorOffset;
-    mPCRE = pcre2_compile(reinterpret_cast<PCRE2_SPTR>(mPattern.c_str()),
-                          mPattern.length(),
-                          FLAGS,
-                          &errorCode,
-                          &errorOffset,
-                          nullptr); // Use default compile context
-
-    if (mPCRE == nullptr)
+    const auto key = std::to_string(FLAGS) + '/' + mPattern;
+    const auto compiled = getCompiled(key, [&]()
     {
-        std::ostringstream ostr;
-        ostr << "PCRE compilation failed at offset " << errorOffset
-             << ": " << getErrorMessage(errorCode);
-        throw RegexException(Ctxt(ostr));
-    }
+        int errorCode;
+        PCRE2_SIZE errorOffset;
+        pcre2_code* const code =
+                pcre2_compile(reinterpret_cast<PCRE2_SPTR>(mPattern.c_str()),
+                              mPattern.length(),
+                              FLAGS,
+                              &errorCode,
+                              &errorOffset,
+                              nullptr); // Use default compile context
+
+        if (code == nullptr)
+        {
+            std::ostringstream ostr;
+            ostr << "PCRE compilation failed at offset " << errorOffset
+                 << ": " << getErrorMessage(errorCode);
+            throw RegexException(Ctxt(ostr));
+        }
+        std::shared_ptr<const pcre2_code> retval(code, pcre2_code_free);
+
+        // If the JIT isn't available (or fails) pcre2_match() uses the
+        // interpreter, so there's no need to check.
+        pcre2_jit_compile(code, PCRE2_JIT_COMPLETE);
+        return std::shared_ptr<const void>(retval);
+    });
+    mPCRE = std::static_pointer_cast<const pcre2_code>(compiled);
 
     return *this;
 }
 
 bool Regex::matches(const std::string& str) const
 {
-    ScopedMatchData matchData(mPCRE);
+    return matches(make_span(str));
+}
+
+bool Regex::matches(coda_oss::span<const char> str) const
+{
+    ScopedMatchData matchData(mPCRE.get());
     return (matchData.match(str) > 0);
 }
 
 bool Regex::match(const std::string& str, RegexMatch& matchObject)
 {
-    ScopedMatchData matchData(mPCRE);
+    return match(make_span(str), matchObject);
+}
+
+bool Regex::match(coda_oss::span<const char> str, RegexMatch& matchObject)
+{
+    ScopedMatchData matchData(mPCRE.get());
     const size_t numMatches = matchData.match(str);
     matchObject.resize(numMatches);
 
@@ -269,14 +344,14 @@ std::string Regex::search(const std::string& matchString,
                           size_t& begin,
                           size_t& end)
 {
-    ScopedMatchData matchData(mPCRE);
-    const size_t numMatches = matchData.match(matchString, startIndex, flags);
+    ScopedMatchData matchData(mPCRE.get());
+    const size_t numMatches = matchData.match(make_span(matchString), startIndex, flags);
 
     if (numMatches > 0)
     {
         begin = matchData.getOutputVector()[0];
         end = matchData.getOutputVector()[1];
-        return matchData.getMatch(matchString, 0);
+        return matchData.getMatch(make_span(matchString), 0);
     }
     else
     {
@@ -70,10 +70,10 @@ Regex::~Regex()
 {
 }
 
-Regex::Regex(const Regex& rhs)
+// The compiled pattern is never modified, so can be shared
+Regex::Regex(const Regex& rhs) :
+    mPattern(rhs.mPattern), mRegex(rhs.mRegex)
 {
-    mPattern = rhs.mPattern;
-    compile(mPattern);
 }
 
 Regex& Regex::operator=(const Regex& rhs)
@@ -81,23 +81,46 @@ Regex& Regex::operator=(const Regex& rhs)
     if (this != &rhs)
     {
         mPattern = rhs.mPattern;
-
-        compile(mPattern);
+        mRegex = rhs.mRegex;
     }
 
     return *this;
 }
 
-Regex& Regex::compile(const std::string& pattern)
+namespace
 {
-    // We'll set these first, so that if we throw an exception we'll
-    // leave the regex in a compiled state, so if the user REALLY
-    // wants to, they can put it in a try/catch block and keep going.
-
-    mPattern = replaceDot(pattern);
-    mRegex = std::regex(mPattern, std::regex::ECMAScript|std::regex::optimize);
+struct CompiledRegex final
+{
+    std::string pattern;  // after replaceDot()
+    std::regex regex;
+};
+}
 
+Regex& Regex::compile(const std::string& pattern)
+{
+    const auto compiled = std::static_pointer_cast<const CompiledRegex>(
+            getCompiled("std::regex/" + pattern, [&]()
+    {
+        auto retval = std::make_shared<CompiledRegex>();
+        retval->pattern = replaceDot(pattern);
+        retval->regex = std::regex(retval->pattern, std::regex::ECMAScript|std::regex::optimize);
+
+        // We'll set these first, so that if we throw an exception we'll
+        // leave the regex in a compiled state, so if the user REALLY
+        // wants to, they can put it in a try/catch block and keep going.
+        mPattern = retval->pattern;
+        mRegex = std::shared_ptr<const std::regex>(retval, &retval->regex);
+        validate();
+        return std::shared_ptr<const void>(retval);
+    }));
+
+    mPattern = compiled->pattern;
+    mRegex = std::shared_ptr<const std::regex>(compiled, &compiled->regex);
+    return *this;
+}
 
+void Regex::validate() const
+{
     // Because VS2015 and gcc handle ^ and $ differently, we'll throw
     // exceptions if they're in the middle of the pattern somewhere
 
@@ -130,8 +153,6 @@ Regex& Regex::compile(const std::string& pattern)
         msg += " Try adding a '^' at the beginning and matching the entire string.";
         throw RegexException(Ctxt(msg));
     }
-
-    return *this;
 }
 
 bool Regex::matches(const std::string& str) const
@@ -140,6 +161,26 @@ bool Regex::matches(const std::string& str) const
     return searchWithContext(str.cbegin(), str.cend(), matches);
 }
 
+bool Regex::matches(coda_oss::span<const char> str) const
+{
+    std::cmatch matches;
+    return searchWithContext(str.data(), str.data() + str.size(), matches);
+}
+
+bool Regex::match(coda_oss::span<const char> str, RegexMatch& matchObject)
+{
+    std::cmatch matches;
+    const bool result = searchWithContext(str.data(), str.data() + str.size(), matches);
+
+    matchObject.resize(matches.size());
+    for (size_t ii = 0; ii < matches.size(); ++ii)
+    {
+        matchObject[ii] = matches[ii].str();
+    }
+
+    return result;
+}
+
 bool Regex::match(const std::string& str, RegexMatch& matchObject)
 {
     std::smatch matches;
@@ -246,11 +287,17 @@ std::string Regex::replaceDot(const std::string& str) const
     return newstr;
 }
 
-bool Regex::searchWithContext(std::string::const_iterator inputIterBegin,
-                              std::string::const_iterator inputIterEnd,
-                              std::smatch& match,
+template <typename TIterator>
+bool Regex::searchWithContext(TIterator inputIterBegin,
+                              TIterator inputIterEnd,
+                              std::match_results<TIterator>& match,
                               bool matchBeginning) const
 {
+    if (mRegex == nullptr)
+    {
+        return false;  // never compiled; a default std::regex matches nothing
+    }
+
     bool b(false);
     auto flags = std::regex_constants::match_default;
     if (!matchBeginning)
@@ -268,19 +315,19 @@ bool Regex::searchWithContext(std::string::const_iterator inputIterBegin,
         if (mPattern.length() >= 2 && mPattern.back() == '$')
         {
             b = std::regex_match(inputIterBegin, inputIterEnd, 
-                                 match, mRegex, flags);
+                                 match, *mRegex, flags);
         }
         else
         {
             flags |= std::regex_constants::match_continuous;
             b = std::regex_search(inputIterBegin, inputIterEnd,
-                                  match, mRegex, flags);
+                                  match, *mRegex, flags);
         }
     }
     else
     {
         b = std::regex_search(inputIterBegin, inputIterEnd,
-                              match, mRegex, flags);
+                              match, *mRegex, flags);
     }
 
     return b;
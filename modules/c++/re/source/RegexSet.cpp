@@ -0,0 +1,357 @@
+/* =========================================================================
+ * This file is part of re-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * re-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "re/RegexSet.h"
+
+#include <ctype.h>
+
+#include <queue>
+
+namespace
+{
+constexpr auto npos = std::string::npos;
+constexpr uint32_t noState = UINT32_MAX;
+constexpr size_t alphabetSize = 256;
+
+// `pos` is at the '['; returns just past the matching ']', or npos.
+size_t skipClass(const std::string& pattern, size_t pos)
+{
+    ++pos;
+    if ((pos < pattern.length()) && (pattern[pos] == '^'))
+    {
+        ++pos;
+    }
+    if ((pos < pattern.length()) && (pattern[pos] == ']'))
+    {
+        ++pos;  // a leading ']' is literal
+    }
+    for (; pos < pattern.length(); ++pos)
+    {
+        if (pattern[pos] == '\\')
+        {
+            ++pos;
+        }
+        else if ((pattern[pos] == '[') && (pos + 1 < pattern.length()) && (pattern[pos + 1] == ':'))
+        {
+            pos = pattern.find(":]", pos + 2);  // [:alpha:]
+            if (pos == npos)
+            {
+                return npos;
+            }
+            ++pos;
+        }
+        else if (pattern[pos] == ']')
+        {
+            return pos + 1;
+        }
+    }
+    return npos;
+}
+
+// `pos` is at the '('; returns just past the matching ')', or npos.
+size_t skipGroup(const std::string& pattern, size_t pos)
+{
+    size_t depth = 0;
+    while (pos < pattern.length())
+    {
+        switch (pattern[pos])
+        {
+        case '\\':
+            pos += 2;
+            continue;
+        case '[':
+            pos = skipClass(pattern, pos);
+            if (pos == npos)
+            {
+                return npos;
+            }
+            continue;
+        case '(':
+            ++depth;
+            break;
+        case ')':
+            if (--depth == 0)
+            {
+                return pos + 1;
+            }
+            break;
+        default:
+            break;
+        }
+        ++pos;
+    }
+    return npos;
+}
+}
+
+namespace re
+{
+std::string RegexSet::getRequiredLiteral(const std::string& pattern)
+{
+    // Inline options such as (?i), verbs and \Q...\E all change what's
+    // literal; don't try.
+    if ((pattern.find("(?") != npos) || (pattern.find("(*") != npos) || (pattern.find("\\Q") != npos))
+    {
+        return "";
+    }
+
+    // Every match contains each run of literal characters in the top-level
+    // concatenation, less any character that a quantifier makes optional.
+    std::string longest;
+    std::string run;
+    const auto endRun = [&]()
+    {
+        if (run.length() > longest.length())
+        {
+            longest = run;
+        }
+        run.clear();
+    };
+
+    size_t pos = 0;
+    while (pos < pattern.length())
+    {
+        const char ch = pattern[pos];
+        switch (ch)
+        {
+        case '|':
+            return "";  // nothing is required of every alternative
+
+        case '(':
+        case '[':
+            endRun();
+            pos = ch == '(' ? skipGroup(pattern, pos) : skipClass(pattern, pos);
+            if (pos == npos)
+            {
+                return "";
+            }
+            continue;
+
+        case '*':
+        case '?':
+        case '{':
+            if (!run.empty())
+            {
+                run.pop_back();  // the quantified character
+            }
+            endRun();
+            pos = ch == '{' ? pattern.find('}', pos) : pos;
+            if (pos == npos)
+            {
+                return longest;
+            }
+            ++pos;
+            continue;
+
+        case '+':  // at least one, but the run can't continue past it
+        case '.':
+        case '^':
+        case '$':
+            endRun();
+            ++pos;
+            continue;
+
+        case '\\':
+        {
+            if (pos + 1 == pattern.length())
+            {
+                return "";
+            }
+            const char escaped = pattern[pos + 1];
+            if (isalnum(static_cast<unsigned char>(escaped)))
+            {
+                // Escapes like \d stand for a class; others (\x41, \1, \p{..})
+                // would need parsing, so give up on those.
+                static const std::string classes = "dDsSwWbBAzZGhHvVRXKN";
+                if (classes.find(escaped) == npos)
+                {
+                    return "";
+                }
+                endRun();
+            }
+            else
+            {
+                run += escaped;
+            }
+            pos += 2;
+            continue;
+        }
+
+        default:
+            run += ch;
+            ++pos;
+            continue;
+        }
+    }
+    endRun();
+    return longest;
+}
+
+RegexSet::RegexSet(const std::vector<std::string>& patterns)
+{
+    mRegexes.reserve(patterns.size());
+
+    // The trie of literals; transitions are filled in below.
+    const auto addState = [&]()
+    {
+        mTransitions.resize(mTransitions.size() + alphabetSize, noState);
+        mOutputs.emplace_back();
+        return static_cast<uint32_t>(mOutputs.size() - 1);
+    };
+    addState();  // the root
+
+    for (size_t ii = 0; ii < patterns.size(); ++ii)
+    {
+        mRegexes.emplace_back(patterns[ii]);
+
+        const auto literal = getRequiredLiteral(patterns[ii]);
+        if (literal.empty())
+        {
+            mUnfiltered.push_back(ii);
+            continue;
+        }
+        uint32_t state = 0;
+        for (const auto ch : literal)
+        {
+            const auto index = state * alphabetSize + static_cast<unsigned char>(ch);
+            if (mTransitions[index] == noState)
+            {
+                const auto next = addState();
+                mTransitions[index] = next;
+            }
+            state = mTransitions[index];
+        }
+        mOutputs[state].push_back(ii);
+    }
+
+    // Breadth-first, so a state's failure state (always shallower) is done
+    // first: missing transitions become those of the failure state, and
+    // each state also outputs whatever its failure state does.
+    std::vector<uint32_t> failure(mOutputs.size(), 0);
+    std::queue<uint32_t> queue;
+    for (size_t ch = 0; ch < alphabetSize; ++ch)
+    {
+        auto& next = mTransitions[ch];
+        if (next == noState)
+        {
+            next = 0;
+        }
+        else
+        {
+            queue.push(next);
+        }
+    }
+    while (!queue.empty())
+    {
+        const auto state = queue.front();
+        queue.pop();
+        for (size_t ch = 0; ch < alphabetSize; ++ch)
+        {
+            const auto fallback = mTransitions[failure[state] * alphabetSize + ch];
+            auto& next = mTransitions[state * alphabetSize + ch];
+            if (next == noState)
+            {
+                next = fallback;
+            }
+            else
+            {
+                failure[next] = fallback;
+                const auto& outputs = mOutputs[fallback];
+                mOutputs[next].insert(mOutputs[next].end(), outputs.begin(), outputs.end());
+                queue.push(next);
+            }
+        }
+    }
+}
+
+size_t RegexSet::findCandidates(coda_oss::span<const char> str, std::vector<bool>& candidates) const
+{
+    const auto numFiltered = mRegexes.size() - mUnfiltered.size();
+    size_t retval = 0;
+    if (numFiltered == 0)
+    {
+        return retval;
+    }
+
+    uint32_t state = 0;
+    for (const auto ch : str)
+    {
+        state = mTransitions[state * alphabetSize + static_cast<unsigned char>(ch)];
+        for (const auto index : mOutputs[state])
+        {
+            if (!candidates[index])
+            {
+                candidates[index] = true;
+                if (++retval == numFiltered)
+                {
+                    return retval;  // everything has been found
+                }
+            }
+        }
+    }
+    return retval;
+}
+
+std::vector<size_t> RegexSet::matches(coda_oss::span<const char> str) const
+{
+    std::vector<bool> candidates(mRegexes.size(), false);
+    findCandidates(str, candidates);
+    for (const auto index : mUnfiltered)
+    {
+        candidates[index] = true;
+    }
+
+    std::vector<size_t> retval;
+    for (size_t ii = 0; ii < candidates.size(); ++ii)
+    {
+        if (candidates[ii] && mRegexes[ii].matches(str))
+        {
+            retval.push_back(ii);
+        }
+    }
+    return retval;
+}
+
+bool RegexSet::matchesAny(coda_oss::span<const char> str) const
+{
+    std::vector<bool> candidates(mRegexes.size(), false);
+    if (findCandidates(str, candidates) > 0)
+    {
+        for (size_t ii = 0; ii < candidates.size(); ++ii)
+        {
+            if (candidates[ii] && mRegexes[ii].matches(str))
+            {
+                return true;
+            }
+        }
+    }
+    for (const auto index : mUnfiltered)
+    {
+        if (mRegexes[index].matches(str))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+}
@@ -45,6 +45,16 @@ double BM_RegexCreation(uint64_t numIterations, const std::string& regexString)
 }
 
 
+// Creation when every Regex compiles its pattern
+double BM_RegexCreationUncached(uint64_t numIterations, const std::string& regexString)
+{
+    const auto capacity = re::Regex::getCacheCapacity();
+    re::Regex::setCacheCapacity(0);
+    const double retval = BM_RegexCreation(numIterations, regexString);
+    re::Regex::setCacheCapacity(capacity);
+    return retval;
+}
+
 // Now benchmark the actual string-matching
 double BM_RegexMatch(uint64_t numIterations, const std::string& fileString, const std::string& regexString)
 {
@@ -61,6 +71,57 @@ double BM_RegexMatch(uint64_t numIterations, const std::string& fileString, cons
     return elapsedTimeMS / numIterations;
 }
 
+// Match every line of the file, copying each into a std::string ...
+double BM_RegexMatchLines(uint64_t numIterations, const std::string& fileString, const std::string& regexString)
+{
+    sys::RealTimeStopWatch sw;
+    re::Regex regex(regexString);
+
+    sw.start();
+    for (uint64_t ii = 0; ii < numIterations; ++ii)
+    {
+        size_t begin = 0;
+        for (size_t end = fileString.find('\n'); end != std::string::npos; end = fileString.find('\n', begin))
+        {
+            const std::string line = fileString.substr(begin, end - begin);
+            regex.matches(line);
+            begin = end + 1;
+        }
+    }
+    double elapsedTimeMS = sw.stop();
+
+    return elapsedTimeMS / numIterations;
+}
+
+// ... and as spans into the file
+double BM_RegexMatchLinesSpan(uint64_t numIterations, const std::string& fileString, const std::string& regexString)
+{
+    sys::RealTimeStopWatch sw;
+    re::Regex regex(regexString);
+
+    sw.start();
+    for (uint64_t ii = 0; ii < numIterations; ++ii)
+    {
+        size_t begin = 0;
+        for (size_t end = fileString.find('\n'); end != std::string::npos; end = fileString.find('\n', begin))
+        {
+            const coda_oss::span<const char> line(fileString.data() + begin, end - begin);
+            regex.matches(line);
+            begin = end + 1;
+        }
+    }
+    double elapsedTimeMS = sw.stop();
+
+    return elapsedTimeMS / numIterations;
+}
+
+void printResult(const std::string& name, double timeMS, uint64_t numIterations)
+{
+    // Convert ms to ns
+    std::cout << std::setw(24) << std::left << name << " "
+              << std::setw(20) << std::right << std::fixed << std::setprecision(0) << timeMS * 1.e6 << " "
+              << std::setw(15) << std::right << numIterations << std::endl;
+}
 
 int main(int argc, char** argv)
 {
@@ -88,7 +149,7 @@ int main(int argc, char** argv)
         std::cout << ldt.format(std::string("%Y-%m-%d %H:%M:%S")) << std::endl;
     
         // Open our text file and feed it into the static buffer
-        std::ifstream bigFin(argv[1]);
+        std::ifstream bigFin(argv[1], std::ios::binary | std::ios::ate);
         if (!bigFin.is_open())
         {
             std::cerr << "Error opening text file!" << std::endl;
@@ -105,27 +166,24 @@ int main(int argc, char** argv)
         std::string fileString(&fileVec[0], size);
     
         // Now run the benchmarks
-        double swtime0 = BM_RegexCreation(numIterations, regexString);
-        double swtime1 = BM_RegexMatch(numIterations, fileString, regexString);
-
-        // Convert ms to ns
-        swtime0 *= 1.e6;
-        swtime1 *= 1.e6;
+        const double swtime0 = BM_RegexCreation(numIterations, regexString);
+        const double swtime1 = BM_RegexCreationUncached(numIterations, regexString);
+        const double swtime2 = BM_RegexMatch(numIterations, fileString, regexString);
+        const double swtime3 = BM_RegexMatchLines(numIterations, fileString, regexString);
+        const double swtime4 = BM_RegexMatchLinesSpan(numIterations, fileString, regexString);
 
         // Pretty-print our results
-        std::cout << std::setw(20) << std::left << "Benchmark" << " "
+        std::cout << std::setw(24) << std::left << "Benchmark" << " "
                   << std::setw(20) << std::right << "Time/Iteration (ns)" << " "
                   << std::setw(15) << std::right << "Iterations" << std::endl;
     
-        std::cout << std::string(57, '-') << std::endl;
-    
-        std::cout << std::setw(20) << std::left << "BM_RegexCreation" << " "
-                  << std::setw(20) << std::right << std::fixed << std::setprecision(0) << swtime0 << " "
-                  << std::setw(15) << std::right << numIterations << std::endl;
+        std::cout << std::string(61, '-') << std::endl;
 
-        std::cout << std::setw(20) << std::left << "BM_RegexMatch" << " "
-                  << std::setw(20) << std::right << std::fixed << std::setprecision(0) << swtime1 << " "
-                  << std::setw(15) << std::right << numIterations << std::endl;
+        printResult("BM_RegexCreation", swtime0, numIterations);
+        printResult("BM_RegexCreationUncached", swtime1, numIterations);
+        printResult("BM_RegexMatch", swtime2, numIterations);
+        printResult("BM_RegexMatchLines", swtime3, numIterations);
+        printResult("BM_RegexMatchLinesSpan", swtime4, numIterations);
     }
     catch (const except::Exception& ex)
     {
@@ -0,0 +1,189 @@
+/* =========================================================================
+ * This file is part of re-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * re-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <import/re.h>
+#include <import/sys.h>
+#include <import/str.h>
+#include <import/except.h>
+
+namespace
+{
+// Patterns of the sort used to classify log lines
+std::vector<std::string> makePatterns()
+{
+    std::vector<std::string> retval{
+        "ERROR [0-9]+:",
+        "WARN(ING)?:",
+        "segmentation fault",
+        "connection (refused|reset)",
+        "timed out after [0-9]+ ms",
+        "disk [a-z]+ is full",
+        "user=[a-z]+ login failed",
+        "checksum mismatch",
+        "out of memory",
+        "^FATAL",
+        "retry [0-9]+ of [0-9]+",
+        "deadlock detected",
+        "permission denied",
+        "no such file",
+        "stack trace:",
+        "assertion .* failed",
+        "GET /api/v[0-9]+/",
+        "POST /upload",
+        "HTTP/1\\.1\" 5[0-9][0-9]",
+        "cache miss",
+    };
+    for (size_t ii = 0; ii < 30; ++ii)
+    {
+        retval.push_back("component" + std::to_string(ii) + ": [a-z]+ error");
+    }
+    return retval;
+}
+
+std::vector<std::string> makeLines(size_t numLines)
+{
+    static const std::vector<std::string> templates{
+        "2023-04-01 12:00:00 INFO request handled in 12 ms",
+        "2023-04-01 12:00:01 DEBUG GET /api/v2/items?id=7 HTTP/1.1\" 200",
+        "2023-04-01 12:00:02 INFO cache hit for key user:1234",
+        "2023-04-01 12:00:03 WARNING: retry 2 of 5 for upstream",
+        "2023-04-01 12:00:04 INFO scheduled job finished successfully",
+        "2023-04-01 12:00:05 ERROR 17: connection refused by 10.0.0.1",
+        "2023-04-01 12:00:06 DEBUG component12: parse error",
+        "2023-04-01 12:00:07 INFO the quick brown fox jumps over the lazy dog",
+    };
+    std::vector<std::string> retval;
+    for (size_t ii = 0; ii < numLines; ++ii)
+    {
+        retval.push_back(templates[ii % templates.size()]);
+    }
+    return retval;
+}
+
+// Each pattern over each line
+double BM_RegexLoop(uint64_t numIterations, const std::vector<std::string>& patterns,
+                    const std::vector<std::string>& lines, size_t& numMatches)
+{
+    std::vector<re::Regex> regexes;
+    for (const auto& pattern : patterns)
+    {
+        regexes.emplace_back(pattern);
+    }
+
+    sys::RealTimeStopWatch sw;
+    sw.start();
+    numMatches = 0;
+    for (uint64_t ii = 0; ii < numIterations; ++ii)
+    {
+        for (const auto& line : lines)
+        {
+            for (const auto& regex : regexes)
+            {
+                numMatches += regex.matches(line) ? 1 : 0;
+            }
+        }
+    }
+    return sw.stop() / numIterations;
+}
+
+// One RegexSet scan of each line
+double BM_RegexSet(uint64_t numIterations, const std::vector<std::string>& patterns,
+                   const std::vector<std::string>& lines, size_t& numMatches)
+{
+    const re::RegexSet set(patterns);
+
+    sys::RealTimeStopWatch sw;
+    sw.start();
+    numMatches = 0;
+    for (uint64_t ii = 0; ii < numIterations; ++ii)
+    {
+        for (const auto& line : lines)
+        {
+            numMatches += set.matches(line).size();
+        }
+    }
+    return sw.stop() / numIterations;
+}
+
+void printResult(const std::string& name, double timeMS, uint64_t numIterations, size_t numMatches)
+{
+    // Convert ms to ns
+    std::cout << std::setw(24) << std::left << name << " "
+              << std::setw(20) << std::right << std::fixed << std::setprecision(0) << timeMS * 1.e6 << " "
+              << std::setw(15) << std::right << numIterations << " "
+              << std::setw(10) << std::right << numMatches << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        uint64_t numIterations = 100;
+        if (argc > 1)
+        {
+            numIterations = str::toType<uint64_t>(argv[1]);
+        }
+
+        const auto patterns = makePatterns();
+        const auto lines = makeLines(1000);
+
+        size_t loopMatches = 0;
+        size_t setMatches = 0;
+        const double swtime0 = BM_RegexLoop(numIterations, patterns, lines, loopMatches);
+        const double swtime1 = BM_RegexSet(numIterations, patterns, lines, setMatches);
+
+        std::cout << patterns.size() << " patterns, " << lines.size() << " lines" << std::endl;
+        std::cout << std::setw(24) << std::left << "Benchmark" << " "
+                  << std::setw(20) << std::right << "Time/Iteration (ns)" << " "
+                  << std::setw(15) << std::right << "Iterations" << " "
+                  << std::setw(10) << std::right << "Matches" << std::endl;
+        std::cout << std::string(72, '-') << std::endl;
+
+        printResult("BM_RegexLoop", swtime0, numIterations, loopMatches);
+        printResult("BM_RegexSet", swtime1, numIterations, setMatches);
+
+        if (loopMatches != setMatches)
+        {
+            std::cerr << "RegexSet found a different number of matches!" << std::endl;
+            return 1;
+        }
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.toString() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "An exception occurred!" << std::endl;
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
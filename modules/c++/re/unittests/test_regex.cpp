@@ -23,6 +23,8 @@
 #include <import/re.h>
 #include "TestCase.h"
 #include <map>
+#include <thread>
+#include <vector>
 
 TEST_CASE(testCompile)
 {
@@ -495,6 +497,83 @@ TEST_CASE(testHttpResponse)
     TEST_ASSERT_EQ(p.getContentLength(), "96");
 }
 
+TEST_CASE(testMatchSpan)
+{
+    // Only "Keep-Alive" is passed in; the rest of the text is never looked at.
+    const std::string text = "Proxy-Connection: Keep-Alive\r\n";
+    const coda_oss::span<const char> value(text.data() + 18, 10);
+
+    re::Regex rx("^[A-Za-z-]+$");
+    TEST_ASSERT(rx.matches(value));
+    TEST_ASSERT_FALSE(rx.matches(text));
+    TEST_ASSERT(rx.matches("Keep-Alive"));
+
+    re::RegexMatch matches;
+    re::Regex rx2("^([A-Za-z]+)-(.*)$");
+    TEST_ASSERT(rx2.match(value, matches));
+    TEST_ASSERT_EQ(matches.size(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(matches[1], "Keep");
+    TEST_ASSERT_EQ(matches[2], "Alive");
+    TEST_ASSERT_FALSE(rx2.match(coda_oss::span<const char>(text.data(), 5), matches));
+    TEST_ASSERT(matches.empty());
+}
+
+TEST_CASE(testCache)
+{
+    const auto capacity = re::Regex::getCacheCapacity();
+    TEST_ASSERT(capacity > 0);
+
+    // Copies and recompiles share the compiled pattern; they still match
+    // the same and can be used from several threads at once.
+    re::Regex rx("([a-z]+)([0-9]+)");
+    const re::Regex copy(rx);
+    std::vector<std::thread> threads;
+    std::vector<int> results(4, 0);
+    for (size_t ii = 0; ii < results.size(); ++ii)
+    {
+        threads.emplace_back([&, ii]()
+        {
+            re::Regex local("([a-z]+)([0-9]+)");
+            re::RegexMatch matches;
+            for (int jj = 0; jj < 1000; ++jj)
+            {
+                if (local.match("abc" + std::to_string(jj), matches) && (matches[2] == std::to_string(jj)) &&
+                    copy.matches("x1") && !copy.matches("123"))
+                {
+                    ++results[ii];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto result : results)
+    {
+        TEST_ASSERT_EQ(result, 1000);
+    }
+
+    // Bad patterns aren't cached; they throw every time.
+    TEST_THROWS(rx.compile("^("));
+    TEST_THROWS(rx.compile("^("));
+
+    // Put the capacity back even if an assertion fails
+    struct RestoreCapacity final
+    {
+        size_t capacity;
+        ~RestoreCapacity()
+        {
+            re::Regex::setCacheCapacity(capacity);
+        }
+    } restore{ capacity };
+
+    re::Regex::setCacheCapacity(0);
+    TEST_ASSERT_EQ(re::Regex::getCacheCapacity(), static_cast<size_t>(0));
+    rx.compile("a+b");
+    TEST_ASSERT(rx.matches("xaab"));
+}
+
 TEST_MAIN(
     TEST_CHECK(testCompile);
     TEST_CHECK(testMatches);
@@ -508,4 +587,6 @@ TEST_MAIN(
     TEST_CHECK(testSub);
     TEST_CHECK(testSplit);
     TEST_CHECK(testHttpResponse);
+    TEST_CHECK(testMatchSpan);
+    TEST_CHECK(testCache);
     )
@@ -0,0 +1,130 @@
+/* =========================================================================
+ * This file is part of re-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * re-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <import/re.h>
+#include "TestCase.h"
+
+namespace
+{
+std::vector<size_t> matchEach(const std::vector<std::string>& patterns, const std::string& str)
+{
+    std::vector<size_t> retval;
+    for (size_t ii = 0; ii < patterns.size(); ++ii)
+    {
+        if (re::Regex(patterns[ii]).matches(str))
+        {
+            retval.push_back(ii);
+        }
+    }
+    return retval;
+}
+}
+
+TEST_CASE(testRequiredLiteral)
+{
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("abc"), "abc");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("^error [0-9]+: disk"), "error ");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("ab*cdef"), "cdef");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("abcd?e"), "abc");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("ab+c"), "ab");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("x{2,3}yz"), "yz");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("a\\.b\\d+cc"), "a.b");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("(foo|bar)baz"), "baz");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("[]abc]xy[[:digit:]]"), "xy");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("beam(Id|String)"), "beam");
+
+    // Nothing that every match must contain
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("foo|bar"), "");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("(?i)foo"), "");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral("\\x41BC"), "");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral(".*"), "");
+    TEST_ASSERT_EQ(re::RegexSet::getRequiredLiteral(""), "");
+}
+
+TEST_CASE(testMatches)
+{
+    const std::vector<std::string> patterns{
+        "error [0-9]+",
+        "warn(ing)?",
+        "^INFO",
+        "disk|network",     // no literal
+        "(?i)timeout",      // no literal
+        "err",              // a prefix of another literal
+        "[0-9]{4}-[0-9]{2}-[0-9]{2}",
+        "rror",             // a suffix of another literal
+        "err",              // a duplicate
+    };
+    const re::RegexSet set(patterns);
+    TEST_ASSERT_EQ(set.size(), patterns.size());
+    TEST_ASSERT_EQ(set[2].getPattern(), "^INFO");
+
+    const std::vector<std::string> inputs{
+        "",
+        "INFO 2023-01-02 all is well",
+        "error 42 on disk",
+        "errors: TIMEOUT",
+        "warning: eRRor",
+        "nothing to see here",
+        "INFO: error",
+        "an error occurred",
+    };
+    for (const auto& input : inputs)
+    {
+        const auto expected = matchEach(patterns, input);
+        TEST_ASSERT(set.matches(input) == expected);
+        TEST_ASSERT_EQ(set.matchesAny(input), !expected.empty());
+    }
+
+    const std::vector<size_t> expected{ 0, 3, 5, 7, 8 };
+    TEST_ASSERT(set.matches("error 42 on disk") == expected);
+    TEST_ASSERT(set.matches("nothing to see here").empty());
+    TEST_ASSERT_FALSE(set.matchesAny("nothing to see here"));
+}
+
+TEST_CASE(testMatchesSpan)
+{
+    const re::RegexSet set(std::vector<std::string>{ "abc$", "^x" });
+    const std::string str = "xyzabcdef";
+    TEST_ASSERT(set.matches(coda_oss::span<const char>(str.data(), 6)) == (std::vector<size_t>{ 0, 1 }));
+    TEST_ASSERT(set.matches(coda_oss::span<const char>(str.data() + 1, 5)) == std::vector<size_t>{ 0 });
+    TEST_ASSERT(set.matches(coda_oss::span<const char>(str.data() + 1, 4)).empty());
+}
+
+TEST_CASE(testEmpty)
+{
+    const re::RegexSet set;
+    TEST_ASSERT_EQ(set.size(), static_cast<size_t>(0));
+    TEST_ASSERT(set.matches("abc").empty());
+    TEST_ASSERT_FALSE(set.matchesAny("abc"));
+
+    TEST_THROWS(re::RegexSet(std::vector<std::string>{ "abc", "^(" }));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testRequiredLiteral);
+    TEST_CHECK(testMatches);
+    TEST_CHECK(testMatchesSpan);
+    TEST_CHECK(testEmpty);
+    )
@@ -41,11 +41,14 @@
  *
  */
 
+#include "str/CharConv.h"
 #include "str/Convert.h"
 #include "str/Tokenizer.h"
 #include "str/Format.h"
+#include "str/FormatString.h"
 #include "str/Manip.h"
 #include "str/Encoding.h"
+#include "str/Split.h"
 #define STR_MAJOR_VERSION 0
 #define STR_MINOR_VERSION 1
 #define STR_MICRO_VERSION 0
@@ -0,0 +1,265 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_str_CharConv_h_INCLUDED_
+#define CODA_OSS_str_CharConv_h_INCLUDED_
+
+#include <stddef.h>
+#include <string.h>
+
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "config/Exports.h"
+#include "coda_oss/span.h"
+
+/*!
+ * \file CharConv.h
+ * \brief Number <-> text conversions in the style of C++17's <charconv>.
+ *
+ * Unlike std::stringstream (and so str::toType() and str::toString()),
+ * these never allocate and ignore the locale: the decimal point is
+ * always '.' and there are no thousands separators.  As with
+ * std::from_chars(), leading whitespace and '+' are not accepted.
+ */
+
+namespace str
+{
+struct from_chars_result final
+{
+    const char* ptr;
+    std::errc ec;
+};
+struct to_chars_result final
+{
+    char* ptr;
+    std::errc ec;
+};
+
+namespace details
+{
+template <typename T>
+using enable_if_integer_t = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>;
+
+inline int digitValue(char ch)
+{
+    if ((ch >= '0') && (ch <= '9'))
+        return ch - '0';
+    if ((ch >= 'a') && (ch <= 'z'))
+        return ch - 'a' + 10;
+    if ((ch >= 'A') && (ch <= 'Z'))
+        return ch - 'A' + 10;
+    return std::numeric_limits<int>::max();
+}
+
+template <typename T>
+inline bool isNegative(T value, std::true_type /*is_signed*/)
+{
+    return value < 0;
+}
+template <typename T>
+inline bool isNegative(T, std::false_type /*is_signed*/)
+{
+    return false;
+}
+}
+
+/*!
+ *  Parses an integer in `base` (2 to 36) from the start of [first, last).
+ *
+ *  \return `ptr` is one past the last character used.  `ec` is
+ *  std::errc::invalid_argument (and `ptr` is `first`) if there are no
+ *  digits, or std::errc::result_out_of_range if the number doesn't fit;
+ *  `value` is only changed on success.
+ */
+template <typename T, typename = details::enable_if_integer_t<T>>
+inline from_chars_result from_chars(const char* first, const char* last, T& value, int base = 10)
+{
+    using U = std::make_unsigned_t<T>;
+
+    auto p = first;
+    const bool negative = std::is_signed<T>::value && (p != last) && (*p == '-');
+    if (negative)
+    {
+        ++p;
+    }
+    const auto max = static_cast<U>(std::numeric_limits<T>::max());
+    const U limit = negative ? static_cast<U>(max + 1) : max;
+
+    const auto digits = p;
+    U result = 0;
+    bool overflow = false;
+    for (; p != last; ++p)
+    {
+        const auto digit = details::digitValue(*p);
+        if (digit >= base)
+        {
+            break;
+        }
+        if (result > (limit - digit) / base)
+        {
+            overflow = true;
+        }
+        else
+        {
+            result = static_cast<U>(result * base + digit);
+        }
+    }
+
+    if (p == digits)
+    {
+        return { first, std::errc::invalid_argument };
+    }
+    if (overflow)
+    {
+        return { p, std::errc::result_out_of_range };
+    }
+    value = negative ? static_cast<T>(static_cast<U>(U(0) - result)) : static_cast<T>(result);
+    return { p, std::errc() };
+}
+
+/*!
+ *  Parses a decimal floating-point number ("1", "-1.5", ".5e-3", "inf",
+ *  "nan") from the start of [first, last).  Results are correctly
+ *  rounded.  Errors are reported as for integers.
+ */
+CODA_OSS_API from_chars_result from_chars(const char* first, const char* last, float& value);
+CODA_OSS_API from_chars_result from_chars(const char* first, const char* last, double& value);
+
+/*!
+ *  Writes `value` in `base` (2 to 36, lowercase letters).
+ *
+ *  \return `ptr` is one past the last character written, or `last`
+ *  with std::errc::value_too_large if there isn't room.
+ */
+template <typename T, typename = details::enable_if_integer_t<T>>
+inline to_chars_result to_chars(char* first, char* last, T value, int base = 10)
+{
+    using U = std::make_unsigned_t<T>;
+
+    auto u = static_cast<U>(value);
+    const bool negative = details::isNegative(value, std::is_signed<T>());
+    if (negative)
+    {
+        u = static_cast<U>(U(0) - u);
+    }
+
+    char buffer[std::numeric_limits<U>::digits + 1];
+    auto const end = buffer + sizeof(buffer);
+    auto p = end;
+    do
+    {
+        *--p = "0123456789abcdefghijklmnopqrstuvwxyz"[u % base];
+        u = static_cast<U>(u / base);
+    } while (u != 0);
+    if (negative)
+    {
+        *--p = '-';
+    }
+
+    const auto length = end - p;
+    if (last - first < length)
+    {
+        return { last, std::errc::value_too_large };
+    }
+    memcpy(first, p, length);
+    return { first + length, std::errc() };
+}
+
+/*!
+ *  Writes `value` with enough significant digits (but no more than
+ *  std::numeric_limits<>::max_digits10) that from_chars() gives back
+ *  exactly the same value.  The format is that of printf()'s "%g".
+ */
+CODA_OSS_API to_chars_result to_chars(char* first, char* last, float value);
+CODA_OSS_API to_chars_result to_chars(char* first, char* last, double value);
+
+//! Same as printf()'s "%.*g", but always with '.' for the decimal point.
+CODA_OSS_API to_chars_result to_chars(char* first, char* last, float value, int precision);
+CODA_OSS_API to_chars_result to_chars(char* first, char* last, double value, int precision);
+CODA_OSS_API to_chars_result to_chars(char* first, char* last, long double value, int precision);
+
+namespace details
+{
+inline bool isListSeparator(char ch, char delimiter)
+{
+    return (ch == delimiter) || (ch == ' ') || (ch == '\t') || (ch == '\n') || (ch == '\r');
+}
+CODA_OSS_API void throwBadList(const char* first, const char* last, size_t index, size_t size);
+}
+
+/*!
+ *  Parses a list of numbers ("1.5, 2, 3" or "1.5 2 3") into `values`.
+ *  Numbers are separated by `delimiter` and/or whitespace; runs of
+ *  separators count as one.  A leading '+' is allowed.
+ *
+ *  \return The number of values parsed
+ *  \throw except::BadCastException if anything isn't a number, or there
+ *  are more than values.size() of them
+ */
+template <typename T>
+size_t toTypes(const char* first, const char* last, coda_oss::span<T> values, char delimiter = ',')
+{
+    size_t count = 0;
+    auto p = first;
+    while (true)
+    {
+        while ((p != last) && details::isListSeparator(*p, delimiter))
+        {
+            ++p;
+        }
+        if (p == last)
+        {
+            return count;
+        }
+
+        const auto start = p;
+        if ((*p == '+') && (p + 1 != last) && (p[1] != '-'))
+        {
+            ++p;
+        }
+        if (count == values.size())
+        {
+            details::throwBadList(start, last, count, values.size());
+        }
+        const auto result = from_chars(p, last, values[count]);
+        if ((result.ec != std::errc()) ||
+            ((result.ptr != last) && !details::isListSeparator(*result.ptr, delimiter)))
+        {
+            details::throwBadList(start, last, count, values.size());
+        }
+        ++count;
+        p = result.ptr;
+    }
+}
+template <typename T>
+inline size_t toTypes(const std::string& s, coda_oss::span<T> values, char delimiter = ',')
+{
+    return toTypes(s.data(), s.data() + s.length(), values, delimiter);
+}
+}
+
+#endif  // CODA_OSS_str_CharConv_h_INCLUDED_
@@ -43,6 +43,7 @@
 #include "import/except.h"
 #include "gsl/gsl.h"
 #include "str/Encoding.h"
+#include "str/CharConv.h"
 
 namespace str
 {
@@ -68,42 +69,61 @@ inline std::string toString(const T& value)
     return toString_(value);
 }
 
+namespace details
+{
+template <typename T>
+inline std::string toString_chars(T value)
+{
+    char buffer[std::numeric_limits<T>::digits + 2];
+    const auto result = to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+}
+template <typename T>
+inline std::string toString_chars(T value, int precision)
+{
+    // Same as writing to a stream with precision(), without the stream
+    char buffer[128];
+    const auto result = to_chars(buffer, buffer + sizeof(buffer), value, precision);
+    return std::string(buffer, result.ptr);
+}
+}
+
 // https://en.cppreference.com/w/cpp/string/basic_string/to_string
 inline auto toString(int value)
 {
-    return toString_(value);
+    return details::toString_chars(value);
 }
 inline auto toString(long value)
 {
-    return toString_(value);
+    return details::toString_chars(value);
 }
 inline auto toString(long long value)
 {
-    return toString_(value);
+    return details::toString_chars(value);
 }
 inline auto toString(unsigned value)
 {
-    return toString_(value);
+    return details::toString_chars(value);
 }
 inline auto toString(unsigned long value)
 {
-    return toString_(value);
+    return details::toString_chars(value);
 }
 inline auto toString(unsigned long long value)
 {
-    return toString_(value);
+    return details::toString_chars(value);
 }
 inline auto toString(float value)
 {
-    return toString_(value);
+    return details::toString_chars(value, std::numeric_limits<float>::max_digits10);
 }
 inline auto toString(double value)
 {
-    return toString_(value);
+    return details::toString_chars(value, std::numeric_limits<double>::max_digits10);
 }
 inline auto toString(long double value)
 {
-    return toString_(value);
+    return details::toString_chars(value, std::numeric_limits<long double>::max_digits10);
 }
 
 inline std::string toString(uint8_t value)
@@ -168,6 +188,39 @@ inline std::string toString(const T& real, const T& imag)
     return toString(std::complex<T>(real, imag));
 }
 
+namespace details
+{
+// Parse without a stringstream when that gives the same result; the
+// stream also skips whitespace, accepts '+' and ignores trailing text.
+template <typename T>
+inline bool toType_(const std::string&, T&)
+{
+    return false;
+}
+template <typename T>
+inline bool fromChars_(const std::string& s, T& value)
+{
+    const auto last = s.data() + s.length();
+    const auto result = from_chars(s.data(), last, value);
+    return (result.ec == std::errc()) && (result.ptr == last);
+}
+inline bool toType_(const std::string& s, short& value) { return fromChars_(s, value); }
+inline bool toType_(const std::string& s, unsigned short& value) { return fromChars_(s, value); }
+inline bool toType_(const std::string& s, int& value) { return fromChars_(s, value); }
+inline bool toType_(const std::string& s, unsigned int& value) { return fromChars_(s, value); }
+inline bool toType_(const std::string& s, long& value) { return fromChars_(s, value); }
+inline bool toType_(const std::string& s, unsigned long& value) { return fromChars_(s, value); }
+inline bool toType_(const std::string& s, long long& value) { return fromChars_(s, value); }
+inline bool toType_(const std::string& s, unsigned long long& value) { return fromChars_(s, value); }
+inline bool isDecimal(const std::string& s) // streams don't read "inf" or "nan"
+{
+    const auto ch = s[(s[0] == '-') && (s.length() > 1) ? 1 : 0];
+    return ((ch >= '0') && (ch <= '9')) || (ch == '.');
+}
+inline bool toType_(const std::string& s, float& value) { return isDecimal(s) && fromChars_(s, value); }
+inline bool toType_(const std::string& s, double& value) { return isDecimal(s) && fromChars_(s, value); }
+}
+
 template <typename T>
 T toType(const std::string& s)
 {
@@ -180,6 +233,10 @@ T toType(const std::string& s)
                                 std::string("Empty string")));
 
     T value;
+    if (details::toType_(s, value))
+    {
+        return value;
+    }
 
     std::stringstream buf(s);
     buf.precision(str::getPrecision(value));
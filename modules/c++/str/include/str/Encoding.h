@@ -154,6 +154,15 @@ inline auto to_w1252string(const coda_oss::u8string& s)
     return to_w1252string(s.c_str(), s.length());
 }
 
+/************************************************************************/
+// Checks the whole sequence without converting it; runs of ASCII are
+// skipped several bytes at a time.
+CODA_OSS_API bool is_valid_utf8(coda_oss::u8string::const_pointer p, size_t sz);
+inline bool is_valid_utf8(const coda_oss::u8string& s)
+{
+    return is_valid_utf8(s.c_str(), s.length());
+}
+
 /************************************************************************/
 
 inline auto u8FromNative(const std::string& s)  // platform determines Windows-1252 or UTF-8 input
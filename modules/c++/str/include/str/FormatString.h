@@ -0,0 +1,363 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_str_FormatString_h_INCLUDED_
+#define CODA_OSS_str_FormatString_h_INCLUDED_
+
+#include <stddef.h>
+#include <string.h>
+
+#include <string>
+#include <type_traits>
+
+#include "config/Exports.h"
+#include "coda_oss/span.h"
+
+/*!
+ * \file FormatString.h
+ * \brief printf()-style formatting with the format string parsed once.
+ *
+ * str::Format() hands the format string to vsprintf() on every call and
+ * always returns a new std::string.  A FormatString is parsed when it's
+ * constructed; declared constexpr, that happens at compile time, and a
+ * conversion that doesn't match its argument's type (or the wrong number
+ * of conversions) is a compile error.  Formatting then copies the literal
+ * text and converts each argument directly, only calling snprintf() for
+ * conversions with flags or a width (and the less common floating-point
+ * ones); numbers are always written with '.' for the decimal point.
+ *
+ * example:
+ *     static constexpr str::FormatString<int> unsupported("Unsupported compression type: %d");
+ *     throw except::Exception(Ctxt(str::Format(unsupported, compression)));
+ *
+ * The argument's type, not a length modifier in the format, decides how
+ * it's converted; "%d", "%ld" and "%zu" are all fine for a size_t.  Each
+ * argument must have exactly one conversion; '*' widths, "%n" and
+ * positional arguments aren't supported.
+ */
+
+namespace str
+{
+namespace details
+{
+struct FormatLiteral final
+{
+    size_t begin;
+    size_t end;
+    bool hasEscapes;  // contains "%%"
+};
+
+struct FormatConversion final
+{
+    FormatLiteral prefix;  // the text before the conversion
+    size_t specBegin;  // just past the '%'
+    size_t specEnd;  // end of the flags, width and precision
+    bool hasFlagsOrWidth;
+    int precision;  // -1 if there isn't one
+    char conversion;  // 'd', 's', etc.; '\0' for the text after the last conversion
+};
+
+struct FormatArg final
+{
+    enum Kind { Signed, Unsigned, Double, String, Pointer } kind;
+    union
+    {
+        long long i;
+        unsigned long long u;
+        double d;
+        const void* p;
+    };
+    const char* s;
+    size_t length;  // of `s`
+    size_t size;  // sizeof() the original integer
+};
+
+template <typename T, typename = void>
+struct FormatTraits;  // not specialized: `T` can't be formatted
+
+template <typename T>
+struct FormatTraits<T, std::enable_if_t<std::is_integral<T>::value>> final
+{
+    static constexpr const char* conversions()
+    {
+        return "diouxXc";
+    }
+    static FormatArg toArg(T value)
+    {
+        FormatArg retval{};
+        retval.kind = std::is_signed<T>::value ? FormatArg::Signed : FormatArg::Unsigned;
+        if (std::is_signed<T>::value)
+            retval.i = static_cast<long long>(value);
+        else
+            retval.u = static_cast<unsigned long long>(value);
+        retval.size = sizeof(T);
+        return retval;
+    }
+};
+template <typename T>
+struct FormatTraits<T, std::enable_if_t<std::is_floating_point<T>::value>> final
+{
+    static constexpr const char* conversions()
+    {
+        return "fFeEgGaA";
+    }
+    static FormatArg toArg(T value)
+    {
+        FormatArg retval{};
+        retval.kind = FormatArg::Double;
+        retval.d = static_cast<double>(value);
+        return retval;
+    }
+};
+template <>
+struct FormatTraits<const char*> final
+{
+    static constexpr const char* conversions()
+    {
+        return "sp";
+    }
+    static FormatArg toArg(const char* value)
+    {
+        FormatArg retval{};
+        retval.kind = FormatArg::String;
+        retval.p = value;
+        retval.s = value == nullptr ? "(null)" : value;
+        retval.length = strlen(retval.s);
+        return retval;
+    }
+};
+template <>
+struct FormatTraits<char*> final
+{
+    static constexpr const char* conversions()
+    {
+        return FormatTraits<const char*>::conversions();
+    }
+    static FormatArg toArg(const char* value)
+    {
+        return FormatTraits<const char*>::toArg(value);
+    }
+};
+template <>
+struct FormatTraits<std::string> final
+{
+    static constexpr const char* conversions()
+    {
+        return "s";
+    }
+    static FormatArg toArg(const std::string& value)
+    {
+        FormatArg retval{};
+        retval.kind = FormatArg::String;
+        retval.s = value.c_str();
+        retval.length = value.length();
+        return retval;
+    }
+};
+template <typename T>
+struct FormatTraits<T*, std::enable_if_t<!std::is_same<std::remove_cv_t<T>, char>::value>> final
+{
+    static constexpr const char* conversions()
+    {
+        return "p";
+    }
+    static FormatArg toArg(const T* value)
+    {
+        FormatArg retval{};
+        retval.kind = FormatArg::Pointer;
+        retval.p = value;
+        return retval;
+    }
+};
+
+template <typename T>
+struct FormatArgType final
+{
+    using type = T;  // keeps the argument from being deduced; FormatString<> decides
+};
+template <typename T>
+using FormatArg_t = typename FormatArgType<T>::type;
+
+constexpr bool isFormatDigit(char ch)
+{
+    return (ch >= '0') && (ch <= '9');
+}
+constexpr bool contains(const char* s, char ch)
+{
+    for (; *s != '\0'; ++s)
+    {
+        if (*s == ch)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Not constexpr: when a FormatString is constexpr, calling this is a compile error.
+[[noreturn]] CODA_OSS_API void throwFormatError(const char* format, const char* what);
+
+CODA_OSS_API size_t formatTo(char* buffer, size_t size, const char* format,
+                             const FormatConversion*, const FormatArg*);
+CODA_OSS_API std::string format(const char* format, const FormatConversion*, const FormatArg*);
+CODA_OSS_API const std::string& formatLocal(const char* format, const FormatConversion*, const FormatArg*);
+}
+
+/*!
+ * \class FormatString
+ * \brief A printf()-style format string for arguments of types `TArgs`.
+ */
+template <typename... TArgs>
+class FormatString final
+{
+    static constexpr size_t numArgs = sizeof...(TArgs);
+    static constexpr size_t maxSpecLength = 32;
+
+    const char* mFormat;
+    details::FormatConversion mConversions[numArgs + 1];  // the last is just the trailing text
+
+public:
+    /*!
+     *  \param format A printf()-style format; it must outlive this object.
+     *  \throws except::InvalidFormatException if the conversions don't match
+     *  `TArgs`; for a constexpr object, that's a compile error instead.
+     */
+    constexpr explicit FormatString(const char* format) : mFormat(format), mConversions{}
+    {
+        const char* const allowed[] = { details::FormatTraits<std::decay_t<TArgs>>::conversions()..., "" };
+
+        details::FormatLiteral literal{ 0, 0, false };
+        size_t arg = 0;
+        size_t pos = 0;
+        while (format[pos] != '\0')
+        {
+            if (format[pos] != '%')
+            {
+                ++pos;
+                continue;
+            }
+            if (format[pos + 1] == '%')
+            {
+                literal.hasEscapes = true;
+                pos += 2;
+                continue;
+            }
+            if (arg == numArgs)
+            {
+                details::throwFormatError(format, "more conversions than arguments");
+            }
+
+            literal.end = pos++;
+            auto& conversion = mConversions[arg];
+            conversion.prefix = literal;
+            conversion.specBegin = pos;
+            while (details::contains("-+ #0", format[pos]))
+                ++pos;
+            while (details::isFormatDigit(format[pos]))
+                ++pos;
+            conversion.hasFlagsOrWidth = pos != conversion.specBegin;
+            conversion.precision = -1;
+            if (format[pos] == '.')
+            {
+                conversion.precision = 0;
+                for (++pos; details::isFormatDigit(format[pos]); ++pos)
+                {
+                    conversion.precision = conversion.precision * 10 + (format[pos] - '0');
+                }
+            }
+            conversion.specEnd = pos;
+            if ((conversion.specEnd - conversion.specBegin > maxSpecLength) || (conversion.precision > 999))
+            {
+                details::throwFormatError(format, "conversion is too long");
+            }
+            while (details::contains("hljztLq", format[pos]))
+                ++pos;
+            conversion.conversion = format[pos];
+            if (!details::contains(allowed[arg], conversion.conversion))
+            {
+                details::throwFormatError(format, "conversion doesn't match the argument's type");
+            }
+
+            ++pos;
+            ++arg;
+            literal = details::FormatLiteral{ pos, pos, false };
+        }
+        if (arg != numArgs)
+        {
+            details::throwFormatError(format, "fewer conversions than arguments");
+        }
+        literal.end = pos;
+        mConversions[numArgs].prefix = literal;
+    }
+
+    const char* c_str() const noexcept
+    {
+        return mFormat;
+    }
+    const details::FormatConversion* conversions() const noexcept
+    {
+        return mConversions;
+    }
+};
+
+/*!
+ *  Format into `buffer`, truncating (and always '\0'-terminating) as
+ *  snprintf() does.
+ *
+ *  \return the length of the complete result, not counting the '\0'
+ */
+template <typename... TArgs>
+inline size_t FormatTo(coda_oss::span<char> buffer, const FormatString<TArgs...>& format,
+                       const details::FormatArg_t<TArgs>&... args)
+{
+    const details::FormatArg formatArgs[] = { details::FormatTraits<std::decay_t<TArgs>>::toArg(args)..., details::FormatArg{} };
+    return details::formatTo(buffer.data(), buffer.size(), format.c_str(), format.conversions(), formatArgs);
+}
+
+/*!
+ *  Format into a new string; short results are built on the stack.
+ *  Existing str::Format() calls can switch over one at a time.
+ */
+template <typename... TArgs>
+inline std::string Format(const FormatString<TArgs...>& format, const details::FormatArg_t<TArgs>&... args)
+{
+    const details::FormatArg formatArgs[] = { details::FormatTraits<std::decay_t<TArgs>>::toArg(args)..., details::FormatArg{} };
+    return details::format(format.c_str(), format.conversions(), formatArgs);
+}
+
+/*!
+ *  Format into a string owned by the calling thread, which is reused (and
+ *  so doesn't allocate once it's big enough) by the next call.
+ *
+ *  \return the formatted text; valid until the next FormatLocal() on this thread
+ */
+template <typename... TArgs>
+inline const std::string& FormatLocal(const FormatString<TArgs...>& format, const details::FormatArg_t<TArgs>&... args)
+{
+    const details::FormatArg formatArgs[] = { details::FormatTraits<std::decay_t<TArgs>>::toArg(args)..., details::FormatArg{} };
+    return details::formatLocal(format.c_str(), format.conversions(), formatArgs);
+}
+}
+
+#endif  // CODA_OSS_str_FormatString_h_INCLUDED_
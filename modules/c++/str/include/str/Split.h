@@ -0,0 +1,186 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_str_Split_h_INCLUDED_
+#define CODA_OSS_str_Split_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <iterator>
+#include <string>
+
+#include "config/Exports.h"
+#include "coda_oss/span.h"
+
+/*!
+ * \file Split.h
+ * \brief Splitting without copying.
+ *
+ * str::split() and str::Tokenizer return a std::vector<std::string>,
+ * copying every token.  SplitView and TokenView find the tokens lazily as
+ * they're iterated and return views into the original text, which must
+ * outlive them.
+ *
+ * example:
+ *     for (auto&& token : str::SplitView(line, ","))
+ *         values.push_back(str::toType<double>(std::string(token.data(), token.size())));
+ */
+
+namespace str
+{
+/*!
+ *  Searches [first, last) for `ch`, `delimiter`, or any one of
+ *  `delimiters`; these all return `last` if nothing is found.  find() is
+ *  built on memchr(); findFirstOf() compares 16 bytes at a time with SSE2
+ *  when there are only a few delimiters.
+ */
+CODA_OSS_API const char* find(const char* first, const char* last, char ch);
+CODA_OSS_API const char* find(const char* first, const char* last, const char* delimiter, size_t length);
+CODA_OSS_API const char* findFirstOf(const char* first, const char* last, const char* delimiters, size_t numDelimiters);
+
+namespace details
+{
+struct CODA_OSS_API Delimiter final
+{
+    std::string chars;
+    bool isSet;  // any one of `chars`, otherwise all of `chars`
+    bool skipEmpty;
+
+    const char* find(const char* first, const char* last) const;
+    size_t length() const
+    {
+        return isSet ? 1 : chars.length();
+    }
+};
+
+class CODA_OSS_API TokenIterator final
+{
+    const Delimiter* mDelimiter = nullptr;
+    const char* mNext = nullptr;  // start of the next token; nullptr after the last one
+    const char* mLast = nullptr;
+    coda_oss::span<const char> mToken;
+    bool mDone = true;
+
+    void next();
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = coda_oss::span<const char>;
+    using difference_type = ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    TokenIterator() = default;  // end
+    TokenIterator(const Delimiter&, const char* first, const char* last);
+
+    reference operator*() const
+    {
+        return mToken;
+    }
+    pointer operator->() const
+    {
+        return &mToken;
+    }
+    TokenIterator& operator++()
+    {
+        next();
+        return *this;
+    }
+    TokenIterator operator++(int)
+    {
+        auto retval = *this;
+        next();
+        return retval;
+    }
+
+    bool operator==(const TokenIterator& rhs) const
+    {
+        return (mDone && rhs.mDone) || ((mDone == rhs.mDone) && (mToken.data() == rhs.mToken.data()));
+    }
+    bool operator!=(const TokenIterator& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+class CODA_OSS_API TokenRange
+{
+    const char* mFirst;
+    const char* mLast;
+    Delimiter mDelimiter;
+
+protected:
+    TokenRange(const char* first, const char* last, Delimiter&&);
+
+public:
+    using iterator = TokenIterator;
+    using const_iterator = TokenIterator;
+
+    iterator begin() const
+    {
+        return iterator(mDelimiter, mFirst, mLast);
+    }
+    iterator end() const
+    {
+        return iterator();
+    }
+};
+}
+
+/*!
+ * \class SplitView
+ * \brief Tokens separated by a delimiter string of any length.
+ *
+ * By default empty tokens are skipped, as str::split() does; set
+ * `skipEmpty` to false for CSV-style fields, where "a,,b" has three.
+ */
+class CODA_OSS_API SplitView final : public details::TokenRange
+{
+public:
+    SplitView(const char* first, const char* last, const std::string& delimiter = " ", bool skipEmpty = true);
+    explicit SplitView(const std::string& s, const std::string& delimiter = " ", bool skipEmpty = true) :
+        SplitView(s.data(), s.data() + s.length(), delimiter, skipEmpty)
+    {
+    }
+    SplitView(const std::string&&, const std::string& = " ", bool = true) = delete;  // would dangle
+};
+
+/*!
+ * \class TokenView
+ * \brief Tokens separated by runs of any of a set of characters, as
+ * str::Tokenizer does.
+ */
+class CODA_OSS_API TokenView final : public details::TokenRange
+{
+public:
+    TokenView(const char* first, const char* last, const std::string& delimiters = " \t\r\n");
+    explicit TokenView(const std::string& s, const std::string& delimiters = " \t\r\n") :
+        TokenView(s.data(), s.data() + s.length(), delimiters)
+    {
+    }
+    TokenView(const std::string&&, const std::string& = " \t\r\n") = delete;  // would dangle
+};
+}
+
+#endif  // CODA_OSS_str_Split_h_INCLUDED_
@@ -0,0 +1,373 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "str/CharConv.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <locale>
+#include <sstream>
+#include <string>
+
+#include "except/Exception.h"
+
+namespace
+{
+inline bool isDigit(char ch)
+{
+    return (ch >= '0') && (ch <= '9');
+}
+
+// Case-insensitive match of the lowercase `word` at the start of [p, last)
+bool startsWith(const char* p, const char* last, const char* word)
+{
+    for (; *word != '\0'; ++p, ++word)
+    {
+        if ((p == last) || ((*p | 0x20) != *word))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Exactly representable powers of ten; see "How to Read Floating Point
+// Numbers Accurately" (Clinger, 1990).
+const double doublePowersOf10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+const float floatPowersOf10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+// The exact value is mantissa * 10^exponent; these succeed only when one
+// correctly rounded multiply or divide gives the correctly rounded result.
+bool fastPath(uint64_t mantissa, int exponent, double& value)
+{
+    constexpr uint64_t maxMantissa = uint64_t(1) << 53;
+    if (mantissa > maxMantissa)
+    {
+        return false;
+    }
+    if ((exponent < -22) || (exponent > 22 + 15))
+    {
+        return false;
+    }
+    if (exponent > 22)
+    {
+        // 123e30 is 123000000000000000e15; fine if that still fits.
+        for (; exponent > 22; --exponent)
+        {
+            mantissa *= 10;
+            if (mantissa > maxMantissa)
+            {
+                return false;
+            }
+        }
+    }
+    value = static_cast<double>(mantissa);
+    value = exponent < 0 ? value / doublePowersOf10[-exponent] : value * doublePowersOf10[exponent];
+    return true;
+}
+bool fastPath(uint64_t mantissa, int exponent, float& value)
+{
+    if ((mantissa > (uint64_t(1) << 24)) || (exponent < -10) || (exponent > 10))
+    {
+        return false;
+    }
+    value = static_cast<float>(mantissa);
+    value = exponent < 0 ? value / floatPowersOf10[-exponent] : value * floatPowersOf10[exponent];
+    return true;
+}
+
+template <typename T>
+str::from_chars_result from_chars_(const char* first, const char* last, T& value)
+{
+    auto p = first;
+    const bool negative = (p != last) && (*p == '-');
+    if (negative)
+    {
+        ++p;
+    }
+    if ((p != last) && !isDigit(*p) && (*p != '.'))
+    {
+        if (startsWith(p, last, "inf"))
+        {
+            value = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+            return { startsWith(p, last, "infinity") ? p + 8 : p + 3, std::errc() };
+        }
+        if (startsWith(p, last, "nan"))
+        {
+            p += 3;
+            if ((p != last) && (*p == '('))
+            {
+                auto close = p + 1;
+                while ((close != last) && ((*close == '_') || isDigit(*close) || (((*close | 0x20) >= 'a') && ((*close | 0x20) <= 'z'))))
+                {
+                    ++close;
+                }
+                if ((close != last) && (*close == ')'))
+                {
+                    p = close + 1;
+                }
+            }
+            value = negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+            return { p, std::errc() };
+        }
+        return { first, std::errc::invalid_argument };
+    }
+
+    // Keep up to 19 significant digits; that always fits in a uint64_t.
+    uint64_t mantissa = 0;
+    int numDigits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool sawDigit = false;
+    const auto addDigit = [&](char ch, bool fraction)
+    {
+        sawDigit = true;
+        if ((mantissa == 0) && (ch == '0'))
+        {
+            exponent -= fraction ? 1 : 0;  // leading zero
+        }
+        else if (numDigits < 19)
+        {
+            mantissa = mantissa * 10 + (ch - '0');
+            numDigits++;
+            exponent -= fraction ? 1 : 0;
+        }
+        else
+        {
+            exponent += fraction ? 0 : 1;
+            truncated = truncated || (ch != '0');
+        }
+    };
+    for (; (p != last) && isDigit(*p); ++p)
+    {
+        addDigit(*p, false /*fraction*/);
+    }
+    if ((p != last) && (*p == '.'))
+    {
+        for (++p; (p != last) && isDigit(*p); ++p)
+        {
+            addDigit(*p, true /*fraction*/);
+        }
+    }
+    if (!sawDigit)
+    {
+        return { first, std::errc::invalid_argument };
+    }
+
+    if ((p != last) && ((*p == 'e') || (*p == 'E')))
+    {
+        auto q = p + 1;
+        const bool negativeExponent = (q != last) && (*q == '-');
+        if ((q != last) && ((*q == '-') || (*q == '+')))
+        {
+            ++q;
+        }
+        if ((q != last) && isDigit(*q))
+        {
+            int e = 0;
+            for (; (q != last) && isDigit(*q); ++q)
+            {
+                e = e < 100000 ? e * 10 + (*q - '0') : e;  // beyond any range; don't overflow
+            }
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    T result;
+    if ((mantissa == 0) && !truncated)
+    {
+        result = 0;
+    }
+    else if (truncated || !fastPath(mantissa, exponent, result))
+    {
+        // Rare enough that an allocation doesn't matter; the classic
+        // locale parses with strtod() in the "C" locale.
+        std::istringstream is(std::string(first, p));
+        is.imbue(std::locale::classic());
+        is >> result;
+        if (is.fail())
+        {
+            return { p, std::errc::result_out_of_range };
+        }
+        value = result;
+        return { p, std::errc() };
+    }
+    value = negative ? -result : result;
+    return { p, std::errc() };
+}
+
+// strtod() and printf() both use LC_NUMERIC, so they agree with each
+// other whatever the locale; only the output needs fixing.
+void useDecimalPoint(char* first, char* last)
+{
+    for (; first != last; ++first)
+    {
+        const auto ch = *first;
+        if (!isDigit(ch) && (ch != '-') && (ch != '+') && (ch != 'e'))
+        {
+            *first = '.';
+        }
+    }
+}
+
+str::to_chars_result copy(char* first, char* last, const char* s, size_t length)
+{
+    if (static_cast<size_t>(last - first) < length)
+    {
+        return { last, std::errc::value_too_large };
+    }
+    memcpy(first, s, length);
+    return { first + length, std::errc() };
+}
+
+template <typename T>
+bool nonFinite(char* first, char* last, T value, str::to_chars_result& result)
+{
+    if (std::isnan(value))
+    {
+        result = std::signbit(value) ? copy(first, last, "-nan", 4) : copy(first, last, "nan", 3);
+        return true;
+    }
+    if (std::isinf(value))
+    {
+        result = value < 0 ? copy(first, last, "-inf", 4) : copy(first, last, "inf", 3);
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+str::to_chars_result to_chars_(char* first, char* last, T value, int precision)
+{
+    str::to_chars_result result;
+    if (nonFinite(first, last, value, result))
+    {
+        return result;
+    }
+
+    char buffer[64];
+    const auto length = snprintf(buffer, sizeof(buffer), "%.*g", precision, static_cast<double>(value));
+    assert((length > 0) && (static_cast<size_t>(length) < sizeof(buffer)));
+    useDecimalPoint(buffer, buffer + length);
+    return copy(first, last, buffer, length);
+}
+
+inline bool roundTrips(const char* s, double value)
+{
+    return strtod(s, nullptr) == value;
+}
+inline bool roundTrips(const char* s, float value)
+{
+    return strtof(s, nullptr) == value;
+}
+
+template <typename T>
+str::to_chars_result to_chars_(char* first, char* last, T value)
+{
+    str::to_chars_result result;
+    if (nonFinite(first, last, value, result))
+    {
+        return result;
+    }
+
+    // "%g" drops trailing zeros, so a value like 0.1 that's exact to
+    // digits10 digits comes out short.
+    char buffer[64];
+    int length = 0;
+    for (int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10; ++precision)
+    {
+        length = snprintf(buffer, sizeof(buffer), "%.*g", precision, static_cast<double>(value));
+        assert((length > 0) && (static_cast<size_t>(length) < sizeof(buffer)));
+        if (roundTrips(buffer, value))
+        {
+            break;
+        }
+    }
+    useDecimalPoint(buffer, buffer + length);
+    return copy(first, last, buffer, length);
+}
+}
+
+str::from_chars_result str::from_chars(const char* first, const char* last, float& value)
+{
+    return from_chars_(first, last, value);
+}
+str::from_chars_result str::from_chars(const char* first, const char* last, double& value)
+{
+    return from_chars_(first, last, value);
+}
+
+str::to_chars_result str::to_chars(char* first, char* last, float value)
+{
+    return to_chars_(first, last, value);
+}
+str::to_chars_result str::to_chars(char* first, char* last, double value)
+{
+    return to_chars_(first, last, value);
+}
+str::to_chars_result str::to_chars(char* first, char* last, float value, int precision)
+{
+    return to_chars_(first, last, value, precision);
+}
+str::to_chars_result str::to_chars(char* first, char* last, double value, int precision)
+{
+    return to_chars_(first, last, value, precision);
+}
+str::to_chars_result str::to_chars(char* first, char* last, long double value, int precision)
+{
+    to_chars_result result;
+    if (nonFinite(first, last, value, result))
+    {
+        return result;
+    }
+
+    char buffer[128];
+    const auto length = snprintf(buffer, sizeof(buffer), "%.*Lg", precision, value);
+    assert((length > 0) && (static_cast<size_t>(length) < sizeof(buffer)));
+    useDecimalPoint(buffer, buffer + length);
+    return copy(first, last, buffer, length);
+}
+
+void str::details::throwBadList(const char* first, const char* last, size_t index, size_t size)
+{
+    auto end = first;
+    while ((end != last) && (end - first < 32) && (*end != ',') && (*end != ' '))
+    {
+        ++end;
+    }
+    const std::string token(first, end);
+    if (index == size)
+    {
+        throw except::BadCastException(except::Context(__FILE__, __LINE__, "", "",
+                "More than " + std::to_string(size) + " values, at '" + token + "'"));
+    }
+    throw except::BadCastException(except::Context(__FILE__, __LINE__, "", "",
+            "Conversion failed for value " + std::to_string(index) + ": '" + token + "'"));
+}
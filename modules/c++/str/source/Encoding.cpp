@@ -48,6 +48,190 @@ CODA_OSS_disable_warning(-Wshadow)
 #include "str/utf8.h"
 CODA_OSS_disable_warning_pop
 
+// Runs of ASCII are the same in every encoding here, so they're found
+// and copied a vector at a time.  str is below sys, so the
+// CODA_OSS_DISABLE_SIMD/CODA_OSS_ENABLE_SIMD checks from
+// sys/AbstractOS.h are repeated here.
+#if !defined(CODA_OSS_DISABLE_SIMD) && (!defined(CODA_OSS_ENABLE_SIMD) || CODA_OSS_ENABLE_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64)
+        #define CODA_OSS_str_Encoding_SSE2 1
+        #include <emmintrin.h>
+    #endif
+    #if defined(__AVX2__)
+        #define CODA_OSS_str_Encoding_AVX2 1
+        #include <immintrin.h>
+    #endif
+#endif
+
+static inline const uint8_t* as_bytes(const void* p)
+{
+    return static_cast<const uint8_t*>(p);
+}
+
+// Number of leading values < 0x80
+static size_t ascii_length(const uint8_t* p, size_t sz)
+{
+    size_t i = 0;
+    #ifdef CODA_OSS_str_Encoding_AVX2
+    for (; i + 32 <= sz; i += 32)
+    {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        if (_mm256_movemask_epi8(v) != 0)
+        {
+            break;
+        }
+    }
+    #endif
+    #ifdef CODA_OSS_str_Encoding_SSE2
+    for (; i + 16 <= sz; i += 16)
+    {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        if (_mm_movemask_epi8(v) != 0)
+        {
+            break;
+        }
+    }
+    #endif
+    while ((i < sz) && (p[i] < 0x80))
+    {
+        i++;
+    }
+    return i;
+}
+static size_t ascii_length(const char16_t* p, size_t sz)
+{
+    size_t i = 0;
+    #ifdef CODA_OSS_str_Encoding_SSE2
+    const auto mask = _mm_set1_epi16(static_cast<short>(0xff80));
+    for (; i + 8 <= sz; i += 8)
+    {
+        const auto v = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(v, _mm_setzero_si128())) != 0xffff)
+        {
+            break;
+        }
+    }
+    #endif
+    while ((i < sz) && (p[i] < 0x80))
+    {
+        i++;
+    }
+    return i;
+}
+static size_t ascii_length(const char32_t* p, size_t sz)
+{
+    size_t i = 0;
+    #ifdef CODA_OSS_str_Encoding_SSE2
+    const auto mask = _mm_set1_epi32(static_cast<int>(0xffffff80));
+    for (; i + 4 <= sz; i += 4)
+    {
+        const auto v = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_setzero_si128())) != 0xffff)
+        {
+            break;
+        }
+    }
+    #endif
+    while ((i < sz) && (p[i] < 0x80))
+    {
+        i++;
+    }
+    return i;
+}
+
+// Copy `sz` ASCII values, which ascii_length() has already checked.
+static void copy_ascii(const uint8_t* p, size_t sz, void* out)
+{
+    memcpy(out, p, sz);
+}
+static void copy_ascii(const uint8_t* p, size_t sz, char16_t* out)
+{
+    size_t i = 0;
+    #ifdef CODA_OSS_str_Encoding_SSE2
+    const auto zero = _mm_setzero_si128();
+    for (; i + 16 <= sz; i += 16)
+    {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+    #endif
+    for (; i < sz; i++)
+    {
+        out[i] = static_cast<char16_t>(p[i]);
+    }
+}
+static void copy_ascii(const uint8_t* p, size_t sz, char32_t* out)
+{
+    size_t i = 0;
+    #ifdef CODA_OSS_str_Encoding_SSE2
+    const auto zero = _mm_setzero_si128();
+    for (; i + 16 <= sz; i += 16)
+    {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const auto lo = _mm_unpacklo_epi8(v, zero);
+        const auto hi = _mm_unpackhi_epi8(v, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+    #endif
+    for (; i < sz; i++)
+    {
+        out[i] = static_cast<char32_t>(p[i]);
+    }
+}
+static void copy_ascii(const char16_t* p, size_t sz, void* out_)
+{
+    auto out = static_cast<uint8_t*>(out_);
+    size_t i = 0;
+    #ifdef CODA_OSS_str_Encoding_SSE2
+    for (; i + 16 <= sz; i += 16)
+    {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+    }
+    #endif
+    for (; i < sz; i++)
+    {
+        out[i] = static_cast<uint8_t>(p[i]);
+    }
+}
+static void copy_ascii(const char32_t* p, size_t sz, void* out_)
+{
+    auto out = static_cast<uint8_t*>(out_);
+    size_t i = 0;
+    #ifdef CODA_OSS_str_Encoding_SSE2
+    for (; i + 16 <= sz; i += 16)
+    {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 4));
+        const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 8));
+        const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 12));
+        const auto ab = _mm_packs_epi32(a, b);
+        const auto cd = _mm_packs_epi32(c, d);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(ab, cd));
+    }
+    #endif
+    for (; i < sz; i++)
+    {
+        out[i] = static_cast<uint8_t>(p[i]);
+    }
+}
+
+template <typename TChar, typename TSource>
+static inline void append_ascii(std::basic_string<TChar>& result, const TSource* p, size_t sz)
+{
+    if (sz > 0)
+    {
+        const auto size = result.size();
+        result.resize(size + sz);
+        copy_ascii(p, sz, &result[size]);
+    }
+}
+
 // Need to look up characters from \x80 (EURO SIGN) to \x9F (LATIN CAPITAL LETTER Y WITH DIAERESIS)
 // in a map: http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1252.TXT
 static inline coda_oss::u8string utf8_(char32_t i)
@@ -202,12 +386,18 @@ public:
     {
         static const auto& lookup = getLookup();
 
+        const auto bytes = as_bytes(p);
         std::basic_string<TChar> retval;
-        for (size_t i = 0; i < sz; i++)
+        retval.reserve(sz);
+        for (size_t i = 0; i < sz;)
         {
-            const auto ch = gsl::narrow<ptrdiff_t>(p[i]);
-            retval += lookup[ch];
-        }    
+            const auto ascii = ascii_length(bytes + i, sz - i);
+            append_ascii(retval, bytes + i, ascii);
+            for (i += ascii; (i < sz) && (bytes[i] >= 0x80); i++)
+            {
+                retval += lookup[bytes[i]];
+            }
+        }
         return retval;
     }
 };
@@ -329,10 +519,15 @@ public:
         static const auto map = make_u16_map();
 
         std::basic_string<TChar> retval;
-        for (size_t i = 0; i < sz; i++)
+        retval.reserve(sz);
+        for (size_t i = 0; i < sz;)
         {
-            const auto utf16 = p[i];
-            utf_to_1252(map, utf16, retval);
+            const auto ascii = ascii_length(p + i, sz - i);
+            append_ascii(retval, p + i, ascii);
+            for (i += ascii; (i < sz) && (p[i] >= 0x80); i++)
+            {
+                utf_to_1252(map, p[i], retval);
+            }
         }
         return retval;
     }
@@ -341,13 +536,20 @@ public:
     {
         static const auto map = make_utf8_map();
 
+        const auto bytes = as_bytes(p);
         std::basic_string<TChar> retval;
-        for (size_t i = 0; i < sz; i++)
+        retval.reserve(sz);
+        for (size_t i = 0; i < sz;)
         {
-            auto utf8 = coda_oss::u8string{p[i]};
-            get_utf8_string(p, sz, i, utf8);
+            const auto ascii = ascii_length(bytes + i, sz - i);
+            append_ascii(retval, bytes + i, ascii);
+            for (i += ascii; (i < sz) && (bytes[i] >= 0x80); i++)
+            {
+                auto utf8 = coda_oss::u8string{p[i]};
+                get_utf8_string(p, sz, i, utf8);
 
-            utf_to_1252(map, utf8, retval);
+                utf_to_1252(map, utf8, retval);
+            }
         }
         return retval;
     }
@@ -380,6 +582,102 @@ struct back_inserter final
     back_inserter operator++(int) noexcept { return *this; }
 };
 
+inline auto utf8_inserter(coda_oss::u8string& s)
+{
+    return back_inserter(s);
+}
+inline auto utf8_inserter(std::string& s)
+{
+    return std::back_inserter(s);
+}
+
+inline void append_code_point(uint32_t cp, std::u16string& result)
+{
+    if (cp > 0xffff)
+    {
+        // make a surrogate pair, as utf8::utf8to16() does
+        result.push_back(static_cast<char16_t>((cp >> 10) + utf8::impl::LEAD_OFFSET));
+        result.push_back(static_cast<char16_t>((cp & 0x3ff) + utf8::impl::TRAIL_SURROGATE_MIN));
+    }
+    else
+    {
+        result.push_back(static_cast<char16_t>(cp));
+    }
+}
+inline void append_code_point(uint32_t cp, std::u32string& result)
+{
+    result.push_back(static_cast<char32_t>(cp));
+}
+
+// UTF-8 to UTF-16 or UTF-32; multi-byte sequences never contain ASCII, so
+// everything between ASCII runs goes to utf8::next().  Decoding against
+// the real end of the input reports errors exactly as utf8::utf8to16() does.
+template <typename TChar>
+static void utf8_to_utfXX(const uint8_t* p, size_t sz, std::basic_string<TChar>& result)
+{
+    result.reserve(sz);
+    const auto end = p + sz;
+    while (p != end)
+    {
+        const auto ascii = ascii_length(p, end - p);
+        append_ascii(result, p, ascii);
+        p += ascii;
+        while ((p != end) && (*p >= 0x80))
+        {
+            append_code_point(utf8::next(p, end), result);
+        }
+    }
+}
+
+// A lead surrogate at the end of a run is paired with whatever follows.
+inline void keep_surrogate_pair(const char16_t*& run, const char16_t* end)
+{
+    if ((run != end) && utf8::impl::is_lead_surrogate(*(run - 1)))
+    {
+        ++run;
+    }
+}
+inline void keep_surrogate_pair(const char32_t*&, const char32_t*)
+{
+}
+
+template <typename TOut>
+inline void utfXX_to_utf8_(const char16_t* begin, const char16_t* end, TOut out)
+{
+    utf8::utf16to8(begin, end, out);
+}
+template <typename TOut>
+inline void utfXX_to_utf8_(const char32_t* begin, const char32_t* end, TOut out)
+{
+    utf8::utf32to8(begin, end, out);
+}
+
+template <typename TChar, typename TString>
+static void utfXX_to_utf8(const TChar* p, size_t sz, TString& result)
+{
+    result.reserve(sz);
+    const auto end = p + sz;
+    while (p != end)
+    {
+        const auto ascii = ascii_length(p, end - p);
+        append_ascii(result, p, ascii);
+        p += ascii;
+        if (p == end)
+        {
+            break;
+        }
+
+        auto run = p;
+        while ((run != end) && (*run >= 0x80))
+        {
+            ++run;
+        }
+        keep_surrogate_pair(run, end);
+        utfXX_to_utf8_(p, run, utf8_inserter(result));
+        p = run;
+    }
+}
+
 template <typename TBasicStringT, typename CharT>
 inline auto to_uXXstring(const std::basic_string<CharT>& s)
 {
@@ -450,7 +748,7 @@ std::string str::details::to_string(const std::wstring& s)
     #if _WIN32
     utf16to1252(p, sz, retval); // UTF16 -> Windows-1252 on Windows.
     #else
-    utf8::utf32to8(p, p + sz, std::back_inserter(retval)); // UTF32 -> UTF-8 everywhere else.
+    utfXX_to_utf8(p, sz, retval); // UTF32 -> UTF-8 everywhere else.
     #endif   
     return retval;
 }
@@ -497,30 +795,28 @@ str::W1252string str::to_w1252string(coda_oss::u8string::const_pointer p, size_t
 coda_oss::u8string str::to_u8string(std::u16string::const_pointer p, size_t sz)
 {
     coda_oss::u8string retval;
-    utf8::utf16to8(p, p + sz, back_inserter(retval));
+    utfXX_to_utf8(p, sz, retval);
     return retval;
 }
 
-std::u16string str::to_u16string(coda_oss::u8string::const_pointer p_, size_t sz)
+std::u16string str::to_u16string(coda_oss::u8string::const_pointer p, size_t sz)
 {
-    auto p = details::cast<std::string::const_pointer>(p_);
     std::u16string retval;
-    utf8::utf8to16(p, p + sz, std::back_inserter(retval));
+    utf8_to_utfXX(as_bytes(p), sz, retval);
     return retval;
 }
 
-std::u32string str::to_u32string(coda_oss::u8string::const_pointer p_, size_t sz)
+std::u32string str::to_u32string(coda_oss::u8string::const_pointer p, size_t sz)
 {
-    auto p = details::cast<std::string::const_pointer>(p_);
     std::u32string retval;
-    utf8::utf8to32(p, p + sz, std::back_inserter(retval));
+    utf8_to_utfXX(as_bytes(p), sz, retval);
     return retval;
 }
 
 coda_oss::u8string str::to_u8string(std::u32string::const_pointer p, size_t sz)
 {
     coda_oss::u8string retval;
-    utf8::utf32to8(p, p + sz, back_inserter(retval));
+    utfXX_to_utf8(p, sz, retval);
     return retval;
 }
 
@@ -530,3 +826,21 @@ coda_oss::u8string str::to_u8string(W1252string::const_pointer p, size_t sz)
     w1252_to_basic_string(p, sz, retval);
     return retval;
 }
+
+bool str::is_valid_utf8(coda_oss::u8string::const_pointer p_, size_t sz)
+{
+    auto p = as_bytes(p_);
+    const auto end = p + sz;
+    while (p != end)
+    {
+        p += ascii_length(p, end - p);
+        while ((p != end) && (*p >= 0x80))
+        {
+            if (utf8::impl::validate_next(p, end) != utf8::impl::UTF8_OK)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
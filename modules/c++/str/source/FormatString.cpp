@@ -0,0 +1,301 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "str/FormatString.h"
+
+#include <stdio.h>
+
+#include <cmath>
+
+#include <algorithm>
+#include <vector>
+
+#include "except/Exception.h"
+#include "str/CharConv.h"
+
+namespace
+{
+// Like snprintf(), copies what fits and counts everything.
+class Writer final
+{
+    char* mNext;
+    char* mLast;  // leaves room for the '\0'
+    const bool mTerminate;
+    size_t mLength = 0;
+
+public:
+    Writer(char* buffer, size_t size) :
+        mNext(buffer), mLast(size == 0 ? buffer : buffer + size - 1), mTerminate(size > 0)
+    {
+    }
+    ~Writer() = default;
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    void append(const char* s, size_t n)
+    {
+        const auto count = std::min(n, static_cast<size_t>(mLast - mNext));
+        if (count > 0)
+        {
+            memcpy(mNext, s, count);
+        }
+        mNext += count;
+        mLength += n;
+    }
+    void append(char ch)
+    {
+        append(&ch, 1);
+    }
+
+    size_t finish()
+    {
+        if (mTerminate)
+        {
+            *mNext = '\0';
+        }
+        return mLength;
+    }
+};
+
+void appendLiteral(Writer& writer, const char* format, const str::details::FormatLiteral& literal)
+{
+    const char* first = format + literal.begin;
+    const char* const last = format + literal.end;
+    if (literal.hasEscapes)
+    {
+        // "%%" -> "%"
+        for (auto percent = std::find(first, last, '%'); percent != last; percent = std::find(first, last, '%'))
+        {
+            writer.append(first, percent + 1 - first);
+            first = percent + 2;
+        }
+    }
+    writer.append(first, last - first);
+}
+
+template <typename T>
+void appendInteger(Writer& writer, T value, int base, bool upperCase)
+{
+    char buffer[64];
+    const auto result = str::to_chars(buffer, buffer + sizeof(buffer), value, base);
+    if (upperCase)
+    {
+        std::transform(buffer, result.ptr, buffer,
+                       [](char ch) { return (ch >= 'a') && (ch <= 'f') ? static_cast<char>(ch - 'a' + 'A') : ch; });
+    }
+    writer.append(buffer, result.ptr - buffer);
+}
+
+// "%.*f" without snprintf() when the result can be computed exactly
+bool appendFixed(Writer& writer, double value, int precision)
+{
+    static const double powersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    if (!std::isfinite(value) || (precision < 0) || (precision > 9))
+    {
+        return false;
+    }
+
+    // Below 2^40, the product is off by at most 2^-12; leave anything near
+    // a tie to snprintf(), which rounds the exact binary value.
+    const auto scaled = std::fabs(value) * powersOf10[precision];
+    if (scaled >= 1099511627776.0)
+    {
+        return false;
+    }
+    const auto whole = std::floor(scaled);
+    const auto fraction = scaled - whole;
+    if (std::fabs(fraction - 0.5) < 1e-3)
+    {
+        return false;
+    }
+    auto digits = static_cast<unsigned long long>(whole) + (fraction > 0.5 ? 1 : 0);
+
+    char buffer[32];
+    char* first = buffer + sizeof(buffer);
+    for (int ii = 0; ii < precision; ++ii)
+    {
+        *--first = static_cast<char>('0' + digits % 10);
+        digits /= 10;
+    }
+    if (precision > 0)
+    {
+        *--first = '.';
+    }
+    do
+    {
+        *--first = static_cast<char>('0' + digits % 10);
+        digits /= 10;
+    } while (digits != 0);
+    if (std::signbit(value))
+    {
+        *--first = '-';
+    }
+    writer.append(first, buffer + sizeof(buffer) - first);
+    return true;
+}
+
+template <typename T>
+void appendPrintf(Writer& writer, const char* spec, T value)
+{
+    char buffer[128];
+    const auto length = snprintf(buffer, sizeof(buffer), spec, value);
+    if (length < 0)
+    {
+        throw except::InvalidFormatException(except::Context(__FILE__, __LINE__, "", "", spec));
+    }
+    if (static_cast<size_t>(length) < sizeof(buffer))
+    {
+        writer.append(buffer, length);
+        return;
+    }
+    std::vector<char> bigBuffer(length + 1);
+    snprintf(bigBuffer.data(), bigBuffer.size(), spec, value);
+    writer.append(bigBuffer.data(), length);
+}
+
+void appendConversion(Writer& writer, const char* format, const str::details::FormatConversion& conversion,
+                      str::details::FormatArg arg)
+{
+    using str::details::FormatArg;
+
+    const auto ch = conversion.conversion;
+    if ((arg.kind == FormatArg::Signed) && (ch != 'd') && (ch != 'i') && (ch != 'c'))
+    {
+        // as printf() would: -1 is "ffffffff" for an int
+        const auto bits = arg.size * 8;
+        arg.kind = FormatArg::Unsigned;
+        const auto value = static_cast<unsigned long long>(arg.i);
+        arg.u = bits < 64 ? value & ((1ull << bits) - 1) : value;
+    }
+
+    if (conversion.specBegin == conversion.specEnd)  // no flags, width or precision
+    {
+        switch (arg.kind)
+        {
+        case FormatArg::Signed:
+            if (ch == 'c')
+                writer.append(static_cast<char>(arg.i));
+            else
+                appendInteger(writer, arg.i, 10, false);
+            return;
+        case FormatArg::Unsigned:
+            if (ch == 'c')
+                writer.append(static_cast<char>(arg.u));
+            else
+                appendInteger(writer, arg.u, ch == 'o' ? 8 : (ch == 'x') || (ch == 'X') ? 16 : 10, ch == 'X');
+            return;
+        case FormatArg::String:
+            if (ch == 's')
+            {
+                writer.append(arg.s, arg.length);
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    if ((arg.kind == FormatArg::Double) && ((ch == 'f') || (ch == 'F')) && !conversion.hasFlagsOrWidth)
+    {
+        if (appendFixed(writer, arg.d, conversion.precision < 0 ? 6 : conversion.precision))
+        {
+            return;
+        }
+    }
+
+    // Rebuild the conversion with the length modifier for the argument's type.
+    char spec[64] = "%";
+    const auto specLength = conversion.specEnd - conversion.specBegin;
+    memcpy(spec + 1, format + conversion.specBegin, specLength);
+    char* modifier = spec + 1 + specLength;
+    if (((arg.kind == FormatArg::Signed) || (arg.kind == FormatArg::Unsigned)) && (ch != 'c'))
+    {
+        *modifier++ = 'l';
+        *modifier++ = 'l';
+    }
+    modifier[0] = ch;
+    modifier[1] = '\0';
+
+    switch (arg.kind)
+    {
+    case FormatArg::Signed:
+        return ch == 'c' ? appendPrintf(writer, spec, static_cast<int>(arg.i)) : appendPrintf(writer, spec, arg.i);
+    case FormatArg::Unsigned:
+        return ch == 'c' ? appendPrintf(writer, spec, static_cast<int>(arg.u)) : appendPrintf(writer, spec, arg.u);
+    case FormatArg::Double:
+        return appendPrintf(writer, spec, arg.d);
+    case FormatArg::String:
+        return ch == 's' ? appendPrintf(writer, spec, arg.s) : appendPrintf(writer, spec, arg.p);
+    case FormatArg::Pointer:
+        return appendPrintf(writer, spec, arg.p);
+    }
+}
+}
+
+void str::details::throwFormatError(const char* format, const char* what)
+{
+    throw except::InvalidFormatException(except::Context(__FILE__, __LINE__, "", "",
+        std::string("Invalid format string \"") + format + "\": " + what));
+}
+
+size_t str::details::formatTo(char* buffer, size_t size, const char* format,
+                              const FormatConversion* conversions, const FormatArg* args)
+{
+    Writer writer(buffer, size);
+    for (; conversions->conversion != '\0'; ++conversions, ++args)
+    {
+        appendLiteral(writer, format, conversions->prefix);
+        appendConversion(writer, format, *conversions, *args);
+    }
+    appendLiteral(writer, format, conversions->prefix);
+    return writer.finish();
+}
+
+std::string str::details::format(const char* format, const FormatConversion* conversions, const FormatArg* args)
+{
+    char buffer[256];
+    const auto length = formatTo(buffer, sizeof(buffer), format, conversions, args);
+    if (length < sizeof(buffer))
+    {
+        return std::string(buffer, length);
+    }
+
+    std::string retval(length, '\0');
+    formatTo(&retval[0], length + 1, format, conversions, args);
+    return retval;
+}
+
+const std::string& str::details::formatLocal(const char* format, const FormatConversion* conversions,
+                                             const FormatArg* args)
+{
+    thread_local std::string retval;
+    retval.resize(retval.capacity());
+    auto length = formatTo(&retval[0], retval.size() + 1, format, conversions, args);
+    if (length > retval.size())
+    {
+        retval.resize(length);
+        length = formatTo(&retval[0], retval.size() + 1, format, conversions, args);
+    }
+    retval.resize(length);
+    return retval;
+}
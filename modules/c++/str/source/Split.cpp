@@ -0,0 +1,180 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "str/Split.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <utility>
+
+#include "except/Exception.h"
+
+// Delimiters are searched for 16 bytes at a time; CODA_OSS_DISABLE_SIMD
+// (normally seen via sys/AbstractOS.h, which str can't include) opts out.
+#if !defined(CODA_OSS_DISABLE_SIMD) && (!defined(CODA_OSS_ENABLE_SIMD) || CODA_OSS_ENABLE_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64)
+        #define CODA_OSS_str_Split_SSE2 1
+        #include <emmintrin.h>
+        #if _MSC_VER
+        #include <intrin.h>
+        #endif
+    #endif
+#endif
+
+#ifdef CODA_OSS_str_Split_SSE2
+static inline int countTrailingZeros(int mask)
+{
+    #if _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, static_cast<unsigned long>(mask));
+    return static_cast<int>(index);
+    #else
+    return __builtin_ctz(static_cast<unsigned>(mask));
+    #endif
+}
+#endif
+
+const char* str::find(const char* first, const char* last, char ch)
+{
+    // memchr() is already vectorized by every C library we build with.
+    const auto result = memchr(first, ch, last - first);
+    return result == nullptr ? last : static_cast<const char*>(result);
+}
+
+const char* str::find(const char* first, const char* last, const char* delimiter, size_t length)
+{
+    if (length == 1)
+    {
+        return find(first, last, delimiter[0]);
+    }
+    while (static_cast<size_t>(last - first) >= length)
+    {
+        first = find(first, last - (length - 1), delimiter[0]);
+        if (first == last - (length - 1))
+        {
+            break;
+        }
+        if (memcmp(first + 1, delimiter + 1, length - 1) == 0)
+        {
+            return first;
+        }
+        ++first;
+    }
+    return last;
+}
+
+const char* str::findFirstOf(const char* first, const char* last, const char* delimiters, size_t numDelimiters)
+{
+    if (numDelimiters == 1)
+    {
+        return find(first, last, delimiters[0]);
+    }
+
+    #ifdef CODA_OSS_str_Split_SSE2
+    constexpr size_t maxVectorDelimiters = 4;
+    if (numDelimiters <= maxVectorDelimiters)
+    {
+        __m128i splat[maxVectorDelimiters];
+        for (size_t ii = 0; ii < numDelimiters; ++ii)
+        {
+            splat[ii] = _mm_set1_epi8(delimiters[ii]);
+        }
+        for (; last - first >= 16; first += 16)
+        {
+            const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            auto matches = _mm_cmpeq_epi8(v, splat[0]);
+            for (size_t ii = 1; ii < numDelimiters; ++ii)
+            {
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(v, splat[ii]));
+            }
+            const auto mask = _mm_movemask_epi8(matches);
+            if (mask != 0)
+            {
+                return first + countTrailingZeros(mask);
+            }
+        }
+    }
+    #endif
+
+    bool isDelimiter[UINT8_MAX + 1] = {};
+    for (size_t ii = 0; ii < numDelimiters; ++ii)
+    {
+        isDelimiter[static_cast<uint8_t>(delimiters[ii])] = true;
+    }
+    for (; first != last; ++first)
+    {
+        if (isDelimiter[static_cast<uint8_t>(*first)])
+        {
+            return first;
+        }
+    }
+    return last;
+}
+
+const char* str::details::Delimiter::find(const char* first, const char* last) const
+{
+    return isSet ? findFirstOf(first, last, chars.data(), chars.length())
+                 : str::find(first, last, chars.data(), chars.length());
+}
+
+str::details::TokenIterator::TokenIterator(const Delimiter& delimiter, const char* first, const char* last) :
+    mDelimiter(&delimiter), mNext(first), mLast(last), mDone(false)
+{
+    next();
+}
+
+void str::details::TokenIterator::next()
+{
+    while (mNext != nullptr)
+    {
+        const auto end = mDelimiter->find(mNext, mLast);
+        mToken = coda_oss::span<const char>(mNext, end - mNext);
+        mNext = end == mLast ? nullptr : end + mDelimiter->length();
+        if (!mDelimiter->skipEmpty || !mToken.empty())
+        {
+            return;
+        }
+    }
+    mDone = true;
+    mToken = coda_oss::span<const char>();
+}
+
+str::details::TokenRange::TokenRange(const char* first, const char* last, Delimiter&& delimiter) :
+    mFirst(first), mLast(last), mDelimiter(std::move(delimiter))
+{
+    if (mDelimiter.chars.empty())
+    {
+        throw except::InvalidArgumentException(except::Context(__FILE__, __LINE__, "", "", "Empty delimiter"));
+    }
+}
+
+str::SplitView::SplitView(const char* first, const char* last, const std::string& delimiter, bool skipEmpty) :
+    TokenRange(first, last, details::Delimiter{ delimiter, false /*isSet*/, skipEmpty })
+{
+}
+
+str::TokenView::TokenView(const char* first, const char* last, const std::string& delimiters) :
+    TokenRange(first, last, details::Delimiter{ delimiters, true /*isSet*/, true /*skipEmpty*/ })
+{
+}
@@ -0,0 +1,156 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Throughput of the str::to_uXXstring() conversions on large inputs,
+ * next to the code-point-at-a-time routines in str/utf8.h.
+ *
+ *    ./EncodingBenchmark [megabytes] [iterations]
+ */
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include <import/str.h>
+#include <str/Encoding.h>
+#include "config/compiler_extensions.h"
+CODA_OSS_disable_warning_push
+#if _MSC_VER
+#pragma warning(disable: 26818) // Switch statement does not cover all cases. Consider adding a '...' label (es.79).
+#else
+CODA_OSS_disable_warning(-Wshadow)
+#endif
+#include "str/utf8.h"
+CODA_OSS_disable_warning_pop
+
+namespace
+{
+// Tags and numbers, as in XML, with `everyN`th word from another script
+std::u32string makeText(size_t length, const std::u32string& script, size_t everyN)
+{
+    std::u32string retval;
+    for (size_t word = 0; retval.length() < length; word++)
+    {
+        if ((everyN > 0) && (word % everyN == 0))
+        {
+            retval += U"<name>" + script + U"</name>\n";
+        }
+        else
+        {
+            retval += U"<value>12345.678</value>\n";
+        }
+    }
+    return retval;
+}
+
+template <typename TFunc>
+void measure(const std::string& name, size_t numBytes, size_t numIterations, TFunc func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    size_t total = 0;
+    for (size_t ii = 0; ii < numIterations; ++ii)
+    {
+        total += func();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const auto mbPerSecond = (static_cast<double>(numBytes) * numIterations / (1024 * 1024)) / elapsed.count();
+    std::cout << "    " << name << ": " << mbPerSecond << " MB/s (" << total << ")\n";
+}
+
+void benchmark(const std::string& name, const std::u32string& text, size_t numIterations)
+{
+    const auto u8 = str::to_u8string(text);
+    const auto u16 = str::to_u16string(u8);
+    const auto p = str::c_str<std::string>(u8);
+    std::cout << name << ", " << u8.length() << " UTF-8 bytes\n";
+
+    measure("is_valid_utf8()", u8.length(), numIterations, [&]() { return str::is_valid_utf8(u8) ? 1 : 0; });
+    measure("utf8::is_valid()", u8.length(), numIterations, [&]() { return utf8::is_valid(p, p + u8.length()) ? 1 : 0; });
+
+    measure("to_u16string(u8string)", u8.length(), numIterations, [&]() { return str::to_u16string(u8).length(); });
+    measure("utf8::utf8to16()", u8.length(), numIterations, [&]()
+    {
+        std::u16string result;
+        utf8::utf8to16(p, p + u8.length(), std::back_inserter(result));
+        return result.length();
+    });
+
+    measure("to_u32string(u8string)", u8.length(), numIterations, [&]() { return str::to_u32string(u8).length(); });
+    measure("utf8::utf8to32()", u8.length(), numIterations, [&]()
+    {
+        std::u32string result;
+        utf8::utf8to32(p, p + u8.length(), std::back_inserter(result));
+        return result.length();
+    });
+
+    measure("to_u8string(u16string)", u8.length(), numIterations, [&]() { return str::to_u8string(u16).length(); });
+    measure("utf8::utf16to8()", u8.length(), numIterations, [&]()
+    {
+        std::string result;
+        utf8::utf16to8(u16.begin(), u16.end(), std::back_inserter(result));
+        return result.length();
+    });
+
+    measure("to_u8string(u32string)", u8.length(), numIterations, [&]() { return str::to_u8string(text).length(); });
+    measure("utf8::utf32to8()", u8.length(), numIterations, [&]()
+    {
+        std::string result;
+        utf8::utf32to8(text.begin(), text.end(), std::back_inserter(result));
+        return result.length();
+    });
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const size_t megabytes = argc > 1 ? str::toType<size_t>(argv[1]) : 8;
+        const size_t numIterations = argc > 2 ? str::toType<size_t>(argv[2]) : 10;
+        const size_t length = megabytes * 1024 * 1024;
+
+        benchmark("ASCII", makeText(length, U"", 0), numIterations);
+        benchmark("Latin-1", makeText(length, U"\u00e9\u00e8\u00fc\u00df\u00f1", 4), numIterations);
+        benchmark("Cyrillic", makeText(length, U"\u0416\u0438\u0437\u043d\u044c", 2), numIterations);
+        benchmark("CJK and emoji", makeText(length, U"\u4e2d\u6587\u6f22\u5b57\U0001f600", 1), numIterations);
+
+        // Windows-1252, as std::string is on Windows
+        str::W1252string w1252;
+        for (size_t ii = 0; w1252.length() < length; ii++)
+        {
+            w1252 += static_cast<str::W1252string::value_type>((ii % 11 == 0) ? 0xe9 : 'a' + ii % 26);
+        }
+        std::cout << "Windows-1252, " << w1252.length() << " bytes\n";
+        measure("to_u8string(W1252string)", w1252.length(), numIterations, [&]() { return str::to_u8string(w1252).length(); });
+        measure("to_u16string(W1252string)", w1252.length(), numIterations, [&]() { return str::to_u16string(w1252).length(); });
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Calls per second of str::Format() with a const char* format and with a
+ * pre-parsed str::FormatString, the latter also into a caller's buffer
+ * and into the thread-local string.
+ *
+ *    ./FormatBenchmark [iterations]
+ */
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <import/str.h>
+
+namespace
+{
+template <typename TFunc>
+void measure(const std::string& name, size_t numIterations, TFunc func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    size_t total = 0;
+    for (size_t ii = 0; ii < numIterations; ++ii)
+    {
+        total += func(ii);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "    " << name << ": " << numIterations / elapsed.count() << " calls/s (" << total << ")\n";
+}
+
+constexpr str::FormatString<int> unsupported("Unsupported compression type: %d");
+constexpr str::FormatString<std::string, size_t> rows("%s: row %zu");
+constexpr str::FormatString<double, double> point("(%.3f, %.3f)");
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const size_t numIterations = argc > 1 ? str::toType<size_t>(argv[1]) : 1000000;
+        const std::string name = "image.tif";
+        char buffer[128];
+
+        std::cout << "\"" << unsupported.c_str() << "\"\n";
+        measure("Format(const char*)", numIterations, [&](size_t ii) { return str::Format(unsupported.c_str(), static_cast<int>(ii)).length(); });
+        measure("Format(FormatString)", numIterations, [&](size_t ii) { return str::Format(unsupported, static_cast<int>(ii)).length(); });
+        measure("FormatTo()", numIterations, [&](size_t ii) { return str::FormatTo(buffer, unsupported, static_cast<int>(ii)); });
+        measure("FormatLocal()", numIterations, [&](size_t ii) { return str::FormatLocal(unsupported, static_cast<int>(ii)).length(); });
+
+        std::cout << "\"" << rows.c_str() << "\"\n";
+        measure("Format(const char*)", numIterations, [&](size_t ii) { return str::Format(rows.c_str(), name, ii).length(); });
+        measure("Format(FormatString)", numIterations, [&](size_t ii) { return str::Format(rows, name, ii).length(); });
+        measure("FormatTo()", numIterations, [&](size_t ii) { return str::FormatTo(buffer, rows, name, ii); });
+
+        std::cout << "\"" << point.c_str() << "\"\n";
+        measure("Format(const char*)", numIterations, [&](size_t ii) { return str::Format(point.c_str(), ii * 0.5, ii * 0.25).length(); });
+        measure("Format(FormatString)", numIterations, [&](size_t ii) { return str::Format(point, ii * 0.5, ii * 0.25).length(); });
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
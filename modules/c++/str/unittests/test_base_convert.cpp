@@ -582,6 +582,85 @@ TEST_CASE(test_Encoding)
         iso8859_1_view, utf_8_view);
 }
 
+// ASCII runs of every length around the vector widths, between
+// characters of 2, 3 and 4 UTF-8 bytes.
+static std::u32string mixedText_u32()
+{
+    static const std::u32string others{ U'\x00e9', U'\x0416', U'\x4e2d', U'\x1f600' };
+    std::u32string retval;
+    for (size_t run = 0; run < 70; run++)
+    {
+        for (size_t i = 0; i < run; i++)
+        {
+            retval += static_cast<char32_t>(U'a' + (i % 26));
+        }
+        retval += others[run % others.size()];
+        retval += others[(run + 1) % others.size()];
+    }
+    return retval;
+}
+TEST_CASE(test_mixed_round_trip)
+{
+    const auto u32 = mixedText_u32();
+    const auto u8 = str::to_u8string(u32);
+    TEST_ASSERT(str::is_valid_utf8(u8));
+    TEST_ASSERT(str::to_u32string(u8) == u32);
+
+    const auto u16 = str::to_u16string(u8);
+    TEST_ASSERT(str::to_u8string(u16) == u8);
+
+    size_t u8Length = 0;
+    size_t u16Length = 0;
+    for (const auto ch : u32)
+    {
+        u8Length += ch < 0x80 ? 1 : ch < 0x800 ? 2 : ch < 0x10000 ? 3 : 4;
+        u16Length += ch < 0x10000 ? 1 : 2;
+    }
+    TEST_ASSERT_EQ(u8.length(), u8Length);
+    TEST_ASSERT_EQ(u16.length(), u16Length);
+
+    // Every offset, so the ASCII runs start anywhere within a vector.
+    for (size_t i = 0; i < 40; i++)
+    {
+        const std::u32string tail(u32.begin() + i, u32.end());
+        TEST_ASSERT(str::to_u32string(str::to_u8string(tail)) == tail);
+    }
+}
+TEST_CASE(test_mixed_Windows1252)
+{
+    str::W1252string w1252;
+    for (size_t run = 0; run < 0x100; run++)
+    {
+        for (size_t i = 0; i < run % 37; i++)
+        {
+            w1252 += static_cast<str::W1252string::value_type>('A' + (i % 26));
+        }
+        w1252 += static_cast<str::W1252string::value_type>(run);
+    }
+    const auto u8 = str::to_u8string(w1252);
+    TEST_ASSERT(str::is_valid_utf8(u8));
+    TEST_ASSERT(str::to_w1252string(u8) == w1252);
+    TEST_ASSERT(str::to_u16string(w1252) == str::to_u16string(u8));
+    TEST_ASSERT(str::to_u32string(w1252) == str::to_u32string(u8));
+}
+TEST_CASE(test_invalid_utf8)
+{
+    const auto u8 = str::to_u8string(mixedText_u32());
+    auto bad = u8;
+    bad.insert(bad.begin() + 100, static_cast<coda_oss::u8string::value_type>(0x80)); // stray continuation byte
+    TEST_ASSERT_FALSE(str::is_valid_utf8(bad));
+    TEST_EXCEPTION(str::to_u16string(bad));
+    TEST_EXCEPTION(str::to_u32string(bad));
+
+    // A 3-byte sequence cut short by ASCII
+    const coda_oss::u8string truncated{ cast8('a'), cast8('\xe4'), cast8('\xb8'), cast8('b') };
+    TEST_ASSERT_FALSE(str::is_valid_utf8(truncated));
+    TEST_EXCEPTION(str::to_u32string(truncated));
+
+    const std::u16string loneSurrogate{ u'a', static_cast<char16_t>(0xd800), u'b' };
+    TEST_EXCEPTION(str::to_u8string(loneSurrogate));
+}
+
 TEST_MAIN(
     TEST_CHECK(testConvert);
     TEST_CHECK(testBadConvert);
@@ -598,4 +677,7 @@ TEST_MAIN(
     TEST_CHECK(test_Windows1252_WIN32);
     TEST_CHECK(test_Windows1252);
     TEST_CHECK(test_Encoding);
+    TEST_CHECK(test_mixed_round_trip);
+    TEST_CHECK(test_mixed_Windows1252);
+    TEST_CHECK(test_invalid_utf8);
     )
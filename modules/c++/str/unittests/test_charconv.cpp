@@ -0,0 +1,242 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <limits>
+#include <random>
+#include <std/string>
+#include <vector>
+
+#include <str/CharConv.h>
+#include <str/Convert.h>
+
+#include "TestCase.h"
+
+namespace
+{
+template <typename T>
+str::from_chars_result fromChars(const std::string& s, T& value)
+{
+    return str::from_chars(s.data(), s.data() + s.length(), value);
+}
+
+template <typename T>
+std::string toChars(T value)
+{
+    char buffer[64];
+    const auto result = str::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+}
+}
+
+TEST_CASE(testFromCharsInteger)
+{
+    int value = 0;
+    auto result = fromChars("-1234xyz", value);
+    TEST_ASSERT(result.ec == std::errc());
+    TEST_ASSERT_EQ(value, -1234);
+    TEST_ASSERT_EQ(*result.ptr, 'x');
+
+    value = 7;
+    TEST_ASSERT(fromChars("+1", value).ec == std::errc::invalid_argument);
+    TEST_ASSERT(fromChars(" 1", value).ec == std::errc::invalid_argument);
+    TEST_ASSERT(fromChars("", value).ec == std::errc::invalid_argument);
+    TEST_ASSERT(fromChars("99999999999", value).ec == std::errc::result_out_of_range);
+    TEST_ASSERT_EQ(value, 7);
+
+    int8_t i8 = 0;
+    TEST_ASSERT(fromChars("-128", i8).ec == std::errc());
+    TEST_ASSERT_EQ(i8, std::numeric_limits<int8_t>::min());
+    TEST_ASSERT(fromChars("128", i8).ec == std::errc::result_out_of_range);
+
+    unsigned u = 0;
+    TEST_ASSERT(fromChars("-1", u).ec == std::errc::invalid_argument);
+    uint64_t u64 = 0;
+    TEST_ASSERT(fromChars("18446744073709551615", u64).ec == std::errc());
+    TEST_ASSERT_EQ(u64, std::numeric_limits<uint64_t>::max());
+    TEST_ASSERT(fromChars("18446744073709551616", u64).ec == std::errc::result_out_of_range);
+
+    const std::string hex = "3BC7";
+    TEST_ASSERT(str::from_chars(hex.data(), hex.data() + hex.length(), value, 16).ec == std::errc());
+    TEST_ASSERT_EQ(value, 0x3BC7);
+}
+
+TEST_CASE(testToCharsInteger)
+{
+    TEST_ASSERT_EQ(toChars(0), "0");
+    TEST_ASSERT_EQ(toChars(-42), "-42");
+    TEST_ASSERT_EQ(toChars(std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+    TEST_ASSERT_EQ(toChars(std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+    TEST_ASSERT_EQ(toChars(static_cast<int8_t>(-128)), "-128");
+
+    char buffer[3];
+    const auto result = str::to_chars(buffer, buffer + sizeof(buffer), 1234);
+    TEST_ASSERT(result.ec == std::errc::value_too_large);
+
+    char hex[8];
+    const auto end = str::to_chars(hex, hex + sizeof(hex), 255, 16).ptr;
+    TEST_ASSERT_EQ(std::string(hex, end), "ff");
+}
+
+TEST_CASE(testFromCharsFloatingPoint)
+{
+    // Compare against strtod() for easy and hard cases.
+    std::vector<std::string> inputs{ "0", "-0", "1", "1.5", ".5", "5.", "-2.25e-3", "1e22", "1e23", "123e30",
+                                     "0.1", "3.14159265358979323846", "2.2250738585072014e-308",
+                                     "1.7976931348623157e308", "9007199254740993", "0.000000000000000000000001",
+                                     "12345678901234567890123", "4.9406564584124654e-324" };
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    for (size_t ii = 0; ii < 1000; ++ii)
+    {
+        std::string s;
+        const size_t numDigits = 1 + ii % 20;
+        for (size_t jj = 0; jj < numDigits; ++jj)
+        {
+            s += static_cast<char>('0' + digit(gen));
+            if (jj == 0)
+            {
+                s += '.';
+            }
+        }
+        inputs.push_back(s + "e" + std::to_string(exponent(gen)));
+    }
+
+    for (const auto& input : inputs)
+    {
+        double value = 0.0;
+        const auto result = fromChars(input, value);
+        TEST_ASSERT(result.ec == std::errc());
+        TEST_ASSERT(result.ptr == input.data() + input.length());
+        TEST_ASSERT_EQ(value, strtod(input.c_str(), nullptr));
+
+        float f = 0.0f;
+        TEST_ASSERT(fromChars(input, f).ec == std::errc() || fromChars(input, f).ec == std::errc::result_out_of_range);
+    }
+
+    double value = 0.0;
+    TEST_ASSERT(fromChars("-0", value).ec == std::errc());
+    TEST_ASSERT(std::signbit(value));
+    const std::string noExponent = "1e";
+    TEST_ASSERT(fromChars(noExponent, value).ptr == noExponent.data() + 1);
+    TEST_ASSERT_EQ(value, 1.0);
+    TEST_ASSERT(fromChars("-Infinity", value).ec == std::errc());
+    TEST_ASSERT_EQ(value, -std::numeric_limits<double>::infinity());
+    TEST_ASSERT(fromChars("nan", value).ec == std::errc());
+    TEST_ASSERT(std::isnan(value));
+    TEST_ASSERT(fromChars("1e999", value).ec == std::errc::result_out_of_range);
+    TEST_ASSERT(fromChars(".", value).ec == std::errc::invalid_argument);
+    TEST_ASSERT(fromChars("e5", value).ec == std::errc::invalid_argument);
+
+    float f = 0.0f;
+    TEST_ASSERT(fromChars("0.1", f).ec == std::errc());
+    TEST_ASSERT_EQ(f, 0.1f);
+    TEST_ASSERT(fromChars("16777217", f).ec == std::errc());
+    TEST_ASSERT_EQ(f, 16777216.0f);
+}
+
+TEST_CASE(testToCharsFloatingPoint)
+{
+    TEST_ASSERT_EQ(toChars(0.1), "0.1");
+    TEST_ASSERT_EQ(toChars(-1.5), "-1.5");
+    TEST_ASSERT_EQ(toChars(1e300), "1e+300");
+    TEST_ASSERT_EQ(toChars(0.1f), "0.1");
+    TEST_ASSERT_EQ(toChars(std::numeric_limits<double>::infinity()), "inf");
+    TEST_ASSERT_EQ(toChars(-std::numeric_limits<double>::infinity()), "-inf");
+
+    // Random bit patterns round trip
+    std::mt19937_64 gen(5678);
+    for (size_t ii = 0; ii < 2000; ++ii)
+    {
+        const uint64_t bits = gen();
+        double expected;
+        memcpy(&expected, &bits, sizeof(expected));
+        if (!std::isfinite(expected))
+        {
+            continue;
+        }
+        const auto s = toChars(expected);
+        double actual = 0.0;
+        TEST_ASSERT(fromChars(s, actual).ec == std::errc());
+        TEST_ASSERT_EQ(actual, expected);
+
+        const auto f = static_cast<float>(expected);
+        if (std::isfinite(f))
+        {
+            float fActual = 0.0f;
+            TEST_ASSERT(fromChars(toChars(f), fActual).ec == std::errc());
+            TEST_ASSERT_EQ(fActual, f);
+        }
+    }
+
+    char buffer[64];
+    const auto end = str::to_chars(buffer, buffer + sizeof(buffer), 1.0 / 3.0, 5).ptr;
+    TEST_ASSERT_EQ(std::string(buffer, end), "0.33333");
+}
+
+TEST_CASE(testToStringToType)
+{
+    // Unchanged from the stringstream versions
+    TEST_ASSERT_EQ(str::toString(-42), "-42");
+    TEST_ASSERT_EQ(str::toString(0.1), "0.10000000000000001");
+    TEST_ASSERT_EQ(str::toString(0.5f), "0.5");
+    TEST_ASSERT_EQ(str::toString(std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+
+    TEST_ASSERT_EQ(str::toType<int>("42"), 42);
+    TEST_ASSERT_EQ(str::toType<int>(" 42"), 42);
+    TEST_ASSERT_EQ(str::toType<int>("+42"), 42);
+    TEST_ASSERT_EQ(str::toType<int>("42abc"), 42);
+    TEST_EXCEPTION(str::toType<int>("99999999999"));
+    TEST_EXCEPTION(str::toType<int>("abc"));
+    TEST_ASSERT_EQ(str::toType<double>("1.5"), 1.5);
+    TEST_ASSERT_EQ(str::toType<double>("0.10000000000000001"), 0.1);
+    TEST_ASSERT_EQ(str::toType<float>("-2.5e3"), -2500.0f);
+}
+
+TEST_CASE(testToTypes)
+{
+    std::vector<double> values(5);
+    const auto count = str::toTypes<double>("1.5, 2,3 +4\n-5e-1", values);
+    TEST_ASSERT_EQ(count, static_cast<size_t>(5));
+    TEST_ASSERT(values == std::vector<double>({ 1.5, 2.0, 3.0, 4.0, -0.5 }));
+
+    std::vector<int> ints(2);
+    TEST_ASSERT_EQ(str::toTypes<int>("  ", ints), static_cast<size_t>(0));
+    TEST_ASSERT_EQ(str::toTypes<int>("7;8", ints, ';'), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(ints[1], 8);
+    TEST_EXCEPTION(str::toTypes<int>("1 2 3", ints));
+    TEST_EXCEPTION(str::toTypes<int>("1 2x", ints));
+    TEST_EXCEPTION(str::toTypes<int>("1.5", ints));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testFromCharsInteger);
+    TEST_CHECK(testToCharsInteger);
+    TEST_CHECK(testFromCharsFloatingPoint);
+    TEST_CHECK(testToCharsFloatingPoint);
+    TEST_CHECK(testToStringToType);
+    TEST_CHECK(testToTypes);
+    )
@@ -0,0 +1,142 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+
+#include <str/Format.h>
+#include <str/FormatString.h>
+
+#include "TestCase.h"
+
+namespace
+{
+// Checked at compile time.
+constexpr str::FormatString<int, std::string> intString("%d: [%s]");
+constexpr str::FormatString<> noArgs("100%% done");
+constexpr str::FormatString<size_t, double, const char*> mixed("%zu items at %.2f%% of %s.");
+}
+
+TEST_CASE(testFormatString)
+{
+    TEST_ASSERT_EQ(str::Format(intString, -12, "abc"), "-12: [abc]");
+    TEST_ASSERT_EQ(str::Format(noArgs), "100% done");
+    TEST_ASSERT_EQ(str::Format(mixed, 3, 12.345, "total"), "3 items at 12.35% of total.");
+
+    // Same as str::Format() with the format as a const char*
+    TEST_ASSERT_EQ(str::Format(intString, 42, std::string("x")), str::Format(intString.c_str(), 42, "x"));
+
+    static constexpr str::FormatString<unsigned short> unsupported("Unsupported compression type: %d");
+    TEST_ASSERT_EQ(str::Format(unsupported, static_cast<unsigned short>(65535)), "Unsupported compression type: 65535");
+}
+
+TEST_CASE(testFormatStringConversions)
+{
+    const auto check = [&](const std::string& actual, const char* expected) { TEST_ASSERT_EQ(actual, expected); };
+
+    check(str::Format(str::FormatString<int>("%x"), -1), "ffffffff");
+    check(str::Format(str::FormatString<int64_t>("%X"), -1), "FFFFFFFFFFFFFFFF");
+    check(str::Format(str::FormatString<uint8_t, uint8_t>("%o %u"), 8, 255), "10 255");
+    check(str::Format(str::FormatString<char, char>("%c%c"), 'o', 'k'), "ok");
+    check(str::Format(str::FormatString<int, int>("[%5d|%-5d]"), 42, -42), "[   42|-42  ]");
+    check(str::Format(str::FormatString<int>("%08x"), 0xbeef), "0000beef");
+    check(str::Format(str::FormatString<std::string, std::string>("[%4s|%.2s]"), "a", "xyz"), "[   a|xy]");
+    check(str::Format(str::FormatString<double, double>("%g %e"), 0.5, 1e10), "0.5 1.000000e+10");
+    check(str::Format(str::FormatString<const char*>("%s"), nullptr), "(null)");
+    check(str::Format(str::FormatString<long long>("%lld"), INT64_MIN), "-9223372036854775808");
+
+    int value = 0;
+    char expected[64];
+    snprintf(expected, sizeof(expected), "%p", static_cast<void*>(&value));
+    check(str::Format(str::FormatString<const int*>("%p"), &value), expected);
+}
+
+TEST_CASE(testFormatStringFixed)
+{
+    static constexpr str::FormatString<double, double, double> fixed("%f %.2f %.0f");
+    const double values[] = { 0.0, -0.0, 0.125, 0.375, 2.5, -0.0001, 1234.5678, 0.1, 1.0 / 3, -2.675,
+                              1e12, 1e13, -1e300, 123456789.987654321, 0.9999999999 };
+    for (const auto value : values)
+    {
+        char expected[1024];
+        snprintf(expected, sizeof(expected), "%f %.2f %.0f", value, value, value);
+        TEST_ASSERT_EQ(str::Format(fixed, value, value, value), expected);
+    }
+    for (int ii = -5000; ii < 5000; ++ii)
+    {
+        const auto value = ii * 0.0125;
+        char expected[128];
+        snprintf(expected, sizeof(expected), "%f %.2f %.0f", value, value, value);
+        TEST_ASSERT_EQ(str::Format(fixed, value, value, value), expected);
+    }
+}
+
+TEST_CASE(testFormatStringErrors)
+{
+    // These are compile errors when the FormatString is constexpr.
+    TEST_EXCEPTION(str::FormatString<int>("%s"));
+    TEST_EXCEPTION(str::FormatString<std::string>("%d"));
+    TEST_EXCEPTION(str::FormatString<int>("%d %d"));
+    TEST_EXCEPTION((str::FormatString<int, int>("%d")));
+    TEST_EXCEPTION(str::FormatString<int>("%*d"));
+    TEST_EXCEPTION(str::FormatString<int>("%"));
+    TEST_EXCEPTION(str::FormatString<double>("%n"));
+}
+
+TEST_CASE(testFormatTo)
+{
+    char buffer[8];
+    TEST_ASSERT_EQ(str::FormatTo(buffer, intString, 1, "a"), static_cast<size_t>(6));
+    TEST_ASSERT_EQ(std::string(buffer), "1: [a]");
+
+    // truncated, like snprintf()
+    TEST_ASSERT_EQ(str::FormatTo(buffer, intString, 12345, "abcdef"), static_cast<size_t>(15));
+    TEST_ASSERT_EQ(std::string(buffer), "12345: ");
+    TEST_ASSERT_EQ(str::FormatTo(coda_oss::span<char>(buffer, static_cast<size_t>(0)), intString, 1, "a"), static_cast<size_t>(6));
+
+    // longer than the stack buffer str::Format() starts with
+    const std::string big(1000, 'x');
+    TEST_ASSERT_EQ(str::Format(intString, 1, big), "1: [" + big + "]");
+}
+
+TEST_CASE(testFormatLocal)
+{
+    const auto& s = str::FormatLocal(intString, 1, "a");
+    TEST_ASSERT_EQ(s, "1: [a]");
+
+    const std::string big(100, 'x');
+    TEST_ASSERT_EQ(str::FormatLocal(intString, 2, big), "2: [" + big + "]");
+    const auto bigData = str::FormatLocal(intString, 3, big).data();
+    TEST_ASSERT(str::FormatLocal(intString, 4, "b").data() == bigData);  // reused
+    TEST_ASSERT_EQ(s, "4: [b]");
+}
+
+TEST_MAIN(
+    TEST_CHECK(testFormatString);
+    TEST_CHECK(testFormatStringConversions);
+    TEST_CHECK(testFormatStringFixed);
+    TEST_CHECK(testFormatStringErrors);
+    TEST_CHECK(testFormatTo);
+    TEST_CHECK(testFormatLocal);
+    )
@@ -0,0 +1,155 @@
+/* =========================================================================
+ * This file is part of str-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * str-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <str/Manip.h>
+#include <str/Split.h>
+#include <str/Tokenizer.h>
+
+#include "TestCase.h"
+
+namespace
+{
+template <typename TView>
+std::vector<std::string> toStrings(const TView& view)
+{
+    std::vector<std::string> retval;
+    for (auto&& token : view)
+    {
+        retval.emplace_back(token.data(), token.size());
+    }
+    return retval;
+}
+
+std::vector<std::string> tokenize(const std::string& s, const std::string& delimiters = " \t\r\n")
+{
+    str::Tokenizer tokenizer(s, delimiters);
+    return tokenizer;
+}
+
+// Long enough that the SIMD loops see several full blocks plus a tail.
+std::string makeLine(const std::string& delimiter)
+{
+    std::string retval;
+    for (size_t ii = 0; ii < 50; ++ii)
+    {
+        retval += std::string(ii % 23, static_cast<char>('a' + ii % 26));
+        retval += delimiter;
+    }
+    return retval;
+}
+}
+
+TEST_CASE(testSplitView)
+{
+    for (const std::string s : { "", ",", "a", "a,b,c", ",a,,b,", ",,,", "abc,def,,ghi,,,jkl" })
+    {
+        TEST_ASSERT(toStrings(str::SplitView(s, ",")) == str::split(s, ","));
+    }
+    const auto line = makeLine(",");
+    TEST_ASSERT(toStrings(str::SplitView(line, ",")) == str::split(line, ","));
+
+    // SplitView doesn't copy
+    const std::string s = "ab cd";
+    str::SplitView view(s);
+    auto it = view.begin();
+    TEST_ASSERT(it->data() == s.data());
+    ++it;
+    TEST_ASSERT(it->data() == s.data() + 3);
+    TEST_ASSERT_EQ(it->size(), static_cast<size_t>(2));
+    ++it;
+    TEST_ASSERT(it == view.end());
+
+    TEST_EXCEPTION(str::SplitView(s, ""));
+}
+
+TEST_CASE(testSplitViewEmptyTokens)
+{
+    const std::string csv = ",a,,b,";
+    const auto fields = toStrings(str::SplitView(csv, ",", false /*skipEmpty*/));
+    TEST_ASSERT(fields == std::vector<std::string>({ "", "a", "", "b", "" }));
+
+    const std::string empty;
+    TEST_ASSERT(toStrings(str::SplitView(empty, ",", false)) == std::vector<std::string>({ "" }));
+}
+
+TEST_CASE(testSplitViewMultiCharDelimiter)
+{
+    for (const std::string s : { "a::b", "::a::::b::", "a:b::c:::d", ":", "a:" })
+    {
+        TEST_ASSERT(toStrings(str::SplitView(s, "::")) == str::split(s, "::"));
+    }
+    const auto line = makeLine("<=>");
+    TEST_ASSERT(toStrings(str::SplitView(line, "<=>")) == str::split(line, "<=>"));
+
+    const std::string s = "a\r\n\r\nb\r\n";
+    TEST_ASSERT(toStrings(str::SplitView(s, "\r\n", false)) == std::vector<std::string>({ "a", "", "b", "" }));
+}
+
+TEST_CASE(testTokenView)
+{
+    for (const std::string s : { "", " ", "a", " a\tb\r\nc ", "  \t\t " })
+    {
+        TEST_ASSERT(toStrings(str::TokenView(s)) == tokenize(s));
+    }
+    const auto line = makeLine(" \t");
+    TEST_ASSERT(toStrings(str::TokenView(line)) == tokenize(line));
+    TEST_ASSERT(toStrings(str::TokenView(line, "aeiou ")) ==
+                tokenize(line, "aeiou "));
+}
+
+TEST_CASE(testFindFirstOf)
+{
+    std::string s(100, 'x');
+    const auto first = s.data();
+    const auto last = s.data() + s.length();
+    TEST_ASSERT(str::findFirstOf(first, last, ",;", 2) == last);
+    TEST_ASSERT(str::find(first, last, ',') == last);
+
+    for (const size_t pos : { 0, 1, 15, 16, 17, 31, 32, 63, 98, 99 })
+    {
+        s.assign(100, 'x');
+        s[pos] = ';';
+        TEST_ASSERT(str::findFirstOf(first, last, ",;", 2) == first + pos);
+        TEST_ASSERT(str::findFirstOf(first, last, ",;:|=", 5) == first + pos);  // table lookup
+        TEST_ASSERT(str::find(first, last, ';') == first + pos);
+        if (pos + 1 < s.length())
+        {
+            s[pos + 1] = ';';
+            TEST_ASSERT(str::find(first, last, ";;", 2) == first + pos);
+        }
+    }
+
+    s = "\xff\x80 ab";
+    TEST_ASSERT(str::findFirstOf(s.data(), s.data() + s.length(), "\x80", 1) == s.data() + 1);
+    TEST_ASSERT(str::findFirstOf(s.data(), s.data() + s.length(), "b\x80", 2) == s.data() + 1);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testSplitView);
+    TEST_CHECK(testSplitViewEmptyTokens);
+    TEST_CHECK(testSplitViewMultiCharDelimiter);
+    TEST_CHECK(testTokenView);
+    TEST_CHECK(testFindFirstOf);
+    )
@@ -24,12 +24,14 @@
 #define __IMPORT_TIFF_H__
 
 #include "tiff/Common.h"
+#include "tiff/Compression.h"
 #include "tiff/Header.h"
 #include "tiff/GenericType.h"
 #include "tiff/IFDEntry.h"
 #include "tiff/IFD.h"
 #include "tiff/KnownTags.h"
 #include "tiff/TypeFactory.h"
+#include "tiff/TileCache.h"
 #include "tiff/ImageReader.h"
 #include "tiff/FileReader.h"
 #include "tiff/ImageWriter.h"
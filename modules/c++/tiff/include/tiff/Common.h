@@ -82,6 +82,10 @@ public:
             SRATIONAL,
             FLOAT,
             DOUBLE,
+            IFD,
+            LONG8 = 16, // BigTIFF
+            SLONG8,
+            IFD8,
             MAX
         };
     };
@@ -143,7 +147,54 @@ public:
             DEFLATE,
             JBIG_BW,
             JBIG_COLOR,
-            PACK_BITS = 32773
+            PACK_BITS = 32773,
+            DEFLATE_OLD = 32946
+        };
+    };
+
+
+    /*
+     * Predictor
+     * http://www.awaresystems.be/imaging/tiff/tifftags/predictor.html
+     */
+
+    class PredictorType
+    {
+    public:
+        enum
+        {
+            NONE = 1,
+            HORIZONTAL_DIFFERENCING,
+            FLOATING_POINT
+        };
+    };
+
+    /**
+     *****************************************************************
+     * @class Tag
+     * @brief Numeric identifiers of the tags used on hot paths.  Looking
+     * an entry up by tag avoids the name lookup in KnownTags.
+     *****************************************************************/
+    class Tag
+    {
+    public:
+        enum
+        {
+            IMAGE_WIDTH = 256,
+            IMAGE_LENGTH = 257,
+            BITS_PER_SAMPLE = 258,
+            COMPRESSION = 259,
+            PHOTOMETRIC_INTERPRETATION = 262,
+            STRIP_OFFSETS = 273,
+            SAMPLES_PER_PIXEL = 277,
+            ROWS_PER_STRIP = 278,
+            STRIP_BYTE_COUNTS = 279,
+            PREDICTOR = 317,
+            TILE_WIDTH = 322,
+            TILE_LENGTH = 323,
+            TILE_OFFSETS = 324,
+            TILE_BYTE_COUNTS = 325,
+            SAMPLE_FORMAT = 339
         };
     };
 
@@ -159,7 +210,7 @@ public:
      *****************************************************************/
     static short sizeOf(unsigned short type)
     {
-        return mTypeSizes[type];
+        return type < Type::MAX ? mTypeSizes[type] : 0;
     }
 
 private:
@@ -0,0 +1,160 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+#ifndef CODA_OSS_tiff_Compression_h_INCLUDED_
+#define CODA_OSS_tiff_Compression_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <config/Exports.h>
+
+namespace tiff
+{
+
+/**
+ *********************************************************************
+ * @class Compression
+ * @brief Codecs for compressed TIFF strips and tiles.
+ *
+ * Each function works on exactly one strip or tile; callers are
+ * free to run them concurrently on different chunks.  Deflate is
+ * only available when the module was built against zlib, see
+ * isSupported().  The same compression types can be both encoded
+ * and decoded.
+ *********************************************************************/
+struct CODA_OSS_API Compression final
+{
+    /**
+     *****************************************************************
+     * Returns true if the specified tiff::Const::CompressionType can
+     * be decoded by decompress().
+     *****************************************************************/
+    static bool isSupported(unsigned short compression);
+
+    /**
+     *****************************************************************
+     * Decodes a single strip or tile.  Decoding stops once the output
+     * buffer is full; a short chunk leaves the remainder untouched.
+     *
+     * @param compression
+     *   the tiff::Const::CompressionType of the data
+     * @param input
+     *   the compressed bytes, as read from the file
+     * @param inputSize
+     *   the number of compressed bytes
+     * @param output
+     *   the buffer to decode into
+     * @param outputSize
+     *   the size of the decoded strip or tile in bytes
+     * @return
+     *   the number of bytes written to the output buffer
+     *****************************************************************/
+    static size_t decompress(unsigned short compression,
+                             const unsigned char* input, size_t inputSize,
+                             unsigned char* output, size_t outputSize);
+
+    //! PackBits (Macintosh RLE) decoding
+    static size_t unpackBits(const unsigned char* input, size_t inputSize,
+                             unsigned char* output, size_t outputSize);
+
+    //! TIFF 6.0 LZW decoding (MSB-first codes with "early change")
+    static size_t decodeLZW(const unsigned char* input, size_t inputSize,
+                            unsigned char* output, size_t outputSize);
+
+    //! zlib/Deflate decoding; throws if zlib support isn't compiled in
+    static size_t inflate(const unsigned char* input, size_t inputSize,
+                          unsigned char* output, size_t outputSize);
+
+    /**
+     *****************************************************************
+     * Encodes a single strip or tile.
+     *
+     * @param compression
+     *   the tiff::Const::CompressionType to use
+     * @param input
+     *   the raw bytes of the chunk
+     * @param inputSize
+     *   the number of raw bytes
+     * @param rowSize
+     *   the number of bytes in each row of the chunk; PackBits never
+     *   lets a run cross a row
+     * @return
+     *   the encoded bytes, as they are to be written to the file
+     *****************************************************************/
+    static std::vector<unsigned char> compress(unsigned short compression,
+                                               const unsigned char* input,
+                                               size_t inputSize, size_t rowSize);
+
+    //! PackBits encoding, row by row
+    static std::vector<unsigned char> packBits(const unsigned char* input,
+                                               size_t inputSize, size_t rowSize);
+
+    //! TIFF 6.0 LZW encoding (MSB-first codes with "early change")
+    static std::vector<unsigned char> encodeLZW(const unsigned char* input,
+                                                size_t inputSize);
+
+    //! zlib/Deflate encoding; throws if zlib support isn't compiled in
+    static std::vector<unsigned char> deflate(const unsigned char* input,
+                                              size_t inputSize);
+
+    /**
+     *****************************************************************
+     * Applies horizontal differencing (Predictor = 2) in place; the
+     * inverse of undoHorizontalPredictor().
+     *****************************************************************/
+    static void applyHorizontalPredictor(unsigned char* data,
+                                         size_t numRows, size_t numColumns,
+                                         unsigned short samplesPerPixel,
+                                         unsigned short bytesPerSample,
+                                         bool reverseBytes);
+
+    /**
+     *****************************************************************
+     * Reverses horizontal differencing (Predictor = 2) in place.
+     *
+     * @param data
+     *   the decoded strip or tile
+     * @param numRows
+     *   the number of rows in the chunk
+     * @param numColumns
+     *   the number of pixels in each row of the chunk
+     * @param samplesPerPixel
+     *   the number of samples in each pixel
+     * @param bytesPerSample
+     *   the size of each sample: 1, 2, 4 or 8 bytes
+     * @param reverseBytes
+     *   whether the samples are in the opposite byte order of this
+     *   machine
+     *****************************************************************/
+    static void undoHorizontalPredictor(unsigned char* data,
+                                        size_t numRows, size_t numColumns,
+                                        unsigned short samplesPerPixel,
+                                        unsigned short bytesPerSample,
+                                        bool reverseBytes);
+};
+
+} // End namespace.
+
+#endif // CODA_OSS_tiff_Compression_h_INCLUDED_
@@ -41,23 +41,30 @@ class CODA_OSS_API Header : public io::Serializable
 public:
     enum ByteOrder { MM, II };
 
+    //! The TIFF identifier: 42 for classic TIFF, 43 for BigTIFF
+    enum Version { CLASSIC_TIFF = 42, BIG_TIFF = 43 };
+
     /**
      *****************************************************************
      * Constructor.  Allows the user to set the values in the header
      * and also provides resonable defaults.
      *
      * @param id
-     *   the TIFF identifier, always "42"
+     *   the TIFF identifier, "42" or "43" for BigTIFF
      * @param byteOrder
      *   the byte order of the file "MM" for Big Endian, "II" 
      *   for Little Endian
      * @param ifdOffset
      *   the offset to the first IFD
      *****************************************************************/
-    Header(const unsigned short id = 42, const char byteOrder[2] = "  ",
-            const sys::Uint32_T ifdOffset = 8) :
+    Header(const unsigned short id = CLASSIC_TIFF, const char byteOrder[2] = "  ",
+            const sys::Uint64_T ifdOffset = 0) :
         mId(id), mIFDOffset(ifdOffset)
     {
+        // The first IFD defaults to immediately following the header.
+        if (mIFDOffset == 0)
+            mIFDOffset = isBigTIFF() ? 16 : 8;
+
         const bool isBigEndian = sys::isBigEndianSystem();
         // The code below previously used strncpy(), but compilers are now
         // quite aggressive about checking for potential problems.  We're only
@@ -126,11 +133,31 @@ public:
      * @return
      *   the IFD offset
      *****************************************************************/
-    sys::Uint32_T getIFDOffset() const
+    sys::Uint64_T getIFDOffset() const
     {
         return mIFDOffset;
     }
 
+    /**
+     *****************************************************************
+     * Returns true if this is a BigTIFF header.  BigTIFF files use
+     * 8-byte offsets and counts throughout.
+     *****************************************************************/
+    bool isBigTIFF() const
+    {
+        return mId == BIG_TIFF;
+    }
+
+    /**
+     *****************************************************************
+     * Returns the size of an offset in the file, 4 bytes for classic
+     * TIFF and 8 bytes for BigTIFF.
+     *****************************************************************/
+    unsigned short getOffsetSize() const
+    {
+        return isBigTIFF() ? 8 : 4;
+    }
+
     ByteOrder getByteOrder() const
     {
         if (mByteOrder[0] == 'M' && mByteOrder[1] == 'M')
@@ -153,7 +180,7 @@ private:
     unsigned short mId;
 
     //! The IFD offset
-    sys::Uint32_T mIFDOffset;
+    sys::Uint64_T mIFDOffset;
     
     bool mDifferentByteOrdering;
     
@@ -23,8 +23,10 @@
 #ifndef __TIFF_IFD_H__
 #define __TIFF_IFD_H__
 
-#include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <import/io.h>
 #include <import/except.h>
@@ -50,8 +52,8 @@ namespace tiff
 class CODA_OSS_API IFD : public io::Serializable
 {
 public:
-    //! The IFDType
-    typedef std::map<unsigned short, tiff::IFDEntry *> IFDType;
+    //! The IFDType, kept sorted by tag
+    typedef std::vector<std::pair<unsigned short, tiff::IFDEntry *> > IFDType;
 
     //! Constructor
     IFD() = default;
@@ -159,13 +161,8 @@ public:
         if (!mapEntry)
             throw except::Exception(Ctxt(str::Format("Unable to add IFD Entry: unknown tag [%s]", name)));
 
-        const auto id = mapEntry->getTagID();
-        const auto type = mapEntry->getType();
-
-        mIFD[id] = new tiff::IFDEntry;
-        *(mIFD[id]) = *mapEntry;
-        mIFD[id]->addValue(tiff::TypeFactory::create( (unsigned char *)&value,
-                type));
+        add(*mapEntry)->addValue(tiff::TypeFactory::create(
+                (unsigned char *)&value, mapEntry->getType()));
     }
 
     /**
@@ -195,8 +192,12 @@ public:
      *
      * @param output
      *   the output stream to write the IFD to
+     * @param bigTIFF
+     *   whether to use the BigTIFF layout (8-byte entry count and
+     *   next IFD offset, 20-byte entries)
      *****************************************************************/
     void serialize(io::OutputStream& output) override;
+    void serialize(io::OutputStream& output, const bool bigTIFF);
 
     /**
      *****************************************************************
@@ -204,9 +205,13 @@ public:
      *
      * @param input
      *   the input stream to read the IFD from
+     * @param bigTIFF
+     *   whether the IFD uses the BigTIFF layout
      *****************************************************************/
     void deserialize(io::InputStream& input) override;
     void deserialize(io::InputStream& input, const bool reverseBytes);
+    void deserialize(io::InputStream& input, const bool reverseBytes,
+                     const bool bigTIFF);
 
     /**
      *****************************************************************
@@ -281,7 +286,7 @@ public:
      * @return
      *   the offset to write the next IFD offset to
      *****************************************************************/
-    sys::Uint32_T getNextIFDOffsetPosition()
+    sys::Uint64_T getNextIFDOffsetPosition()
     {
         return mNextIFDOffsetPosition;
     }
@@ -297,21 +302,40 @@ private:
      * @param offset
      *   the file offset that indicates the beginning position of 
      *   the IFD.
+     * @param bigTIFF
+     *   whether the IFD will be written in the BigTIFF layout
      * @return
      *   the highest overflow offset calculated, this marks the
      *   potential beginning of the next image.
      *****************************************************************/
-    sys::Uint32_T finalize(const sys::Uint32_T offset);
+    sys::Uint64_T finalize(const sys::Uint64_T offset, const bool bigTIFF);
 
-    //! The IFD entries
+    /**
+     *****************************************************************
+     * Returns the position of the specified tag in the IFD, or the
+     * position where it would be inserted.
+     *****************************************************************/
+    IFDType::iterator find(unsigned short tag);
+    IFDType::const_iterator find(unsigned short tag) const;
+
+    /**
+     *****************************************************************
+     * Adds the specified entry to the IFD, replacing (and freeing)
+     * any entry that already has the same tag.  The first overload
+     * takes ownership; the second copies a value-less template entry
+     * such as those in the KnownTags registry.
+     *
+     * @return
+     *   the entry owned by the IFD
+     *****************************************************************/
+    tiff::IFDEntry* add(std::unique_ptr<tiff::IFDEntry> entry);
+    tiff::IFDEntry* add(const tiff::IFDEntry& entry);
+
+    //! The IFD entries, sorted by tag for binary searching
     IFDType mIFD;
-    IFDType ifd() const
-    {
-        return mIFD;
-    }
 
     //! Offset where the next IFD offset can be written to
-    sys::Uint32_T mNextIFDOffsetPosition = 0;
+    sys::Uint64_T mNextIFDOffsetPosition = 0;
 };
 
 } // End namespace.
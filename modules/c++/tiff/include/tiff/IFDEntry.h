@@ -117,14 +117,41 @@ public:
         return mValues[index];
     }
 
+    /**
+     *****************************************************************
+     * Returns the value at the specified index as an unsigned
+     * integer.  Offsets and sizes may be stored as SHORT, LONG or,
+     * in a BigTIFF file, LONG8; this hides the difference.
+     *
+     * @param index
+     *   the index that indicates which value to retrieve
+     * @return
+     *   the value at the specified index
+     *****************************************************************/
+    sys::Uint64_T getUint64(const sys::Uint32_T index) const;
+
+    /**
+     *****************************************************************
+     * Returns every value as an unsigned integer.  The type is only
+     * checked once, so this is the cheap way to decode long arrays
+     * such as StripOffsets or TileByteCounts.
+     *
+     * @return
+     *   the values, in order
+     *****************************************************************/
+    std::vector<sys::Uint64_T> getUint64Values() const;
+
     /**
      *****************************************************************
      * Writes the IFD entry to the specified output stream.
      *
      * @param output
      *   the output stream to write the entry to
+     * @param bigTIFF
+     *   whether to use the 20-byte BigTIFF entry layout
      *****************************************************************/
     void serialize(io::OutputStream& output) override;
+    void serialize(io::OutputStream& output, const bool bigTIFF);
 
     /**
      *****************************************************************
@@ -132,9 +159,13 @@ public:
      *
      * @param input
      *   the input stream to read the entry from
+     * @param bigTIFF
+     *   whether the entry uses the 20-byte BigTIFF layout
      *****************************************************************/
     void deserialize(io::InputStream& input) override;
     void deserialize(io::InputStream& input, const bool reverseBytes);
+    void deserialize(io::InputStream& input, const bool reverseBytes,
+                     const bool bigTIFF);
 
     /**
      *****************************************************************
@@ -201,7 +232,7 @@ public:
      * @return
      *  the value offset
      *****************************************************************/
-    sys::Uint32_T getOffset() const
+    sys::Uint64_T getOffset() const
     {
         return mOffset;
     }
@@ -331,32 +362,36 @@ public:
      *****************************************************************
      * Used for outputting the IFD entry to a file.  Calculates
      * a file offset to put data that overflows the size allowed for
-     * an IFD entry value (4 bytes) and sets the value count to be
-     * the number of values that were added to the IFD entry.
+     * an IFD entry value (4 bytes, 8 for BigTIFF) and sets the value
+     * count to be the number of values that were added to the IFD
+     * entry.
      *
      * @param offset
      *   the next free file offset that the values will can be
      *   written to
+     * @param bigTIFF
+     *   whether the entry will be written in the BigTIFF layout
      * @return
      *   the next free file offset, compensating for the IFD entry's
      *   values being written at the specified input offset
      *****************************************************************/
-    sys::Uint32_T finalize(const sys::Uint32_T offset);
+    sys::Uint64_T finalize(const sys::Uint64_T offset, const bool bigTIFF = false);
 
     /**
      *****************************************************************
      * According to the TIFF 6.0 spec, the size of an IFD entry is 12
-     * bytes.  The sizeof operator is thrown off by the extra members 
-     * mName of string type, and mValues of vector type (both of which
-     * are not in the specification but exist to make life simpler),
-     * hence the adjustment.  Returns the size of the IFD entry.
+     * bytes (20 bytes for BigTIFF).  The sizeof operator is thrown
+     * off by the extra members mName of string type, and mValues of
+     * vector type (both of which are not in the specification but
+     * exist to make life simpler), hence the adjustment.  Returns the
+     * size of the IFD entry.
      *
      * @return
-     *   the size of an IFD entry (12 bytes).
+     *   the size of an IFD entry (12 or 20 bytes).
      *****************************************************************/
-    static unsigned short sizeOf()
+    static unsigned short sizeOf(const bool bigTIFF = false)
     {
-        return 12;
+        return bigTIFF ? 20 : 12;
     }
 
 private:
@@ -383,7 +418,7 @@ private:
     sys::Uint32_T mCount;
 
     //! The file offset to values for the IFD entry
-    sys::Uint32_T mOffset;
+    sys::Uint64_T mOffset;
 
     //! The name of the IFD entry (i.e. "ImageWidth")
     std::string mName;
@@ -23,11 +23,16 @@
 #ifndef __TIFF_IMAGE_READER_H__
 #define __TIFF_IMAGE_READER_H__
 
+#include <stddef.h>
+
+#include <vector>
+
 #include <import/io.h>
 #include <config/Exports.h>
 
 #include "tiff/IFDEntry.h"
 #include "tiff/IFD.h"
+#include "tiff/TileCache.h"
 
 namespace tiff
 {
@@ -52,9 +57,11 @@ public:
      *   the stream to read the TIFF image from
      *****************************************************************/
     ImageReader(io::FileInputStream *input) :
-        mIFD(), mStripByteCounts(nullptr), mStripOffsets(nullptr), mInput(input),
+        mIFD(), mInput(input),
                 mNextOffset(0), mBytePosition(0), mStripIndex(0),
-                mElementSize(0), mReverseBytes(false)
+                mElementSize(0), mCompression(0), mPredictor(0),
+                mReverseBytes(false), mTiled(false), mChunkElemWidth(0),
+                mChunkElemLength(0), mChunksAcross(0)
     {
     }
 
@@ -67,8 +74,13 @@ public:
      *****************************************************************
      * Processes the image from the file.  Reads the image's IFD
      * and stores it for later use.
+     *
+     * @param reverseBytes
+     *   whether the file is in the opposite byte order of this machine
+     * @param bigTIFF
+     *   whether the file is a BigTIFF (64-bit offsets)
      *****************************************************************/
-    void process(const bool reverseBytes = false);
+    void process(const bool reverseBytes = false, const bool bigTIFF = false);
 
     /**
      *****************************************************************
@@ -84,6 +96,8 @@ public:
      * Gets the specified number of elements from the TIFF image and
      * stores them into the specified buffer.  The buffer must be
      * allocated outside because it is not allocated in this function.
+     * Compressed strips and tiles (see tiff::Compression) are decoded
+     * in parallel directly into the buffer where possible.
      * 
      * @param buffer
      *   the buffer to populate with image data
@@ -92,6 +106,48 @@ public:
      *****************************************************************/
     void getData(unsigned char *buffer, const sys::Uint32_T numElementsToRead);
 
+    /**
+     *****************************************************************
+     * Reads a rectangular window of the image into the specified
+     * buffer, in raster order.  Every strip or tile overlapping the
+     * window is read whole, decoded (in parallel) if it isn't already
+     * in the tile cache, and the window is then copied out of the
+     * cached tiles.  This does not change the position used by
+     * getData().
+     *
+     * @param row
+     *   the first row of the window
+     * @param col
+     *   the first column of the window
+     * @param numRows
+     *   the number of rows in the window
+     * @param numCols
+     *   the number of columns in the window
+     * @param buffer
+     *   the buffer to populate; must hold numRows * numCols elements
+     *****************************************************************/
+    void readRegion(size_t row, size_t col, size_t numRows, size_t numCols,
+                    unsigned char *buffer);
+
+    /**
+     *****************************************************************
+     * Sets the most decoded bytes readRegion() keeps in its tile
+     * cache; 0 disables caching.
+     *
+     * @param numBytes
+     *   the cache budget in bytes
+     *****************************************************************/
+    void setTileCacheSize(size_t numBytes)
+    {
+        mTileCache.setMaxBytes(numBytes);
+    }
+
+    //! The cache of decoded strips or tiles used by readRegion().
+    tiff::TileCache& getTileCache()
+    {
+        return mTileCache;
+    }
+
     /**
      *****************************************************************
      * Returns a pointer to the IFD for this image.
@@ -123,7 +179,7 @@ public:
      * @return
      *   the next IFD offset
      *****************************************************************/
-    sys::Uint32_T getNextOffset() const
+    sys::Uint64_T getNextOffset() const
     {
         return mNextOffset;
     }
@@ -154,31 +210,107 @@ private:
      *****************************************************************/
     void getTileData(unsigned char *buffer, sys::Uint32_T numElementsToRead);
 
-    //! Contains the IFD for this image.
-    tiff::IFD mIFD;
+    /**
+     *****************************************************************
+     * Reads the specified number of elements into the specified
+     * buffer from a compressed image, stripped or tiled.  Every strip
+     * or tile overlapping the request is read once and the chunks
+     * are then decoded in parallel.
+     * @param buffer
+     *   the buffer to populate with image data
+     * @param numElementsToRead
+     *   the number of elements (not bytes) to read from the image
+     *****************************************************************/
+    void getCompressedData(unsigned char *buffer, sys::Uint32_T numElementsToRead);
 
-    //! A pointer to the "StripByteCounts" IFDEntry to make reading faster.
-    tiff::IFDEntry *mStripByteCounts;
+    /**
+     *****************************************************************
+     * Looks up the strip or tile layout once the IFD has been read,
+     * decoding the offsets and byte counts so reads don't go back to
+     * the IFD.
+     *****************************************************************/
+    void initChunkLayout();
+
+    //! Throws if the strip or tile layout can't be used for decoding.
+    void validateChunkLayout() const;
+
+    //! The number of rows of decoded data in the specified chunk.
+    size_t getChunkRows(size_t chunkRow) const;
+
+    /**
+     *****************************************************************
+     * Reads the raw (possibly compressed) bytes of a strip or tile.
+     * The input stream is shared, so this must not be called
+     * concurrently.
+     *****************************************************************/
+    std::vector<unsigned char> readChunk(size_t index);
 
-    //! A pointer to the "StripOffsets" IFDEntry to make reading faster.
-    tiff::IFDEntry *mStripOffsets;
+    /**
+     *****************************************************************
+     * Decompresses a strip or tile and undoes any predictor.  Safe to
+     * call concurrently on different chunks.
+     *
+     * @param raw
+     *   the bytes as read by readChunk()
+     * @param numRows
+     *   the number of rows in the chunk
+     * @param output
+     *   the buffer to decode into
+     * @param outputSize
+     *   the size of the decoded chunk in bytes
+     *****************************************************************/
+    void decodeChunk(const std::vector<unsigned char>& raw, size_t numRows,
+                     unsigned char *output, size_t outputSize) const;
+
+    //! Contains the IFD for this image.
+    tiff::IFD mIFD;
 
     //! Points to the input file stream.
     io::FileInputStream *mInput;
 
     //! The offset to the next IFD.
-    sys::Uint32_T mNextOffset;
+    sys::Uint64_T mNextOffset;
 
     //! Used to keep track of the current read position in the file.
-    sys::Uint32_T mBytePosition;
+    sys::Uint64_T mBytePosition;
     
     sys::Uint32_T mStripIndex;
 
     //! The element size of the image.
     unsigned short mElementSize;
 
+    //! The image's compression, see tiff::Const::CompressionType.
+    unsigned short mCompression;
+
+    //! The image's predictor, see tiff::Const::PredictorType.
+    unsigned short mPredictor;
+
     //! Whether to reverse bytes when reading.
     bool mReverseBytes;
+
+    //! Whether the image is tiled, otherwise strips are treated as tiles
+    bool mTiled;
+
+    //! The width of a strip or tile in elements
+    size_t mChunkElemWidth;
+
+    //! The length of a strip or tile in rows
+    size_t mChunkElemLength;
+
+    //! The number of strips or tiles across the image
+    size_t mChunksAcross;
+
+    //! The "StripOffsets" or "TileOffsets" values
+    std::vector<sys::Uint64_T> mChunkOffsets;
+
+    //! The "StripByteCounts" or "TileByteCounts" values, may be empty
+    std::vector<sys::Uint64_T> mChunkByteCounts;
+
+    //! The running total of mChunkByteCounts, stripped images only
+    std::vector<sys::Uint64_T> mStripStarts;
+
+    //! Decoded strips or tiles, see readRegion()
+    tiff::TileCache mTileCache;
 };
 
 } // End namespace.
@@ -23,6 +23,11 @@
 #ifndef __TIFF_IMAGE_WRITER_H__
 #define __TIFF_IMAGE_WRITER_H__
 
+#include <stddef.h>
+
+#include <mutex>
+#include <vector>
+
 #include <import/io.h>
 #include <config/Exports.h>
 
@@ -40,6 +45,13 @@ namespace tiff
  *
  * Writes a TIFF image to a stream.  Contains functions for writing
  * the image's IFD, and for putting data to a stream.
+ *
+ * If the IFD's Compression is LZW, PackBits or Deflate (or a
+ * Predictor is set), strips and tiles are compressed in parallel and
+ * appended to the file as they finish; their offsets and byte counts
+ * are filled in by writeIFD().  Such images can also be written a
+ * strip or tile at a time, in any order and from multiple threads,
+ * with putChunk().
  *********************************************************************/
 class CODA_OSS_API ImageWriter
 {
@@ -61,9 +73,12 @@ public:
      *   the output stream to write the image to
      * @param ifdOffset
      *   the offset to the beginning of the IFD for this image
+     * @param bigTIFF
+     *   whether the file is a BigTIFF (64-bit offsets)
      *****************************************************************/
-    ImageWriter(io::FileOutputStream *output, const sys::Uint32_T ifdOffset) :
-                mOutput(output), mIFDOffset(ifdOffset)
+    ImageWriter(io::FileOutputStream *output, const sys::Uint64_T ifdOffset,
+                const bool bigTIFF = false) :
+                mOutput(output), mIFDOffset(ifdOffset), mBigTIFF(bigTIFF)
     {
     }
 
@@ -82,6 +97,26 @@ public:
     void putData(const unsigned char *buffer,
                  sys::Uint32_T numElementsToWrite);
 
+    /**
+     *****************************************************************
+     * Compresses and writes a single strip or tile of a compressed
+     * image.  May be called concurrently and in any order, but each
+     * chunk may be written only once and not mixed with putData().
+     *
+     * @param index
+     *   the index of the strip or tile, in raster order
+     * @param data
+     *   the uncompressed chunk, getChunkSize(index) bytes.  Tiles are
+     *   always full size; pad the right and bottom edges.
+     *****************************************************************/
+    void putChunk(size_t index, const unsigned char *data);
+
+    //! The number of strips or tiles in the image.
+    size_t getNumChunks();
+
+    //! The size in bytes of an uncompressed strip or tile.
+    size_t getChunkSize(size_t index);
+
     /**
      *****************************************************************
      * Returns a pointer to this image's IFD.  Allows the user to set
@@ -95,7 +130,12 @@ public:
         return &mIFD;
     }
 
-    //! Writes this image's IFD to the output stream.
+    /**
+     *****************************************************************
+     * Writes this image's IFD to the output stream.  For a compressed
+     * image this fills in the strip and tile offsets, so it throws if
+     * any chunk is missing or the IFD was already written.
+     *****************************************************************/
     void writeIFD();
 
     /**
@@ -111,7 +151,7 @@ public:
      * @return
      *   the position to write the next IFD offset to
      *****************************************************************/
-    sys::Uint32_T getNextIFDOffset() const
+    sys::Uint64_T getNextIFDOffset() const
     {
         return mIFDOffset;
     }
@@ -183,6 +223,28 @@ private:
      *****************************************************************/
     void initTiles();
 
+    /**
+     *****************************************************************
+     * Adds an empty StripOffsets or TileOffsets entry; these are LONG8
+     * in a BigTIFF file and LONG otherwise.
+     *
+     * @param name
+     *   the name of the entry to add
+     *****************************************************************/
+    void addOffsetsEntry(const std::string& name);
+
+    /**
+     *****************************************************************
+     * Appends a file offset to a StripOffsets or TileOffsets entry.
+     * Throws if the offset doesn't fit in a classic TIFF.
+     *
+     * @param name
+     *   the name of the entry
+     * @param offset
+     *   the file offset to append
+     *****************************************************************/
+    void addOffsetValue(const std::string& name, const sys::Uint64_T offset);
+
     /**
      *****************************************************************
      * Writes data to a file in stripped format.
@@ -207,6 +269,38 @@ private:
     void putTileData(const unsigned char *buffer,
                      sys::Uint32_T numElementsToWrite);
 
+    /**
+     *****************************************************************
+     * Buffers raster data for a compressed image, compressing and
+     * writing complete rows of strips or tiles in parallel.
+     *
+     * @param buffer
+     *   the buffer to write to the file
+     * @param numElementsToWrite
+     *   the number of elements (not bytes) to write to the file
+     *****************************************************************/
+    void putCompressedData(const unsigned char *buffer,
+                           sys::Uint32_T numElementsToWrite);
+
+    //! Compresses and writes every chunk in mPending.
+    void flushPending();
+
+    //! Sets up the strip or tile layout used for compressed images.
+    void initChunks(size_t chunkElemWidth, size_t chunkElemLength);
+
+    //! Compresses a chunk; safe to call concurrently.
+    std::vector<unsigned char> encodeChunk(const unsigned char *data,
+                                           size_t numRows) const;
+
+    //! Appends a compressed chunk to the file and records its location.
+    void appendChunk(size_t index, const std::vector<unsigned char>& encoded);
+
+    //! Adds the offsets and byte counts of a compressed image to the IFD.
+    void finalizeChunks();
+
+    //! Whether the image's chunks go through tiff::Compression
+    bool isEncoded() const;
+
     //! The TIFF IFD for this image
     tiff::IFD mIFD;
 
@@ -229,13 +323,16 @@ private:
     io::FileOutputStream *mOutput = nullptr;
 
     //! The position to write the next IFD to
-    sys::Uint32_T mIFDOffset;
+    sys::Uint64_T mIFDOffset;
+
+    //! Whether the file is a BigTIFF
+    bool mBigTIFF = false;
 
     //! The ideal size of a tile
     sys::Uint32_T mIdealChunkSize = CHUNK_SIZE;
 
     //! Used to determine the position in the image
-    sys::Uint32_T mBytePosition = 0;
+    sys::Uint64_T mBytePosition = 0;
 
     //! The image's element size.  Stored here to prevent frequent IFD access
     unsigned short mElementSize = 0;
@@ -245,6 +342,45 @@ private:
 
     //! The format of the file, either TILED or STRIPPED
     ImageFormat mFormat = STRIPPED;
+
+    //! The image's compression, see tiff::Const::CompressionType.
+    unsigned short mCompression = 1;
+
+    //! The image's predictor, see tiff::Const::PredictorType.
+    unsigned short mPredictor = 1;
+
+    //! The width of a strip or tile in elements
+    size_t mChunkElemWidth = 0;
+
+    //! The length of a strip or tile in rows
+    size_t mChunkElemLength = 0;
+
+    //! The number of strips or tiles across the image
+    size_t mChunksAcross = 0;
+
+    //! Where each compressed chunk was written
+    std::vector<sys::Uint64_T> mChunkOffsets;
+
+    //! The compressed size of each chunk
+    std::vector<sys::Uint64_T> mChunkByteCounts;
+
+    //! Whether each chunk has been written
+    std::vector<bool> mChunkWritten;
+
+    //! Whether finalizeChunks() has filled in the IFD
+    bool mChunksFinalized = false;
+
+    //! The end of the compressed data written so far
+    sys::Uint64_T mAppendOffset = 0;
+
+    //! Raster data from putData() waiting to be compressed
+    std::vector<unsigned char> mPending;
+
+    //! The image row at the start of mPending
+    size_t mPendingRow = 0;
+
+    //! Guards the output stream and chunk bookkeeping in putChunk()
+    std::mutex mMutex;
 };
 
 } // End namespace.
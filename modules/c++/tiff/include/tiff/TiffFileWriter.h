@@ -65,6 +65,23 @@ struct CODA_OSS_API FileWriter
         openFile(fileName);
     }
 
+    /**
+     *****************************************************************
+     * Constructor.  Opens the specified file name for writing,
+     * optionally as a BigTIFF (64-bit offsets) so that the file may
+     * exceed 4GB.
+     *
+     * @param fileName
+     *   the file to open for writing
+     * @param bigTIFF
+     *   whether to write a BigTIFF
+     *****************************************************************/
+    FileWriter(const std::string& fileName, bool bigTIFF) :
+        mIFDOffset(0), mHeader(bigTIFF ? tiff::Header::BIG_TIFF : tiff::Header::CLASSIC_TIFF)
+    {
+        openFile(fileName);
+    }
+
     //! Destructor
     ~FileWriter();
 
@@ -122,7 +139,7 @@ struct CODA_OSS_API FileWriter
 
 private:
     //! The position to write the offset to the first IFD to
-    sys::Uint32_T mIFDOffset;
+    sys::Uint64_T mIFDOffset;
 
     //! The output stream
     io::FileOutputStream mOutput;
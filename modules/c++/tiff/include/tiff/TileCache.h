@@ -0,0 +1,132 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+#ifndef CODA_OSS_tiff_TileCache_h_INCLUDED_
+#define CODA_OSS_tiff_TileCache_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <config/Exports.h>
+
+namespace tiff
+{
+
+/**
+ *********************************************************************
+ * @class TileCache
+ * @brief A least-recently-used cache of decoded strips or tiles.
+ *
+ * Tiles are keyed by their index in the TileOffsets (or StripOffsets)
+ * entry and held by shared_ptr, so a tile that is evicted while a
+ * caller is still copying out of it stays alive until the caller is
+ * done.  The cache is bounded by the total number of bytes it holds;
+ * a tile larger than the whole budget is never retained.  All
+ * operations are thread-safe.
+ *********************************************************************/
+class CODA_OSS_API TileCache final
+{
+public:
+    typedef std::shared_ptr<const std::vector<unsigned char> > TilePtr;
+
+    //! The default budget, in bytes
+    static const size_t DEFAULT_MAX_BYTES;
+
+    /**
+     *****************************************************************
+     * Constructor.
+     *
+     * @param maxBytes
+     *   the most decoded bytes to hold at once; 0 disables caching
+     *****************************************************************/
+    explicit TileCache(size_t maxBytes = DEFAULT_MAX_BYTES) :
+        mMaxBytes(maxBytes)
+    {
+    }
+
+    TileCache(const TileCache&) = delete;
+    TileCache& operator=(const TileCache&) = delete;
+
+    /**
+     *****************************************************************
+     * Looks up a tile, marking it as the most recently used.
+     *
+     * @param index
+     *   the index of the tile
+     * @return
+     *   the tile, or nullptr if it isn't cached
+     *****************************************************************/
+    TilePtr get(size_t index);
+
+    /**
+     *****************************************************************
+     * Adds (or replaces) a tile, evicting the least recently used
+     * tiles until the cache is back within its budget.  A tile larger
+     * than the whole budget is not cached, though it still drops any
+     * tile previously cached at that index.
+     *
+     * @param index
+     *   the index of the tile
+     * @param tile
+     *   the decoded tile
+     *****************************************************************/
+    void put(size_t index, TilePtr tile);
+
+    //! Drops every cached tile.
+    void clear();
+
+    //! Changes the budget, evicting tiles if necessary.
+    void setMaxBytes(size_t maxBytes);
+
+    size_t getMaxBytes() const;
+
+    //! The number of decoded bytes currently held
+    size_t getNumBytes() const;
+
+    //! The number of tiles currently held
+    size_t size() const;
+
+private:
+    typedef std::list<std::pair<size_t, TilePtr> > TileList;
+
+    //! Must be called with mMutex held.
+    void evict();
+
+    mutable std::mutex mMutex;
+    size_t mMaxBytes;
+    size_t mNumBytes = 0;
+
+    //! The tiles, most recently used first
+    TileList mTiles;
+    std::unordered_map<size_t, TileList::iterator> mIndex;
+};
+
+} // End namespace.
+
+#endif // CODA_OSS_tiff_TileCache_h_INCLUDED_
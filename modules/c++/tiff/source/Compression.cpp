@@ -0,0 +1,642 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "tiff/Compression.h"
+
+#include <string.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <import/except.h>
+#include <import/str.h>
+#include <sys/ByteSwap.h>
+
+#include "tiff/Common.h"
+#include "tiff/tiff_config.h"
+
+#ifdef TIFF_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+
+namespace
+{
+constexpr str::FormatString<unsigned short> unsupportedCompression("Unsupported compression type: %d");
+}
+
+bool tiff::Compression::isSupported(unsigned short compression)
+{
+    switch (compression)
+    {
+    case tiff::Const::CompressionType::NO_COMPRESSION:
+    case tiff::Const::CompressionType::LZW:
+    case tiff::Const::CompressionType::PACK_BITS:
+        return true;
+
+    case tiff::Const::CompressionType::DEFLATE:
+    case tiff::Const::CompressionType::DEFLATE_OLD:
+#ifdef TIFF_ZLIB_SUPPORT
+        return true;
+#else
+        return false;
+#endif
+
+    default:
+        return false;
+    }
+}
+
+size_t tiff::Compression::decompress(unsigned short compression,
+                                     const unsigned char* input, size_t inputSize,
+                                     unsigned char* output, size_t outputSize)
+{
+    switch (compression)
+    {
+    case tiff::Const::CompressionType::NO_COMPRESSION:
+    {
+        const auto numBytes = std::min(inputSize, outputSize);
+        memcpy(output, input, numBytes);
+        return numBytes;
+    }
+    case tiff::Const::CompressionType::LZW:
+        return decodeLZW(input, inputSize, output, outputSize);
+
+    case tiff::Const::CompressionType::PACK_BITS:
+        return unpackBits(input, inputSize, output, outputSize);
+
+    case tiff::Const::CompressionType::DEFLATE:
+    case tiff::Const::CompressionType::DEFLATE_OLD:
+        return inflate(input, inputSize, output, outputSize);
+
+    default:
+        throw except::Exception(Ctxt(str::Format(unsupportedCompression, compression)));
+    }
+}
+
+size_t tiff::Compression::unpackBits(const unsigned char* input, size_t inputSize,
+                                     unsigned char* output, size_t outputSize)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while (in < inputSize && out < outputSize)
+    {
+        const auto n = static_cast<signed char>(input[in++]);
+        if (n >= 0)
+        {
+            // Copy the next n + 1 bytes literally.
+            auto count = static_cast<size_t>(n) + 1;
+            count = std::min(count, inputSize - in);
+            count = std::min(count, outputSize - out);
+            memcpy(output + out, input + in, count);
+            in += count;
+            out += count;
+        }
+        else if (n != -128)
+        {
+            // Repeat the next byte -n + 1 times; -128 is a no-op.
+            if (in >= inputSize)
+                break;
+            auto count = static_cast<size_t>(1 - n);
+            count = std::min(count, outputSize - out);
+            memset(output + out, input[in++], count);
+            out += count;
+        }
+    }
+    return out;
+}
+
+namespace
+{
+constexpr unsigned short LZW_CLEAR_CODE = 256;
+constexpr unsigned short LZW_EOI_CODE = 257;
+constexpr unsigned short LZW_FIRST_CODE = 258;
+constexpr unsigned short LZW_MAX_CODES = 4096;
+constexpr unsigned short LZW_MIN_BITS = 9;
+constexpr unsigned short LZW_MAX_BITS = 12;
+
+// The string table for a single LZW strip.  Each entry is stored as its
+// prefix code plus final byte, so strings are emitted back-to-front.
+struct LZWTable final
+{
+    uint16_t prefix[LZW_MAX_CODES];
+    uint16_t length[LZW_MAX_CODES];
+    unsigned char suffix[LZW_MAX_CODES];
+    unsigned char first[LZW_MAX_CODES];
+
+    LZWTable()
+    {
+        for (uint16_t ii = 0; ii < 256; ++ii)
+        {
+            prefix[ii] = 0;
+            length[ii] = 1;
+            suffix[ii] = first[ii] = static_cast<unsigned char>(ii);
+        }
+    }
+
+    // Writes the string for 'code' into 'output', which must hold length[code] bytes.
+    void write(uint16_t code, unsigned char* output) const
+    {
+        for (auto pos = length[code]; pos > 1; --pos)
+        {
+            output[pos - 1] = suffix[code];
+            code = prefix[code];
+        }
+        output[0] = suffix[code];
+    }
+};
+}
+
+size_t tiff::Compression::decodeLZW(const unsigned char* input, size_t inputSize,
+                                    unsigned char* output, size_t outputSize)
+{
+    // Old-style (pre TIFF 6.0) LZW wrote codes LSB-first; libtiff's heuristic
+    // for spotting it is a leading zero byte followed by an odd byte.
+    if (inputSize >= 2 && input[0] == 0 && (input[1] & 0x1))
+        throw except::Exception(Ctxt("Old-style LZW compression is not supported"));
+
+    std::unique_ptr<LZWTable> pTable(new LZWTable());
+    LZWTable& table = *pTable;
+
+    size_t in = 0;
+    size_t out = 0;
+    uint32_t bitBuffer = 0;
+    unsigned short bitCount = 0;
+    unsigned short codeWidth = LZW_MIN_BITS;
+    uint16_t nextCode = LZW_FIRST_CODE;
+    uint16_t previous = LZW_CLEAR_CODE;
+
+    // Writes one table string, truncating at the end of the output buffer.
+    const auto emit = [&](uint16_t code)
+    {
+        const size_t length = table.length[code];
+        if (out + length <= outputSize)
+        {
+            table.write(code, output + out);
+            out += length;
+        }
+        else
+        {
+            unsigned char scratch[LZW_MAX_CODES];
+            table.write(code, scratch);
+            memcpy(output + out, scratch, outputSize - out);
+            out = outputSize;
+        }
+    };
+
+    while (out < outputSize)
+    {
+        while (bitCount < codeWidth && in < inputSize)
+        {
+            bitBuffer = (bitBuffer << 8) | input[in++];
+            bitCount += 8;
+        }
+        if (bitCount < codeWidth)
+            break; // ran out of data without an EOI
+
+        const auto code = static_cast<uint16_t>(
+                (bitBuffer >> (bitCount - codeWidth)) & ((1u << codeWidth) - 1));
+        bitCount -= codeWidth;
+
+        if (code == LZW_EOI_CODE)
+            break;
+
+        if (code == LZW_CLEAR_CODE)
+        {
+            codeWidth = LZW_MIN_BITS;
+            nextCode = LZW_FIRST_CODE;
+            previous = LZW_CLEAR_CODE;
+            continue;
+        }
+
+        if (previous == LZW_CLEAR_CODE)
+        {
+            if (code > 255)
+                throw except::Exception(Ctxt("Corrupt LZW data: invalid first code"));
+            emit(code);
+            previous = code;
+            continue;
+        }
+
+        if (code > nextCode)
+            throw except::Exception(Ctxt(str::Format("Corrupt LZW data: code %d out of range", code)));
+
+        if (nextCode < LZW_MAX_CODES)
+        {
+            // For the KwKwK case (code == nextCode) the new entry's final byte
+            // is the first byte of the previous string.
+            table.prefix[nextCode] = previous;
+            table.first[nextCode] = table.first[previous];
+            table.suffix[nextCode] = (code == nextCode) ? table.first[previous] : table.first[code];
+            table.length[nextCode] = static_cast<uint16_t>(table.length[previous] + 1);
+            ++nextCode;
+
+            // TIFF LZW increases the code width one code early.
+            if (nextCode + 1 >= (1 << codeWidth) && codeWidth < LZW_MAX_BITS)
+                ++codeWidth;
+        }
+        else if (code == nextCode)
+        {
+            throw except::Exception(Ctxt("Corrupt LZW data: string table overflow"));
+        }
+
+        emit(code);
+        previous = code;
+    }
+    return out;
+}
+
+size_t tiff::Compression::inflate(const unsigned char* input, size_t inputSize,
+                                  unsigned char* output, size_t outputSize)
+{
+#ifdef TIFF_ZLIB_SUPPORT
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit(&stream) != Z_OK)
+        throw except::Exception(Ctxt("Unable to initialize zlib"));
+
+    // zlib's sizes are 32-bit; strips and tiles are comfortably smaller.
+    stream.next_in = const_cast<Bytef*>(input);
+    stream.avail_in = static_cast<uInt>(inputSize);
+    stream.next_out = output;
+    stream.avail_out = static_cast<uInt>(outputSize);
+
+    const auto result = ::inflate(&stream, Z_FINISH);
+    const auto numBytes = static_cast<size_t>(stream.total_out);
+    inflateEnd(&stream);
+
+    // A full output buffer is fine even if the stream has trailing data.
+    if (result != Z_STREAM_END && stream.avail_out != 0)
+    {
+        throw except::Exception(Ctxt(str::Format("Corrupt Deflate data: zlib error %d", result)));
+    }
+    return numBytes;
+#else
+    (void)input; (void)inputSize; (void)output; (void)outputSize;
+    throw except::Exception(Ctxt("Deflate compression requires zlib support"));
+#endif
+}
+
+std::vector<unsigned char> tiff::Compression::compress(unsigned short compression,
+                                                       const unsigned char* input,
+                                                       size_t inputSize, size_t rowSize)
+{
+    switch (compression)
+    {
+    case tiff::Const::CompressionType::NO_COMPRESSION:
+        return std::vector<unsigned char>(input, input + inputSize);
+
+    case tiff::Const::CompressionType::LZW:
+        return encodeLZW(input, inputSize);
+
+    case tiff::Const::CompressionType::PACK_BITS:
+        return packBits(input, inputSize, rowSize);
+
+    case tiff::Const::CompressionType::DEFLATE:
+    case tiff::Const::CompressionType::DEFLATE_OLD:
+        return deflate(input, inputSize);
+
+    default:
+        throw except::Exception(Ctxt(str::Format(unsupportedCompression, compression)));
+    }
+}
+
+std::vector<unsigned char> tiff::Compression::packBits(const unsigned char* input,
+                                                       size_t inputSize, size_t rowSize)
+{
+    if (rowSize == 0)
+        rowSize = inputSize;
+
+    // Worst case is one header byte per 128 literal bytes.
+    std::vector<unsigned char> output;
+    output.reserve(inputSize + inputSize / 128 + 1);
+
+    for (size_t rowStart = 0; rowStart < inputSize; rowStart += rowSize)
+    {
+        const size_t rowEnd = std::min(rowStart + rowSize, inputSize);
+        size_t in = rowStart;
+        while (in < rowEnd)
+        {
+            // Runs of three or more bytes are worth replicating.
+            size_t run = 1;
+            while (in + run < rowEnd && run < 128 && input[in + run] == input[in])
+                ++run;
+            if (run >= 3)
+            {
+                output.push_back(static_cast<unsigned char>(static_cast<signed char>(1 - static_cast<int>(run))));
+                output.push_back(input[in]);
+                in += run;
+                continue;
+            }
+
+            // Otherwise gather literals up to the next worthwhile run.
+            size_t literal = 0;
+            while (in + literal < rowEnd && literal < 128)
+            {
+                const size_t pos = in + literal;
+                if (pos + 2 < rowEnd && input[pos] == input[pos + 1] &&
+                    input[pos] == input[pos + 2])
+                    break;
+                ++literal;
+            }
+            output.push_back(static_cast<unsigned char>(literal - 1));
+            output.insert(output.end(), input + in, input + in + literal);
+            in += literal;
+        }
+    }
+    return output;
+}
+
+namespace
+{
+// Writes LZW codes MSB-first.
+struct LZWBitWriter final
+{
+    std::vector<unsigned char>& output;
+    uint32_t bitBuffer = 0;
+    unsigned short bitCount = 0;
+
+    explicit LZWBitWriter(std::vector<unsigned char>& output_) : output(output_)
+    {
+    }
+
+    void write(uint16_t code, unsigned short codeWidth)
+    {
+        bitBuffer = (bitBuffer << codeWidth) | code;
+        bitCount += codeWidth;
+        while (bitCount >= 8)
+        {
+            output.push_back(static_cast<unsigned char>(bitBuffer >> (bitCount - 8)));
+            bitCount -= 8;
+        }
+    }
+
+    void flush()
+    {
+        if (bitCount > 0)
+            output.push_back(static_cast<unsigned char>(bitBuffer << (8 - bitCount)));
+        bitCount = 0;
+    }
+};
+
+// Maps (prefix code, next byte) to a table code with open addressing.
+struct LZWHashTable final
+{
+    static constexpr size_t SIZE = 8192; // a power of two, > 2x LZW_MAX_CODES
+    uint32_t keys[SIZE];
+    uint16_t codes[SIZE];
+
+    LZWHashTable()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        memset(keys, 0xFF, sizeof(keys)); // EMPTY
+    }
+
+    // Returns the slot for 'key': either its entry or the empty slot to fill.
+    size_t find(uint32_t key) const
+    {
+        size_t slot = (key * 2654435761u) & (SIZE - 1);
+        while (keys[slot] != EMPTY && keys[slot] != key)
+            slot = (slot + 1) & (SIZE - 1);
+        return slot;
+    }
+
+    static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+};
+}
+
+std::vector<unsigned char> tiff::Compression::encodeLZW(const unsigned char* input,
+                                                        size_t inputSize)
+{
+    std::vector<unsigned char> output;
+    output.reserve(inputSize / 2 + 16);
+    LZWBitWriter writer(output);
+
+    std::unique_ptr<LZWHashTable> pTable(new LZWHashTable());
+    LZWHashTable& table = *pTable;
+
+    unsigned short codeWidth = LZW_MIN_BITS;
+    uint16_t nextCode = LZW_FIRST_CODE;
+    writer.write(LZW_CLEAR_CODE, codeWidth);
+
+    // Mirrors the decoder, which widens codes one code early; the table
+    // is reset just before it would overflow (as libtiff does).
+    const auto addCode = [&]()
+    {
+        ++nextCode;
+        if (nextCode == LZW_MAX_CODES - 2)
+        {
+            writer.write(LZW_CLEAR_CODE, codeWidth);
+            table.clear();
+            nextCode = LZW_FIRST_CODE;
+            codeWidth = LZW_MIN_BITS;
+        }
+        else if (nextCode >= (1 << codeWidth) && codeWidth < LZW_MAX_BITS)
+        {
+            ++codeWidth;
+        }
+    };
+
+    if (inputSize > 0)
+    {
+        uint16_t current = input[0];
+        for (size_t in = 1; in < inputSize; ++in)
+        {
+            const uint32_t key = (static_cast<uint32_t>(current) << 8) | input[in];
+            const size_t slot = table.find(key);
+            if (table.keys[slot] == key)
+            {
+                current = table.codes[slot];
+                continue;
+            }
+
+            writer.write(current, codeWidth);
+            table.keys[slot] = key;
+            table.codes[slot] = nextCode;
+            addCode();
+            current = input[in];
+        }
+
+        // The decoder adds an entry for the last code too.
+        writer.write(current, codeWidth);
+        addCode();
+    }
+
+    writer.write(LZW_EOI_CODE, codeWidth);
+    writer.flush();
+    return output;
+}
+
+std::vector<unsigned char> tiff::Compression::deflate(const unsigned char* input,
+                                                      size_t inputSize)
+{
+#ifdef TIFF_ZLIB_SUPPORT
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit(&stream, Z_DEFAULT_COMPRESSION) != Z_OK)
+        throw except::Exception(Ctxt("Unable to initialize zlib"));
+
+    std::vector<unsigned char> output(deflateBound(&stream, static_cast<uLong>(inputSize)));
+    stream.next_in = const_cast<Bytef*>(input);
+    stream.avail_in = static_cast<uInt>(inputSize);
+    stream.next_out = output.data();
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    const auto result = ::deflate(&stream, Z_FINISH);
+    output.resize(static_cast<size_t>(stream.total_out));
+    deflateEnd(&stream);
+
+    if (result != Z_STREAM_END)
+        throw except::Exception(Ctxt(str::Format("Unable to compress data: zlib error %d", result)));
+    return output;
+#else
+    (void)input; (void)inputSize;
+    throw except::Exception(Ctxt("Deflate compression requires zlib support"));
+#endif
+}
+
+namespace
+{
+template <typename T>
+inline T load(const unsigned char* p, bool reverseBytes)
+{
+    T value;
+    memcpy(&value, p, sizeof(T));
+    return reverseBytes ? sys::byteSwap(value) : value;
+}
+template <typename T>
+inline void store(unsigned char* p, T value, bool reverseBytes)
+{
+    if (reverseBytes)
+        value = sys::byteSwap(value);
+    memcpy(p, &value, sizeof(T));
+}
+
+template <typename T>
+void accumulate(unsigned char* data, size_t numRows, size_t samplesPerRow,
+                size_t samplesPerPixel, bool reverseBytes)
+{
+    const size_t rowBytes = samplesPerRow * sizeof(T);
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        unsigned char* const rowData = data + row * rowBytes;
+        for (size_t ii = samplesPerPixel; ii < samplesPerRow; ++ii)
+        {
+            auto p = rowData + ii * sizeof(T);
+            const auto left = load<T>(p - samplesPerPixel * sizeof(T), reverseBytes);
+            const auto value = load<T>(p, reverseBytes);
+            store<T>(p, static_cast<T>(value + left), reverseBytes);
+        }
+    }
+}
+
+// The inverse of accumulate(); each row is processed right to left.
+template <typename T>
+void difference(unsigned char* data, size_t numRows, size_t samplesPerRow,
+                size_t samplesPerPixel, bool reverseBytes)
+{
+    const size_t rowBytes = samplesPerRow * sizeof(T);
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        unsigned char* const rowData = data + row * rowBytes;
+        for (size_t ii = samplesPerRow; ii-- > samplesPerPixel;)
+        {
+            auto p = rowData + ii * sizeof(T);
+            const auto left = load<T>(p - samplesPerPixel * sizeof(T), reverseBytes);
+            const auto value = load<T>(p, reverseBytes);
+            store<T>(p, static_cast<T>(value - left), reverseBytes);
+        }
+    }
+}
+
+template <>
+void accumulate<uint8_t>(unsigned char* data, size_t numRows, size_t samplesPerRow,
+                         size_t samplesPerPixel, bool)
+{
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        unsigned char* const rowData = data + row * samplesPerRow;
+        for (size_t ii = samplesPerPixel; ii < samplesPerRow; ++ii)
+            rowData[ii] = static_cast<uint8_t>(rowData[ii] + rowData[ii - samplesPerPixel]);
+    }
+}
+}
+
+void tiff::Compression::applyHorizontalPredictor(unsigned char* data,
+                                                 size_t numRows, size_t numColumns,
+                                                 unsigned short samplesPerPixel,
+                                                 unsigned short bytesPerSample,
+                                                 bool reverseBytes)
+{
+    const size_t samplesPerRow = numColumns * samplesPerPixel;
+    switch (bytesPerSample)
+    {
+    case 1:
+        difference<uint8_t>(data, numRows, samplesPerRow, samplesPerPixel, false);
+        break;
+    case 2:
+        difference<uint16_t>(data, numRows, samplesPerRow, samplesPerPixel, reverseBytes);
+        break;
+    case 4:
+        difference<uint32_t>(data, numRows, samplesPerRow, samplesPerPixel, reverseBytes);
+        break;
+    case 8:
+        difference<uint64_t>(data, numRows, samplesPerRow, samplesPerPixel, reverseBytes);
+        break;
+    default:
+        throw except::Exception(Ctxt(str::Format(
+                "Horizontal predictor unsupported for %d byte samples", bytesPerSample)));
+    }
+}
+
+void tiff::Compression::undoHorizontalPredictor(unsigned char* data,
+                                                size_t numRows, size_t numColumns,
+                                                unsigned short samplesPerPixel,
+                                                unsigned short bytesPerSample,
+                                                bool reverseBytes)
+{
+    const size_t samplesPerRow = numColumns * samplesPerPixel;
+    switch (bytesPerSample)
+    {
+    case 1:
+        accumulate<uint8_t>(data, numRows, samplesPerRow, samplesPerPixel, reverseBytes);
+        break;
+    case 2:
+        accumulate<uint16_t>(data, numRows, samplesPerRow, samplesPerPixel, reverseBytes);
+        break;
+    case 4:
+        accumulate<uint32_t>(data, numRows, samplesPerRow, samplesPerPixel, reverseBytes);
+        break;
+    case 8:
+        accumulate<uint64_t>(data, numRows, samplesPerRow, samplesPerPixel, reverseBytes);
+        break;
+    default:
+        throw except::Exception(Ctxt(str::Format(
+                "Horizontal predictor unsupported for %d byte samples", bytesPerSample)));
+    }
+}
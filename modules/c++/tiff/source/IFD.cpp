@@ -27,6 +27,8 @@
 #include "tiff/IFDEntry.h"
 #include "tiff/KnownTags.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <sstream>
 #include <import/io.h>
@@ -46,28 +48,37 @@ const tiff::IFDEntry* tiff::IFD::operator[](const char* name) const
     return (*this)[mapEntry->getTagID()];
 }
 
+tiff::IFD::IFDType::iterator tiff::IFD::find(unsigned short tag)
+{
+    return std::lower_bound(mIFD.begin(), mIFD.end(), tag,
+            [](const IFDType::value_type& lhs, unsigned short rhs)
+            {
+                return lhs.first < rhs;
+            });
+}
+tiff::IFD::IFDType::const_iterator tiff::IFD::find(unsigned short tag) const
+{
+    return std::lower_bound(mIFD.begin(), mIFD.end(), tag,
+            [](const IFDType::value_type& lhs, unsigned short rhs)
+            {
+                return lhs.first < rhs;
+            });
+}
+
 tiff::IFDEntry *tiff::IFD::operator[](unsigned short tag)
 {
-    // Ensures that the key exists.  Without this check, the defined
-    // behavior for the [] operator is to create an entry if it does
-    // not exist.  This is to make sure that the map doesn't get full
-    // of invalid key/value pairs if you're just trying to verify whether
-    // a key already exists of not.
-    return exists(tag) ? mIFD[tag] : nullptr;
+    const auto it = find(tag);
+    return (it != mIFD.end() && it->first == tag) ? it->second : nullptr;
 }
 const tiff::IFDEntry* tiff::IFD::operator[](unsigned short tag) const
 {
-    // Ensures that the key exists.  Without this check, the defined
-    // behavior for the [] operator is to create an entry if it does
-    // not exist.  This is to make sure that the map doesn't get full
-    // of invalid key/value pairs if you're just trying to verify whether
-    // a key already exists of not.
-    return exists(tag) ? ifd()[tag] : nullptr;
+    const auto it = find(tag);
+    return (it != mIFD.end() && it->first == tag) ? it->second : nullptr;
 }
 
 bool tiff::IFD::exists(unsigned short tag) const
 {
-    return mIFD.find(tag) != mIFD.end();
+    return (*this)[tag] != nullptr;
 }
 
 bool tiff::IFD::exists(const char *name) const
@@ -78,11 +89,29 @@ bool tiff::IFD::exists(const char *name) const
     return exists(mapEntry->getTagID());
 }
 
+tiff::IFDEntry* tiff::IFD::add(std::unique_ptr<tiff::IFDEntry> entry)
+{
+    const unsigned short id = entry->getTagID();
+    const auto it = find(id);
+    if (it != mIFD.end() && it->first == id)
+    {
+        delete it->second;
+        it->second = entry.release();
+        return it->second;
+    }
+    return mIFD.insert(it, IFDType::value_type(id, entry.release()))->second;
+}
+
+tiff::IFDEntry* tiff::IFD::add(const tiff::IFDEntry& entry)
+{
+    std::unique_ptr<tiff::IFDEntry> copy(new tiff::IFDEntry);
+    *copy = entry;
+    return add(std::move(copy));
+}
+
 void tiff::IFD::addEntry(const tiff::IFDEntry *entry)
 {
-    unsigned short id = entry->getTagID();
-    mIFD[id] = new tiff::IFDEntry;
-    *(mIFD[id]) = *entry;
+    add(*entry);
 }
 
 void tiff::IFD::addEntry(const std::string& name)
@@ -92,10 +121,7 @@ void tiff::IFD::addEntry(const std::string& name)
     if (!mapEntry)
         throw except::Exception(Ctxt(str::Format("Unable to add IFD Entry: unknown tag [%s]", name)));
 
-    unsigned short id = mapEntry->getTagID();
-
-    mIFD[id] = new tiff::IFDEntry;
-    *(mIFD[id]) = *mapEntry;
+    add(*mapEntry);
 }
 
 void tiff::IFD::deserialize(io::InputStream& input)
@@ -105,20 +131,45 @@ void tiff::IFD::deserialize(io::InputStream& input)
 
 void tiff::IFD::deserialize(io::InputStream& input, const bool reverseBytes)
 {
-    unsigned short ifdEntryCount;
-    input.read((sys::byte *)&ifdEntryCount, sizeof(ifdEntryCount));
-    if (reverseBytes)
-        ifdEntryCount = sys::byteSwap(ifdEntryCount);
+    deserialize(input, reverseBytes, false);
+}
+
+void tiff::IFD::deserialize(io::InputStream& input, const bool reverseBytes,
+                            const bool bigTIFF)
+{
+    sys::Uint64_T ifdEntryCount;
+    if (bigTIFF)
+    {
+        input.read((sys::byte *)&ifdEntryCount, sizeof(ifdEntryCount));
+        if (reverseBytes)
+            ifdEntryCount = sys::byteSwap(ifdEntryCount);
+    }
+    else
+    {
+        unsigned short count;
+        input.read((sys::byte *)&count, sizeof(count));
+        if (reverseBytes)
+            count = sys::byteSwap(count);
+        ifdEntryCount = count;
+    }
 
-    for (unsigned short i = 0; i < ifdEntryCount; i++)
+    // Entries are normally already sorted by tag, so this is a
+    // sequence of appends.
+    mIFD.reserve(mIFD.size() + static_cast<size_t>(ifdEntryCount));
+    for (sys::Uint64_T i = 0; i < ifdEntryCount; i++)
     {
-        tiff::IFDEntry *entry = new tiff::IFDEntry();
-        entry->deserialize(input, reverseBytes);
-        mIFD[entry->getTagID()] = entry;
+        std::unique_ptr<tiff::IFDEntry> entry(new tiff::IFDEntry);
+        entry->deserialize(input, reverseBytes, bigTIFF);
+        add(std::move(entry));
     }
 }
 
 void tiff::IFD::serialize(io::OutputStream& output)
+{
+    serialize(output, false);
+}
+
+void tiff::IFD::serialize(io::OutputStream& output, const bool bigTIFF)
 {
     io::Seekable *seekable =
             dynamic_cast<io::Seekable *>(&output);
@@ -128,29 +179,38 @@ void tiff::IFD::serialize(io::OutputStream& output)
     // Makes sure all data offsets are defined for each entry.
     // Keep the offset just past the end of the IFD.  This offset
     // is where the next potential image could be written.
-    const auto endOffset = finalize(static_cast<sys::Uint32_T>(seekable->tell()));
+    const auto endOffset = finalize(static_cast<sys::Uint64_T>(seekable->tell()), bigTIFF);
 
     // Write out IFD entry count.
-    const auto ifdEntryCount = static_cast<uint16_t>(mIFD.size());
-    output.write((sys::byte *)&ifdEntryCount, sizeof(ifdEntryCount));
+    if (bigTIFF)
+    {
+        const auto ifdEntryCount = static_cast<sys::Uint64_T>(mIFD.size());
+        output.write((sys::byte *)&ifdEntryCount, sizeof(ifdEntryCount));
+    }
+    else
+    {
+        const auto ifdEntryCount = static_cast<uint16_t>(mIFD.size());
+        output.write((sys::byte *)&ifdEntryCount, sizeof(ifdEntryCount));
+    }
 
     // Write out each IFD entry.
     for (IFDType::const_iterator i = mIFD.begin(); i != mIFD.end(); ++i)
     {
         tiff::IFDEntry *entry = i->second;
-        entry->serialize(output);
+        entry->serialize(output, bigTIFF);
     }
 
     // Remember the current position in case there is another IFD after
     // this one.
-    mNextIFDOffsetPosition = static_cast<sys::Uint32_T>(seekable->tell());
+    mNextIFDOffsetPosition = static_cast<sys::Uint64_T>(seekable->tell());
 
     // Write out the default next IFD location.
-    sys::Uint32_T nextOffset = 0;
-    output.write((sys::byte *)&nextOffset, sizeof(sys::Uint32_T));
+    const sys::Uint64_T nextOffset = 0;
+    output.write((sys::byte *)&nextOffset,
+                 bigTIFF ? sizeof(sys::Uint64_T) : sizeof(sys::Uint32_T));
 
     // Seek the end of the IFD, the next image can begin here.
-    seekable->seek(endOffset, io::Seekable::START);
+    seekable->seek(static_cast<sys::Off_T>(endOffset), io::Seekable::START);
 }
 
 void tiff::IFD::print(io::OutputStream& output) const
@@ -170,7 +230,7 @@ void tiff::IFD::print(io::OutputStream& output) const
 
 sys::Uint32_T tiff::IFD::getImageWidth() const
 {
-    auto imageWidth = (*this)[tiff::KnownTags::IMAGE_WIDTH];
+    auto imageWidth = (*this)[tiff::Const::Tag::IMAGE_WIDTH];
     if (!imageWidth)
         return 0;
 
@@ -182,7 +242,7 @@ sys::Uint32_T tiff::IFD::getImageWidth() const
 
 sys::Uint32_T tiff::IFD::getImageLength() const
 {
-    auto imageLength = (*this)[tiff::KnownTags::IMAGE_LENGTH];
+    auto imageLength = (*this)[tiff::Const::Tag::IMAGE_LENGTH];
     if (!imageLength)
         return 0;
 
@@ -205,8 +265,8 @@ unsigned short tiff::IFD::getNumBands() const
 {
     unsigned short numBands = 1;
     
-    auto samplesPerPixel = (*this)[tiff::KnownTags::SAMPLES_PER_PIXEL];
-    auto bitsPerSample = (*this)[tiff::KnownTags::BITS_PER_SAMPLE];
+    auto samplesPerPixel = (*this)[tiff::Const::Tag::SAMPLES_PER_PIXEL];
+    auto bitsPerSample = (*this)[tiff::Const::Tag::BITS_PER_SAMPLE];
     
     if (samplesPerPixel)
         numBands = *(::tiff::GenericType<unsigned short> *)(*samplesPerPixel)[0];
@@ -218,28 +278,30 @@ unsigned short tiff::IFD::getNumBands() const
 
 unsigned short tiff::IFD::getElementSize() const
 {
-    auto bitsPerSample = (*this)[tiff::KnownTags::BITS_PER_SAMPLE];
+    auto bitsPerSample = (*this)[tiff::Const::Tag::BITS_PER_SAMPLE];
     const auto bytesPerSample = (!bitsPerSample) ? 1
             : *(tiff::GenericType<unsigned short> *)(*bitsPerSample)[0] >> 3;
 
     return static_cast<unsigned short>(bytesPerSample * getNumBands());
 }
 
-sys::Uint32_T tiff::IFD::finalize(const sys::Uint32_T offset)
+sys::Uint64_T tiff::IFD::finalize(const sys::Uint64_T offset, const bool bigTIFF)
 {
     // Find the beginning offset to extra IFD data.  The IFD length is
     // the size of an IFD entry multiplied by the number of entries, plus
     // 4 bytes to hold the offset to the next IFD, and 2 bytes to hold the
-    // IFD entry count.
-    auto dataOffset = static_cast<sys::Uint32_T>(offset + sizeof(short) + (mIFD.size()
-            * tiff::IFDEntry::sizeOf()) + sizeof(sys::Uint32_T));
+    // IFD entry count.  BigTIFF uses 8 bytes for both.
+    const size_t countSize = bigTIFF ? sizeof(sys::Uint64_T) : sizeof(short);
+    const size_t nextOffsetSize = bigTIFF ? sizeof(sys::Uint64_T) : sizeof(sys::Uint32_T);
+    auto dataOffset = offset + countSize + (mIFD.size()
+            * tiff::IFDEntry::sizeOf(bigTIFF)) + nextOffsetSize;
 
     for (IFDType::iterator i = mIFD.begin(); i != mIFD.end(); ++i)
     {
         // Send in the current offset.  If the value size of the IFD entry
         // requires that data be placed outside the IFD entry, the offset that
         // is returned will be adjusted to compensate for that data.
-        dataOffset = i->second->finalize(dataOffset);
+        dataOffset = i->second->finalize(dataOffset, bigTIFF);
     }
 
     return dataOffset;
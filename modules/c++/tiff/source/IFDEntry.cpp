@@ -23,6 +23,8 @@
 #include <string>
 #include <string.h>
 #include <sstream>
+#include <limits>
+#include <vector>
 #include <import/io.h>
 #include <import/except.h>
 #include <import/mem.h>
@@ -35,6 +37,11 @@
 
 
 void tiff::IFDEntry::serialize(io::OutputStream& output)
+{
+    serialize(output, false);
+}
+
+void tiff::IFDEntry::serialize(io::OutputStream& output, const bool bigTIFF)
 {
     io::Seekable *seekable =
             dynamic_cast<io::Seekable *>(&output);
@@ -43,15 +50,26 @@ void tiff::IFDEntry::serialize(io::OutputStream& output)
 
     output.write((sys::byte *)&mTag, sizeof(mTag));
     output.write((sys::byte *)&mType, sizeof(mType));
-    output.write((sys::byte *)&mCount, sizeof(mCount));
+    if (bigTIFF)
+    {
+        const sys::Uint64_T count = mCount;
+        output.write((sys::byte *)&count, sizeof(count));
+    }
+    else
+    {
+        output.write((sys::byte *)&mCount, sizeof(mCount));
+    }
 
-    sys::Uint32_T size = mCount * tiff::Const::sizeOf(mType);
+    // The value field is 4 bytes (8 for BigTIFF); larger values are
+    // written elsewhere and the field holds their offset instead.
+    const size_t fieldSize = bigTIFF ? sizeof(sys::Uint64_T) : sizeof(sys::Uint32_T);
+    const size_t size = static_cast<size_t>(mCount) * tiff::Const::sizeOf(mType);
 
-    if (size > 4)
+    if (size > fieldSize)
     {
         // Keep the current position and jump to the write position.
         const auto current = seekable->tell();
-        seekable->seek(mOffset, io::Seekable::START);
+        seekable->seek(static_cast<sys::Off_T>(mOffset), io::Seekable::START);
 
         // Write the values out at the current cursor position
         for (sys::Uint32_T i = 0; i < mValues.size(); ++i)
@@ -62,20 +80,30 @@ void tiff::IFDEntry::serialize(io::OutputStream& output)
         seekable->seek(current, io::Seekable::START);
 
         // Write out the data offset.
-        output.write((sys::byte *)&mOffset, sizeof(mOffset));
+        if (bigTIFF)
+        {
+            output.write((sys::byte *)&mOffset, sizeof(mOffset));
+        }
+        else
+        {
+            const auto offset = static_cast<sys::Uint32_T>(mOffset);
+            output.write((sys::byte *)&offset, sizeof(offset));
+        }
     }
     else
     {
+        // The values are left-justified in the field, padded with zeros.
+        size_t written = 0;
         for (sys::Uint32_T i = 0; i < mCount; ++i)
         {
-            // The value must take up four bytes.  If the number of bytes is
-            // less than four, duplicate the value until you hit 4 bytes in length.
-            const auto iterations = (4 / mCount) / mValues[i]->size();
-
-            for (size_t j = 0; j < iterations; ++j)
-                output.write((sys::byte *)mValues[i]->data(),
-                        mValues[i]->size());
+            output.write((sys::byte *)mValues[i]->data(),
+                    mValues[i]->size());
+            written += mValues[i]->size();
         }
+
+        const sys::byte padding[sizeof(sys::Uint64_T)] = { 0 };
+        if (written < fieldSize)
+            output.write(padding, fieldSize - written);
     }
 }
 
@@ -85,6 +113,12 @@ void tiff::IFDEntry::deserialize(io::InputStream& input)
 }
 
 void tiff::IFDEntry::deserialize(io::InputStream& input, const bool reverseBytes)
+{
+    deserialize(input, reverseBytes, false);
+}
+
+void tiff::IFDEntry::deserialize(io::InputStream& input, const bool reverseBytes,
+                                 const bool bigTIFF)
 {
     io::Seekable *seekable =
             dynamic_cast<io::Seekable*>(&input);
@@ -93,58 +127,79 @@ void tiff::IFDEntry::deserialize(io::InputStream& input, const bool reverseBytes
 
     input.read((char *)&mTag, sizeof(mTag));
     input.read((char *)&mType, sizeof(mType));
-    input.read((char *)&mCount, sizeof(mCount));
-    input.read((char *)&mOffset, sizeof(mOffset));
+
+    // The value field is 4 bytes (8 for BigTIFF) and holds either the
+    // values themselves or the offset to them.
+    unsigned char field[sizeof(sys::Uint64_T)] = { 0 };
+    size_t fieldSize = sizeof(sys::Uint32_T);
+    if (bigTIFF)
+    {
+        sys::Uint64_T count = 0;
+        input.read((char *)&count, sizeof(count));
+        if (reverseBytes)
+            count = sys::byteSwap(count);
+        if (count > std::numeric_limits<sys::Uint32_T>::max())
+            throw except::Exception(Ctxt("IFD entry has too many values"));
+        mCount = static_cast<sys::Uint32_T>(count);
+
+        fieldSize = sizeof(sys::Uint64_T);
+        input.read((char *)field, fieldSize);
+
+        memcpy(&mOffset, field, sizeof(mOffset));
+    }
+    else
+    {
+        input.read((char *)&mCount, sizeof(mCount));
+        input.read((char *)field, fieldSize);
+        if (reverseBytes)
+            mCount = sys::byteSwap(mCount);
+
+        sys::Uint32_T offset;
+        memcpy(&offset, field, sizeof(offset));
+        mOffset = offset;
+    }
 
     if (reverseBytes)
     {
         mTag = sys::byteSwap(mTag);
         mType =  sys::byteSwap(mType);
-        mCount = sys::byteSwap(mCount);
-        mOffset = sys::byteSwap(mOffset);
+        mOffset = bigTIFF ? sys::byteSwap(mOffset)
+                : sys::byteSwap(static_cast<sys::Uint32_T>(mOffset));
     }
 
-    sys::Uint32_T size = mCount * tiff::Const::sizeOf(mType);
+    const size_t size = static_cast<size_t>(mCount) * tiff::Const::sizeOf(mType);
 
-    if (size > 4)
+    // Rationals are pairs of 4-byte values and are swapped as such.
+    auto elementSize = tiff::Const::sizeOf(mType);
+    size_t numElements = mCount;
+    if ((mType == tiff::Const::Type::RATIONAL) || (mType == tiff::Const::Type::SRATIONAL))
+    {
+        elementSize = tiff::Const::sizeOf(mType) / 2;
+        numElements = static_cast<size_t>(mCount) * 2;
+    }
+
+    if (size > fieldSize)
     {
         // Keep the current position and jump to the read position.
         const auto current = seekable->tell();
-        seekable->seek(mOffset, io::Seekable::START);
+        seekable->seek(static_cast<sys::Off_T>(mOffset), io::Seekable::START);
 
         // Read in the value(s);
-        sys::byte *buffer = new sys::byte[size];
-
-        input.read(buffer, size);
-        if (reverseBytes)
-        {
-            auto elementSize = tiff::Const::sizeOf(mType);
-            sys::Uint32_T numElements = mCount;
-            if ((mType == tiff::Const::Type::RATIONAL) || (mType == tiff::Const::Type::SRATIONAL))
-            {
-                elementSize = tiff::Const::sizeOf(mType) / 2;
-                numElements = mCount * 2;
-            }
-            if (elementSize > 1)
-                sys::byteSwap(buffer, elementSize, numElements);
-        }
+        std::vector<sys::byte> buffer(size);
+        input.read(buffer.data(), size);
+        if (reverseBytes && elementSize > 1)
+            sys::byteSwap(buffer.data(), elementSize, numElements);
 
-        parseValues((const unsigned char *)buffer);
-        delete[] buffer;
+        parseValues((const unsigned char *)buffer.data());
 
         // Reset the cursor position.
         seekable->seek(current, io::Seekable::START);
     }
     else
     {
-        if (reverseBytes)
-        {
-            // Re-reverse because a value may be less than 4 bytes.
-            mOffset = sys::byteSwap(mOffset);
-            const auto elementSize = tiff::Const::sizeOf(mType);
-            sys::byteSwap((sys::byte*)&mOffset, elementSize, sizeof(mOffset) / elementSize);
-        }
-        parseValues((unsigned char *)&mOffset);
+        if (reverseBytes && elementSize > 1)
+            sys::byteSwap(field, elementSize, numElements);
+        parseValues(field);
     }
 
     //try to retrieve the name as well
@@ -152,6 +207,67 @@ void tiff::IFDEntry::deserialize(io::InputStream& input, const bool reverseBytes
     mName = mapEntry ? mapEntry->getName() : "";
 }
 
+sys::Uint64_T tiff::IFDEntry::getUint64(const sys::Uint32_T index) const
+{
+    const tiff::TypeInterface* const value = mValues[index];
+    switch (mType)
+    {
+    case tiff::Const::Type::BYTE:
+    case tiff::Const::Type::UNDEFINED:
+        return *(const tiff::GenericType<unsigned char> *)value;
+    case tiff::Const::Type::SHORT:
+        return *(const tiff::GenericType<unsigned short> *)value;
+    case tiff::Const::Type::LONG:
+    case tiff::Const::Type::IFD:
+        return *(const tiff::GenericType<sys::Uint32_T> *)value;
+    case tiff::Const::Type::LONG8:
+    case tiff::Const::Type::IFD8:
+        return *(const tiff::GenericType<sys::Uint64_T> *)value;
+    default:
+        throw except::Exception(Ctxt(str::Format(
+                "IFD entry %d does not hold unsigned integers", mTag)));
+    }
+}
+
+namespace
+{
+template <typename T>
+void appendValues(const std::vector<tiff::TypeInterface*>& values,
+                  std::vector<sys::Uint64_T>& result)
+{
+    for (const auto value : values)
+        result.push_back(*(const tiff::GenericType<T> *)value);
+}
+}
+
+std::vector<sys::Uint64_T> tiff::IFDEntry::getUint64Values() const
+{
+    std::vector<sys::Uint64_T> result;
+    result.reserve(mValues.size());
+    switch (mType)
+    {
+    case tiff::Const::Type::BYTE:
+    case tiff::Const::Type::UNDEFINED:
+        appendValues<unsigned char>(mValues, result);
+        break;
+    case tiff::Const::Type::SHORT:
+        appendValues<unsigned short>(mValues, result);
+        break;
+    case tiff::Const::Type::LONG:
+    case tiff::Const::Type::IFD:
+        appendValues<sys::Uint32_T>(mValues, result);
+        break;
+    case tiff::Const::Type::LONG8:
+    case tiff::Const::Type::IFD8:
+        appendValues<sys::Uint64_T>(mValues, result);
+        break;
+    default:
+        throw except::Exception(Ctxt(str::Format(
+                "IFD entry %d does not hold unsigned integers", mTag)));
+    }
+    return result;
+}
+
 void tiff::IFDEntry::print(io::OutputStream& output) const
 {
     std::ostringstream message;
@@ -218,12 +334,13 @@ void tiff::IFDEntry::parseValues(const unsigned char *buffer)
     }
 }
 
-sys::Uint32_T tiff::IFDEntry::finalize(const sys::Uint32_T offset)
+sys::Uint64_T tiff::IFDEntry::finalize(const sys::Uint64_T offset, const bool bigTIFF)
 {
     mCount = static_cast<sys::Uint32_T>(mValues.size());
 
-    sys::Uint32_T size = mCount * tiff::Const::sizeOf(mType);
-    if (size > 4)
+    const size_t fieldSize = bigTIFF ? sizeof(sys::Uint64_T) : sizeof(sys::Uint32_T);
+    const size_t size = static_cast<size_t>(mCount) * tiff::Const::sizeOf(mType);
+    if (size > fieldSize)
     {
         mOffset = offset;
         return offset + size;
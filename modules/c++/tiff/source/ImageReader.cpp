@@ -23,27 +23,76 @@
 #include "tiff/ImageReader.h"
 
 #include <sstream>
+#include <algorithm>
+#include <memory>
+#include <vector>
 #include <import/io.h>
 #include <import/except.h>
+#include <import/sys.h>
+#include <mt/Runnable1D.h>
+#include <str/FormatString.h>
 #include "tiff/Common.h"
+#include "tiff/Compression.h"
 #include "tiff/GenericType.h"
 #include "tiff/IFDEntry.h"
 
-void tiff::ImageReader::process(const bool reverseBytes)
+namespace
+{
+constexpr str::FormatString<unsigned short> unsupportedCompression("Unsupported compression type: %d");
+
+void checkSupported(unsigned short compression, unsigned short predictor)
+{
+    if (!tiff::Compression::isSupported(compression))
+        throw except::Exception(Ctxt(str::Format(unsupportedCompression, compression)));
+
+    if (predictor != tiff::Const::PredictorType::NONE &&
+        predictor != tiff::Const::PredictorType::HORIZONTAL_DIFFERENCING)
+        throw except::Exception(Ctxt(str::Format("Unsupported predictor: %d", predictor)));
+}
+
+// A compressed strip or tile, read from the file but not yet decoded.
+struct Chunk final
+{
+    size_t row = 0; // the first image row in the chunk
+    size_t column = 0; // the chunk's column, tiled images only
+    std::vector<unsigned char> data;
+};
+}
+
+void tiff::ImageReader::process(const bool reverseBytes, const bool bigTIFF)
 {
     mReverseBytes = reverseBytes;
 
-    mIFD.deserialize(*mInput, mReverseBytes);
+    mIFD.deserialize(*mInput, mReverseBytes, bigTIFF);
 
-    mInput->read((sys::byte *)&mNextOffset, sizeof(mNextOffset));
-    if (mReverseBytes)
-        mNextOffset = sys::byteSwap(mNextOffset);
+    if (bigTIFF)
+    {
+        mInput->read((sys::byte *)&mNextOffset, sizeof(mNextOffset));
+        if (mReverseBytes)
+            mNextOffset = sys::byteSwap(mNextOffset);
+    }
+    else
+    {
+        sys::Uint32_T nextOffset;
+        mInput->read((sys::byte *)&nextOffset, sizeof(nextOffset));
+        if (mReverseBytes)
+            nextOffset = sys::byteSwap(nextOffset);
+        mNextOffset = nextOffset;
+    }
 
     // Done here to lower the number of calls to it later.
     mElementSize = mIFD.getElementSize();
 
-    mStripByteCounts = mIFD["StripByteCounts"];
-    mStripOffsets = mIFD["StripOffsets"];
+    const tiff::IFDEntry* const compression = mIFD[tiff::Const::Tag::COMPRESSION];
+    mCompression = compression ? static_cast<unsigned short>(compression->getUint64(0))
+            : static_cast<unsigned short>(tiff::Const::CompressionType::NO_COMPRESSION);
+
+    const tiff::IFDEntry* const predictor = mIFD[tiff::Const::Tag::PREDICTOR];
+    mPredictor = predictor ? static_cast<unsigned short>(predictor->getUint64(0))
+            : static_cast<unsigned short>(tiff::Const::PredictorType::NONE);
+
+    initChunkLayout();
+    mTileCache.clear();
 }
 
 void tiff::ImageReader::print(io::OutputStream &output) const
@@ -59,21 +108,19 @@ void tiff::ImageReader::print(io::OutputStream &output) const
 void tiff::ImageReader::getData(unsigned char *buffer,
         const sys::Uint32_T numElementsToRead)
 {
-    //see if it is uncompressed
-    tiff::IFDEntry *compression = mIFD["Compression"];
-    if (compression)
-    {
-        unsigned short c = *(tiff::GenericType<unsigned short> *)(*compression)[0];
-        if (c != tiff::Const::CompressionType::NO_COMPRESSION)
-            throw except::Exception(Ctxt(str::Format("Unsupported compression type: %d", c)));
-    }
-    
-    if (mIFD["StripOffsets"])
+    checkSupported(mCompression, mPredictor);
+    if (mChunkOffsets.empty())
+        throw except::Exception(Ctxt("Unsupported TIFF file format"));
+
+    // A predictor is only meaningful with compression, but some writers
+    // set it anyway; route those images through the decoding path too.
+    if (mCompression != tiff::Const::CompressionType::NO_COMPRESSION ||
+        mPredictor != tiff::Const::PredictorType::NONE)
+        getCompressedData(buffer, numElementsToRead);
+    else if (!mTiled)
         getStripData(buffer, numElementsToRead);
-    else if (mIFD["TileOffsets"])
-        getTileData(buffer, numElementsToRead);
     else
-        throw except::Exception(Ctxt("Unsupported TIFF file format"));
+        getTileData(buffer, numElementsToRead);
 
     if (mReverseBytes)
         sys::byteSwap(buffer, mElementSize, numElementsToRead);
@@ -82,29 +129,30 @@ void tiff::ImageReader::getData(unsigned char *buffer,
 void tiff::ImageReader::getStripData(unsigned char *buffer,
         sys::Uint32_T numElementsToRead)
 {
+    if (mChunkByteCounts.empty())
+        throw except::Exception(Ctxt("StripByteCounts must be defined"));
+
     sys::Uint32_T bufferOffset = 0;
     
     //figure out how far we are in the current strip
-    sys::Uint32_T stripOffset = 0;
-    for (sys::Uint32_T i = 0; i < mStripIndex; ++i)
-        stripOffset += *(tiff::GenericType<sys::Uint32_T> *)(*mStripByteCounts)[i];
-    sys::Uint32_T stripPosition = mBytePosition - stripOffset;
+    sys::Uint64_T stripPosition = mBytePosition - mStripStarts[mStripIndex];
     
     //how many bytes do we need to read?
     sys::Uint32_T numBytesToRead = numElementsToRead * mElementSize;
 
     while (numBytesToRead)
     {
-        if (mStripIndex >= mStripOffsets->getCount())
+        if (mStripIndex >= mChunkOffsets.size() ||
+            mStripIndex >= mChunkByteCounts.size())
             throw except::Exception(Ctxt("Invalid strip offset index"));
 
-        sys::Uint32_T stripSize = *(tiff::GenericType<sys::Uint32_T> *)(*mStripByteCounts)[mStripIndex];
+        const sys::Uint64_T stripSize = mChunkByteCounts[mStripIndex];
 
         // Calculate what remains to be read in the current strip.
-        sys::Uint32_T remainingBytesInStrip = stripSize - stripPosition;
+        sys::Uint64_T remainingBytesInStrip = stripSize - stripPosition;
 
         // Seek to the strip offset plus the last read position.
-        sys::Uint32_T seekPos = (*(tiff::GenericType<sys::Uint32_T> *)(*mStripOffsets)[mStripIndex]) + stripPosition;
+        sys::Uint64_T seekPos = mChunkOffsets[mStripIndex] + stripPosition;
 
         
         sys::Uint32_T thisRead = numBytesToRead;
@@ -113,12 +161,12 @@ void tiff::ImageReader::getStripData(unsigned char *buffer,
         // in the current strip, just read what can be read from the current strip.
         if (numBytesToRead > remainingBytesInStrip)
         {
-            thisRead = remainingBytesInStrip;
+            thisRead = static_cast<sys::Uint32_T>(remainingBytesInStrip);
             mStripIndex++; //increment the strip index for next time
         }
         
         // Go to the offset, and read.
-        mInput->seek(seekPos, io::Seekable::START);
+        mInput->seek(static_cast<sys::Off_T>(seekPos), io::Seekable::START);
         mInput->read((sys::byte *)buffer + bufferOffset, thisRead);
 
         // Update the tile position in bytes.
@@ -136,30 +184,15 @@ void tiff::ImageReader::getStripData(unsigned char *buffer,
 void tiff::ImageReader::getTileData(unsigned char*buffer,
         sys::Uint32_T numElementsToRead)
 {
-    // Get the image width and length.
+    validateChunkLayout();
+
+    // Get the image width and the tile layout.
     sys::Uint32_T imageElemWidth = mIFD.getImageWidth();
     sys::Uint32_T imageByteWidth = imageElemWidth * mElementSize;
-
-    // Get the tile width.
-    tiff::IFDEntry *tileWidth = mIFD["TileWidth"];
-    sys::Uint32_T tileElemWidth = 0;
-    if (tileWidth->getType() == tiff::Const::Type::LONG)
-        tileElemWidth = *(tiff::GenericType<sys::Uint32_T> *)(*tileWidth)[0];
-    else
-        tileElemWidth = *(tiff::GenericType<unsigned short> *)(*tileWidth)[0];
+    const auto tileElemWidth = static_cast<sys::Uint32_T>(mChunkElemWidth);
     sys::Uint32_T tileByteWidth = tileElemWidth * mElementSize;
-
-    // Get the tile length.
-    tiff::IFDEntry *tileLength = mIFD["TileLength"];
-    sys::Uint32_T tileElemLength = 0;
-    if (tileLength->getType() == tiff::Const::Type::LONG)
-        tileElemLength = *(tiff::GenericType<sys::Uint32_T> *)(*tileLength)[0];
-    else
-        tileElemLength = *(tiff::GenericType<unsigned short> *)(*tileLength)[0];
-
-    // Compute the number of tiles wide the image is.
-    sys::Uint32_T tilesAcross = (imageElemWidth + tileElemWidth - 1)
-            / tileElemWidth;
+    const auto tileElemLength = static_cast<sys::Uint32_T>(mChunkElemLength);
+    const auto tilesAcross = static_cast<sys::Uint32_T>(mChunksAcross);
 
     // Determine how many bytes were used to pad the right edge.
     sys::Uint32_T widthPadding = (tileByteWidth * tilesAcross) - imageByteWidth;
@@ -170,12 +203,12 @@ void tiff::ImageReader::getTileData(unsigned char*buffer,
         sys::Uint32_T bytesToRead = mElementSize * numElementsToRead;
 
         // Compute the row in image, row in tile, and tile row.
-        sys::Uint32_T row = mBytePosition / imageByteWidth;
+        auto row = static_cast<sys::Uint32_T>(mBytePosition / imageByteWidth);
         sys::Uint32_T tileRow = row / tileElemLength;
         sys::Uint32_T rowInTile = row % tileElemLength;
 
         // Compute the column in image, column in tile, and tile column.
-        sys::Uint32_T column = mBytePosition - (row * imageByteWidth);
+        auto column = static_cast<sys::Uint32_T>(mBytePosition - (static_cast<sys::Uint64_T>(row) * imageByteWidth));
         sys::Uint32_T tileColumn = column / tileByteWidth;
         sys::Uint32_T colInTile = column % tileByteWidth;
 
@@ -194,13 +227,15 @@ void tiff::ImageReader::getTileData(unsigned char*buffer,
         if (bytesToRead> remainingBytesThisLine)
             bytesToRead = remainingBytesThisLine;
 
+        if (tileIndex >= mChunkOffsets.size())
+            throw except::Exception(Ctxt("Invalid tile offset index"));
+
         // Seek to the tile offset plus the last read position.
-        tiff::IFDEntry *tileOffsets = mIFD["TileOffsets"];
-        sys::Uint32_T seekPos = (*(tiff::GenericType<sys::Uint32_T> *)(*tileOffsets)[tileIndex]) + (rowInTile * tileByteWidth)
+        const sys::Uint64_T seekPos = mChunkOffsets[tileIndex] + (rowInTile * tileByteWidth)
                 + colInTile;
 
         // Go to the offset.
-        mInput->seek(seekPos, io::Seekable::START);
+        mInput->seek(static_cast<sys::Off_T>(seekPos), io::Seekable::START);
 
         // Read the data.
         mInput->read((sys::byte *)buffer + bufferOffset, bytesToRead);
@@ -213,3 +248,277 @@ void tiff::ImageReader::getTileData(unsigned char*buffer,
         numElementsToRead -= (bytesToRead / mElementSize);
     }
 }
+
+void tiff::ImageReader::getCompressedData(unsigned char *buffer,
+        sys::Uint32_T numElementsToRead)
+{
+    validateChunkLayout();
+
+    const size_t imageElemWidth = mIFD.getImageWidth();
+    const size_t imageElemLength = mIFD.getImageLength();
+    const size_t imageByteWidth = imageElemWidth * mElementSize;
+    const size_t chunkByteWidth = mChunkElemWidth * mElementSize;
+
+    // The requested bytes, in raster order.
+    const auto startByte = static_cast<size_t>(mBytePosition);
+    const size_t endByte = startByte + static_cast<size_t>(numElementsToRead) * mElementSize;
+    if (endByte > imageByteWidth * imageElemLength)
+        throw except::Exception(Ctxt("Attempted to read past the end of the image"));
+    if (startByte == endByte)
+        return;
+
+    const size_t firstRow = startByte / imageByteWidth;
+    const size_t lastRow = (endByte - 1) / imageByteWidth;
+
+    // Read every overlapping chunk up front; the stream can only be read
+    // by one thread at a time, but decoding is independent per chunk.
+    std::vector<Chunk> chunks;
+    for (size_t chunkRow = firstRow / mChunkElemLength;
+         chunkRow <= lastRow / mChunkElemLength; ++chunkRow)
+    {
+        for (size_t chunkColumn = 0; chunkColumn < mChunksAcross; ++chunkColumn)
+        {
+            Chunk chunk;
+            chunk.row = chunkRow * mChunkElemLength;
+            chunk.column = chunkColumn;
+            chunk.data = readChunk(chunkRow * mChunksAcross + chunkColumn);
+            chunks.push_back(std::move(chunk));
+        }
+    }
+
+    const auto decode = [&](size_t ii)
+    {
+        const Chunk& chunk = chunks[ii];
+
+        const size_t chunkRows = getChunkRows(chunk.row / mChunkElemLength);
+        const size_t decodedSize = chunkRows * chunkByteWidth;
+
+        // A strip entirely inside the request is decoded in place.
+        const size_t chunkStartByte = chunk.row * imageByteWidth;
+        const bool inPlace = !mTiled && chunkStartByte >= startByte &&
+                chunkStartByte + decodedSize <= endByte;
+
+        std::vector<unsigned char> scratch;
+        unsigned char* decoded = nullptr;
+        if (inPlace)
+        {
+            decoded = buffer + (chunkStartByte - startByte);
+        }
+        else
+        {
+            scratch.resize(decodedSize);
+            decoded = scratch.data();
+        }
+
+        decodeChunk(chunk.data, chunkRows, decoded, decodedSize);
+        if (inPlace)
+            return;
+
+        // Copy out the part of each row that was requested.
+        const size_t columnByte = chunk.column * chunkByteWidth;
+        const size_t columnBytes = std::min(chunkByteWidth, imageByteWidth - columnByte);
+        const size_t endRow = std::min(chunk.row + chunkRows, lastRow + 1);
+        for (size_t row = std::max(chunk.row, firstRow); row < endRow; ++row)
+        {
+            const size_t rowStartByte = row * imageByteWidth + columnByte;
+            const size_t from = std::max(rowStartByte, startByte);
+            const size_t to = std::min(rowStartByte + columnBytes, endByte);
+            if (from < to)
+            {
+                memcpy(buffer + (from - startByte),
+                       decoded + (row - chunk.row) * chunkByteWidth + (from - rowStartByte),
+                       to - from);
+            }
+        }
+    };
+
+    const size_t numThreads = std::min(chunks.size(), sys::OS().getNumCPUs());
+    mt::run1D(chunks.size(), numThreads, decode);
+
+    mBytePosition = endByte;
+}
+
+void tiff::ImageReader::readRegion(size_t row, size_t col,
+        size_t numRows, size_t numCols, unsigned char *buffer)
+{
+    checkSupported(mCompression, mPredictor);
+
+    const size_t imageElemWidth = mIFD.getImageWidth();
+    const size_t imageElemLength = mIFD.getImageLength();
+    if (row + numRows > imageElemLength || col + numCols > imageElemWidth)
+        throw except::Exception(Ctxt("Region extends past the end of the image"));
+    if (numRows == 0 || numCols == 0)
+        return;
+
+    validateChunkLayout();
+
+    const size_t chunkByteWidth = mChunkElemWidth * mElementSize;
+    const size_t regionByteWidth = numCols * mElementSize;
+
+    // Look up every overlapping strip or tile, noting the ones that
+    // have to be read.
+    struct Tile final
+    {
+        size_t index;
+        size_t row; // the first image row in the tile
+        size_t column; // the first image column in the tile
+        tiff::TileCache::TilePtr data;
+    };
+    std::vector<Tile> tiles;
+    std::vector<size_t> missing;
+    for (size_t chunkRow = row / mChunkElemLength;
+         chunkRow <= (row + numRows - 1) / mChunkElemLength; ++chunkRow)
+    {
+        for (size_t chunkColumn = col / mChunkElemWidth;
+             chunkColumn <= (col + numCols - 1) / mChunkElemWidth; ++chunkColumn)
+        {
+            const size_t index = chunkRow * mChunksAcross + chunkColumn;
+            Tile tile{ index, chunkRow * mChunkElemLength,
+                       chunkColumn * mChunkElemWidth, mTileCache.get(index) };
+            if (!tile.data)
+                missing.push_back(tiles.size());
+            tiles.push_back(std::move(tile));
+        }
+    }
+
+    // The stream is shared, so the reads are serial; decoding isn't.
+    std::vector<std::vector<unsigned char> > raw(missing.size());
+    for (size_t ii = 0; ii < missing.size(); ++ii)
+        raw[ii] = readChunk(tiles[missing[ii]].index);
+
+    const size_t numCPUs = sys::OS().getNumCPUs();
+    mt::run1D(missing.size(), std::min(missing.size(), numCPUs), [&](size_t ii)
+    {
+        Tile& tile = tiles[missing[ii]];
+        const size_t chunkRows = getChunkRows(tile.row / mChunkElemLength);
+        auto decoded = std::make_shared<std::vector<unsigned char> >(
+                chunkRows * chunkByteWidth);
+        decodeChunk(raw[ii], chunkRows, decoded->data(), decoded->size());
+        tile.data = decoded;
+    });
+    for (const auto ii : missing)
+        mTileCache.put(tiles[ii].index, tiles[ii].data);
+
+    // Each tile fills a disjoint part of the region.
+    mt::run1D(tiles.size(), std::min(tiles.size(), numCPUs), [&](size_t ii)
+    {
+        const Tile& tile = tiles[ii];
+        const size_t chunkRows = tile.data->size() / chunkByteWidth;
+        const size_t firstRow = std::max(row, tile.row);
+        const size_t endRow = std::min(row + numRows, tile.row + chunkRows);
+        const size_t firstCol = std::max(col, tile.column);
+        const size_t endCol = std::min(col + numCols, tile.column + mChunkElemWidth);
+        const size_t numBytes = (endCol - firstCol) * mElementSize;
+
+        for (size_t rr = firstRow; rr < endRow; ++rr)
+        {
+            memcpy(buffer + (rr - row) * regionByteWidth + (firstCol - col) * mElementSize,
+                   tile.data->data() + (rr - tile.row) * chunkByteWidth
+                           + (firstCol - tile.column) * mElementSize,
+                   numBytes);
+        }
+    });
+
+    if (mReverseBytes)
+        sys::byteSwap(buffer, mElementSize, numRows * numCols);
+}
+
+void tiff::ImageReader::initChunkLayout()
+{
+    const size_t imageElemWidth = mIFD.getImageWidth();
+    const size_t imageElemLength = mIFD.getImageLength();
+
+    // Strips are handled as tiles that span the width of the image.
+    const tiff::IFDEntry* offsets = mIFD[tiff::Const::Tag::STRIP_OFFSETS];
+    const tiff::IFDEntry* byteCounts = mIFD[tiff::Const::Tag::STRIP_BYTE_COUNTS];
+    mTiled = offsets == nullptr;
+    if (mTiled)
+    {
+        offsets = mIFD[tiff::Const::Tag::TILE_OFFSETS];
+        byteCounts = mIFD[tiff::Const::Tag::TILE_BYTE_COUNTS];
+        const tiff::IFDEntry *tileWidth = mIFD[tiff::Const::Tag::TILE_WIDTH];
+        const tiff::IFDEntry *tileLength = mIFD[tiff::Const::Tag::TILE_LENGTH];
+        mChunkElemWidth = tileWidth ? static_cast<size_t>(tileWidth->getUint64(0)) : 0;
+        mChunkElemLength = tileLength ? static_cast<size_t>(tileLength->getUint64(0)) : 0;
+    }
+    else
+    {
+        mChunkElemWidth = imageElemWidth;
+        mChunkElemLength = imageElemLength;
+        const tiff::IFDEntry *rowsPerStrip = mIFD[tiff::Const::Tag::ROWS_PER_STRIP];
+        if (rowsPerStrip)
+            mChunkElemLength = std::min(mChunkElemLength,
+                    static_cast<size_t>(rowsPerStrip->getUint64(0)));
+    }
+
+    mChunksAcross = mChunkElemWidth == 0 ? 0
+            : (imageElemWidth + mChunkElemWidth - 1) / mChunkElemWidth;
+
+    mChunkOffsets = offsets ? offsets->getUint64Values() : std::vector<sys::Uint64_T>();
+    mChunkByteCounts = byteCounts ? byteCounts->getUint64Values() : std::vector<sys::Uint64_T>();
+
+    // Where each strip starts in the image, for getStripData().
+    mStripStarts.clear();
+    if (!mTiled)
+    {
+        mStripStarts.reserve(mChunkByteCounts.size() + 1);
+        mStripStarts.push_back(0);
+        for (const auto byteCount : mChunkByteCounts)
+            mStripStarts.push_back(mStripStarts.back() + byteCount);
+    }
+}
+
+void tiff::ImageReader::validateChunkLayout() const
+{
+    if (mChunkOffsets.empty())
+        throw except::Exception(Ctxt("Unsupported TIFF file format"));
+    if (mTiled && (!mIFD.exists(tiff::Const::Tag::TILE_WIDTH) ||
+                   !mIFD.exists(tiff::Const::Tag::TILE_LENGTH)))
+        throw except::Exception(Ctxt("TileWidth and TileLength must be defined"));
+    if (mChunkByteCounts.empty() &&
+        mCompression != tiff::Const::CompressionType::NO_COMPRESSION)
+        throw except::Exception(Ctxt("Compressed images must define byte counts"));
+    if (mChunkElemWidth == 0 || mChunkElemLength == 0)
+        throw except::Exception(Ctxt("Invalid strip or tile dimensions"));
+}
+
+size_t tiff::ImageReader::getChunkRows(size_t chunkRow) const
+{
+    // Tiles are always full size (padded); the last strip may be short.
+    if (mTiled)
+        return mChunkElemLength;
+
+    const size_t imageElemLength = mIFD.getImageLength();
+    return std::min(mChunkElemLength, imageElemLength - chunkRow * mChunkElemLength);
+}
+
+std::vector<unsigned char> tiff::ImageReader::readChunk(size_t index)
+{
+    if (index >= mChunkOffsets.size() ||
+        (!mChunkByteCounts.empty() && index >= mChunkByteCounts.size()))
+        throw except::Exception(Ctxt("Invalid strip or tile offset index"));
+
+    const size_t size = !mChunkByteCounts.empty()
+            ? static_cast<size_t>(mChunkByteCounts[index])
+            : getChunkRows(index / mChunksAcross) * mChunkElemWidth * mElementSize;
+
+    std::vector<unsigned char> data(size);
+    mInput->seek(static_cast<sys::Off_T>(mChunkOffsets[index]), io::Seekable::START);
+    mInput->read(reinterpret_cast<sys::byte *>(data.data()), data.size());
+    return data;
+}
+
+void tiff::ImageReader::decodeChunk(const std::vector<unsigned char>& raw,
+        size_t numRows, unsigned char *output, size_t outputSize) const
+{
+    tiff::Compression::decompress(mCompression, raw.data(), raw.size(),
+            output, outputSize);
+
+    if (mPredictor == tiff::Const::PredictorType::HORIZONTAL_DIFFERENCING)
+    {
+        const unsigned short numBands = mIFD.getNumBands();
+        const auto bytesPerSample = static_cast<unsigned short>(mElementSize / numBands);
+        tiff::Compression::undoHorizontalPredictor(output, numRows,
+                mChunkElemWidth, numBands, bytesPerSample, mReverseBytes);
+    }
+}
@@ -22,15 +22,23 @@
 
 #include "tiff/ImageWriter.h"
 
+#include <string.h>
+
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <limits>
 #include <import/except.h>
+#include <import/sys.h>
+#include <mt/Runnable1D.h>
 
 #include "gsl/gsl.h"
 
 #include "tiff/Common.h"
+#include "tiff/Compression.h"
 #include "tiff/GenericType.h"
 #include "tiff/IFDEntry.h"
+#include "tiff/KnownTags.h"
 
 const unsigned short tiff::ImageWriter::CHUNK_SIZE = 8192;
 
@@ -39,7 +47,11 @@ void tiff::ImageWriter::putData(const unsigned char *buffer,
 {
     validate();
 
-    if (mFormat == TILED)
+    if (isEncoded())
+    {
+        putCompressedData(buffer, numElementsToWrite);
+    }
+    else if (mFormat == TILED)
     {
         putTileData(buffer, numElementsToWrite);
     }
@@ -51,18 +63,34 @@ void tiff::ImageWriter::putData(const unsigned char *buffer,
 
 void tiff::ImageWriter::writeIFD()
 {
+    // Compressed data is laid out as it finishes; the IFD goes after it.
+    if (isEncoded())
+    {
+        finalizeChunks();
+        mOutput->seek(static_cast<sys::Off_T>(mAppendOffset), io::Seekable::START);
+    }
+
     // Retain the current file offset.
-    const auto offset = gsl::narrow<int32_t>(mOutput->tell()); // Per TIFF spec, "offset" MUST be a 32-bit value!
+    const auto offset = mOutput->tell();
 
     // Seek to the position to write the current offset to.
-    mOutput->seek(mIFDOffset, io::Seekable::START);
+    mOutput->seek(static_cast<sys::Off_T>(mIFDOffset), io::Seekable::START);
 
     // Write the current offset.
-    mOutput->write((sys::byte *)&offset, sizeof(offset));
+    if (mBigTIFF)
+    {
+        const auto ifdOffset = static_cast<sys::Uint64_T>(offset);
+        mOutput->write((sys::byte *)&ifdOffset, sizeof(ifdOffset));
+    }
+    else
+    {
+        const auto ifdOffset = gsl::narrow<int32_t>(offset); // Per TIFF spec, "offset" MUST be a 32-bit value!
+        mOutput->write((sys::byte *)&ifdOffset, sizeof(ifdOffset));
+    }
 
     // Reseek to the current offset and write out the IFD.
     mOutput->seek(offset, io::Seekable::START);
-    mIFD.serialize(*mOutput);
+    mIFD.serialize(*mOutput, mBigTIFF);
 
     // Keep the position in the file that the offset to the next
     // IFD can be written to, in case there is another IFD.
@@ -90,10 +118,21 @@ void tiff::ImageWriter::validate()
         mIFD.addEntry("Compression", (unsigned short) 1);
     else
     {
-        if (*(tiff::GenericType<unsigned short> *)(*compression)[0] != 1)
+        mCompression = static_cast<unsigned short>(compression->getUint64(0));
+        if (!tiff::Compression::isSupported(mCompression))
             throw except::Exception(Ctxt("Unsupported compression type"));
     }
 
+    // Predictor
+    tiff::IFDEntry *predictor = mIFD["Predictor"];
+    if (predictor)
+    {
+        mPredictor = static_cast<unsigned short>(predictor->getUint64(0));
+        if (mPredictor != tiff::Const::PredictorType::NONE &&
+            mPredictor != tiff::Const::PredictorType::HORIZONTAL_DIFFERENCING)
+            throw except::Exception(Ctxt("Unsupported predictor"));
+    }
+
     // XResolution
     tiff::IFDEntry *xResolution = mIFD["XResolution"];
     if (!xResolution)
@@ -240,6 +279,14 @@ void tiff::ImageWriter::initTiles()
     mIFD.addEntry("TileWidth", (sys::Uint32_T) tileSize);
     mIFD.addEntry("TileLength", (sys::Uint32_T) tileSize);
 
+    if (isEncoded())
+    {
+        mIFD.addEntry("TileByteCounts");
+        addOffsetsEntry("TileOffsets");
+        initChunks(tileSize, tileSize);
+        return;
+    }
+
     auto fileOffset = mOutput->tell();
     const sys::Uint32_T tilesAcross = (mIFD.getImageWidth() + tileSize - 1)
             / tileSize;
@@ -248,13 +295,13 @@ void tiff::ImageWriter::initTiles()
     const unsigned short elementSize = mIFD.getElementSize();
 
     mIFD.addEntry("TileByteCounts");
-    mIFD.addEntry("TileOffsets");
+    addOffsetsEntry("TileOffsets");
     for (sys::Uint32_T y = 0; y < tilesDown; ++y)
     {
         for (sys::Uint32_T x = 0; x < tilesAcross; ++x)
         {
             const sys::Uint32_T byteCount = tileSize * tileSize * elementSize;
-            mIFD.addEntryValue("TileOffsets", (sys::Uint32_T) fileOffset);
+            addOffsetValue("TileOffsets", static_cast<sys::Uint64_T>(fileOffset));
             mIFD.addEntryValue("TileByteCounts", (sys::Uint32_T) byteCount);
             fileOffset += byteCount;
         }
@@ -283,6 +330,16 @@ void tiff::ImageWriter::initStrips()
 
     mIFD.addEntry("RowsPerStrip", rowsPerStrip);
 
+    if (isEncoded())
+    {
+        addOffsetsEntry("StripOffsets");
+        mIFD.addEntry("StripByteCounts");
+        // Unlike tiles, strips needn't be padded past the last row.
+        initChunks(mIFD.getImageWidth(),
+                   std::min<size_t>(rowsPerStrip, mIFD.getImageLength()));
+        return;
+    }
+
     const sys::Uint32_T length = mIFD.getImageLength();
     const sys::Uint32_T stripsPerImage =
             (sys::Uint32_T)floor(static_cast<double>(length + rowsPerStrip - 1)
@@ -291,17 +348,17 @@ void tiff::ImageWriter::initStrips()
     auto offset = mOutput->tell();
 
     // Add counts and offsets for all but the last strip.
-    mIFD.addEntry("StripOffsets");
+    addOffsetsEntry("StripOffsets");
     mIFD.addEntry("StripByteCounts");
     for (sys::Uint32_T i = 0; i < stripsPerImage - 1; ++i)
     {
-        mIFD.addEntryValue("StripOffsets", (sys::Uint32_T) offset);
+        addOffsetValue("StripOffsets", static_cast<sys::Uint64_T>(offset));
         mIFD.addEntryValue("StripByteCounts", (sys::Uint32_T) stripByteCount);
         offset += stripByteCount;
     }
 
     // Add the last offset.
-    mIFD.addEntryValue("StripOffsets", (sys::Uint32_T) offset);
+    addOffsetValue("StripOffsets", static_cast<sys::Uint64_T>(offset));
 
     // The last byte count can be less than the previous counts.  This occurs
     // (for example) if RowsPerStrip is even, and ImageLength is odd.
@@ -313,6 +370,33 @@ void tiff::ImageWriter::initStrips()
     mStripByteCounts = mIFD["StripByteCounts"];
 }
 
+void tiff::ImageWriter::addOffsetsEntry(const std::string& name)
+{
+    if (!mBigTIFF)
+    {
+        mIFD.addEntry(name);
+        return;
+    }
+
+    const tiff::IFDEntry* const mapEntry = tiff::KnownTagsRegistry::getInstance()[name];
+    const tiff::IFDEntry entry(mapEntry->getTagID(), tiff::Const::Type::LONG8, name);
+    mIFD.addEntry(&entry);
+}
+
+void tiff::ImageWriter::addOffsetValue(const std::string& name,
+                                       const sys::Uint64_T offset)
+{
+    if (mBigTIFF)
+    {
+        mIFD.addEntryValue(name, offset);
+        return;
+    }
+
+    if (offset > std::numeric_limits<sys::Uint32_T>::max())
+        throw except::Exception(Ctxt("Image data exceeds 4GB; write a BigTIFF instead"));
+    mIFD.addEntryValue(name, static_cast<sys::Uint32_T>(offset));
+}
+
 void tiff::ImageWriter::putTileData(const unsigned char *buffer,
                                     sys::Uint32_T numElementsToWrite)
 {
@@ -330,7 +414,7 @@ void tiff::ImageWriter::putTileData(const unsigned char *buffer,
     // Determine how many bytes were used to pad the right edge.
     const sys::Uint32_T widthPadding = (tileByteWidth * tilesAcross) - imageByteWidth;
     sys::Uint32_T globalReadOffset = 0;
-    sys::Uint32_T tempBytePosition = mBytePosition;
+    sys::Uint64_T tempBytePosition = mBytePosition;
     const sys::Uint32_T numBytesToWrite = numElementsToWrite * mElementSize;
     sys::Uint32_T currentNumBytesRead = 0;
     sys::Uint32_T remainingElementsToWrite = numElementsToWrite;
@@ -345,11 +429,11 @@ void tiff::ImageWriter::putTileData(const unsigned char *buffer,
         }
 
         // Compute the row and tile row.
-        const sys::Uint32_T row = tempBytePosition / imageByteWidth;
+        const auto row = static_cast<sys::Uint32_T>(tempBytePosition / imageByteWidth);
         const sys::Uint32_T tileRow = row / tileElemLength;
 
         // Compute the column and tile column.
-        const sys::Uint32_T column = tempBytePosition - (row * imageByteWidth);
+        const auto column = static_cast<sys::Uint32_T>(tempBytePosition - (static_cast<sys::Uint64_T>(row) * imageByteWidth));
         const sys::Uint32_T tileColumn = column / tileByteWidth;
 
         // Compute the 1D tile index from the tile row and tile column.
@@ -409,10 +493,10 @@ void tiff::ImageWriter::putTileData(const unsigned char *buffer,
             currentNumBytesRead += numBytesToCopy;
         }
 
-        sys::Uint32_T seekPos = *(tiff::GenericType<sys::Uint32_T> *)(*mTileOffsets)[tileIndex];
+        sys::Uint64_T seekPos = mTileOffsets->getUint64(tileIndex);
         seekPos += (row % tileElemLength) * tileByteWidth;
         seekPos += (column % tileByteWidth);
-        mOutput->seek(seekPos, io::Seekable::START);
+        mOutput->seek(static_cast<sys::Off_T>(seekPos), io::Seekable::START);
         mOutput->write(copyBuffer, copyOffset);
         delete [] copyBuffer;
     }
@@ -420,7 +504,9 @@ void tiff::ImageWriter::putTileData(const unsigned char *buffer,
     mBytePosition += numBytesToWrite;
 
     // All of the real data is in, just have to pad the bottom of the file.
-    if (mBytePosition == mIFD.getImageSize())
+    // IFD::getImageSize() is 32-bit, too small for BigTIFF
+    const auto imageSize = static_cast<sys::Uint64_T>(mIFD.getImageWidth()) * mIFD.getImageLength() * mElementSize;
+    if (mBytePosition == imageSize)
     {
         sys::Uint32_T imageElemLength = mIFD.getImageLength();
         sys::Uint32_T tilesDown = (imageElemLength + tileElemLength - 1)
@@ -436,9 +522,9 @@ void tiff::ImageWriter::putTileData(const unsigned char *buffer,
 
             for (sys::Uint32_T i = 0; i < tilesAcross; ++i)
             {
-                sys::Uint32_T seekPos = *(tiff::GenericType<sys::Uint32_T> *)(*mTileOffsets)[startIndex + i];
+                sys::Uint64_T seekPos = mTileOffsets->getUint64(startIndex + i);
                 seekPos += paddingStartLine * tileByteWidth;
-                mOutput->seek(seekPos, io::Seekable::START);
+                mOutput->seek(static_cast<sys::Off_T>(seekPos), io::Seekable::START);
                 mOutput->write(padBuffer, paddedLines * tileByteWidth);
             }
 
@@ -452,9 +538,9 @@ void tiff::ImageWriter::putTileData(const unsigned char *buffer,
         else
         {
             auto lastTileIndex = static_cast<sys::Uint32_T>(mTileOffsets->getValues().size() - 1);
-            sys::Uint32_T seekPos = *(tiff::GenericType<sys::Uint32_T> *)(*mTileOffsets)[lastTileIndex];
-            seekPos += *(tiff::GenericType<sys::Uint32_T> *)(*mTileByteCounts)[lastTileIndex];
-            mOutput->seek(seekPos, io::Seekable::START);
+            sys::Uint64_T seekPos = mTileOffsets->getUint64(lastTileIndex);
+            seekPos += mTileByteCounts->getUint64(lastTileIndex);
+            mOutput->seek(static_cast<sys::Off_T>(seekPos), io::Seekable::START);
         }
     }
 }
@@ -468,8 +554,8 @@ void tiff::ImageWriter::putStripData(const unsigned char *buffer,
     while (numElementsToWrite)
     {
         sys::Uint32_T bytesToWrite = mElementSize * numElementsToWrite;
-        sys::Uint32_T stripIndex = mBytePosition / stripSize;
-        sys::Uint32_T stripPosition = mBytePosition % stripSize;
+        const auto stripIndex = static_cast<sys::Uint32_T>(mBytePosition / stripSize);
+        const auto stripPosition = static_cast<sys::Uint32_T>(mBytePosition % stripSize);
 
         // Calculate what remains to be written in the current strip.
         sys::Uint32_T remainingBytesInStrip =
@@ -485,3 +571,199 @@ void tiff::ImageWriter::putStripData(const unsigned char *buffer,
         mBytePosition += bytesToWrite;
     }
 }
+
+bool tiff::ImageWriter::isEncoded() const
+{
+    return mCompression != tiff::Const::CompressionType::NO_COMPRESSION ||
+           mPredictor != tiff::Const::PredictorType::NONE;
+}
+
+void tiff::ImageWriter::initChunks(size_t chunkElemWidth, size_t chunkElemLength)
+{
+    const size_t imageElemWidth = mIFD.getImageWidth();
+    const size_t imageElemLength = mIFD.getImageLength();
+
+    mChunkElemWidth = chunkElemWidth;
+    mChunkElemLength = chunkElemLength;
+    mChunksAcross = (imageElemWidth + mChunkElemWidth - 1) / mChunkElemWidth;
+    const size_t chunksDown = (imageElemLength + mChunkElemLength - 1) / mChunkElemLength;
+
+    const size_t numChunks = mChunksAcross * chunksDown;
+    mChunkOffsets.assign(numChunks, 0);
+    mChunkByteCounts.assign(numChunks, 0);
+    mChunkWritten.assign(numChunks, false);
+    mChunksFinalized = false;
+    mAppendOffset = static_cast<sys::Uint64_T>(mOutput->tell());
+    mPending.clear();
+    mPendingRow = 0;
+}
+
+size_t tiff::ImageWriter::getNumChunks()
+{
+    validate();
+    return mChunkWritten.size();
+}
+
+size_t tiff::ImageWriter::getChunkSize(size_t index)
+{
+    validate();
+    if (!isEncoded())
+        throw except::Exception(Ctxt("Chunks are only used for compressed images"));
+    if (index >= mChunkWritten.size())
+        throw except::Exception(Ctxt("Invalid strip or tile index"));
+
+    // Tiles are always full size; the last strip may be short.
+    size_t numRows = mChunkElemLength;
+    if (mFormat != TILED)
+    {
+        const size_t row = index * mChunkElemLength;
+        numRows = std::min(numRows, mIFD.getImageLength() - row);
+    }
+    return numRows * mChunkElemWidth * mElementSize;
+}
+
+void tiff::ImageWriter::putChunk(size_t index, const unsigned char *data)
+{
+    size_t chunkSize = 0;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        chunkSize = getChunkSize(index);
+    }
+
+    const size_t chunkByteWidth = mChunkElemWidth * mElementSize;
+    const auto encoded = encodeChunk(data, chunkSize / chunkByteWidth);
+    appendChunk(index, encoded);
+}
+
+std::vector<unsigned char> tiff::ImageWriter::encodeChunk(
+        const unsigned char *data, size_t numRows) const
+{
+    const size_t chunkByteWidth = mChunkElemWidth * mElementSize;
+    const size_t chunkSize = numRows * chunkByteWidth;
+    if (mPredictor != tiff::Const::PredictorType::HORIZONTAL_DIFFERENCING)
+        return tiff::Compression::compress(mCompression, data, chunkSize, chunkByteWidth);
+
+    // The predictor works in place, so difference a copy.
+    std::vector<unsigned char> scratch(data, data + chunkSize);
+    const unsigned short numBands = mIFD.getNumBands();
+    tiff::Compression::applyHorizontalPredictor(scratch.data(), numRows,
+            mChunkElemWidth, numBands,
+            static_cast<unsigned short>(mElementSize / numBands), false);
+    return tiff::Compression::compress(mCompression, scratch.data(),
+            scratch.size(), chunkByteWidth);
+}
+
+void tiff::ImageWriter::appendChunk(size_t index,
+        const std::vector<unsigned char>& encoded)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mChunkWritten[index])
+        throw except::Exception(Ctxt(str::Format("Strip or tile %zu was already written", index)));
+
+    mOutput->seek(static_cast<sys::Off_T>(mAppendOffset), io::Seekable::START);
+    mOutput->write(reinterpret_cast<const sys::byte *>(encoded.data()), encoded.size());
+
+    mChunkOffsets[index] = mAppendOffset;
+    mChunkByteCounts[index] = encoded.size();
+    mChunkWritten[index] = true;
+    mAppendOffset += encoded.size();
+}
+
+void tiff::ImageWriter::putCompressedData(const unsigned char *buffer,
+        sys::Uint32_T numElementsToWrite)
+{
+    const size_t imageByteWidth = static_cast<size_t>(mIFD.getImageWidth()) * mElementSize;
+    const size_t imageSize = imageByteWidth * mIFD.getImageLength();
+
+    // Buffer enough rows of chunks to keep every core busy.
+    const size_t numCPUs = sys::OS().getNumCPUs();
+    const size_t chunkRowsPerFlush = std::max<size_t>(1,
+            (numCPUs + mChunksAcross - 1) / mChunksAcross);
+    const size_t pendingSize = chunkRowsPerFlush * mChunkElemLength * imageByteWidth;
+
+    size_t numBytes = static_cast<size_t>(numElementsToWrite) * mElementSize;
+    if (mBytePosition + numBytes > imageSize)
+        throw except::Exception(Ctxt("Attempted to write past the end of the image"));
+
+    while (numBytes)
+    {
+        const size_t thisWrite = std::min(numBytes, pendingSize - mPending.size());
+        mPending.insert(mPending.end(), buffer, buffer + thisWrite);
+        buffer += thisWrite;
+        numBytes -= thisWrite;
+        mBytePosition += thisWrite;
+
+        if (mPending.size() == pendingSize || mBytePosition == imageSize)
+            flushPending();
+    }
+}
+
+void tiff::ImageWriter::flushPending()
+{
+    const size_t imageByteWidth = static_cast<size_t>(mIFD.getImageWidth()) * mElementSize;
+    const size_t chunkByteWidth = mChunkElemWidth * mElementSize;
+    const size_t numRows = mPending.size() / imageByteWidth;
+    if (numRows == 0)
+        return;
+
+    const size_t firstChunkRow = mPendingRow / mChunkElemLength;
+    const size_t numChunkRows = (numRows + mChunkElemLength - 1) / mChunkElemLength;
+    const size_t numChunks = numChunkRows * mChunksAcross;
+
+    const auto encode = [&](size_t ii)
+    {
+        const size_t chunkRow = ii / mChunksAcross;
+        const size_t chunkColumn = ii % mChunksAcross;
+        const size_t firstRow = chunkRow * mChunkElemLength; // within mPending
+        const size_t chunkRows = std::min(mChunkElemLength, numRows - firstRow);
+        const unsigned char* const rows = mPending.data() + firstRow * imageByteWidth;
+
+        std::vector<unsigned char> encoded;
+        if (mFormat == TILED)
+        {
+            // Copy the tile out of the raster, padding the edges with zeros.
+            std::vector<unsigned char> tile(mChunkElemLength * chunkByteWidth);
+            const size_t columnByte = chunkColumn * chunkByteWidth;
+            const size_t numBytes = std::min(chunkByteWidth, imageByteWidth - columnByte);
+            for (size_t row = 0; row < chunkRows; ++row)
+            {
+                memcpy(tile.data() + row * chunkByteWidth,
+                       rows + row * imageByteWidth + columnByte, numBytes);
+            }
+            encoded = encodeChunk(tile.data(), mChunkElemLength);
+        }
+        else
+        {
+            encoded = encodeChunk(rows, chunkRows);
+        }
+        appendChunk((firstChunkRow + chunkRow) * mChunksAcross + chunkColumn, encoded);
+    };
+
+    mt::run1D(numChunks, std::min(numChunks, sys::OS().getNumCPUs()), encode);
+
+    mPendingRow += numRows;
+    mPending.clear();
+}
+
+void tiff::ImageWriter::finalizeChunks()
+{
+    validate();
+    if (mChunksFinalized)
+        throw except::Exception(Ctxt("The IFD of a compressed image can only be written once"));
+    for (size_t ii = 0; ii < mChunkWritten.size(); ++ii)
+    {
+        if (!mChunkWritten[ii])
+            throw except::Exception(Ctxt(str::Format("Strip or tile %zu was never written", ii)));
+    }
+
+    const std::string offsets = mFormat == TILED ? "TileOffsets" : "StripOffsets";
+    const std::string byteCounts = mFormat == TILED ? "TileByteCounts" : "StripByteCounts";
+    for (size_t ii = 0; ii < mChunkWritten.size(); ++ii)
+    {
+        addOffsetValue(offsets, mChunkOffsets[ii]);
+        if (mChunkByteCounts[ii] > std::numeric_limits<sys::Uint32_T>::max())
+            throw except::Exception(Ctxt("Compressed strip or tile exceeds 4GB"));
+        mIFD.addEntryValue(byteCounts, static_cast<sys::Uint32_T>(mChunkByteCounts[ii]));
+    }
+    mChunksFinalized = true;
+}
@@ -61,7 +61,7 @@ void tiff::FileWriter::openFile(const std::string& fileName)
 void tiff::FileWriter::close()
 {
     mIFDOffset = 0;
-    mHeader = tiff::Header{};
+    mHeader = tiff::Header(mHeader.isBigTIFF() ? tiff::Header::BIG_TIFF : tiff::Header::CLASSIC_TIFF);
 
     mOutput.close();
 
@@ -95,7 +95,7 @@ tiff::ImageWriter *tiff::FileWriter::addImage()
     if (!mImages.empty())
         mIFDOffset = mImages.back()->getNextIFDOffset();
 
-    auto image = std::make_unique<tiff::ImageWriter>(&mOutput, mIFDOffset);
+    auto image = std::make_unique<tiff::ImageWriter>(&mOutput, mIFDOffset, mHeader.isBigTIFF());
     mImages.push_back(image.get());
     tiff::ImageWriter* const writer = image.release();
 
@@ -107,6 +107,6 @@ void tiff::FileWriter::writeHeader()
     mHeader.serialize(mOutput);
 
     // Have to rewind a few bytes to write out the actual IFD offset.
-    mIFDOffset = static_cast <sys::Uint32_T>(mOutput.tell());
-    mIFDOffset -= (int)sizeof(sys::Uint32_T);
+    mIFDOffset = static_cast<sys::Uint64_T>(mOutput.tell());
+    mIFDOffset -= mHeader.getOffsetSize();
 }
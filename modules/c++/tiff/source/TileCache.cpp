@@ -0,0 +1,107 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "tiff/TileCache.h"
+
+const size_t tiff::TileCache::DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+tiff::TileCache::TilePtr tiff::TileCache::get(size_t index)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const auto it = mIndex.find(index);
+    if (it == mIndex.end())
+        return nullptr;
+
+    // Move the tile to the front of the list.
+    mTiles.splice(mTiles.begin(), mTiles, it->second);
+    return it->second->second;
+}
+
+void tiff::TileCache::put(size_t index, TilePtr tile)
+{
+    if (!tile)
+        return;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const auto it = mIndex.find(index);
+    if (it != mIndex.end())
+    {
+        mNumBytes -= it->second->second->size();
+        mTiles.erase(it->second);
+        mIndex.erase(it);
+    }
+
+    // A tile that would never fit isn't worth evicting the others for.
+    if (tile->size() > mMaxBytes)
+        return;
+
+    mNumBytes += tile->size();
+    mTiles.emplace_front(index, std::move(tile));
+    mIndex[index] = mTiles.begin();
+    evict();
+}
+
+void tiff::TileCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTiles.clear();
+    mIndex.clear();
+    mNumBytes = 0;
+}
+
+void tiff::TileCache::setMaxBytes(size_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxBytes = maxBytes;
+    evict();
+}
+
+size_t tiff::TileCache::getMaxBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMaxBytes;
+}
+
+size_t tiff::TileCache::getNumBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNumBytes;
+}
+
+size_t tiff::TileCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTiles.size();
+}
+
+void tiff::TileCache::evict()
+{
+    while (mNumBytes > mMaxBytes && !mTiles.empty())
+    {
+        mNumBytes -= mTiles.back().second->size();
+        mIndex.erase(mTiles.back().first);
+        mTiles.pop_back();
+    }
+}
@@ -0,0 +1,145 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TestCase.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <import/io.h>
+#include <import/sys.h>
+#include <tiff/Common.h>
+#include <tiff/FileReader.h>
+#include <tiff/FileWriter.h>
+#include <tiff/Header.h>
+#include <tiff/IFD.h>
+#include <tiff/KnownTags.h>
+
+namespace
+{
+constexpr size_t NUM_ROWS = 100;
+constexpr size_t NUM_COLS = 75;
+
+std::vector<uint16_t> makeImage()
+{
+    std::vector<uint16_t> image(NUM_ROWS * NUM_COLS);
+    for (size_t ii = 0; ii < image.size(); ++ii)
+        image[ii] = static_cast<uint16_t>(ii * 7);
+    return image;
+}
+
+void writeImage(const std::string& pathname, bool bigTIFF,
+                tiff::ImageWriter::ImageFormat format,
+                const std::vector<uint16_t>& image)
+{
+    tiff::FileWriter writer(pathname, bigTIFF);
+    writer.writeHeader();
+
+    // Two images so the next-IFD offsets are exercised too.
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        tiff::ImageWriter* const imageWriter = writer.addImage();
+        imageWriter->setImageFormat(format);
+        imageWriter->setIdealChunkSize(1024);
+
+        tiff::IFD* const ifd = imageWriter->getIFD();
+        ifd->addEntry(tiff::KnownTags::IMAGE_WIDTH, static_cast<sys::Uint32_T>(NUM_COLS));
+        ifd->addEntry(tiff::KnownTags::IMAGE_LENGTH, static_cast<sys::Uint32_T>(NUM_ROWS));
+        ifd->addEntry(tiff::KnownTags::BITS_PER_SAMPLE, static_cast<unsigned short>(16));
+        ifd->addEntry(tiff::KnownTags::PHOTOMETRIC_INTERPRETATION,
+                      static_cast<unsigned short>(tiff::Const::PhotoInterpType::BLACK_IS_ZERO));
+
+        writer.putData(reinterpret_cast<const unsigned char*>(image.data()),
+                       static_cast<sys::Uint32_T>(image.size()),
+                       static_cast<sys::Uint32_T>(ii));
+        imageWriter->writeIFD();
+    }
+    writer.close();
+}
+
+unsigned short readVersion(const std::string& pathname)
+{
+    io::FileInputStream input(pathname);
+    tiff::Header header;
+    header.deserialize(input);
+    return header.isBigTIFF() ? tiff::Header::BIG_TIFF : tiff::Header::CLASSIC_TIFF;
+}
+
+void testRoundTrip(const std::string& testName, bool bigTIFF,
+                   tiff::ImageWriter::ImageFormat format)
+{
+    const std::string pathname = "test_bigtiff.tif";
+    const auto image = makeImage();
+    writeImage(pathname, bigTIFF, format, image);
+
+    TEST_ASSERT_EQ(readVersion(pathname),
+                   bigTIFF ? tiff::Header::BIG_TIFF : tiff::Header::CLASSIC_TIFF);
+
+    tiff::FileReader reader(pathname);
+    TEST_ASSERT_EQ(reader.getImageCount(), static_cast<sys::Uint32_T>(2));
+    for (sys::Uint32_T ii = 0; ii < reader.getImageCount(); ++ii)
+    {
+        const tiff::IFD& ifd = *reader[ii]->getIFD();
+        const auto offsets = ifd[format == tiff::ImageWriter::TILED ? "TileOffsets" : "StripOffsets"];
+        TEST_ASSERT_NOT_EQ(offsets, nullptr);
+        TEST_ASSERT_EQ(offsets->getType(),
+                       bigTIFF ? tiff::Const::Type::LONG8 : tiff::Const::Type::LONG);
+
+        std::vector<uint16_t> actual(image.size());
+        reader.getData(reinterpret_cast<unsigned char*>(actual.data()),
+                       static_cast<sys::Uint32_T>(actual.size()), ii);
+        TEST_ASSERT(actual == image);
+    }
+    reader.close();
+
+    sys::OS().remove(pathname);
+}
+}
+
+TEST_CASE(testClassicStripped)
+{
+    testRoundTrip(testName, false, tiff::ImageWriter::STRIPPED);
+}
+
+TEST_CASE(testClassicTiled)
+{
+    testRoundTrip(testName, false, tiff::ImageWriter::TILED);
+}
+
+TEST_CASE(testBigTIFFStripped)
+{
+    testRoundTrip(testName, true, tiff::ImageWriter::STRIPPED);
+}
+
+TEST_CASE(testBigTIFFTiled)
+{
+    testRoundTrip(testName, true, tiff::ImageWriter::TILED);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testClassicStripped);
+    TEST_CHECK(testClassicTiled);
+    TEST_CHECK(testBigTIFFStripped);
+    TEST_CHECK(testBigTIFFTiled);
+    )
@@ -0,0 +1,168 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TestCase.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <tiff/Common.h>
+#include <tiff/Compression.h>
+
+TEST_CASE(testUnpackBits)
+{
+    // The example from Apple's PackBits technical note.
+    const std::vector<unsigned char> packed{ 0xFE, 0xAA, 0x02, 0x80, 0x00, 0x2A, 0xFD, 0xAA,
+                                             0x03, 0x80, 0x00, 0x2A, 0x22, 0xF7, 0xAA };
+    const std::vector<unsigned char> expected{ 0xAA, 0xAA, 0xAA, 0x80, 0x00, 0x2A, 0xAA, 0xAA,
+                                               0xAA, 0xAA, 0x80, 0x00, 0x2A, 0x22, 0xAA, 0xAA,
+                                               0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+
+    std::vector<unsigned char> actual(expected.size());
+    const auto numBytes = tiff::Compression::decompress(tiff::Const::CompressionType::PACK_BITS,
+            packed.data(), packed.size(), actual.data(), actual.size());
+    TEST_ASSERT_EQ(numBytes, expected.size());
+    TEST_ASSERT(actual == expected);
+
+    // Decoding stops at the end of the output buffer.
+    std::vector<unsigned char> truncated(4);
+    TEST_ASSERT_EQ(tiff::Compression::unpackBits(packed.data(), packed.size(),
+            truncated.data(), truncated.size()), truncated.size());
+    TEST_ASSERT_EQ(truncated[3], 0x80);
+}
+
+TEST_CASE(testDecodeLZW)
+{
+    // Clear, 'A', 'B', 258 ("AB"), EOI as 9-bit codes
+    const std::vector<unsigned char> encoded{ 0x80, 0x10, 0x48, 0x50, 0x28, 0x08 };
+    std::vector<unsigned char> actual(4);
+    const auto numBytes = tiff::Compression::decompress(tiff::Const::CompressionType::LZW,
+            encoded.data(), encoded.size(), actual.data(), actual.size());
+    TEST_ASSERT_EQ(numBytes, actual.size());
+    TEST_ASSERT(actual == (std::vector<unsigned char>{ 'A', 'B', 'A', 'B' }));
+
+    // Clear, 'A', 258, EOI: the code being defined is used immediately
+    const std::vector<unsigned char> kwkwk{ 0x80, 0x10, 0x60, 0x50, 0x10 };
+    std::vector<unsigned char> repeated(3);
+    TEST_ASSERT_EQ(tiff::Compression::decodeLZW(kwkwk.data(), kwkwk.size(),
+            repeated.data(), repeated.size()), repeated.size());
+    TEST_ASSERT(repeated == (std::vector<unsigned char>{ 'A', 'A', 'A' }));
+}
+
+TEST_CASE(testHorizontalPredictor)
+{
+    // Two rows of two RGB pixels
+    std::vector<unsigned char> bytes{ 1, 2, 3, 1, 1, 1,
+                                      10, 20, 30, 255, 0, 1 };
+    tiff::Compression::undoHorizontalPredictor(bytes.data(), 2, 2, 3, 1, false);
+    TEST_ASSERT(bytes == (std::vector<unsigned char>{ 1, 2, 3, 2, 3, 4,
+                                                      10, 20, 30, 9, 20, 31 }));
+
+    std::vector<uint16_t> shorts{ 1000, 1, 1, 1 };
+    tiff::Compression::undoHorizontalPredictor(reinterpret_cast<unsigned char*>(shorts.data()),
+            1, 4, 1, sizeof(uint16_t), false);
+    TEST_ASSERT(shorts == (std::vector<uint16_t>{ 1000, 1001, 1002, 1003 }));
+}
+
+namespace
+{
+// Runs, literals and enough distinct strings to fill (and reset) the LZW table.
+std::vector<unsigned char> makeTestData(size_t size)
+{
+    std::vector<unsigned char> data(size);
+    uint32_t state = 12345;
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        state = state * 1103515245 + 12345;
+        data[ii] = (ii % 1000 < 300) ? static_cast<unsigned char>(ii / 1000)
+                : static_cast<unsigned char>(state >> 24);
+    }
+    return data;
+}
+
+void testRoundTrip(const std::string& testName, unsigned short compression, size_t size)
+{
+    const auto expected = makeTestData(size);
+    const auto encoded = tiff::Compression::compress(compression, expected.data(),
+            expected.size(), 100);
+
+    std::vector<unsigned char> actual(expected.size());
+    const auto numBytes = tiff::Compression::decompress(compression,
+            encoded.data(), encoded.size(), actual.data(), actual.size());
+    TEST_ASSERT_EQ(numBytes, expected.size());
+    TEST_ASSERT(actual == expected);
+}
+}
+
+TEST_CASE(testPackBitsRoundTrip)
+{
+    testRoundTrip(testName, tiff::Const::CompressionType::PACK_BITS, 0);
+    testRoundTrip(testName, tiff::Const::CompressionType::PACK_BITS, 1);
+    testRoundTrip(testName, tiff::Const::CompressionType::PACK_BITS, 10000);
+
+    // Runs never cross rows.
+    const std::vector<unsigned char> twoRows(8, 0x11);
+    const auto packed = tiff::Compression::packBits(twoRows.data(), twoRows.size(), 4);
+    TEST_ASSERT(packed == (std::vector<unsigned char>{ 0xFD, 0x11, 0xFD, 0x11 }));
+}
+
+TEST_CASE(testLZWRoundTrip)
+{
+    // The reverse of the vectors in testDecodeLZW
+    const std::vector<unsigned char> abab{ 'A', 'B', 'A', 'B' };
+    TEST_ASSERT(tiff::Compression::encodeLZW(abab.data(), abab.size()) ==
+                (std::vector<unsigned char>{ 0x80, 0x10, 0x48, 0x50, 0x28, 0x08 }));
+
+    testRoundTrip(testName, tiff::Const::CompressionType::LZW, 0);
+    testRoundTrip(testName, tiff::Const::CompressionType::LZW, 1);
+    testRoundTrip(testName, tiff::Const::CompressionType::LZW, 100000);
+}
+
+TEST_CASE(testDeflateRoundTrip)
+{
+    if (!tiff::Compression::isSupported(tiff::Const::CompressionType::DEFLATE))
+        return;
+    testRoundTrip(testName, tiff::Const::CompressionType::DEFLATE, 100000);
+}
+
+TEST_CASE(testApplyHorizontalPredictor)
+{
+    const std::vector<uint16_t> expected{ 1, 2, 3, 1000, 999, 65535, 7, 8, 9 };
+    auto samples = expected;
+    auto bytes = reinterpret_cast<unsigned char*>(samples.data());
+    tiff::Compression::applyHorizontalPredictor(bytes, 1, 9, 1, 2, false);
+    TEST_ASSERT_EQ(samples[1], static_cast<uint16_t>(1));
+    tiff::Compression::undoHorizontalPredictor(bytes, 1, 9, 1, 2, false);
+    TEST_ASSERT(samples == expected);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testUnpackBits);
+    TEST_CHECK(testDecodeLZW);
+    TEST_CHECK(testHorizontalPredictor);
+    TEST_CHECK(testPackBitsRoundTrip);
+    TEST_CHECK(testLZWRoundTrip);
+    TEST_CHECK(testDeflateRoundTrip);
+    TEST_CHECK(testApplyHorizontalPredictor);
+    )
@@ -0,0 +1,114 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "TestCase.h"
+
+#include <string>
+#include <vector>
+
+#include <import/io.h>
+#include <import/sys.h>
+#include <tiff/Common.h>
+#include <tiff/IFD.h>
+#include <tiff/IFDEntry.h>
+#include <tiff/KnownTags.h>
+
+TEST_CASE(testTagLookup)
+{
+    tiff::IFD ifd;
+    ifd.addEntry(tiff::KnownTags::IMAGE_LENGTH, static_cast<sys::Uint32_T>(20));
+    ifd.addEntry(tiff::KnownTags::BITS_PER_SAMPLE, static_cast<unsigned short>(16));
+    ifd.addEntry(tiff::KnownTags::IMAGE_WIDTH, static_cast<sys::Uint32_T>(10));
+
+    TEST_ASSERT_EQ(ifd.size(), static_cast<sys::Uint32_T>(3));
+    TEST_ASSERT(ifd.exists(tiff::Const::Tag::IMAGE_WIDTH));
+    TEST_ASSERT_FALSE(ifd.exists(tiff::Const::Tag::TILE_WIDTH));
+    TEST_ASSERT_NULL(ifd[tiff::Const::Tag::STRIP_OFFSETS]);
+
+    const tiff::IFD& constIFD = ifd;
+    TEST_ASSERT_EQ(constIFD[tiff::Const::Tag::IMAGE_WIDTH], constIFD["ImageWidth"]);
+    TEST_ASSERT_EQ(constIFD.getImageWidth(), static_cast<sys::Uint32_T>(10));
+    TEST_ASSERT_EQ(constIFD.getImageLength(), static_cast<sys::Uint32_T>(20));
+    TEST_ASSERT_EQ(constIFD.getElementSize(), static_cast<unsigned short>(2));
+
+    // Adding an existing tag replaces it.
+    ifd.addEntry(tiff::KnownTags::IMAGE_WIDTH, static_cast<sys::Uint32_T>(30));
+    TEST_ASSERT_EQ(ifd.size(), static_cast<sys::Uint32_T>(3));
+    TEST_ASSERT_EQ(ifd.getImageWidth(), static_cast<sys::Uint32_T>(30));
+}
+
+TEST_CASE(testSerializedOrder)
+{
+    tiff::IFD ifd;
+    ifd.addEntry("StripByteCounts");
+    ifd.addEntry("StripOffsets");
+    for (sys::Uint32_T ii = 0; ii < 5; ++ii)
+    {
+        ifd.addEntryValue("StripOffsets", 1000 + ii * 100);
+        ifd.addEntryValue("StripByteCounts", static_cast<sys::Uint32_T>(100));
+    }
+    ifd.addEntry(tiff::KnownTags::IMAGE_WIDTH, static_cast<sys::Uint32_T>(10));
+
+    const std::string pathname = "test_ifd.bin";
+    {
+        io::FileOutputStream output(pathname);
+        ifd.serialize(output);
+        output.close();
+    }
+
+    io::FileInputStream stream(pathname);
+    tiff::IFD copy;
+    copy.deserialize(stream);
+    TEST_ASSERT_EQ(copy.size(), static_cast<sys::Uint32_T>(3));
+
+    // Entries are written in ascending tag order, as TIFF requires.
+    stream.seek(2, io::Seekable::START);
+    unsigned short previous = 0;
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        tiff::IFDEntry entry;
+        entry.deserialize(stream);
+        TEST_ASSERT(entry.getTagID() > previous);
+        previous = entry.getTagID();
+    }
+
+    // Offsets and byte counts decode in one pass.
+    const std::vector<sys::Uint64_T> offsets =
+            copy[tiff::Const::Tag::STRIP_OFFSETS]->getUint64Values();
+    const std::vector<sys::Uint64_T> byteCounts =
+            copy[tiff::Const::Tag::STRIP_BYTE_COUNTS]->getUint64Values();
+    TEST_ASSERT_EQ(offsets.size(), static_cast<size_t>(5));
+    TEST_ASSERT_EQ(byteCounts.size(), static_cast<size_t>(5));
+    for (size_t ii = 0; ii < offsets.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(offsets[ii], static_cast<sys::Uint64_T>(1000 + ii * 100));
+        TEST_ASSERT_EQ(byteCounts[ii], static_cast<sys::Uint64_T>(100));
+    }
+    stream.close();
+    sys::OS().remove(pathname);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testTagLookup);
+    TEST_CHECK(testSerializedOrder);
+    )
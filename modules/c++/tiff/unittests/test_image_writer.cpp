@@ -0,0 +1,272 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TestCase.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <import/io.h>
+#include <import/sys.h>
+#include <tiff/Common.h>
+#include <tiff/Compression.h>
+#include <tiff/FileReader.h>
+#include <tiff/FileWriter.h>
+#include <tiff/IFD.h>
+#include <tiff/KnownTags.h>
+
+namespace
+{
+constexpr size_t NUM_ROWS = 123;
+constexpr size_t NUM_COLS = 97;
+
+std::vector<uint16_t> makeImage(size_t numRows = NUM_ROWS)
+{
+    // Smooth enough to compress, with some noise.
+    std::vector<uint16_t> image(numRows * NUM_COLS);
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        for (size_t col = 0; col < NUM_COLS; ++col)
+            image[row * NUM_COLS + col] = static_cast<uint16_t>(row * 50 + col * 3 + (col * row) % 7);
+    }
+    return image;
+}
+
+tiff::ImageWriter* addImage(tiff::FileWriter& writer, tiff::ImageWriter::ImageFormat format,
+                            unsigned short compression, unsigned short predictor,
+                            size_t numRows = NUM_ROWS)
+{
+    tiff::ImageWriter* const imageWriter = writer.addImage();
+    imageWriter->setImageFormat(format);
+    imageWriter->setIdealChunkSize(2048);
+
+    tiff::IFD* const ifd = imageWriter->getIFD();
+    ifd->addEntry(tiff::KnownTags::IMAGE_WIDTH, static_cast<sys::Uint32_T>(NUM_COLS));
+    ifd->addEntry(tiff::KnownTags::IMAGE_LENGTH, static_cast<sys::Uint32_T>(numRows));
+    ifd->addEntry(tiff::KnownTags::BITS_PER_SAMPLE, static_cast<unsigned short>(16));
+    ifd->addEntry(tiff::KnownTags::PHOTOMETRIC_INTERPRETATION,
+                  static_cast<unsigned short>(tiff::Const::PhotoInterpType::BLACK_IS_ZERO));
+    ifd->addEntry(tiff::KnownTags::COMPRESSION, compression);
+    if (predictor != tiff::Const::PredictorType::NONE)
+        ifd->addEntry("Predictor", predictor);
+    return imageWriter;
+}
+
+void checkImage(const std::string& testName, const std::string& pathname,
+                const std::vector<uint16_t>& image)
+{
+    tiff::FileReader reader(pathname);
+    std::vector<uint16_t> actual(image.size());
+    reader.getData(reinterpret_cast<unsigned char*>(actual.data()),
+                   static_cast<sys::Uint32_T>(actual.size()));
+    TEST_ASSERT(actual == image);
+    reader.close();
+}
+
+void testPutData(const std::string& testName, tiff::ImageWriter::ImageFormat format,
+                 unsigned short compression, unsigned short predictor)
+{
+    const std::string pathname = "test_image_writer.tif";
+    const auto image = makeImage();
+    {
+        tiff::FileWriter writer(pathname);
+        writer.writeHeader();
+        tiff::ImageWriter* const imageWriter = addImage(writer, format, compression, predictor);
+
+        // Odd-sized pieces so buffered rows straddle chunk boundaries.
+        size_t pos = 0;
+        size_t step = 31;
+        while (pos < image.size())
+        {
+            const size_t numElements = std::min(step, image.size() - pos);
+            writer.putData(reinterpret_cast<const unsigned char*>(image.data() + pos),
+                           static_cast<sys::Uint32_T>(numElements));
+            pos += numElements;
+            step = step * 2 + 1;
+        }
+        imageWriter->writeIFD();
+        writer.close();
+    }
+    checkImage(testName, pathname, image);
+    sys::OS().remove(pathname);
+}
+}
+
+TEST_CASE(testPutDataCompressed)
+{
+    const std::vector<unsigned short> compressions{ tiff::Const::CompressionType::LZW,
+                                                    tiff::Const::CompressionType::PACK_BITS,
+                                                    tiff::Const::CompressionType::DEFLATE };
+    for (const auto compression : compressions)
+    {
+        if (!tiff::Compression::isSupported(compression))
+            continue;
+        testPutData(testName, tiff::ImageWriter::STRIPPED, compression, tiff::Const::PredictorType::NONE);
+        testPutData(testName, tiff::ImageWriter::TILED, compression, tiff::Const::PredictorType::NONE);
+        testPutData(testName, tiff::ImageWriter::STRIPPED, compression,
+                    tiff::Const::PredictorType::HORIZONTAL_DIFFERENCING);
+        testPutData(testName, tiff::ImageWriter::TILED, compression,
+                    tiff::Const::PredictorType::HORIZONTAL_DIFFERENCING);
+    }
+}
+
+TEST_CASE(testPutChunk)
+{
+    const std::string pathname = "test_image_writer.tif";
+    const auto image = makeImage();
+    {
+        tiff::FileWriter writer(pathname);
+        writer.writeHeader();
+        tiff::ImageWriter* const imageWriter = addImage(writer, tiff::ImageWriter::TILED,
+                tiff::Const::CompressionType::LZW, tiff::Const::PredictorType::NONE);
+
+        const tiff::IFD& ifd = *imageWriter->getIFD();
+        const size_t numChunks = imageWriter->getNumChunks();
+        const auto tileWidth = static_cast<size_t>(ifd["TileWidth"]->getUint64(0));
+        const auto tileLength = static_cast<size_t>(ifd["TileLength"]->getUint64(0));
+        const size_t tilesAcross = (NUM_COLS + tileWidth - 1) / tileWidth;
+        TEST_ASSERT_EQ(imageWriter->getChunkSize(0), tileWidth * tileLength * sizeof(uint16_t));
+
+        // Tiles are written back to front, interleaved across threads.
+        const size_t numThreads = 3;
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < numThreads; ++thread)
+        {
+            threads.emplace_back([&, thread]()
+            {
+                for (size_t ii = numChunks - 1 - thread; ii < numChunks; ii -= numThreads)
+                {
+                    std::vector<uint16_t> tile(tileWidth * tileLength);
+                    const size_t row0 = (ii / tilesAcross) * tileLength;
+                    const size_t col0 = (ii % tilesAcross) * tileWidth;
+                    for (size_t row = row0; row < std::min(row0 + tileLength, NUM_ROWS); ++row)
+                    {
+                        const size_t numCols = std::min(tileWidth, NUM_COLS - col0);
+                        memcpy(&tile[(row - row0) * tileWidth], &image[row * NUM_COLS + col0],
+                               numCols * sizeof(uint16_t));
+                    }
+                    imageWriter->putChunk(ii, reinterpret_cast<const unsigned char*>(tile.data()));
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        // Each chunk can only be written once.
+        std::vector<uint16_t> tile(tileWidth * tileLength);
+        TEST_EXCEPTION(imageWriter->putChunk(0, reinterpret_cast<const unsigned char*>(tile.data())));
+
+        imageWriter->writeIFD();
+        writer.close();
+    }
+    checkImage(testName, pathname, image);
+    sys::OS().remove(pathname);
+}
+
+TEST_CASE(testMissingChunk)
+{
+    const std::string pathname = "test_image_writer.tif";
+    {
+        tiff::FileWriter writer(pathname);
+        writer.writeHeader();
+        tiff::ImageWriter* const imageWriter = addImage(writer, tiff::ImageWriter::STRIPPED,
+                tiff::Const::CompressionType::PACK_BITS, tiff::Const::PredictorType::NONE);
+        TEST_ASSERT(imageWriter->getNumChunks() > 1);
+
+        std::vector<unsigned char> strip(imageWriter->getChunkSize(0));
+        imageWriter->putChunk(0, strip.data());
+        TEST_EXCEPTION(imageWriter->writeIFD());
+        writer.close();
+    }
+    sys::OS().remove(pathname);
+}
+
+TEST_CASE(testShortTiledImage)
+{
+    // Fewer rows than a single 32x32 tile.
+    const size_t numRows = 20;
+    const std::string pathname = "test_image_writer.tif";
+    const auto image = makeImage(numRows);
+    size_t tileSize = 0;
+    {
+        tiff::FileWriter writer(pathname);
+        writer.writeHeader();
+        tiff::ImageWriter* const imageWriter = addImage(writer, tiff::ImageWriter::TILED,
+                tiff::Const::CompressionType::PACK_BITS, tiff::Const::PredictorType::NONE,
+                numRows);
+        writer.putData(reinterpret_cast<const unsigned char*>(image.data()),
+                       static_cast<sys::Uint32_T>(image.size()));
+        tileSize = imageWriter->getChunkSize(0);
+
+        // Writing the IFD again would repeat the offsets.
+        imageWriter->writeIFD();
+        TEST_EXCEPTION(imageWriter->writeIFD());
+        TEST_ASSERT_EQ((*imageWriter->getIFD())["TileOffsets"]->getCount(),
+                       static_cast<sys::Uint32_T>(imageWriter->getNumChunks()));
+        TEST_ASSERT_EQ((*imageWriter->getIFD())["TileByteCounts"]->getCount(),
+                       static_cast<sys::Uint32_T>(imageWriter->getNumChunks()));
+        writer.close();
+    }
+
+    {
+        tiff::FileReader reader(pathname);
+        const tiff::IFD& ifd = *reader[0]->getIFD();
+        const auto tileWidth = static_cast<size_t>(ifd["TileWidth"]->getUint64(0));
+        const auto tileLength = static_cast<size_t>(ifd["TileLength"]->getUint64(0));
+        TEST_ASSERT(tileLength > numRows);
+
+        // Tiles are padded to full size, even past the last row.
+        TEST_ASSERT_EQ(tileSize, tileWidth * tileLength * sizeof(uint16_t));
+
+        // Every tile decodes to the full TileLength rows.
+        const tiff::IFDEntry* const offsets = ifd["TileOffsets"];
+        const tiff::IFDEntry* const byteCounts = ifd["TileByteCounts"];
+        TEST_ASSERT_EQ(offsets->getCount(), byteCounts->getCount());
+        io::FileInputStream input(pathname);
+        for (sys::Uint32_T ii = 0; ii < byteCounts->getCount(); ++ii)
+        {
+            std::vector<unsigned char> raw(static_cast<size_t>(byteCounts->getUint64(ii)));
+            input.seek(static_cast<sys::Off_T>(offsets->getUint64(ii)), io::Seekable::START);
+            input.read(reinterpret_cast<sys::byte*>(raw.data()), raw.size());
+
+            std::vector<unsigned char> tile(tileSize);
+            TEST_ASSERT_EQ(tiff::Compression::decompress(tiff::Const::CompressionType::PACK_BITS,
+                           raw.data(), raw.size(), tile.data(), tile.size()), tileSize);
+        }
+        input.close();
+        reader.close();
+    }
+    checkImage(testName, pathname, image);
+    sys::OS().remove(pathname);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testPutDataCompressed);
+    TEST_CHECK(testPutChunk);
+    TEST_CHECK(testMissingChunk);
+    TEST_CHECK(testShortTiledImage);
+    )
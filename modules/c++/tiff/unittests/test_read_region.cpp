@@ -0,0 +1,179 @@
+/* =========================================================================
+ * This file is part of tiff-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * tiff-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TestCase.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <import/sys.h>
+#include <tiff/Common.h>
+#include <tiff/FileReader.h>
+#include <tiff/FileWriter.h>
+#include <tiff/IFD.h>
+#include <tiff/KnownTags.h>
+#include <tiff/TileCache.h>
+
+namespace
+{
+constexpr size_t NUM_ROWS = 90;
+constexpr size_t NUM_COLS = 70;
+
+std::vector<uint16_t> makeImage()
+{
+    std::vector<uint16_t> image(NUM_ROWS * NUM_COLS);
+    for (size_t ii = 0; ii < image.size(); ++ii)
+        image[ii] = static_cast<uint16_t>(ii * 3 + 1);
+    return image;
+}
+
+void writeImage(const std::string& pathname, tiff::ImageWriter::ImageFormat format,
+                const std::vector<uint16_t>& image)
+{
+    tiff::FileWriter writer(pathname);
+    writer.writeHeader();
+
+    tiff::ImageWriter* const imageWriter = writer.addImage();
+    imageWriter->setImageFormat(format);
+    imageWriter->setIdealChunkSize(1024);
+
+    tiff::IFD* const ifd = imageWriter->getIFD();
+    ifd->addEntry(tiff::KnownTags::IMAGE_WIDTH, static_cast<sys::Uint32_T>(NUM_COLS));
+    ifd->addEntry(tiff::KnownTags::IMAGE_LENGTH, static_cast<sys::Uint32_T>(NUM_ROWS));
+    ifd->addEntry(tiff::KnownTags::BITS_PER_SAMPLE, static_cast<unsigned short>(16));
+    ifd->addEntry(tiff::KnownTags::PHOTOMETRIC_INTERPRETATION,
+                  static_cast<unsigned short>(tiff::Const::PhotoInterpType::BLACK_IS_ZERO));
+
+    writer.putData(reinterpret_cast<const unsigned char*>(image.data()),
+                   static_cast<sys::Uint32_T>(image.size()));
+    imageWriter->writeIFD();
+    writer.close();
+}
+
+void testRegions(const std::string& testName, tiff::ImageWriter::ImageFormat format)
+{
+    const std::string pathname = "test_read_region.tif";
+    const auto image = makeImage();
+    writeImage(pathname, format, image);
+
+    tiff::FileReader reader(pathname);
+    tiff::ImageReader& imageReader = *reader[0];
+
+    struct Region final { size_t row, col, numRows, numCols; };
+    const std::vector<Region> regions{ { 0, 0, NUM_ROWS, NUM_COLS },
+                                       { 17, 5, 40, 33 },
+                                       { NUM_ROWS - 1, NUM_COLS - 1, 1, 1 },
+                                       { 31, 0, 1, NUM_COLS },
+                                       { 17, 5, 40, 33 } }; // served from the cache
+    for (const auto& region : regions)
+    {
+        std::vector<uint16_t> actual(region.numRows * region.numCols);
+        imageReader.readRegion(region.row, region.col, region.numRows, region.numCols,
+                               reinterpret_cast<unsigned char*>(actual.data()));
+        for (size_t rr = 0; rr < region.numRows; ++rr)
+        {
+            for (size_t cc = 0; cc < region.numCols; ++cc)
+            {
+                TEST_ASSERT_EQ(actual[rr * region.numCols + cc],
+                               image[(region.row + rr) * NUM_COLS + region.col + cc]);
+            }
+        }
+    }
+    TEST_ASSERT(imageReader.getTileCache().size() > 0);
+
+    // Reading past the edge of the image is an error.
+    std::vector<uint16_t> scratch(4);
+    TEST_EXCEPTION(imageReader.readRegion(NUM_ROWS - 1, 0, 2, 2,
+            reinterpret_cast<unsigned char*>(scratch.data())));
+
+    // With caching disabled the results are the same.
+    imageReader.setTileCacheSize(0);
+    TEST_ASSERT_EQ(imageReader.getTileCache().size(), static_cast<size_t>(0));
+    std::vector<uint16_t> actual(image.size());
+    imageReader.readRegion(0, 0, NUM_ROWS, NUM_COLS,
+                           reinterpret_cast<unsigned char*>(actual.data()));
+    TEST_ASSERT(actual == image);
+    TEST_ASSERT_EQ(imageReader.getTileCache().size(), static_cast<size_t>(0));
+
+    reader.close();
+    sys::OS().remove(pathname);
+}
+
+tiff::TileCache::TilePtr makeTile(size_t size)
+{
+    return std::make_shared<std::vector<unsigned char> >(size);
+}
+}
+
+TEST_CASE(testTileCache)
+{
+    tiff::TileCache cache(300);
+    cache.put(0, makeTile(100));
+    cache.put(1, makeTile(100));
+    cache.put(2, makeTile(100));
+    TEST_ASSERT_EQ(cache.getNumBytes(), static_cast<size_t>(300));
+
+    // Touch tile 0 so tile 1 is the least recently used.
+    TEST_ASSERT_NOT_EQ(cache.get(0), nullptr);
+    cache.put(3, makeTile(100));
+    TEST_ASSERT_EQ(cache.size(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(cache.get(1), nullptr);
+    TEST_ASSERT_NOT_EQ(cache.get(0), nullptr);
+
+    // Replacing a tile doesn't double count it.
+    cache.put(3, makeTile(50));
+    TEST_ASSERT_EQ(cache.getNumBytes(), static_cast<size_t>(250));
+
+    // A tile bigger than the budget isn't kept, and doesn't flush the others.
+    cache.put(4, makeTile(1000));
+    TEST_ASSERT_EQ(cache.get(4), nullptr);
+    TEST_ASSERT_EQ(cache.size(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(cache.getNumBytes(), static_cast<size_t>(250));
+
+    // Nor does an oversized replacement leave the old tile behind.
+    cache.put(3, makeTile(1000));
+    TEST_ASSERT_EQ(cache.get(3), nullptr);
+    TEST_ASSERT_EQ(cache.getNumBytes(), static_cast<size_t>(200));
+
+    cache.put(5, makeTile(100));
+    cache.setMaxBytes(50);
+    TEST_ASSERT_EQ(cache.size(), static_cast<size_t>(0));
+}
+
+TEST_CASE(testReadRegionStripped)
+{
+    testRegions(testName, tiff::ImageWriter::STRIPPED);
+}
+
+TEST_CASE(testReadRegionTiled)
+{
+    testRegions(testName, tiff::ImageWriter::TILED);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testTileCache);
+    TEST_CHECK(testReadRegionStripped);
+    TEST_CHECK(testReadRegionTiled);
+    )
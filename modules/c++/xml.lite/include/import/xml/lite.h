@@ -30,10 +30,17 @@
 #include "xml/lite/NamespaceStack.h"
 #include "xml/lite/Document.h"
 #include "xml/lite/Element.h"
+#include "xml/lite/ElementIndex.h"
+#include "xml/lite/ElementPath.h"
 #include "xml/lite/XMLException.h"
 #include "xml/lite/XMLReader.h"
 #include "xml/lite/MinidomHandler.h"
 #include "xml/lite/MinidomParser.h"
+#include "xml/lite/CompactDocument.h"
+#include "xml/lite/CompactDomParser.h"
+#include "xml/lite/ParserPool.h"
+#include "xml/lite/XMLStreamReader.h"
+#include "xml/lite/XMLWriter.h"
 #include "xml/lite/Serializable.h"
 #include "xml/lite/Validator.h"
 
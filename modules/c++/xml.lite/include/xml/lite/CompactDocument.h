@@ -0,0 +1,377 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_CompactDocument_h_INCLUDED_
+#define CODA_OSS_xml_lite_CompactDocument_h_INCLUDED_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <memory>
+#include <new> // std::nothrow_t
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <config/Exports.h>
+#include <coda_oss/span.h>
+#include <coda_oss/string.h>
+
+#include "xml/lite/Attributes.h"
+#include "xml/lite/Element.h"
+#include "xml/lite/QName.h"
+
+/*!
+ * \file  CompactDocument.h
+ * \brief A read-only, arena-backed alternative to Document.
+ *
+ * A Document built by the MinidomHandler is a tree of individually
+ * allocated Elements, each with its own strings, QName and Attributes;
+ * for very large documents most of the parse (and teardown) time goes
+ * to the allocator.  A CompactDocument stores every element and
+ * attribute in a flat array, interns names so each distinct name is
+ * stored once, and keeps all character data and attribute values back
+ * to back in a single buffer.  Destroying it frees a handful of
+ * blocks regardless of the size of the document.
+ *
+ * Elements are accessed through CompactElement, a cheap handle that
+ * mirrors the query side of Element.
+ */
+
+namespace xml
+{
+namespace lite
+{
+struct CompactDocument;
+
+/*!
+ * \class CompactElement
+ * \brief A read-only view of one element of a CompactDocument
+ *
+ * This is a (document, index) pair and is cheap to copy; it is only
+ * valid as long as the document is.  A default-constructed element
+ * is "null" and converts to false; that is what the std::nothrow
+ * lookups return when nothing matches.
+ */
+class CODA_OSS_API CompactElement final
+{
+    const CompactDocument* mDocument = nullptr;
+    uint32_t mIndex = 0;
+
+public:
+    CompactElement() = default;
+    CompactElement(const CompactDocument& document, uint32_t index) :
+        mDocument(&document), mIndex(index)
+    {
+    }
+
+    explicit operator bool() const
+    {
+        return mDocument != nullptr;
+    }
+
+    std::string getLocalName() const;
+    std::string getPrefix() const;
+    std::string getUri() const;
+
+    /*!
+     *  Returns the qualified name (e.g., soap-env:Body).
+     */
+    std::string getQName() const;
+    void getQName(xml::lite::QName& result) const;
+
+    /*!
+     *  Returns the character data of this element.  The view points
+     *  into the document's buffer and is UTF-8 encoded.
+     */
+    coda_oss::span<const char> characterData() const;
+    std::string getCharacterData() const;  // native encoding, as Element
+    const coda_oss::u8string& getCharacterData(coda_oss::u8string& result) const;
+
+    /*!
+     *  Attributes are stored in the document; these look them up
+     *  without building an Attributes object.
+     */
+    size_t getNumAttributes() const;
+
+    /*!
+     *  The parts of the name, and of attribute i's name and value, as
+     *  stored in the document; nothing is copied.
+     *  \param i  Must be less than getNumAttributes()
+     */
+    const std::string& prefix() const;
+    const std::string& localName() const;
+    const std::string& attributePrefix(size_t i) const;
+    const std::string& attributeLocalName(size_t i) const;
+    coda_oss::span<const char> attributeValue(size_t i) const;
+
+    bool getAttributeValue(const std::string& qname, std::string& result) const;
+    bool getAttributeValue(const xml::lite::QName&, std::string& result) const;
+
+    /*!
+     *  Returns the value of the attribute with the specified qname.
+     *  \throw except::NoSuchKeyException if there isn't one
+     */
+    std::string attribute(const std::string& qname) const;
+
+    //! Builds an Attributes object, for code that needs one.
+    Attributes getAttributes() const;
+
+    CompactElement getParent() const;
+
+    //! The first child and next sibling, for allocation-free walks
+    CompactElement getFirstChild() const;
+    CompactElement getNextSibling() const;
+
+    size_t getNumChildren() const;
+    std::vector<CompactElement> getChildren() const;
+
+    /*!
+     *  Get the elements by local name, like Element::getElementsByTagName()
+     *  \param localName The local name
+     *  \param elements The elements
+     */
+    void getElementsByTagName(const std::string& localName,
+                              std::vector<CompactElement>& elements,
+                              bool recurse = false) const;
+    std::vector<CompactElement> getElementsByTagName(const std::string& localName,
+                                                     bool recurse = false) const
+    {
+        std::vector<CompactElement> v;
+        getElementsByTagName(localName, v, recurse);
+        return v;
+    }
+    void getElementsByTagName(const xml::lite::QName&,
+                              std::vector<CompactElement>& elements,
+                              bool recurse = false) const;
+    std::vector<CompactElement> getElementsByTagName(const xml::lite::QName& name,
+                                                     bool recurse = false) const
+    {
+        std::vector<CompactElement> v;
+        getElementsByTagName(name, v, recurse);
+        return v;
+    }
+    void getElementsByTagNameNS(const std::string& qname,
+                                std::vector<CompactElement>& elements,
+                                bool recurse = false) const;
+    std::vector<CompactElement> getElementsByTagNameNS(const std::string& qname,
+                                                       bool recurse = false) const
+    {
+        std::vector<CompactElement> v;
+        getElementsByTagNameNS(qname, v, recurse);
+        return v;
+    }
+
+    /*!
+     *  \param std::nothrow -- returns a null element unless exactly one is found
+     */
+    CompactElement getElementByTagName(std::nothrow_t, const std::string& localName, bool recurse = false) const;
+    CompactElement getElementByTagName(const std::string& localName, bool recurse = false) const;
+    CompactElement getElementByTagName(std::nothrow_t, const xml::lite::QName&, bool recurse = false) const;
+    CompactElement getElementByTagName(const xml::lite::QName&, bool recurse = false) const;
+    CompactElement getElementByTagNameNS(std::nothrow_t, const std::string& qname, bool recurse = false) const;
+    CompactElement getElementByTagNameNS(const std::string& qname, bool recurse = false) const;
+
+    bool hasElement(const std::string& localName) const;
+    bool hasElement(const xml::lite::QName&) const;
+
+    /*!
+     *  Makes a deep copy of this element (and its children) as an
+     *  ordinary, mutable Element.
+     */
+    std::unique_ptr<Element> toElement() const;
+
+    bool operator==(const CompactElement& rhs) const
+    {
+        return (mDocument == rhs.mDocument) && (mIndex == rhs.mIndex);
+    }
+    bool operator!=(const CompactElement& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    template <typename TMatch>
+    void getElements(TMatch match, std::vector<CompactElement>& elements, bool recurse) const;
+};
+
+/*!
+ * \class CompactDocument
+ * \brief The arena holding the elements of a parsed document.
+ *
+ * Normally filled in by a CompactDomHandler (see CompactDomParser.h);
+ * the building functions are public so other handlers can use them.
+ * Elements must be added in document order (a parent before its
+ * children), which is what a SAX parse produces.
+ */
+struct CODA_OSS_API CompactDocument final
+{
+    //! An index that refers to nothing
+    static const uint32_t npos;
+
+    CompactDocument() = default;
+    CompactDocument(const CompactDocument&) = delete;
+    CompactDocument& operator=(const CompactDocument&) = delete;
+    CompactDocument(CompactDocument&&) = default;
+    CompactDocument& operator=(CompactDocument&&) = default;
+
+    /*!
+     *  Retrieves the root element; null if the document is empty.
+     */
+    CompactElement getRootElement() const
+    {
+        return mNodes.empty() ? CompactElement() : CompactElement(*this, 0);
+    }
+
+    bool empty() const
+    {
+        return mNodes.empty();
+    }
+
+    size_t getNumElements() const
+    {
+        return mNodes.size();
+    }
+
+    /*!
+     *  Discards every element; the memory is kept for the next parse.
+     */
+    void clear();
+
+    /*!
+     *  Adds an element as the last child of the specified parent.
+     *  \param parent  The parent, npos for the root element
+     *  \param uri  The namespace URI
+     *  \param qname  The qualified name, prefix:localName
+     *  \return The index of the new element
+     */
+    uint32_t addElement(uint32_t parent, const std::string& uri, const std::string& qname);
+
+    /*!
+     *  Adds an attribute to the most recently added element.
+     */
+    void addAttribute(const std::string& uri, const std::string& qname, const std::string& value);
+
+    /*!
+     *  Sets the character data of an element; the data is copied
+     *  to the end of the document's buffer.
+     */
+    void setCharacterData(uint32_t element, const char* data, size_t size);
+
+    /*!
+     *  Returns the id of an interned name, or npos if no element or
+     *  attribute uses it.  Comparing ids is how lookups avoid string
+     *  comparisons.
+     */
+    uint32_t findName(const std::string& name) const;
+
+    /*!
+     *  The number of bytes the document holds on to, including spare
+     *  capacity.
+     */
+    size_t getNumBytes() const;
+
+private:
+    friend class CompactElement;
+
+    struct Node final
+    {
+        uint32_t parent;
+        uint32_t firstChild;
+        uint32_t lastChild;
+        uint32_t nextSibling;
+        uint32_t numChildren;
+        uint32_t uri;  // name ids
+        uint32_t prefix;
+        uint32_t localName;
+        uint32_t firstAttribute;
+        uint32_t numAttributes;
+        size_t textOffset;  // into mText
+        size_t textSize;
+    };
+    struct Attribute final
+    {
+        uint32_t uri;
+        uint32_t prefix;
+        uint32_t localName;
+        size_t valueOffset;  // into mText
+        size_t valueSize;
+    };
+
+    uint32_t intern(const std::string& name);
+    void splitQName(const std::string& qname, uint32_t& prefix, uint32_t& localName);
+    const std::string& getName(uint32_t id) const
+    {
+        return mNames[id];
+    }
+    coda_oss::span<const char> getText(size_t offset, size_t size) const
+    {
+        return coda_oss::span<const char>(mText.data() + offset, size);
+    }
+    size_t appendText(const char* data, size_t size);
+
+    std::vector<Node> mNodes;
+    std::vector<Attribute> mAttributes;
+
+    //! Character data and attribute values, back to back
+    std::vector<char> mText;
+
+    //! Interned names; id 0 is the empty string
+    std::vector<std::string> mNames;
+    std::unordered_map<std::string, uint32_t> mNameIds;
+};
+
+#ifndef SWIG
+/*!
+ *  Returns the character data of this element converted to the specified type.
+ */
+template <typename T>
+inline T getValue(const CompactElement& element)
+{
+    const auto characterData = element.getCharacterData();
+    if (characterData.empty())
+    {
+        throw except::BadCastException(Ctxt("call getCharacterData() to get an empty string"));
+    }
+    return details::toType<T>(characterData);
+}
+template <typename T>
+inline bool getValue(const CompactElement& element, T& value)
+{
+    try
+    {
+        value = getValue<T>(element);
+    }
+    catch (const except::BadCastException&)
+    {
+        return false;
+    }
+    return true;
+}
+#endif // SWIG
+
+}
+}
+
+#endif // CODA_OSS_xml_lite_CompactDocument_h_INCLUDED_
@@ -0,0 +1,178 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_CompactDomParser_h_INCLUDED_
+#define CODA_OSS_xml_lite_CompactDomParser_h_INCLUDED_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <config/Exports.h>
+#include <io/InputStream.h>
+
+#include "xml/lite/ContentHandler.h"
+#include "xml/lite/CompactDocument.h"
+#include "xml/lite/XMLReader.h"
+
+/*!
+ * \file CompactDomParser.h
+ * \brief Parses a document into a CompactDocument.
+ *
+ * This is the MinidomParser for the arena-backed CompactDocument:
+ * the same SAX driver underneath, but elements go into the
+ * document's arrays rather than being allocated one by one.  Use it
+ * for large documents that are only read.
+ */
+
+namespace xml
+{
+namespace lite
+{
+/*!
+ * \class CompactDomHandler
+ * \brief A ContentHandler that fills a CompactDocument.
+ *
+ * Character data is handled just as in MinidomHandler: the text
+ * directly inside an element (before, between and after its children)
+ * is concatenated and, unless preserveCharacterData() is set, trimmed.
+ */
+struct CODA_OSS_API CompactDomHandler final : public ContentHandler
+{
+    CompactDomHandler() = default;
+    ~CompactDomHandler() = default;
+    CompactDomHandler(const CompactDomHandler&) = delete;
+    CompactDomHandler& operator=(const CompactDomHandler&) = delete;
+
+    CompactDocument& getDocument()
+    {
+        return mDocument;
+    }
+    const CompactDocument& getDocument() const
+    {
+        return mDocument;
+    }
+
+    void characters(const char* value, int length) override;
+    bool vcharacters(const void /*XMLCh*/*, size_t length) override;
+
+    void startElement(const std::string& uri,
+                      const std::string& localName,
+                      const std::string& qname,
+                      const Attributes& atts) override;
+
+    void endElement(const std::string& uri,
+                    const std::string& localName,
+                    const std::string& qname) override;
+
+    //! Empties the document, keeping its memory for the next parse.
+    void clear();
+
+    /*!
+     * If set to true, whitespaces will be preserved in the parsed
+     * character data. Otherwise, it will be trimmed.
+     */
+    void preserveCharacterData(bool preserve)
+    {
+        mPreserveCharData = preserve;
+    }
+
+private:
+    struct OpenElement final
+    {
+        uint32_t index;
+        size_t textStart;  // where this element's text starts in mCharacters
+    };
+
+    CompactDocument mDocument;
+
+    //! Text of the open elements, outermost first
+    std::string mCharacters;
+    std::vector<OpenElement> mOpenElements;
+    bool mPreserveCharData = false;
+};
+
+/*!
+ * \class CompactDomParser
+ * \brief Parses an InputStream into a CompactDocument.
+ */
+struct CODA_OSS_API CompactDomParser final
+{
+    CompactDomParser();
+    ~CompactDomParser() = default;
+    CompactDomParser(const CompactDomParser&) = delete;
+    CompactDomParser& operator=(const CompactDomParser&) = delete;
+
+    /*!
+     *  Parses the stream, replacing the current document.
+     *  \param is  This is the input stream to feed the parser
+     *  \param size  This is the size of the stream to feed the parser
+     */
+    void parse(io::InputStream& is, int size = io::InputStream::IS_END);
+
+    //! Empties the document, keeping its memory for the next parse.
+    void clear()
+    {
+        mHandler.clear();
+    }
+
+    const CompactDocument& getDocument() const
+    {
+        return mHandler.getDocument();
+    }
+
+    /*!
+     *  Moves the document out of the parser; the parser is left with
+     *  an empty one.  CompactElements refer to the document object,
+     *  so get them from the returned document, not before the move.
+     */
+    CompactDocument releaseDocument();
+
+    XMLReader& getReader()
+    {
+        return mReader;
+    }
+
+    CompactDomHandler& getHandler()
+    {
+        return mHandler;
+    }
+
+    //! @see CompactDomHandler::preserveCharacterData
+    void preserveCharacterData(bool preserve)
+    {
+        mHandler.preserveCharacterData(preserve);
+    }
+
+private:
+    CompactDomHandler mHandler;
+    XMLReader mReader;
+};
+
+}
+}
+
+#endif  // CODA_OSS_xml_lite_CompactDomParser_h_INCLUDED_
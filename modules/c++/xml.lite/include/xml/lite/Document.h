@@ -40,11 +40,13 @@
 
 #include <utility>
 #include <memory>
+#include <mutex>
 #include "coda_oss/string.h"
 
 #include <config/Exports.h>
 
 #include "xml/lite/Element.h"
+#include "xml/lite/ElementIndex.h"
 #include "xml/lite/QName.h"
 
 namespace xml
@@ -175,6 +177,28 @@ struct CODA_OSS_API Document  // SOAPDocument derives :-(
         return mRootNode;
     }
 
+    #ifndef SWIG
+    /*!
+     * An index of the element names in the document, for frequent
+     * lookups.  It's built the first time it's needed and again after
+     * anything in the tree changes (see Element::getModificationCount()).
+     * Threads may call this at the same time, so long as none of them
+     * is changing the tree.
+     * \throw XMLException if there is no root element
+     */
+    const ElementIndex& getIndex() const;
+
+    /*!
+     * Discards the index; needed only after changing the tree directly
+     * through Element::getChildren().
+     */
+    void invalidateIndex()
+    {
+        std::lock_guard<std::mutex> lock(mIndexMutex);
+        mIndex.reset();
+    }
+    #endif // SWIG
+
 private:
     Document(const Document&);
     Document& operator=(const Document&);
@@ -182,6 +206,11 @@ private:
     //! The root node element
     Element *mRootNode;
     bool mOwnRoot;
+
+    #ifndef SWIG
+    mutable std::unique_ptr<ElementIndex> mIndex;
+    mutable std::mutex mIndexMutex;
+    #endif // SWIG
 };
 
 inline Element& getRootElement(Document& doc)
@@ -24,6 +24,8 @@
 #ifndef CODA_OSS_xml_lite_Element_h_INCLUDED_
 #define CODA_OSS_xml_lite_Element_h_INCLUDED_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <new> // std::nothrow_t
@@ -349,6 +351,7 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     void setLocalName(const std::string& localName)
     {
         mName.setName(localName);
+        modified();
     }
 
     /*!
@@ -367,10 +370,12 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     void setQName(const std::string& qname)
     {
         mName.setQName(qname);
+        modified();
     }
     void setQName(const xml::lite::QName& qname)
     {
         mName = qname;
+        modified();
     }
     Element& operator=(const QName& qname)
     {
@@ -400,6 +405,7 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     void setUri(const xml::lite::Uri& uri)
     {
         mName.setAssociatedUri(uri);
+        modified();
     }
     void setUri(const std::string& uri)
     {
@@ -424,6 +430,7 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     void setPrefix(const std::string& prefix)
     {
         mName.setPrefix(prefix);
+        modified();
     }
 
 
@@ -465,6 +472,7 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
     void clearChildren()
     {
         mChildren.clear();
+        modified();
     }
 
     Element* getParent() const
@@ -474,10 +482,30 @@ struct CODA_OSS_API Element  // SOAPElement derives :-(
 
     void setParent(Element* parent)
     {
+        modified();  // the tree this element is leaving ...
         mParent = parent;
+        modified();  // ... and the one it's joining
+    }
+
+    //! The element at the top of this one's tree: itself if it has no parent
+    const Element& getTop() const;
+
+    /*!
+     *  A count of the changes made to the names and structure of the
+     *  tree this element is in (setQName(), addChild(),
+     *  destroyChildren(), etc.), kept by getTop().  An ElementIndex
+     *  uses this to know when it's out of date.  Changes made directly
+     *  through getChildren() aren't counted.
+     */
+    uint64_t getModificationCount() const
+    {
+        return getTop().mModificationCount;
     }
 
 protected:
+    //! Bumps getModificationCount() for this element's tree
+    void modified();
+
     //! The children of this element
     std::vector<Element*> mChildren;
     xml::lite::QName mName;
@@ -494,6 +522,7 @@ private:
     void depthPrint(io::OutputStream& stream, int depth, const std::string& formatter, bool isConsoleOutput = false) const;
 
     Element* mParent = nullptr;
+    uint64_t mModificationCount = 0;  // only meaningful at the top of a tree
     //! The attributes for this element
     xml::lite::Attributes mAttributes;
     coda_oss::u8string mCharacterData;
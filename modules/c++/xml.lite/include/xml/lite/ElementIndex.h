@@ -0,0 +1,195 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_ElementIndex_h_INCLUDED_
+#define CODA_OSS_xml_lite_ElementIndex_h_INCLUDED_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <config/Exports.h>
+
+#include "xml/lite/Element.h"
+#include "xml/lite/QName.h"
+
+/*!
+ * \file ElementIndex.h
+ * \brief Name lookups without walking the tree
+ *
+ * Element::getElementsByTagName() scans (and with recurse, walks)
+ * the tree on every call, comparing names as strings.  ElementIndex
+ * numbers the elements of a tree in document order and, for every
+ * local name, keeps the list of elements with that name; a recursive
+ * query is then a binary search and a copy.
+ *
+ * Document::getIndex() builds one on demand and rebuilds it when the
+ * tree changes.
+ */
+
+namespace xml
+{
+namespace lite
+{
+/*!
+ * \class ElementIndex
+ * \brief A snapshot of the names in a tree of elements
+ *
+ * The results are the same (and in the same order) as the Element
+ * functions of the same name.  The index doesn't follow changes to
+ * the tree: when isStale() is true, build a new one.
+ */
+class CODA_OSS_API ElementIndex final
+{
+public:
+    //! Refers to nothing
+    static const uint32_t npos;
+
+    /*!
+     *  Indexes root and everything under it.
+     *  \param root  Must outlive the index
+     */
+    explicit ElementIndex(const Element& root);
+
+    ElementIndex(const ElementIndex&) = delete;
+    ElementIndex& operator=(const ElementIndex&) = delete;
+    ElementIndex(ElementIndex&&) = default;
+    ElementIndex& operator=(ElementIndex&&) = default;
+
+    const Element& getRoot() const
+    {
+        return *mEntries[0].element;
+    }
+
+    //! The number of elements indexed
+    size_t size() const
+    {
+        return mEntries.size();
+    }
+
+    /*!
+     *  Whether the tree holding the root has changed since the index
+     *  was built; see Element::getModificationCount().  This errs on
+     *  the side of caution: a change anywhere in that tree, even
+     *  outside the indexed part, makes the index stale.
+     */
+    bool isStale() const
+    {
+        const Element& top = getRoot().getTop();
+        return (&top != mTop) || (top.getModificationCount() != mModificationCount);
+    }
+
+    //! Whether the element is in the index
+    bool contains(const Element&) const;
+
+    /*!
+     *  As Element::getElementsByTagName(), starting from base.
+     *  \throw XMLException if base isn't in the index
+     */
+    void getElementsByTagName(const Element& base, const std::string& localName,
+                              std::vector<Element*>& elements, bool recurse = false) const;
+    std::vector<Element*> getElementsByTagName(const Element& base, const std::string& localName,
+                                               bool recurse = false) const
+    {
+        std::vector<Element*> retval;
+        getElementsByTagName(base, localName, retval, recurse);
+        return retval;
+    }
+    void getElementsByTagName(const Element& base, const xml::lite::QName&,
+                              std::vector<Element*>& elements, bool recurse = false) const;
+    std::vector<Element*> getElementsByTagName(const Element& base, const xml::lite::QName& name,
+                                               bool recurse = false) const
+    {
+        std::vector<Element*> retval;
+        getElementsByTagName(base, name, retval, recurse);
+        return retval;
+    }
+
+    /*!
+     *  As Element::getElementsByTagNameNS(), starting from base.
+     *  \param qname  prefix:localName, or just localName for no prefix
+     */
+    void getElementsByTagNameNS(const Element& base, const std::string& qname,
+                                std::vector<Element*>& elements, bool recurse = false) const;
+    std::vector<Element*> getElementsByTagNameNS(const Element& base, const std::string& qname,
+                                                 bool recurse = false) const
+    {
+        std::vector<Element*> retval;
+        getElementsByTagNameNS(base, qname, retval, recurse);
+        return retval;
+    }
+
+    /*!
+     *  Lower-level access, for ElementPath: elements are referred to
+     *  by their position in document order (the root is 0), and names
+     *  by the id findName() returns.
+     */
+    uint32_t findName(const std::string& name) const;
+    uint32_t getPosition(const Element&) const;
+    Element* getElement(uint32_t position) const
+    {
+        return mEntries[position].element;
+    }
+
+    /*!
+     *  Appends the positions of the children (or, with recurse, the
+     *  descendants) of the element at position whose local name has
+     *  the given id; npos matches any name.
+     */
+    void getPositions(uint32_t position, uint32_t localName, std::vector<uint32_t>& positions,
+                      bool recurse) const;
+
+private:
+    struct Entry final
+    {
+        Element* element;
+        uint32_t parent;
+        uint32_t end;  // one past the last descendant
+        uint32_t localName;  // name ids
+        uint32_t prefix;
+        uint32_t uri;
+    };
+
+    uint32_t intern(const std::string&);
+
+    template <typename TMatch>
+    void getElements(const Element& base, uint32_t localName, TMatch match,
+                     std::vector<Element*>& elements, bool recurse) const;
+
+    const Element* mTop = nullptr;
+    uint64_t mModificationCount = 0;
+    std::vector<Entry> mEntries;
+    std::unordered_map<const Element*, uint32_t> mPositions;
+    std::unordered_map<std::string, uint32_t> mNameIds;
+
+    //! For each local name id, the positions of the elements with that name
+    std::vector<std::vector<uint32_t>> mElementsByName;
+};
+}
+}
+
+#endif  // CODA_OSS_xml_lite_ElementIndex_h_INCLUDED_
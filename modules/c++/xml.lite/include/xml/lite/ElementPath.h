@@ -0,0 +1,94 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_ElementPath_h_INCLUDED_
+#define CODA_OSS_xml_lite_ElementPath_h_INCLUDED_
+
+#include <string>
+#include <vector>
+
+#include <config/Exports.h>
+
+#include "xml/lite/Element.h"
+#include "xml/lite/ElementIndex.h"
+
+namespace xml
+{
+namespace lite
+{
+/*!
+ * \class ElementPath
+ * \brief A path of local names, parsed once and used many times
+ *
+ * The path is relative to the element it's applied to:
+ *  - "ImageData/NumRows" are the NumRows children of the ImageData
+ *    children
+ *  - "//NumRows" are all the NumRows elements at any depth, and
+ *    "ImageData//Value" all the Values under ImageData
+ *  - "*" matches any one name
+ *
+ * Results are in document order.  With an ElementIndex, each step
+ * is a lookup rather than a walk of the tree.
+ */
+class CODA_OSS_API ElementPath final
+{
+public:
+    /*!
+     *  \throw except::InvalidArgumentException if the path is malformed
+     */
+    explicit ElementPath(const std::string& path);
+
+    const std::string& toString() const
+    {
+        return mPath;
+    }
+
+    /*!
+     *  The elements matching the path, starting from context.
+     *  \param pIndex  An up-to-date index containing context, or nullptr
+     */
+    std::vector<Element*> select(const Element& context, const ElementIndex* pIndex = nullptr) const;
+
+    /*!
+     *  The one element matching the path.
+     *  \throw XMLException if there isn't exactly one
+     */
+    Element& selectOne(const Element& context, const ElementIndex* pIndex = nullptr) const;
+
+private:
+    struct Step final
+    {
+        std::string localName;  // "*" for any
+        bool recurse;  // "//" rather than "/"
+    };
+
+    std::vector<Element*> select(const Element& context, const ElementIndex& index) const;
+
+    std::string mPath;
+    std::vector<Step> mSteps;
+};
+}
+}
+
+#endif  // CODA_OSS_xml_lite_ElementPath_h_INCLUDED_
@@ -0,0 +1,135 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_ParserPool_h_INCLUDED_
+#define CODA_OSS_xml_lite_ParserPool_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "config/Exports.h"
+#include "io/InputStream.h"
+#include "xml/lite/CompactDocument.h"
+#include "xml/lite/Document.h"
+
+/*!
+ * \file ParserPool.h
+ * \brief Parses many documents in parallel.
+ *
+ * Constructing a MinidomParser sets up a Xerces reader and its
+ * transcoders; doing that for every file of a batch costs as much as
+ * parsing a small file.  A ParserPool keeps one parser per thread and
+ * resets it between documents.
+ */
+
+namespace xml
+{
+namespace lite
+{
+struct MinidomParser;
+struct CompactDomParser;
+
+/*!
+ * \struct ParseTiming
+ * \brief Where the time for one document of a batch went.
+ */
+struct ParseTiming final
+{
+    //! Creating (first use on a thread) or resetting the parser, in ms
+    double setupTimeMS = 0.0;
+
+    //! Parsing the document, in ms
+    double parseTimeMS = 0.0;
+};
+
+/*!
+ * \class ParserPool
+ * \brief Parses batches of InputStreams on a pool of threads.
+ *
+ * Results are returned in the order of the inputs.  If any document
+ * fails to parse, the whole batch throws once all threads finish.
+ * A ParserPool itself must only be used by one thread at a time.
+ */
+struct CODA_OSS_API ParserPool final
+{
+    /*!
+     *  \param numThreads  Maximum number of threads to parse on; 0 uses
+     *  the number of CPUs
+     */
+    explicit ParserPool(size_t numThreads = 0);
+    ~ParserPool();
+
+    ParserPool(const ParserPool&) = delete;
+    ParserPool& operator=(const ParserPool&) = delete;
+
+    /*!
+     *  Parses every stream into a Document.  Each stream is read by
+     *  exactly one thread.
+     *  \param inputs  The streams to parse; none may be null
+     *  \return One Document per input, in the same order
+     */
+    std::vector<std::unique_ptr<Document>> parse(const std::vector<io::InputStream*>& inputs);
+
+    //! Same as parse(), but into CompactDocuments
+    std::vector<CompactDocument> parseCompact(const std::vector<io::InputStream*>& inputs);
+
+    //! @see MinidomHandler::preserveCharacterData
+    void preserveCharacterData(bool preserve)
+    {
+        mPreserveCharData = preserve;
+    }
+
+    size_t getNumThreads() const
+    {
+        return mNumThreads;
+    }
+
+    //! Number of parsers created so far, of either kind
+    size_t getNumParsers() const;
+
+    /*!
+     *  Timings for each document of the most recent batch, in the
+     *  order of the inputs.
+     */
+    const std::vector<ParseTiming>& getTimings() const
+    {
+        return mTimings;
+    }
+
+private:
+    const size_t mNumThreads;
+    bool mPreserveCharData = false;
+
+    //! Indexed by thread; created the first time a thread needs one
+    std::vector<std::unique_ptr<MinidomParser>> mParsers;
+    std::vector<std::unique_ptr<CompactDomParser>> mCompactParsers;
+
+    std::vector<ParseTiming> mTimings;
+};
+}
+}
+
+#endif  // CODA_OSS_xml_lite_ParserPool_h_INCLUDED_
@@ -43,6 +43,7 @@ namespace xml
 namespace lite
 {
 using Validator = ValidatorXerces;
+using ValidatorPool = ValidatorPoolXerces;
 }
 }
 #endif // CODA_OSS_xml_lite_Validator_h_INCLUDED_
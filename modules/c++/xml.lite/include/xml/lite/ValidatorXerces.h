@@ -25,6 +25,7 @@
 #define CODA_OSS_xml_lite_ValidatorXerces_h_INCLUDED_
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <coda_oss/string.h>
 
@@ -106,6 +107,13 @@ struct CODA_OSS_API ValidatorXerces : public ValidatorInterface
                     logging::Logger* log = nullptr,
                     bool recursive = true);
 
+    /*!
+     *  Constructor sharing the schemas of another validator, see
+     *  getGrammarPool(); nothing is loaded.
+     *  \param grammarPool  A loaded and locked grammar pool
+     */
+    explicit ValidatorXerces(std::shared_ptr<xercesc::XMLGrammarPool> grammarPool);
+
     ValidatorXerces(const ValidatorXerces&) = delete;
     ValidatorXerces& operator=(const ValidatorXerces&) = delete;
     ValidatorXerces(ValidatorXerces&&) = default;
@@ -128,19 +136,76 @@ struct CODA_OSS_API ValidatorXerces : public ValidatorInterface
     // Search each directory for XSD files
     static std::vector<coda_oss::filesystem::path> loadSchemas(const std::vector<coda_oss::filesystem::path>& schemaPaths, bool recursive=true);
 
+    /*!
+     *  The loaded schemas.  The pool is locked, so it can be shared by
+     *  validators in other threads.
+     */
+    std::shared_ptr<xercesc::XMLGrammarPool> getGrammarPool() const
+    {
+        return mSchemaPool;
+    }
+
 private:
     XercesContext mCtxt;
 
+    void createValidator();
+
     bool validate_(const coda_oss::u8string& xml, 
                    const std::string& xmlID,
                    std::vector<ValidationInfo>& errors) const;
 
-    std::unique_ptr<xercesc::XMLGrammarPool> mSchemaPool;
+    std::shared_ptr<xercesc::XMLGrammarPool> mSchemaPool;
     std::unique_ptr<xml::lite::ValidationErrorHandler> mErrorHandler;
     std::unique_ptr<xercesc::DOMLSParser> mValidator;
 
 };
 
+/*!
+ * \class ValidatorPoolXerces
+ * \brief A validator that can be used from many threads at once.
+ *
+ * A ValidatorXerces can only validate one document at a time.  This
+ * loads the schemas once, into a locked grammar pool that is shared
+ * read-only, and keeps a ValidatorXerces (i.e., a parser) for each
+ * document being validated; they're created as needed and reused.
+ */
+struct CODA_OSS_API ValidatorPoolXerces final : public ValidatorInterface
+{
+    //! See ValidatorXerces
+    ValidatorPoolXerces(const std::vector<std::string>& schemaPaths,
+                        logging::Logger* log = nullptr,
+                        bool recursive = true);
+    ValidatorPoolXerces(const std::vector<coda_oss::filesystem::path>&,
+                        logging::Logger* log = nullptr,
+                        bool recursive = true);
+    ValidatorPoolXerces(const ValidatorPoolXerces&) = delete;
+    ValidatorPoolXerces& operator=(const ValidatorPoolXerces&) = delete;
+
+    using ValidatorInterface::validate;
+
+    //! Thread-safe; see ValidatorXerces::validate()
+    bool validate(const std::string& xml,
+                  const std::string& xmlID,
+                  std::vector<ValidationInfo>& errors) const override;
+    bool validate(const coda_oss::u8string&, const std::string& xmlID, std::vector<ValidationInfo>&) const override;
+    bool validate(const str::W1252string&, const std::string& xmlID, std::vector<ValidationInfo>&) const override;
+
+    //! The number of validators created so far: at most the number of threads
+    size_t getNumValidators() const;
+
+private:
+    template <typename TString>
+    bool validate_(const TString& xml, const std::string& xmlID, std::vector<ValidationInfo>& errors) const;
+
+    std::unique_ptr<ValidatorXerces> acquire() const;
+    void release(std::unique_ptr<ValidatorXerces>&&) const;
+
+    std::shared_ptr<xercesc::XMLGrammarPool> mGrammarPool;
+    mutable std::mutex mMutex;
+    mutable std::vector<std::unique_ptr<ValidatorXerces>> mAvailable;
+    mutable size_t mNumValidators = 0;
+};
+
 //! stream the entire log -- newline separated
 std::ostream& operator<< (std::ostream& out,
                           const ValidationErrorHandler& errorHandler);
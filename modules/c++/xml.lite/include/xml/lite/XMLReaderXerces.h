@@ -66,6 +66,10 @@ class CODA_OSS_API XMLReaderXerces final : public XMLReaderInterface
     std::unique_ptr<XercesContentHandler> mDriverContentHandler;
     std::unique_ptr<XercesErrorHandler>   mErrorHandler;
 
+    // For parseFirst()/parseNext()
+    std::unique_ptr<InputSource> mProgressiveSource;
+    XMLPScanToken mScanToken;
+
 public:
 
     //! Constructor.  Creates a new XML parser
@@ -105,6 +109,32 @@ public:
     void parse(bool storeEncoding, io::InputStream& is, int size = io::InputStream::IS_END);
     void parse(io::InputStream& is, const void*pInitialEncoding, const void* pFallbackEncoding,
         int size = io::InputStream::IS_END);
+
+    /*!
+     *  Starts a progressive parse: rather than reading all of the stream
+     *  up front, the stream is read as the parse moves along, and each
+     *  call to parseNext() delivers the next few events to the content
+     *  handler.  There's no retry with a fallback encoding as there
+     *  is for parse().
+     *
+     *  \param is  The stream to parse; must outlive the parse
+     *  \param pEncoding  Overrides the encoding of the document (see
+     *                    getWindows1252Encoding()), nullptr to detect it
+     *  \return false if the document couldn't be started
+     */
+    bool parseFirst(io::InputStream& is, const void* pEncoding = nullptr);
+
+    /*!
+     *  Continues a progressive parse.
+     *  \return false once the end of the document has been reached
+     */
+    bool parseNext();
+
+    /*!
+     *  Abandons a progressive parse so that parse() or parseFirst()
+     *  can be called again.
+     */
+    void parseReset();
     
     //! Method to create an xml reader
     void create() override;
@@ -0,0 +1,206 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_XMLStreamReader_h_INCLUDED_
+#define CODA_OSS_xml_lite_XMLStreamReader_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <config/Exports.h>
+#include <coda_oss/string.h>
+#include <io/InputStream.h>
+
+#include "xml/lite/Attributes.h"
+#include "xml/lite/Element.h"
+#include "xml/lite/XMLReader.h"
+
+/*!
+ * \file XMLStreamReader.h
+ * \brief A pull parser: walk a document one event at a time
+ *
+ * MinidomParser always builds the whole Document.  XMLStreamReader
+ * reads the stream as it goes and hands back one event at a time,
+ * so only the elements that are asked for (with readElement()) are
+ * ever built; everything else costs O(depth) memory.
+ *
+ *   xml::lite::XMLStreamReader reader(stream);
+ *   reader.addPathFilter("/SICD/ImageData");
+ *   auto imageData = reader.readNextElement(); // nullptr if not found
+ */
+
+namespace xml
+{
+namespace lite
+{
+/*!
+ * \class XMLStreamReader
+ * \brief Cursor-style access to the SAX events of a document
+ *
+ * Call next() to move to the next event; the accessors then describe
+ * it.  Adjacent character data is reported as one Characters event,
+ * untrimmed.
+ *
+ * With path filters, only the elements matching a filter (and
+ * everything under them) are reported; the rest of the document is
+ * parsed but nothing is kept.  A filter is an absolute path of local
+ * names, e.g. "/SICD/ImageData", where "*" matches any one name.
+ */
+class CODA_OSS_API XMLStreamReader final
+{
+public:
+    enum class Event
+    {
+        None,  // next() hasn't been called
+        StartElement,
+        Characters,
+        EndElement,
+        EndDocument
+    };
+
+    /*!
+     *  \param is  The document; must outlive the reader
+     */
+    explicit XMLStreamReader(io::InputStream& is);
+    ~XMLStreamReader();
+
+    XMLStreamReader(const XMLStreamReader&) = delete;
+    XMLStreamReader& operator=(const XMLStreamReader&) = delete;
+    XMLStreamReader(XMLStreamReader&&) = delete;
+    XMLStreamReader& operator=(XMLStreamReader&&) = delete;
+
+    /*!
+     *  Only report the subtrees at the specified path; may be called
+     *  more than once.  Must be called before the first next().
+     *  \throw except::InvalidArgumentException if the path isn't absolute
+     */
+    void addPathFilter(const std::string& path);
+
+    /*!
+     *  Whether readElement() keeps whitespace around character data;
+     *  the default, as with MinidomParser, is to trim it.
+     */
+    void preserveCharacterData(bool preserve)
+    {
+        mPreserveCharData = preserve;
+    }
+
+    /*!
+     *  Moves to the next event.
+     *  \return false once EndDocument has been reached
+     */
+    bool next();
+
+    Event getEvent() const
+    {
+        return mEvent;
+    }
+
+    /*!
+     *  The depth of the current element (the root is 1).  For
+     *  Characters, the depth of the element containing them.
+     */
+    size_t getDepth() const
+    {
+        return mDepth;
+    }
+
+    //! Names of the current StartElement or EndElement
+    const std::string& getUri() const
+    {
+        return mUri;
+    }
+    const std::string& getLocalName() const
+    {
+        return mLocalName;
+    }
+    const std::string& getQName() const
+    {
+        return mQName;
+    }
+
+    //! Attributes of the current StartElement
+    const Attributes& getAttributes() const
+    {
+        return mAttributes;
+    }
+
+    //! Text of the current Characters event, UTF-8
+    const coda_oss::u8string& getCharacterData() const
+    {
+        return mCharacterData;
+    }
+
+    /*!
+     *  From a StartElement, skips past the element and its children;
+     *  the current event is then the element's EndElement.  Nothing
+     *  under the element is kept.
+     *  \throw except::Exception if the current event isn't StartElement
+     */
+    void skipElement();
+
+    /*!
+     *  From a StartElement, builds the element and its children just
+     *  as MinidomParser would; the current event is then the element's
+     *  EndElement.
+     *  \throw except::Exception if the current event isn't StartElement
+     */
+    std::unique_ptr<Element> readElement();
+
+    /*!
+     *  Moves to the next StartElement and reads it.  With path
+     *  filters, this returns each matching subtree in turn.
+     *  \return nullptr at the end of the document
+     */
+    std::unique_ptr<Element> readNextElement();
+
+private:
+    class Handler;
+    struct QueuedEvent;
+
+    void requireStartElement(const char* caller) const;
+
+    io::InputStream& mStream;
+    XMLReader mReader;
+    std::unique_ptr<Handler> mHandler;
+    bool mStarted = false;
+    bool mDone = false;
+    bool mPreserveCharData = false;
+
+    // The current event
+    Event mEvent = Event::None;
+    size_t mDepth = 0;
+    std::string mUri;
+    std::string mLocalName;
+    std::string mQName;
+    Attributes mAttributes;
+    coda_oss::u8string mCharacterData;
+};
+}
+}
+
+#endif  // CODA_OSS_xml_lite_XMLStreamReader_h_INCLUDED_
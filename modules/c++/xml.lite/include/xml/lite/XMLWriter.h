@@ -0,0 +1,155 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+#ifndef CODA_OSS_xml_lite_XMLWriter_h_INCLUDED_
+#define CODA_OSS_xml_lite_XMLWriter_h_INCLUDED_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <config/Exports.h>
+#include <coda_oss/string.h>
+#include <io/OutputStream.h>
+
+#include "xml/lite/Element.h"
+#include "xml/lite/CompactDocument.h"
+
+/*!
+ * \file XMLWriter.h
+ * \brief Serializes elements through a reusable buffer
+ *
+ * Element::print() builds each tag with string concatenation and
+ * hands every piece to the stream.  XMLWriter instead appends the
+ * output to one buffer, which is written to the stream in large
+ * blocks.  For a CompactElement, names and text are copied straight
+ * from the document, so nothing is allocated per node once the buffer
+ * has grown to size.  Element only hands out copies of its names and
+ * attribute values; names too long for the small-string buffer still
+ * cost an allocation each.
+ */
+
+namespace xml
+{
+namespace lite
+{
+/*!
+ * \class XMLWriter
+ * \brief A buffered writer for Element and CompactElement trees
+ *
+ * The layout is the same as Element::print() (empty formatter) or
+ * Element::prettyPrint() without the trailing newline.  Unlike
+ * print(), character data and attribute values are escaped; call
+ * setEscape(false) for data that is already escaped.
+ *
+ * Output is only guaranteed to reach the stream after flush(); the
+ * destructor flushes too, but can't report errors.
+ */
+class CODA_OSS_API XMLWriter final
+{
+public:
+    static const size_t DEFAULT_BUFFER_SIZE;
+
+    /*!
+     *  \param stream  Where the output goes; must outlive the writer
+     *  \param formatter  Indentation for each level, e.g. "   ".
+     *                    If empty, everything is on one line.
+     *  \param bufferSize  How much is collected before writing
+     */
+    XMLWriter(io::OutputStream& stream, const std::string& formatter = "",
+              size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~XMLWriter() noexcept;
+
+    XMLWriter(const XMLWriter&) = delete;
+    XMLWriter& operator=(const XMLWriter&) = delete;
+    XMLWriter(XMLWriter&&) = delete;
+    XMLWriter& operator=(XMLWriter&&) = delete;
+
+    //! Whether character data and attribute values are escaped (default true)
+    void setEscape(bool escape)
+    {
+        mEscape = escape;
+    }
+    bool getEscape() const
+    {
+        return mEscape;
+    }
+
+    /*!
+     *  Writes an element and all of its children.
+     */
+    void write(const Element&);
+    void write(const CompactElement&);
+
+    /*!
+     *  Writes text as-is, e.g., an XML declaration or a newline.
+     */
+    void write(const std::string&);
+
+    /*!
+     *  Writes whatever is buffered to the stream and flushes it.
+     */
+    void flush();
+
+private:
+    void write(const Element&, size_t depth);
+    void write(const CompactElement&, size_t depth);
+
+    void append(const char* data, size_t size);
+    void append(const std::string& s)
+    {
+        append(s.data(), s.size());
+    }
+    void append(char c)
+    {
+        if (mSize == mBuffer.size())
+        {
+            flushBuffer();
+        }
+        mBuffer[mSize++] = c;
+    }
+    void appendEscaped(const char* data, size_t size, bool isAttribute);
+    void appendIndent(size_t depth);
+    void appendName(const std::string& prefix, const std::string& localName);
+    void appendAttribute(const std::string& qname, const std::string& value);
+    void flushBuffer();
+
+    io::OutputStream& mStream;
+    const std::string mFormatter;
+    bool mEscape = true;
+
+    std::vector<char> mBuffer;
+    size_t mSize = 0;
+
+    //! mFormatter repeated; grows as deeper levels are written
+    std::string mIndent;
+
+    //! Scratch space for Element character data
+    coda_oss::u8string mCharacterData;
+};
+}
+}
+
+#endif  // CODA_OSS_xml_lite_XMLWriter_h_INCLUDED_
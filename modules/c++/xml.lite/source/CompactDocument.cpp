@@ -0,0 +1,526 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/CompactDocument.h"
+
+#include <limits>
+#include <std/string>
+
+#include <except/Exception.h>
+#include <str/Encoding.h>
+
+#include "xml/lite/XMLException.h"
+
+const uint32_t xml::lite::CompactDocument::npos = std::numeric_limits<uint32_t>::max();
+
+void xml::lite::CompactDocument::clear()
+{
+    mNodes.clear();
+    mAttributes.clear();
+    mText.clear();
+    mNames.clear();
+    mNameIds.clear();
+}
+
+uint32_t xml::lite::CompactDocument::intern(const std::string& name)
+{
+    if (mNames.empty())
+    {
+        mNames.emplace_back();
+        mNameIds.emplace(std::string(), 0);
+    }
+
+    const auto it = mNameIds.find(name);
+    if (it != mNameIds.end())
+    {
+        return it->second;
+    }
+    const auto id = static_cast<uint32_t>(mNames.size());
+    mNames.push_back(name);
+    mNameIds.emplace(name, id);
+    return id;
+}
+
+uint32_t xml::lite::CompactDocument::findName(const std::string& name) const
+{
+    const auto it = mNameIds.find(name);
+    return it == mNameIds.end() ? npos : it->second;
+}
+
+void xml::lite::CompactDocument::splitQName(const std::string& qname,
+        uint32_t& prefix, uint32_t& localName)
+{
+    const auto colon = qname.find(':');
+    if (colon == std::string::npos)
+    {
+        prefix = intern(std::string());
+        localName = intern(qname);
+    }
+    else
+    {
+        prefix = intern(qname.substr(0, colon));
+        localName = intern(qname.substr(colon + 1));
+    }
+}
+
+size_t xml::lite::CompactDocument::appendText(const char* data, size_t size)
+{
+    const size_t offset = mText.size();
+    mText.insert(mText.end(), data, data + size);
+    return offset;
+}
+
+uint32_t xml::lite::CompactDocument::addElement(uint32_t parent,
+        const std::string& uri, const std::string& qname)
+{
+    if (mNodes.size() >= static_cast<size_t>(npos))
+    {
+        throw xml::lite::XMLException(Ctxt("Too many elements for a CompactDocument"));
+    }
+    if (parent == npos ? !mNodes.empty() : parent >= mNodes.size())
+    {
+        throw xml::lite::XMLException(Ctxt("Invalid parent element"));
+    }
+
+    Node node;
+    node.parent = parent;
+    node.firstChild = npos;
+    node.lastChild = npos;
+    node.nextSibling = npos;
+    node.numChildren = 0;
+    node.uri = intern(uri);
+    splitQName(qname, node.prefix, node.localName);
+    node.firstAttribute = static_cast<uint32_t>(mAttributes.size());
+    node.numAttributes = 0;
+    node.textOffset = 0;
+    node.textSize = 0;
+
+    const auto index = static_cast<uint32_t>(mNodes.size());
+    mNodes.push_back(node);
+
+    if (parent != npos)
+    {
+        Node& parentNode = mNodes[parent];
+        if (parentNode.lastChild == npos)
+        {
+            parentNode.firstChild = index;
+        }
+        else
+        {
+            mNodes[parentNode.lastChild].nextSibling = index;
+        }
+        parentNode.lastChild = index;
+        ++parentNode.numChildren;
+    }
+    return index;
+}
+
+void xml::lite::CompactDocument::addAttribute(const std::string& uri,
+        const std::string& qname, const std::string& value)
+{
+    if (mNodes.empty())
+    {
+        throw xml::lite::XMLException(Ctxt("Attributes must follow an element"));
+    }
+
+    Attribute attribute;
+    attribute.uri = intern(uri);
+    splitQName(qname, attribute.prefix, attribute.localName);
+    attribute.valueOffset = appendText(value.data(), value.size());
+    attribute.valueSize = value.size();
+    mAttributes.push_back(attribute);
+    ++mNodes.back().numAttributes;
+}
+
+void xml::lite::CompactDocument::setCharacterData(uint32_t element,
+        const char* data, size_t size)
+{
+    Node& node = mNodes.at(element);
+    node.textOffset = appendText(data, size);
+    node.textSize = size;
+}
+
+size_t xml::lite::CompactDocument::getNumBytes() const
+{
+    size_t numBytes = mNodes.capacity() * sizeof(Node) +
+            mAttributes.capacity() * sizeof(Attribute) + mText.capacity() +
+            mNames.capacity() * sizeof(std::string);
+    for (const auto& name : mNames)
+    {
+        numBytes += name.capacity();
+    }
+    return numBytes;
+}
+
+std::string xml::lite::CompactElement::getLocalName() const
+{
+    return mDocument->getName(mDocument->mNodes[mIndex].localName);
+}
+
+std::string xml::lite::CompactElement::getPrefix() const
+{
+    return mDocument->getName(mDocument->mNodes[mIndex].prefix);
+}
+
+std::string xml::lite::CompactElement::getUri() const
+{
+    return mDocument->getName(mDocument->mNodes[mIndex].uri);
+}
+
+std::string xml::lite::CompactElement::getQName() const
+{
+    const auto& node = mDocument->mNodes[mIndex];
+    const auto& prefix = mDocument->getName(node.prefix);
+    const auto& localName = mDocument->getName(node.localName);
+    return prefix.empty() ? localName : prefix + ":" + localName;
+}
+
+void xml::lite::CompactElement::getQName(xml::lite::QName& result) const
+{
+    result = QName(Uri(getUri()), getQName());
+}
+
+coda_oss::span<const char> xml::lite::CompactElement::characterData() const
+{
+    const auto& node = mDocument->mNodes[mIndex];
+    return mDocument->getText(node.textOffset, node.textSize);
+}
+
+const coda_oss::u8string& xml::lite::CompactElement::getCharacterData(coda_oss::u8string& result) const
+{
+    const auto data = characterData();
+    const auto begin = reinterpret_cast<const coda_oss::u8string::value_type*>(data.data());
+    result.assign(begin, begin + data.size());
+    return result;
+}
+
+std::string xml::lite::CompactElement::getCharacterData() const
+{
+    coda_oss::u8string result;
+    return str::to_native(getCharacterData(result));
+}
+
+size_t xml::lite::CompactElement::getNumAttributes() const
+{
+    return mDocument->mNodes[mIndex].numAttributes;
+}
+
+const std::string& xml::lite::CompactElement::prefix() const
+{
+    return mDocument->getName(mDocument->mNodes[mIndex].prefix);
+}
+
+const std::string& xml::lite::CompactElement::localName() const
+{
+    return mDocument->getName(mDocument->mNodes[mIndex].localName);
+}
+
+const std::string& xml::lite::CompactElement::attributePrefix(size_t i) const
+{
+    const auto& node = mDocument->mNodes[mIndex];
+    return mDocument->getName(mDocument->mAttributes[node.firstAttribute + i].prefix);
+}
+
+const std::string& xml::lite::CompactElement::attributeLocalName(size_t i) const
+{
+    const auto& node = mDocument->mNodes[mIndex];
+    return mDocument->getName(mDocument->mAttributes[node.firstAttribute + i].localName);
+}
+
+coda_oss::span<const char> xml::lite::CompactElement::attributeValue(size_t i) const
+{
+    const auto& node = mDocument->mNodes[mIndex];
+    const auto& attribute = mDocument->mAttributes[node.firstAttribute + i];
+    return mDocument->getText(attribute.valueOffset, attribute.valueSize);
+}
+
+bool xml::lite::CompactElement::getAttributeValue(const std::string& qname,
+        std::string& result) const
+{
+    // Unlike Element, don't build a QName for every attribute.
+    const auto colon = qname.find(':');
+    const auto prefix = mDocument->findName(colon == std::string::npos
+            ? std::string() : qname.substr(0, colon));
+    const auto localName = mDocument->findName(colon == std::string::npos
+            ? qname : qname.substr(colon + 1));
+    if (prefix == CompactDocument::npos || localName == CompactDocument::npos)
+    {
+        return false;
+    }
+
+    const auto& node = mDocument->mNodes[mIndex];
+    for (uint32_t ii = 0; ii < node.numAttributes; ++ii)
+    {
+        const auto& attribute = mDocument->mAttributes[node.firstAttribute + ii];
+        if (attribute.localName == localName && attribute.prefix == prefix)
+        {
+            const auto value = mDocument->getText(attribute.valueOffset, attribute.valueSize);
+            result.assign(value.data(), value.size());
+            return true;
+        }
+    }
+    return false;
+}
+
+bool xml::lite::CompactElement::getAttributeValue(const xml::lite::QName& name,
+        std::string& result) const
+{
+    const auto uri = mDocument->findName(name.getUri().value);
+    const auto localName = mDocument->findName(name.getName());
+    if (uri == CompactDocument::npos || localName == CompactDocument::npos)
+    {
+        return false;
+    }
+
+    const auto& node = mDocument->mNodes[mIndex];
+    for (uint32_t ii = 0; ii < node.numAttributes; ++ii)
+    {
+        const auto& attribute = mDocument->mAttributes[node.firstAttribute + ii];
+        if (attribute.localName == localName && attribute.uri == uri)
+        {
+            const auto value = mDocument->getText(attribute.valueOffset, attribute.valueSize);
+            result.assign(value.data(), value.size());
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string xml::lite::CompactElement::attribute(const std::string& qname) const
+{
+    std::string result;
+    if (!getAttributeValue(qname, result))
+    {
+        throw except::NoSuchKeyException(Ctxt(qname));
+    }
+    return result;
+}
+
+xml::lite::Attributes xml::lite::CompactElement::getAttributes() const
+{
+    Attributes result;
+    const auto& node = mDocument->mNodes[mIndex];
+    for (uint32_t ii = 0; ii < node.numAttributes; ++ii)
+    {
+        const auto& attribute = mDocument->mAttributes[node.firstAttribute + ii];
+        const auto& prefix = mDocument->getName(attribute.prefix);
+        const auto& localName = mDocument->getName(attribute.localName);
+        const auto value = mDocument->getText(attribute.valueOffset, attribute.valueSize);
+
+        AttributeNode attributeNode(QName(Uri(mDocument->getName(attribute.uri)),
+                prefix.empty() ? localName : prefix + ":" + localName));
+        attributeNode.setValue(std::string(value.data(), value.size()));
+        result.add(attributeNode);
+    }
+    return result;
+}
+
+xml::lite::CompactElement xml::lite::CompactElement::getParent() const
+{
+    const auto parent = mDocument->mNodes[mIndex].parent;
+    return parent == CompactDocument::npos ? CompactElement() : CompactElement(*mDocument, parent);
+}
+
+xml::lite::CompactElement xml::lite::CompactElement::getFirstChild() const
+{
+    const auto child = mDocument->mNodes[mIndex].firstChild;
+    return child == CompactDocument::npos ? CompactElement() : CompactElement(*mDocument, child);
+}
+
+xml::lite::CompactElement xml::lite::CompactElement::getNextSibling() const
+{
+    const auto sibling = mDocument->mNodes[mIndex].nextSibling;
+    return sibling == CompactDocument::npos ? CompactElement() : CompactElement(*mDocument, sibling);
+}
+
+size_t xml::lite::CompactElement::getNumChildren() const
+{
+    return mDocument->mNodes[mIndex].numChildren;
+}
+
+std::vector<xml::lite::CompactElement> xml::lite::CompactElement::getChildren() const
+{
+    std::vector<CompactElement> children;
+    children.reserve(getNumChildren());
+    for (auto child = getFirstChild(); child; child = child.getNextSibling())
+    {
+        children.push_back(child);
+    }
+    return children;
+}
+
+template <typename TMatch>
+void xml::lite::CompactElement::getElements(TMatch match,
+        std::vector<CompactElement>& elements, bool recurse) const
+{
+    // Same order as Element: each match is followed by its descendants.
+    const auto& nodes = mDocument->mNodes;
+    for (auto child = nodes[mIndex].firstChild; child != CompactDocument::npos;
+         child = nodes[child].nextSibling)
+    {
+        if (match(nodes[child]))
+        {
+            elements.emplace_back(*mDocument, child);
+        }
+        if (recurse)
+        {
+            CompactElement(*mDocument, child).getElements(match, elements, recurse);
+        }
+    }
+}
+
+void xml::lite::CompactElement::getElementsByTagName(const std::string& localName,
+        std::vector<CompactElement>& elements, bool recurse) const
+{
+    // A name that was never interned can't match anything.
+    const auto id = mDocument->findName(localName);
+    if (id == CompactDocument::npos)
+    {
+        return;
+    }
+    getElements([&](const CompactDocument::Node& node) { return node.localName == id; },
+                elements, recurse);
+}
+
+void xml::lite::CompactElement::getElementsByTagName(const xml::lite::QName& name,
+        std::vector<CompactElement>& elements, bool recurse) const
+{
+    const auto uri = mDocument->findName(name.getUri().value);
+    const auto localName = mDocument->findName(name.getName());
+    if (uri == CompactDocument::npos || localName == CompactDocument::npos)
+    {
+        return;
+    }
+    getElements([&](const CompactDocument::Node& node) {
+                    return (node.localName == localName) && (node.uri == uri); },
+                elements, recurse);
+}
+
+void xml::lite::CompactElement::getElementsByTagNameNS(const std::string& qname,
+        std::vector<CompactElement>& elements, bool recurse) const
+{
+    const auto colon = qname.find(':');
+    const auto prefix = mDocument->findName(colon == std::string::npos
+            ? std::string() : qname.substr(0, colon));
+    const auto localName = mDocument->findName(colon == std::string::npos
+            ? qname : qname.substr(colon + 1));
+    if (prefix == CompactDocument::npos || localName == CompactDocument::npos)
+    {
+        return;
+    }
+    getElements([&](const CompactDocument::Node& node) {
+                    return (node.localName == localName) && (node.prefix == prefix); },
+                elements, recurse);
+}
+
+namespace
+{
+// As Element, the std::nothrow lookups return "null" unless there's exactly one match.
+template <typename TGetElements>
+xml::lite::CompactElement getElement(std::nothrow_t, TGetElements getElements)
+{
+    const auto elements = getElements();
+    return elements.size() == 1 ? elements[0] : xml::lite::CompactElement();
+}
+template <typename TGetElements, typename TMakeContext>
+xml::lite::CompactElement getElement(TGetElements getElements, TMakeContext makeContext)
+{
+    const auto elements = getElements();
+    if (elements.size() != 1)
+    {
+        throw xml::lite::XMLException(makeContext(std::to_string(elements.size())));
+    }
+    return elements[0];
+}
+}
+
+xml::lite::CompactElement xml::lite::CompactElement::getElementByTagName(std::nothrow_t,
+        const std::string& localName, bool recurse) const
+{
+    return getElement(std::nothrow, [&]() { return getElementsByTagName(localName, recurse); });
+}
+xml::lite::CompactElement xml::lite::CompactElement::getElementByTagName(
+        const std::string& localName, bool recurse) const
+{
+    return getElement([&]() { return getElementsByTagName(localName, recurse); },
+                      [&](const std::string& sz) {
+                          return Ctxt("Expected exactly one '" + localName + "'; but got " + sz); });
+}
+
+xml::lite::CompactElement xml::lite::CompactElement::getElementByTagName(std::nothrow_t,
+        const xml::lite::QName& name, bool recurse) const
+{
+    return getElement(std::nothrow, [&]() { return getElementsByTagName(name, recurse); });
+}
+xml::lite::CompactElement xml::lite::CompactElement::getElementByTagName(
+        const xml::lite::QName& name, bool recurse) const
+{
+    return getElement([&]() { return getElementsByTagName(name, recurse); },
+                      [&](const std::string& sz) {
+                          return Ctxt("Expected exactly one '" + name.getName() +
+                                      "' (uri=" + name.getUri().value + "); but got " + sz); });
+}
+
+xml::lite::CompactElement xml::lite::CompactElement::getElementByTagNameNS(std::nothrow_t,
+        const std::string& qname, bool recurse) const
+{
+    return getElement(std::nothrow, [&]() { return getElementsByTagNameNS(qname, recurse); });
+}
+xml::lite::CompactElement xml::lite::CompactElement::getElementByTagNameNS(
+        const std::string& qname, bool recurse) const
+{
+    return getElement([&]() { return getElementsByTagNameNS(qname, recurse); },
+                      [&](const std::string& sz) {
+                          return Ctxt("Expected exactly one '" + qname + "'; but got " + sz); });
+}
+
+bool xml::lite::CompactElement::hasElement(const std::string& localName) const
+{
+    const auto id = mDocument->findName(localName);
+    for (auto child = getFirstChild(); child; child = child.getNextSibling())
+    {
+        if (mDocument->mNodes[child.mIndex].localName == id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool xml::lite::CompactElement::hasElement(const xml::lite::QName& name) const
+{
+    return !getElementsByTagName(name).empty();
+}
+
+std::unique_ptr<xml::lite::Element> xml::lite::CompactElement::toElement() const
+{
+    coda_oss::u8string characterData;
+    auto result = Element::create(QName(Uri(getUri()), getQName()),
+                                  getCharacterData(characterData));
+    result->setAttributes(getAttributes());
+    for (auto child = getFirstChild(); child; child = child.getNextSibling())
+    {
+        result->addChild(child.toElement());
+    }
+    return result;
+}
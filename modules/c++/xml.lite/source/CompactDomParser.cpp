@@ -0,0 +1,130 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/CompactDomParser.h"
+
+#include <assert.h>
+#include <wctype.h>
+
+#include <stdexcept>
+#include <std/string>
+#include <utility>
+
+#include <str/Encoding.h>
+
+void xml::lite::CompactDomHandler::clear()
+{
+    mDocument.clear();
+    mCharacters.clear();
+    mOpenElements.clear();
+}
+
+void xml::lite::CompactDomHandler::characters(const char* value, int length)
+{
+    // See MinidomHandler: when we get here the text is in the native encoding.
+    const auto s = str::u8FromNative(std::string(value, length));
+    mCharacters.append(reinterpret_cast<const char*>(s.data()), s.size());
+}
+
+bool xml::lite::CompactDomHandler::vcharacters(const void /*XMLCh*/* chars_, size_t length)
+{
+    if (chars_ == nullptr)
+    {
+        throw std::invalid_argument("chars_ is NULL.");
+    }
+    if (length == 0)
+    {
+        throw std::invalid_argument("length is 0.");
+    }
+
+    static_assert(sizeof(XMLCh) == sizeof(char16_t), "XMLCh should be 16-bits.");
+    const auto s = str::to_u8string(static_cast<const char16_t*>(chars_), length);
+    mCharacters.append(reinterpret_cast<const char*>(s.data()), s.size());
+    return true; // vcharacters() processed
+}
+
+void xml::lite::CompactDomHandler::startElement(const std::string& uri,
+                                                const std::string& /*localName*/,
+                                                const std::string& qname,
+                                                const xml::lite::Attributes& atts)
+{
+    if (mOpenElements.empty())
+    {
+        // A new document
+        mDocument.clear();
+        mCharacters.clear();
+    }
+
+    const auto parent = mOpenElements.empty() ? CompactDocument::npos : mOpenElements.back().index;
+    const auto index = mDocument.addElement(parent, uri, qname);
+    for (int ii = 0; ii < atts.getLength(); ++ii)
+    {
+        const auto& attribute = atts.getNode(ii);
+        mDocument.addAttribute(attribute.getUri(), attribute.getQName(), attribute.getValue());
+    }
+
+    mOpenElements.push_back(OpenElement{ index, mCharacters.size() });
+}
+
+void xml::lite::CompactDomHandler::endElement(const std::string& /*uri*/,
+                                              const std::string& /*localName*/,
+                                              const std::string& /*qname*/)
+{
+    assert(!mOpenElements.empty());
+    const OpenElement current = mOpenElements.back();
+    mOpenElements.pop_back();
+
+    // Everything after textStart belongs to this element; the text of
+    // its children was removed as each of them ended.
+    size_t begin = current.textStart;
+    size_t end = mCharacters.size();
+    if (!mPreserveCharData)
+    {
+        const auto isSpace = [&](size_t i) {
+            return iswspace(static_cast<wint_t>(static_cast<unsigned char>(mCharacters[i]))) != 0; };
+        while (begin < end && isSpace(begin))
+            ++begin;
+        while (end > begin && isSpace(end - 1))
+            --end;
+    }
+    mDocument.setCharacterData(current.index, mCharacters.data() + begin, end - begin);
+    mCharacters.resize(current.textStart);
+}
+
+xml::lite::CompactDomParser::CompactDomParser()
+{
+    mReader.setContentHandler(&mHandler);
+}
+
+void xml::lite::CompactDomParser::parse(io::InputStream& is, int size)
+{
+    mHandler.clear();
+    mReader.parse(is, size);
+}
+
+xml::lite::CompactDocument xml::lite::CompactDomParser::releaseDocument()
+{
+    CompactDocument result(std::move(mHandler.getDocument()));
+    mHandler.clear();
+    return result;
+}
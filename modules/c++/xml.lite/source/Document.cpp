@@ -36,11 +36,27 @@ void xml::lite::Document::destroy()
     remove(mRootNode);
 }
 
+const xml::lite::ElementIndex& xml::lite::Document::getIndex() const
+{
+    if (mRootNode == nullptr)
+    {
+        throw xml::lite::XMLException(Ctxt("The document has no root element"));
+    }
+
+    std::lock_guard<std::mutex> lock(mIndexMutex);
+    if ((mIndex.get() == nullptr) || mIndex->isStale() || (&mIndex->getRoot() != mRootNode))
+    {
+        mIndex.reset(new ElementIndex(*mRootNode));
+    }
+    return *mIndex;
+}
+
 void xml::lite::Document::remove(Element * toDelete)
 {
     //  Added code here to make sure we can remove from root
     if (toDelete == mRootNode)
     {
+        mIndex.reset();
         if (mRootNode && mOwnRoot)
             delete mRootNode;
         mRootNode = nullptr;
@@ -97,6 +113,7 @@ void xml::lite::Document::remove(xml::lite::Element * toDelete,
 {
     if (fromHere != nullptr && toDelete != nullptr)
     {
+        mIndex.reset();  // getChildren() is changed directly
         for (std::vector<xml::lite::Element *>::iterator i =
                 fromHere->getChildren().begin(); i
                 != fromHere->getChildren().end(); ++i)
@@ -46,6 +46,22 @@ std::unique_ptr<xml::lite::Element> xml::lite::Element::create(const QName& qnam
     return std::make_unique<Element>(qname,  characterData);
 }
 
+const xml::lite::Element& xml::lite::Element::getTop() const
+{
+    const Element* retval = this;
+    while (retval->mParent != nullptr)
+    {
+        retval = retval->mParent;
+    }
+    return *retval;
+}
+void xml::lite::Element::modified()
+{
+    // While parsing, children are added to a parent that isn't yet in
+    // the tree, so this is usually a single step.
+    ++const_cast<Element&>(getTop()).mModificationCount;
+}
+
 xml::lite::Element::Element(const xml::lite::Element& node)
 {
     *this = node;
@@ -59,6 +75,7 @@ xml::lite::Element& xml::lite::Element::operator=(const xml::lite::Element& node
         mAttributes = node.mAttributes;
         mChildren = node.mChildren;
         mParent = node.mParent;
+        modified();
     }
     return *this;
 }
@@ -231,6 +248,7 @@ void xml::lite::Element::destroyChildren()
         // Delete it
         delete childAtBack;
     }
+    modified();
 }
 
 void xml::lite::Element::print(io::OutputStream& stream) const
@@ -351,7 +369,7 @@ void xml::lite::Element::depthPrint(io::OutputStream& stream, int depth, const s
 void xml::lite::Element::addChild(xml::lite::Element * node)
 {
     mChildren.push_back(node);
-    node->setParent(this);
+    node->setParent(this);  // modified()
 }
 
 xml::lite::Element& xml::lite::Element::addChild(std::unique_ptr<xml::lite::Element>&& node)
@@ -435,6 +453,7 @@ void xml::lite::Element::setNamespacePrefix(
     str::trim(prefix);
     auto uri = uri_.value;
     changePrefix(this, prefix, uri);
+    modified();
 
     // Add namespace definition
     ::xml::lite::Attributes& attr = getAttributes();
@@ -451,6 +470,7 @@ void xml::lite::Element::setNamespaceURI(
     str::trim(prefix);
     auto uri = uri_.value;
     changeURI(this, prefix, uri);
+    modified();
 
     // Add namespace definition
     ::xml::lite::Attributes& attr = getAttributes();
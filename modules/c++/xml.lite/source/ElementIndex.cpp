@@ -0,0 +1,230 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/ElementIndex.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "xml/lite/XMLException.h"
+
+const uint32_t xml::lite::ElementIndex::npos = std::numeric_limits<uint32_t>::max();
+
+xml::lite::ElementIndex::ElementIndex(const Element& root) :
+    mTop(&root.getTop()),
+    mModificationCount(mTop->getModificationCount())
+{
+    intern("");  // id 0, for no prefix and no uri
+
+    // Number the elements in document order; "end" is filled in once
+    // all of an element's children have been numbered.
+    struct Frame final
+    {
+        uint32_t position;
+        size_t nextChild;
+    };
+    std::vector<Frame> frames;
+
+    xml::lite::QName name;
+    auto add = [&](const Element& element, uint32_t parent)
+    {
+        if (mEntries.size() >= npos)
+        {
+            throw xml::lite::XMLException(Ctxt("Too many elements to index"));
+        }
+        const auto position = static_cast<uint32_t>(mEntries.size());
+
+        element.getQName(name);
+        Entry entry;
+        entry.element = const_cast<Element*>(&element);  // as Element::getElementsByTagName()
+        entry.parent = parent;
+        entry.end = position + 1;
+        entry.localName = intern(name.getName());
+        entry.prefix = intern(name.getPrefix());
+        entry.uri = intern(name.getUri().value);
+        mEntries.push_back(entry);
+
+        mPositions[&element] = position;
+        mElementsByName[entry.localName].push_back(position);
+        frames.push_back({ position, 0 });
+    };
+
+    add(root, npos);
+    while (!frames.empty())
+    {
+        const auto position = frames.back().position;
+        const auto& children = mEntries[position].element->getChildren();
+        const auto nextChild = frames.back().nextChild++;
+        if (nextChild < children.size())
+        {
+            add(*children[nextChild], position);
+        }
+        else
+        {
+            mEntries[position].end = static_cast<uint32_t>(mEntries.size());
+            frames.pop_back();
+        }
+    }
+}
+
+uint32_t xml::lite::ElementIndex::intern(const std::string& name)
+{
+    const auto result = mNameIds.emplace(name, static_cast<uint32_t>(mNameIds.size()));
+    if (result.second)
+    {
+        mElementsByName.emplace_back();
+    }
+    return result.first->second;
+}
+
+uint32_t xml::lite::ElementIndex::findName(const std::string& name) const
+{
+    const auto it = mNameIds.find(name);
+    return it == mNameIds.end() ? npos : it->second;
+}
+
+bool xml::lite::ElementIndex::contains(const Element& element) const
+{
+    return mPositions.find(&element) != mPositions.end();
+}
+
+uint32_t xml::lite::ElementIndex::getPosition(const Element& element) const
+{
+    const auto it = mPositions.find(&element);
+    if (it == mPositions.end())
+    {
+        throw xml::lite::XMLException(Ctxt("Element '" + element.getQName() + "' isn't in the index"));
+    }
+    return it->second;
+}
+
+template <typename TFunc>
+static void forEachPosition(const std::vector<uint32_t>& byName, uint32_t begin, uint32_t end,
+                            TFunc f)
+{
+    auto it = std::upper_bound(byName.begin(), byName.end(), begin);
+    const auto last = std::lower_bound(it, byName.end(), end);
+    for (; it != last; ++it)
+    {
+        f(*it);
+    }
+}
+
+void xml::lite::ElementIndex::getPositions(uint32_t position, uint32_t localName,
+                                           std::vector<uint32_t>& positions, bool recurse) const
+{
+    const auto end = mEntries[position].end;
+    if (!recurse)
+    {
+        // Walk the siblings; each one's "end" is where the next starts
+        for (auto child = position + 1; child < end; child = mEntries[child].end)
+        {
+            if ((localName == npos) || (mEntries[child].localName == localName))
+            {
+                positions.push_back(child);
+            }
+        }
+    }
+    else if (localName == npos)
+    {
+        for (auto descendant = position + 1; descendant < end; ++descendant)
+        {
+            positions.push_back(descendant);
+        }
+    }
+    else
+    {
+        forEachPosition(mElementsByName[localName], position, end,
+                        [&](uint32_t descendant) { positions.push_back(descendant); });
+    }
+}
+
+template <typename TMatch>
+void xml::lite::ElementIndex::getElements(const Element& base, uint32_t localName, TMatch match,
+                                          std::vector<Element*>& elements, bool recurse) const
+{
+    const auto position = getPosition(base);
+    if (localName == npos)
+    {
+        return;  // no element has that name
+    }
+
+    const auto end = mEntries[position].end;
+    if (!recurse)
+    {
+        for (auto child = position + 1; child < end; child = mEntries[child].end)
+        {
+            const auto& entry = mEntries[child];
+            if ((entry.localName == localName) && match(entry))
+            {
+                elements.push_back(entry.element);
+            }
+        }
+    }
+    else
+    {
+        forEachPosition(mElementsByName[localName], position, end, [&](uint32_t descendant)
+        {
+            const auto& entry = mEntries[descendant];
+            if (match(entry))
+            {
+                elements.push_back(entry.element);
+            }
+        });
+    }
+}
+
+void xml::lite::ElementIndex::getElementsByTagName(const Element& base, const std::string& localName,
+                                                   std::vector<Element*>& elements, bool recurse) const
+{
+    getElements(base, findName(localName), [](const Entry&) { return true; }, elements, recurse);
+}
+
+void xml::lite::ElementIndex::getElementsByTagName(const Element& base, const xml::lite::QName& name,
+                                                   std::vector<Element*>& elements, bool recurse) const
+{
+    const auto uri = findName(name.getUri().value);
+    if (uri == npos)
+    {
+        (void)getPosition(base);  // still validate base
+        return;
+    }
+    getElements(base, findName(name.getName()), [&](const Entry& entry) { return entry.uri == uri; },
+                elements, recurse);
+}
+
+void xml::lite::ElementIndex::getElementsByTagNameNS(const Element& base, const std::string& qname,
+                                                     std::vector<Element*>& elements, bool recurse) const
+{
+    // Same split as QName::toString()
+    const auto colon = qname.find(':');
+    const auto prefix = findName(colon == std::string::npos ? "" : qname.substr(0, colon));
+    const auto localName = colon == std::string::npos ? qname : qname.substr(colon + 1);
+    if (prefix == npos)
+    {
+        (void)getPosition(base);
+        return;
+    }
+    getElements(base, findName(localName), [&](const Entry& entry) { return entry.prefix == prefix; },
+                elements, recurse);
+}
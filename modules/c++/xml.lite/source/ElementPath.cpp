@@ -0,0 +1,178 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/ElementPath.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <except/Exception.h>
+
+#include "xml/lite/XMLException.h"
+
+xml::lite::ElementPath::ElementPath(const std::string& path) : mPath(path)
+{
+    size_t pos = 0;
+    bool recurse = false;
+    if (path.compare(0, 2, "//") == 0)
+    {
+        recurse = true;
+        pos = 2;
+    }
+
+    while (true)
+    {
+        const auto slash = path.find('/', pos);
+        const auto localName = path.substr(pos, slash == std::string::npos ? std::string::npos : slash - pos);
+        if (localName.empty())
+        {
+            throw except::InvalidArgumentException(Ctxt("Malformed path '" + path + "'"));
+        }
+        mSteps.push_back({ localName, recurse });
+        if (slash == std::string::npos)
+        {
+            break;
+        }
+
+        recurse = (slash + 1 < path.size()) && (path[slash + 1] == '/');
+        pos = slash + (recurse ? 2 : 1);
+    }
+}
+
+static bool matches(const std::string& localName, const xml::lite::Element& element)
+{
+    return (localName == "*") || (element.getLocalName() == localName);
+}
+
+// Walks the tree below element, adding the matches of a step whose
+// context is "current".  One walk keeps the results in document
+// order even when the elements in "current" are nested.
+static void selectStep(const xml::lite::Element& element, bool inCurrent,
+                       const std::unordered_set<const xml::lite::Element*>& current,
+                       const std::string& localName, bool recurse, std::vector<xml::lite::Element*>& result)
+{
+    for (const auto& child : element.getChildren())
+    {
+        if (inCurrent && matches(localName, *child))
+        {
+            result.push_back(child);
+        }
+        const bool childInCurrent = (recurse && inCurrent) || (current.count(child) > 0);
+        selectStep(*child, childInCurrent, current, localName, recurse, result);
+    }
+}
+
+std::vector<xml::lite::Element*> xml::lite::ElementPath::select(const Element& context, const ElementIndex* pIndex) const
+{
+    if (pIndex != nullptr)
+    {
+        return select(context, *pIndex);
+    }
+
+    std::vector<Element*> current{ const_cast<Element*>(&context) };
+    bool nested = false;  // can elements of current contain each other?
+    for (const auto& step : mSteps)
+    {
+        std::vector<Element*> next;
+        if (!nested && !step.recurse)
+        {
+            for (const auto& element : current)
+            {
+                for (const auto& child : element->getChildren())
+                {
+                    if (matches(step.localName, *child))
+                    {
+                        next.push_back(child);
+                    }
+                }
+            }
+        }
+        else
+        {
+            const std::unordered_set<const Element*> set(current.begin(), current.end());
+            selectStep(context, set.count(&context) > 0, set, step.localName, step.recurse, next);
+        }
+        nested = nested || step.recurse;
+        current = std::move(next);
+        if (current.empty())
+        {
+            break;
+        }
+    }
+    return current;
+}
+
+std::vector<xml::lite::Element*> xml::lite::ElementPath::select(const Element& context, const ElementIndex& index) const
+{
+    std::vector<uint32_t> current{ index.getPosition(context) };
+    std::vector<uint32_t> next;
+    for (const auto& step : mSteps)
+    {
+        auto localName = ElementIndex::npos;  // any
+        if (step.localName != "*")
+        {
+            localName = index.findName(step.localName);
+            if (localName == ElementIndex::npos)
+            {
+                return std::vector<Element*>();  // nothing has that name
+            }
+        }
+
+        next.clear();
+        for (const auto position : current)
+        {
+            index.getPositions(position, localName, next, step.recurse);
+        }
+        if (current.size() > 1)
+        {
+            // Positions are document order; nested contexts can produce
+            // them out of order, or more than once.
+            std::sort(next.begin(), next.end());
+            next.erase(std::unique(next.begin(), next.end()), next.end());
+        }
+        std::swap(current, next);
+        if (current.empty())
+        {
+            break;
+        }
+    }
+
+    std::vector<Element*> retval;
+    retval.reserve(current.size());
+    for (const auto position : current)
+    {
+        retval.push_back(index.getElement(position));
+    }
+    return retval;
+}
+
+xml::lite::Element& xml::lite::ElementPath::selectOne(const Element& context, const ElementIndex* pIndex) const
+{
+    const auto elements = select(context, pIndex);
+    if (elements.size() != 1)
+    {
+        throw xml::lite::XMLException(Ctxt("Expected exactly one '" + mPath + "'; but got " +
+                                           std::to_string(elements.size())));
+    }
+    return *elements[0];
+}
@@ -0,0 +1,166 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/ParserPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "except/Exception.h"
+#include "mt/Runnable1D.h"
+#include "sys/OS.h"
+#include "xml/lite/CompactDomParser.h"
+#include "xml/lite/MinidomParser.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsedMS(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void reset(xml::lite::MinidomParser& parser)
+{
+    parser.setDocument(std::make_unique<xml::lite::Document>());
+}
+void reset(xml::lite::CompactDomParser& parser)
+{
+    parser.clear();
+}
+
+void release(xml::lite::MinidomParser& parser, std::unique_ptr<xml::lite::Document>& result)
+{
+    parser.getDocument(result);
+
+    // Don't leave the parser pointing at a document it no longer owns.
+    parser.setDocument(nullptr, true /*own*/);
+}
+void release(xml::lite::CompactDomParser& parser, xml::lite::CompactDocument& result)
+{
+    result = parser.releaseDocument();
+}
+
+// One per thread; run1D() hands each its own range of documents.
+template <typename TParser, typename TResult>
+struct ParseOp final
+{
+    const std::vector<io::InputStream*>* inputs;
+    std::unique_ptr<TParser>* parser;
+    std::vector<TResult>* results;
+    std::vector<xml::lite::ParseTiming>* timings;
+    bool preserveCharData;
+
+    void operator()(size_t ii) const
+    {
+        const auto start = Clock::now();
+        if (!*parser)
+        {
+            *parser = std::make_unique<TParser>();
+        }
+        reset(**parser);
+        (*parser)->preserveCharacterData(preserveCharData);
+        const auto parseStart = Clock::now();
+
+        try
+        {
+            (*parser)->parse(*(*inputs)[ii]);
+        }
+        catch (...)
+        {
+            // A failed parse leaves the handler mid-document; reset() only
+            // swaps the document, so start the next one on a new parser.
+            parser->reset();
+            throw;
+        }
+        release(**parser, (*results)[ii]);
+
+        auto& timing = (*timings)[ii];
+        timing.setupTimeMS = elapsedMS(start, parseStart);
+        timing.parseTimeMS = elapsedMS(parseStart, Clock::now());
+    }
+};
+
+template <typename TParser, typename TResult>
+std::vector<TResult> parseAll(const std::vector<io::InputStream*>& inputs, size_t maxThreads,
+                              bool preserveCharData, std::vector<std::unique_ptr<TParser>>& parsers,
+                              std::vector<xml::lite::ParseTiming>& timings)
+{
+    if (std::find(inputs.begin(), inputs.end(), nullptr) != inputs.end())
+    {
+        throw except::NullPointerReference(Ctxt("Null InputStream passed to ParserPool"));
+    }
+
+    std::vector<TResult> results(inputs.size());
+    timings.assign(inputs.size(), xml::lite::ParseTiming());
+    if (inputs.empty())
+    {
+        return results;
+    }
+
+    const size_t numThreads = std::min(inputs.size(), maxThreads);
+    if (parsers.size() < numThreads)
+    {
+        parsers.resize(numThreads);
+    }
+
+    std::vector<ParseOp<TParser, TResult>> ops;
+    ops.reserve(numThreads);
+    for (size_t ii = 0; ii < numThreads; ++ii)
+    {
+        ops.push_back({ &inputs, &parsers[ii], &results, &timings, preserveCharData });
+    }
+    mt::run1D(inputs.size(), numThreads, ops);
+    return results;
+}
+}
+
+xml::lite::ParserPool::ParserPool(size_t numThreads) :
+    mNumThreads(numThreads == 0 ? sys::OS().getNumCPUs() : numThreads)
+{
+}
+
+xml::lite::ParserPool::~ParserPool() = default;
+
+std::vector<std::unique_ptr<xml::lite::Document>>
+xml::lite::ParserPool::parse(const std::vector<io::InputStream*>& inputs)
+{
+    return parseAll<MinidomParser, std::unique_ptr<Document>>(
+            inputs, mNumThreads, mPreserveCharData, mParsers, mTimings);
+}
+
+std::vector<xml::lite::CompactDocument>
+xml::lite::ParserPool::parseCompact(const std::vector<io::InputStream*>& inputs)
+{
+    return parseAll<CompactDomParser, CompactDocument>(
+            inputs, mNumThreads, mPreserveCharData, mCompactParsers, mTimings);
+}
+
+size_t xml::lite::ParserPool::getNumParsers() const
+{
+    const auto isCreated = [](const auto& parser) { return parser != nullptr; };
+    return std::count_if(mParsers.begin(), mParsers.end(), isCreated) +
+           std::count_if(mCompactParsers.begin(), mCompactParsers.end(), isCreated);
+}
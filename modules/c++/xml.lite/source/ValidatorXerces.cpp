@@ -40,6 +40,7 @@ CODA_OSS_disable_warning_pop
 #include <sys/Path.h>
 #include <io/StringStream.h>
 #include <mem/ScopedArray.h>
+#include <except/Exception.h>
 
 namespace fs = std::filesystem;
 
@@ -109,6 +110,46 @@ ValidatorXerces::ValidatorXerces(
         new xercesc::XMLGrammarPoolImpl(
             xercesc::XMLPlatformUtils::fgMemoryManager));
 
+    createValidator();
+
+    // load our schemas --
+    // search each directory for schemas
+    const auto schemas = loadSchemas(sys::convertPaths(schemaPaths), recursive);
+
+    //  add the schema to the validator
+    //  add the schema to the validator
+    for (auto&& schema : schemas)
+    {
+        if (!mValidator->loadGrammar(schema.c_str(),
+                                     xercesc::Grammar::SchemaGrammarType,
+                                     true))
+        {
+            if (log != nullptr)
+            {
+                std::ostringstream oss;
+                oss << "Error: Failure to load schema " << schema;
+                log->warn(Ctxt(oss));
+            }
+        }
+    }
+
+    //! no additional schemas will be loaded after this point!
+    mSchemaPool->lockPool();
+}
+
+ValidatorXerces::ValidatorXerces(std::shared_ptr<xercesc::XMLGrammarPool> grammarPool) :
+    ValidatorInterface(std::vector<std::string>(), nullptr /*log*/),
+    mSchemaPool(std::move(grammarPool))
+{
+    if (mSchemaPool.get() == nullptr)
+    {
+        throw except::InvalidArgumentException(Ctxt("A grammar pool is required"));
+    }
+    createValidator();
+}
+
+void ValidatorXerces::createValidator()
+{
     const XMLCh ls_id [] = {xercesc::chLatin_L, 
                             xercesc::chLatin_S, 
                             xercesc::chNull};
@@ -152,30 +193,6 @@ ValidatorXerces::ValidatorXerces(
             new ValidationErrorHandler());
     config->setParameter(xercesc::XMLUni::fgDOMErrorHandler, 
                          mErrorHandler.get());
-
-    // load our schemas --
-    // search each directory for schemas
-    const auto schemas = loadSchemas(sys::convertPaths(schemaPaths), recursive);
-
-    //  add the schema to the validator
-    //  add the schema to the validator
-    for (auto&& schema : schemas)
-    {
-        if (!mValidator->loadGrammar(schema.c_str(),
-                                     xercesc::Grammar::SchemaGrammarType,
-                                     true))
-        {
-            if (log != nullptr)
-            {
-                std::ostringstream oss;
-                oss << "Error: Failure to load schema " << schema;
-                log->warn(Ctxt(oss));
-            }
-        }
-    }
-
-    //! no additional schemas will be loaded after this point!
-    mSchemaPool->lockPool();
 }
 
 std::vector<coda_oss::filesystem::path> ValidatorXerces::loadSchemas(const std::vector<coda_oss::filesystem::path>& schemaPaths, bool recursive)
@@ -304,6 +321,97 @@ bool ValidatorXerces::validate(const str::W1252string& xml,
     return validate(str::to_u8string(xml), xmlID, errors);
 }
 
+ValidatorPoolXerces::ValidatorPoolXerces(
+        const std::vector<fs::path>& schemaPaths,
+        logging::Logger* log,
+        bool recursive) :
+    ValidatorPoolXerces(sys::convertPaths(schemaPaths), log, recursive)
+{
+}
+ValidatorPoolXerces::ValidatorPoolXerces(
+    const std::vector<std::string>& schemaPaths,
+    logging::Logger* log,
+    bool recursive) :
+    ValidatorInterface(schemaPaths, log, recursive)
+{
+    // The first validator loads (and locks) the schemas for everybody
+    auto validator = std::make_unique<ValidatorXerces>(schemaPaths, log, recursive);
+    mGrammarPool = validator->getGrammarPool();
+    release(std::move(validator));
+    mNumValidators = 1;
+}
+
+std::unique_ptr<ValidatorXerces> ValidatorPoolXerces::acquire() const
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mAvailable.empty())
+        {
+            auto retval = std::move(mAvailable.back());
+            mAvailable.pop_back();
+            return retval;
+        }
+    }
+
+    // Creating a parser is the expensive part; don't hold the lock.  Only
+    // count it once it exists, in case creating it throws.
+    auto retval = std::make_unique<ValidatorXerces>(mGrammarPool);
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mNumValidators;
+    return retval;
+}
+
+void ValidatorPoolXerces::release(std::unique_ptr<ValidatorXerces>&& validator) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mAvailable.push_back(std::move(validator));
+}
+
+size_t ValidatorPoolXerces::getNumValidators() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNumValidators;
+}
+
+template <typename TString>
+bool ValidatorPoolXerces::validate_(const TString& xml,
+                                    const std::string& xmlID,
+                                    std::vector<ValidationInfo>& errors) const
+{
+    auto validator = acquire();
+    bool retval;
+    try
+    {
+        retval = validator->validate(xml, xmlID, errors);
+    }
+    catch (...)
+    {
+        release(std::move(validator));
+        throw;
+    }
+    release(std::move(validator));
+    return retval;
+}
+
+bool ValidatorPoolXerces::validate(const std::string& xml,
+                                   const std::string& xmlID,
+                                   std::vector<ValidationInfo>& errors) const
+{
+    return validate_(xml, xmlID, errors);
+}
+bool ValidatorPoolXerces::validate(const coda_oss::u8string& xml,
+                                   const std::string& xmlID,
+                                   std::vector<ValidationInfo>& errors) const
+{
+    return validate_(xml, xmlID, errors);
+}
+bool ValidatorPoolXerces::validate(const str::W1252string& xml,
+                                   const std::string& xmlID,
+                                   std::vector<ValidationInfo>& errors) const
+{
+    return validate_(xml, xmlID, errors);
+}
+
 }
 }
 #endif
@@ -104,6 +104,88 @@ void xml::lite::XMLReaderXerces::parse(io::InputStream& is, int size)
     parse(is, nullptr /*pInitialEncoding*/, getWindows1252Encoding(), size);
 }
 
+namespace
+{
+// Feeds Xerces from an io::InputStream a block at a time
+class IoBinInputStream final : public BinInputStream
+{
+    io::InputStream& mStream;
+    XMLFilePos mPos = 0;
+
+public:
+    explicit IoBinInputStream(io::InputStream& is) : mStream(is)
+    {
+    }
+
+    XMLFilePos curPos() const override
+    {
+        return mPos;
+    }
+
+    XMLSize_t readBytes(XMLByte* const toFill, const XMLSize_t maxToRead) override
+    {
+        const auto numBytes = mStream.read(toFill, maxToRead);
+        if (numBytes <= 0)
+        {
+            return 0;  // EOF
+        }
+        mPos += static_cast<XMLFilePos>(numBytes);
+        return static_cast<XMLSize_t>(numBytes);
+    }
+
+    const XMLCh* getContentType() const override
+    {
+        return nullptr;
+    }
+};
+
+class IoInputSource final : public InputSource
+{
+    io::InputStream& mStream;
+
+public:
+    explicit IoInputSource(io::InputStream& is) :
+        InputSource(xml::lite::XMLReaderXerces::MEM_BUFFER_ID()), mStream(is)
+    {
+    }
+
+    BinInputStream* makeStream() const override
+    {
+        return new IoBinInputStream(mStream);
+    }
+};
+}
+
+bool xml::lite::XMLReaderXerces::parseFirst(io::InputStream& is, const void* pEncoding)
+{
+    parseReset();
+
+    mProgressiveSource.reset(new IoInputSource(is));
+    if (pEncoding != nullptr)
+    {
+        mProgressiveSource->setEncoding(static_cast<const XMLCh*>(pEncoding));
+    }
+    return mNative->parseFirst(*mProgressiveSource, mScanToken);
+}
+
+bool xml::lite::XMLReaderXerces::parseNext()
+{
+    if (mProgressiveSource.get() == nullptr)
+    {
+        throw xml::lite::XMLParseException(Ctxt("parseFirst() must be called before parseNext()"));
+    }
+    return mNative->parseNext(mScanToken);
+}
+
+void xml::lite::XMLReaderXerces::parseReset()
+{
+    if (mProgressiveSource.get() != nullptr)
+    {
+        mNative->parseReset(mScanToken);
+        mProgressiveSource.reset();
+    }
+}
+
 // This function creates the parser
 void xml::lite::XMLReaderXerces::create()
 {
@@ -125,6 +207,7 @@ void xml::lite::XMLReaderXerces::create()
 // This function destroys the parser
 void xml::lite::XMLReaderXerces::destroy()
 {
+    mProgressiveSource.reset();
     mNative.reset();
     mDriverContentHandler.reset();
     mErrorHandler.reset();
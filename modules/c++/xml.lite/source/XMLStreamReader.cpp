@@ -0,0 +1,387 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/XMLStreamReader.h"
+
+#include <deque>
+#include <stdexcept>
+#include <utility>
+
+#include <except/Exception.h>
+#include <str/Encoding.h>
+#include <str/Manip.h>
+
+#include "xml/lite/XMLException.h"
+
+struct xml::lite::XMLStreamReader::QueuedEvent final
+{
+    Event event;
+    size_t depth;
+    std::string uri;
+    std::string localName;
+    std::string qname;
+    Attributes attributes;
+    coda_oss::u8string characterData;
+};
+
+// Turns the SAX callbacks into a queue of events.  Xerces delivers a
+// handful of callbacks for each parseNext(); events outside of the
+// path filters (or inside a skipped element) are dropped right here.
+class xml::lite::XMLStreamReader::Handler final : public ContentHandler
+{
+    // Local names of the open elements; only kept with path filters
+    std::vector<std::string> mPath;
+    size_t mDepth = 0;
+
+    bool matches() const
+    {
+        for (const auto& filter : filters)
+        {
+            if (filter.size() != mDepth)
+            {
+                continue;
+            }
+            size_t ii = 0;
+            for (; ii < mDepth; ++ii)
+            {
+                if ((filter[ii] != "*") && (filter[ii] != mPath[ii]))
+                {
+                    break;
+                }
+            }
+            if (ii == mDepth)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool reporting() const
+    {
+        return (filters.empty() || (matchDepth > 0)) && (skipDepth == 0);
+    }
+
+    QueuedEvent& push(Event event)
+    {
+        events.emplace_back();
+        auto& retval = events.back();
+        retval.event = event;
+        retval.depth = mDepth;
+        return retval;
+    }
+
+    void characters(coda_oss::u8string&& s)
+    {
+        if (!events.empty() && (events.back().event == Event::Characters))
+        {
+            events.back().characterData += s;
+        }
+        else
+        {
+            push(Event::Characters).characterData = std::move(s);
+        }
+    }
+
+public:
+    std::deque<QueuedEvent> events;
+    std::vector<std::vector<std::string>> filters;
+    size_t matchDepth = 0;  // depth of the element matching a filter
+    size_t skipDepth = 0;  // depth of the element being skipped
+    bool endOfDocument = false;
+
+    void endDocument() override
+    {
+        endOfDocument = true;
+        push(Event::EndDocument);
+    }
+
+    void characters(const char* value, int length) override
+    {
+        if (reporting())
+        {
+            characters(str::u8FromNative(std::string(value, length)));
+        }
+    }
+
+    bool vcharacters(const void /*XMLCh*/* chars_, size_t length) override
+    {
+        if (chars_ == nullptr)
+        {
+            throw std::invalid_argument("chars_ is NULL.");
+        }
+        if (reporting() && (length > 0))
+        {
+            static_assert(sizeof(XMLCh) == sizeof(char16_t), "XMLCh should be 16-bits.");
+            characters(str::to_u8string(static_cast<const char16_t*>(chars_), length));
+        }
+        return true;  // vcharacters() processed
+    }
+
+    void startElement(const std::string& uri,
+                      const std::string& localName,
+                      const std::string& qname,
+                      const Attributes& atts) override
+    {
+        ++mDepth;
+        if (!filters.empty())
+        {
+            // Reuse the strings rather than push and pop them
+            if (mPath.size() < mDepth)
+            {
+                mPath.resize(mDepth);
+            }
+            mPath[mDepth - 1] = localName;
+            if ((matchDepth == 0) && matches())
+            {
+                matchDepth = mDepth;
+            }
+        }
+
+        if (reporting())
+        {
+            auto& event = push(Event::StartElement);
+            event.uri = uri;
+            event.localName = localName;
+            event.qname = qname;
+            event.attributes = atts;
+        }
+    }
+
+    void endElement(const std::string& uri,
+                    const std::string& localName,
+                    const std::string& qname) override
+    {
+        if (skipDepth == mDepth)
+        {
+            skipDepth = 0;
+        }
+        if (reporting())
+        {
+            auto& event = push(Event::EndElement);
+            event.uri = uri;
+            event.localName = localName;
+            event.qname = qname;
+        }
+        if (matchDepth == mDepth)
+        {
+            matchDepth = 0;
+        }
+        --mDepth;
+    }
+};
+
+xml::lite::XMLStreamReader::XMLStreamReader(io::InputStream& is) :
+    mStream(is), mHandler(new Handler())
+{
+    mReader.setContentHandler(mHandler.get());
+}
+
+xml::lite::XMLStreamReader::~XMLStreamReader()
+{
+    try
+    {
+        mReader.parseReset();
+    }
+    catch (...)
+    {
+    }
+}
+
+void xml::lite::XMLStreamReader::addPathFilter(const std::string& path)
+{
+    if (mStarted)
+    {
+        throw except::Exception(Ctxt("Path filters must be added before calling next()"));
+    }
+    if (path.empty() || (path[0] != '/'))
+    {
+        throw except::InvalidArgumentException(Ctxt("Path '" + path + "' must start with '/'"));
+    }
+
+    if ((path.back() == '/') || (path.find("//") != std::string::npos))
+    {
+        throw except::InvalidArgumentException(Ctxt("Path '" + path + "' has an empty name"));
+    }
+    auto filter = str::split(path.substr(1), "/");
+    mHandler->filters.push_back(std::move(filter));
+}
+
+bool xml::lite::XMLStreamReader::next()
+{
+    if (mDone)
+    {
+        return false;
+    }
+
+    auto& events = mHandler->events;
+
+    // Parse until there's an event; Characters are held back until
+    // whatever follows them shows up, so they're reported in one piece.
+    while (events.empty() ||
+           ((events.size() == 1) && (events.front().event == Event::Characters)))
+    {
+        if (mHandler->endOfDocument)
+        {
+            break;
+        }
+        if (!mStarted)
+        {
+            mStarted = true;
+            if (!mReader.parseFirst(mStream))
+            {
+                throw xml::lite::XMLParseException(Ctxt("Unable to start parsing the document"));
+            }
+        }
+        else if (!mReader.parseNext())
+        {
+            break;
+        }
+    }
+
+    if (events.empty())
+    {
+        mEvent = Event::EndDocument;
+        mDepth = 0;
+        mDone = true;
+        return false;
+    }
+
+    auto& event = events.front();
+    mEvent = event.event;
+    mDepth = event.depth;
+    mUri = std::move(event.uri);
+    mLocalName = std::move(event.localName);
+    mQName = std::move(event.qname);
+    mAttributes = std::move(event.attributes);
+    mCharacterData = std::move(event.characterData);
+    events.pop_front();
+
+    if (mEvent == Event::EndDocument)
+    {
+        mDone = true;
+        return false;
+    }
+    return true;
+}
+
+void xml::lite::XMLStreamReader::requireStartElement(const char* caller) const
+{
+    if (mEvent != Event::StartElement)
+    {
+        throw except::Exception(Ctxt(std::string(caller) + "() must be called at a StartElement"));
+    }
+}
+
+void xml::lite::XMLStreamReader::skipElement()
+{
+    requireStartElement("skipElement");
+    const auto depth = mDepth;
+
+    // Drop whatever of the element has been queued; if its end hasn't
+    // been seen yet, have the handler drop the rest as it's parsed.
+    auto& events = mHandler->events;
+    while (!events.empty() &&
+           !((events.front().event == Event::EndElement) && (events.front().depth == depth)))
+    {
+        events.pop_front();
+    }
+    if (events.empty())
+    {
+        mHandler->skipDepth = depth;
+    }
+
+    if (!next() || (mEvent != Event::EndElement))
+    {
+        throw xml::lite::XMLParseException(Ctxt("Unexpected end of document"));
+    }
+}
+
+static std::unique_ptr<xml::lite::Element> newElement(const xml::lite::XMLStreamReader& reader)
+{
+    std::unique_ptr<xml::lite::Element> retval(new xml::lite::Element(reader.getQName(), reader.getUri()));
+    retval->setAttributes(reader.getAttributes());
+    return retval;
+}
+
+std::unique_ptr<xml::lite::Element> xml::lite::XMLStreamReader::readElement()
+{
+    requireStartElement("readElement");
+
+    // As in MinidomHandler, the text directly inside an element is
+    // concatenated and (optionally) trimmed.
+    struct OpenElement final
+    {
+        Element* element;
+        coda_oss::u8string characterData;
+    };
+
+    auto retval = newElement(*this);
+    std::vector<OpenElement> openElements{ { retval.get(), coda_oss::u8string() } };
+    while (!openElements.empty())
+    {
+        if (!next())
+        {
+            throw xml::lite::XMLParseException(Ctxt("Unexpected end of document"));
+        }
+
+        switch (mEvent)
+        {
+        case Event::StartElement:
+        {
+            auto& child = openElements.back().element->addChild(newElement(*this));
+            openElements.push_back({ &child, coda_oss::u8string() });
+            break;
+        }
+        case Event::Characters:
+            openElements.back().characterData += mCharacterData;
+            break;
+        case Event::EndElement:
+        {
+            auto& current = openElements.back();
+            if (!mPreserveCharData)
+            {
+                str::trim(current.characterData);
+            }
+            current.element->setCharacterData(std::move(current.characterData));
+            openElements.pop_back();
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return retval;
+}
+
+std::unique_ptr<xml::lite::Element> xml::lite::XMLStreamReader::readNextElement()
+{
+    while (next())
+    {
+        if (mEvent == Event::StartElement)
+        {
+            return readElement();
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,277 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "xml/lite/XMLWriter.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+const size_t xml::lite::XMLWriter::DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+xml::lite::XMLWriter::XMLWriter(io::OutputStream& stream, const std::string& formatter, size_t bufferSize) :
+    mStream(stream), mFormatter(formatter), mBuffer(std::max(bufferSize, static_cast<size_t>(1)))
+{
+}
+
+xml::lite::XMLWriter::~XMLWriter() noexcept
+{
+    try
+    {
+        flushBuffer();
+    }
+    catch (...)
+    {
+    }
+}
+
+void xml::lite::XMLWriter::flushBuffer()
+{
+    if (mSize > 0)
+    {
+        // Reset first so a throwing stream doesn't see the same data twice
+        const auto size = mSize;
+        mSize = 0;
+        mStream.write(mBuffer.data(), size);
+    }
+}
+
+void xml::lite::XMLWriter::flush()
+{
+    flushBuffer();
+    mStream.flush();
+}
+
+void xml::lite::XMLWriter::append(const char* data, size_t size)
+{
+    if (size > mBuffer.size() - mSize)
+    {
+        flushBuffer();
+        if (size >= mBuffer.size())
+        {
+            // Too big to be worth copying
+            mStream.write(data, size);
+            return;
+        }
+    }
+    memcpy(mBuffer.data() + mSize, data, size);
+    mSize += size;
+}
+
+void xml::lite::XMLWriter::appendEscaped(const char* data, size_t size, bool isAttribute)
+{
+    if (!mEscape)
+    {
+        append(data, size);
+        return;
+    }
+
+    // Copy runs of ordinary characters in one go
+    const char* const end = data + size;
+    const char* run = data;
+    for (const char* p = data; p != end; ++p)
+    {
+        const char* entity = nullptr;
+        size_t entitySize = 0;
+        switch (*p)
+        {
+        case '&': entity = "&amp;"; entitySize = 5; break;
+        case '<': entity = "&lt;"; entitySize = 4; break;
+        case '>':
+            if (!isAttribute)
+            {
+                entity = "&gt;"; entitySize = 4;
+            }
+            break;
+        case '"':
+            if (isAttribute)
+            {
+                entity = "&quot;"; entitySize = 6;
+            }
+            break;
+        default: break;
+        }
+        if (entity != nullptr)
+        {
+            append(run, p - run);
+            append(entity, entitySize);
+            run = p + 1;
+        }
+    }
+    append(run, end - run);
+}
+
+void xml::lite::XMLWriter::appendIndent(size_t depth)
+{
+    const size_t size = depth * mFormatter.size();
+    if (size == 0)
+    {
+        return;
+    }
+    if (mIndent.size() < size)
+    {
+        // Double the table so deep documents don't rebuild it at every level
+        if (mIndent.empty())
+        {
+            mIndent = mFormatter;
+        }
+        while (mIndent.size() < size)
+        {
+            mIndent += mIndent;
+        }
+    }
+    append(mIndent.data(), size);
+}
+
+void xml::lite::XMLWriter::appendAttribute(const std::string& qname, const std::string& value)
+{
+    append(' ');
+    append(qname);
+    append("=\"", 2);
+    appendEscaped(value.data(), value.size(), true /*isAttribute*/);
+    append('"');
+}
+
+void xml::lite::XMLWriter::appendName(const std::string& prefix, const std::string& localName)
+{
+    if (!prefix.empty())
+    {
+        append(prefix);
+        append(':');
+    }
+    append(localName);
+}
+
+void xml::lite::XMLWriter::write(const std::string& s)
+{
+    append(s);
+}
+
+void xml::lite::XMLWriter::write(const Element& element)
+{
+    write(element, 0);
+}
+
+void xml::lite::XMLWriter::write(const Element& element, size_t depth)
+{
+    appendIndent(depth);
+
+    const auto name = element.getQName();
+    append('<');
+    append(name);
+
+    const auto& attributes = element.getAttributes();
+    for (int i = 0; i < attributes.getLength(); i++)
+    {
+        const auto& attribute = attributes.getNode(i);
+        appendAttribute(attribute.getQName(), attribute.getValue());
+    }
+
+    element.getCharacterData(mCharacterData);
+    const auto& children = element.getChildren();
+    if (mCharacterData.empty() && children.empty())
+    {
+        append("/>", 2);
+        return;
+    }
+
+    append('>');
+    appendEscaped(reinterpret_cast<const char*>(mCharacterData.data()), mCharacterData.size(),
+                  false /*isAttribute*/);
+
+    for (const auto& child : children)
+    {
+        if (!mFormatter.empty())
+        {
+            append('\n');
+        }
+        write(*child, depth + 1);
+    }
+    if (!children.empty() && !mFormatter.empty())
+    {
+        append('\n');
+        appendIndent(depth);
+    }
+
+    append("</", 2);
+    append(name);
+    append('>');
+}
+
+void xml::lite::XMLWriter::write(const CompactElement& element)
+{
+    write(element, 0);
+}
+
+void xml::lite::XMLWriter::write(const CompactElement& element, size_t depth)
+{
+    appendIndent(depth);
+
+    // Names are references into the document; nothing is copied
+    const auto& prefix = element.prefix();
+    const auto& localName = element.localName();
+    append('<');
+    appendName(prefix, localName);
+
+    const auto numAttributes = element.getNumAttributes();
+    for (size_t i = 0; i < numAttributes; i++)
+    {
+        append(' ');
+        appendName(element.attributePrefix(i), element.attributeLocalName(i));
+        append("=\"", 2);
+        const auto value = element.attributeValue(i);
+        appendEscaped(value.data(), value.size(), true /*isAttribute*/);
+        append('"');
+    }
+
+    // Character data is already UTF-8 in the document; no copy needed
+    const auto characterData = element.characterData();
+    auto child = element.getFirstChild();
+    if (characterData.empty() && !child)
+    {
+        append("/>", 2);
+        return;
+    }
+
+    append('>');
+    appendEscaped(characterData.data(), characterData.size(), false /*isAttribute*/);
+
+    const bool hasChildren = static_cast<bool>(child);
+    for (; child; child = child.getNextSibling())
+    {
+        if (!mFormatter.empty())
+        {
+            append('\n');
+        }
+        write(child, depth + 1);
+    }
+    if (hasChildren && !mFormatter.empty())
+    {
+        append('\n');
+        appendIndent(depth);
+    }
+
+    append("</", 2);
+    appendName(prefix, localName);
+    append('>');
+}
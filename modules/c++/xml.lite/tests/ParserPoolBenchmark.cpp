@@ -0,0 +1,127 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Parses one file many times, first with a new MinidomParser per
+ * document and then through a ParserPool.
+ *
+ *    ./ParserPoolBenchmark <xml file> [documents] [threads]
+ */
+
+#if defined(USE_XERCES)
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <import/except.h>
+#include <import/io.h>
+#include <import/str.h>
+#include <import/sys.h>
+#include <xml/lite/MinidomParser.h>
+#include <xml/lite/ParserPool.h>
+
+namespace
+{
+std::vector<std::unique_ptr<io::StringStream>> makeStreams(const std::string& xml, size_t numDocuments)
+{
+    std::vector<std::unique_ptr<io::StringStream>> retval;
+    for (size_t ii = 0; ii < numDocuments; ++ii)
+    {
+        retval.push_back(std::make_unique<io::StringStream>());
+        retval.back()->stream() << xml;
+    }
+    return retval;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        if (argc < 2 || argc > 4)
+        {
+            throw except::Exception(Ctxt(str::Format(
+                "Usage: %s <xml file> [documents] [threads]\n", argv[0])));
+        }
+        const size_t numDocuments = argc > 2 ? str::toType<size_t>(argv[2]) : 100;
+        const size_t numThreads = argc > 3 ? str::toType<size_t>(argv[3]) : 0;
+
+        io::FileInputStream fis(argv[1]);
+        io::StringStream oss;
+        fis.streamTo(oss);
+        const auto xml = oss.stream().str();
+
+        sys::RealTimeStopWatch sw;
+        {
+            auto streams = makeStreams(xml, numDocuments);
+            sw.start();
+            for (auto& stream : streams)
+            {
+                xml::lite::MinidomParser parser;
+                parser.parse(*stream);
+            }
+            std::cout << "MinidomParser per document: " << sw.stop() << " ms" << std::endl;
+        }
+
+        xml::lite::ParserPool pool(numThreads);
+        for (size_t batch = 0; batch < 2; ++batch)
+        {
+            auto streams = makeStreams(xml, numDocuments);
+            std::vector<io::InputStream*> inputs;
+            for (auto& stream : streams)
+            {
+                inputs.push_back(stream.get());
+            }
+
+            sw.start();
+            pool.parse(inputs);
+            const double elapsed = sw.stop();
+
+            double setupTime = 0.0;
+            double parseTime = 0.0;
+            for (const auto& timing : pool.getTimings())
+            {
+                setupTime += timing.setupTimeMS;
+                parseTime += timing.parseTimeMS;
+            }
+            std::cout << "ParserPool batch " << batch << " (" << pool.getNumThreads() << " threads): "
+                      << elapsed << " ms; setup " << setupTime << " ms, parse " << parseTime
+                      << " ms summed over threads" << std::endl;
+        }
+    }
+    catch (const except::Throwable& t)
+    {
+        std::cout << "Caught Throwable: " << t.toString() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
+
+#else
+int main()
+{
+}
+#endif
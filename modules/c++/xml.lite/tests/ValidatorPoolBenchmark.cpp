@@ -0,0 +1,166 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Validation throughput from several threads.
+ *
+ *    ./ValidatorPoolBenchmark <schema dir> <xml file> [threads] [documents]
+ *
+ * "per thread" gives each thread its own Validator, so each one loads
+ * the schemas; "pool" loads them once and shares them.  Times include
+ * loading the schemas.
+ */
+
+#if defined(USE_XERCES)
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <import/except.h>
+#include <import/io.h>
+#include <import/str.h>
+#include <import/sys.h>
+#include <xml/lite/Validator.h>
+
+namespace
+{
+template <typename TValidate>
+void runThreads(size_t numThreads, size_t numDocuments, TValidate validate)
+{
+    std::atomic<size_t> next{0};
+
+    // An exception escaping a std::thread calls std::terminate(); hold on
+    // to it and rethrow once every thread is done.
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    std::vector<std::thread> threads;
+    for (size_t ii = 0; ii < numThreads; ++ii)
+    {
+        threads.emplace_back([&, ii]()
+        {
+            try
+            {
+                validate(ii, next, numDocuments);
+            }
+            catch (...)
+            {
+                exceptions[ii] = std::current_exception();
+                next = numDocuments; // stop the other threads
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto& exception : exceptions)
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+void report(const std::string& name, size_t numDocuments, double elapsedTimeMS)
+{
+    std::cout << name << ": " << elapsedTimeMS << " ms, "
+              << numDocuments / (elapsedTimeMS / 1000.0) << " documents/s" << std::endl;
+}
+
+void validateAll(const xml::lite::ValidatorInterface& validator, const std::string& xml,
+                 std::atomic<size_t>& next, size_t numDocuments)
+{
+    std::vector<xml::lite::ValidationInfo> errors;
+    while (next++ < numDocuments)
+    {
+        errors.clear();
+        if (validator.validate(xml, "benchmark", errors))
+        {
+            throw except::Exception(Ctxt("Validation failed: " + errors[0].toString()));
+        }
+    }
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        if (argc < 3 || argc > 5)
+        {
+            throw except::Exception(Ctxt(str::Format(
+                "Usage: %s <schema dir> <xml file> [threads] [documents]\n", argv[0])));
+        }
+        const std::vector<std::string> schemaPaths{ argv[1] };
+        const size_t numThreads = argc > 3 ? str::toType<size_t>(argv[3]) : sys::OS().getNumCPUs();
+        const size_t numDocuments = argc > 4 ? str::toType<size_t>(argv[4]) : 1000;
+
+        io::FileInputStream fis(argv[2]);
+        io::StringStream oss;
+        fis.streamTo(oss);
+        const auto xml = oss.stream().str();
+
+        std::cout << numDocuments << " documents, " << numThreads << " threads" << std::endl;
+
+        sys::RealTimeStopWatch sw;
+        sw.start();
+        runThreads(numThreads, numDocuments, [&](size_t, std::atomic<size_t>& next, size_t n)
+        {
+            const xml::lite::Validator validator(schemaPaths);
+            validateAll(validator, xml, next, n);
+        });
+        report("Validator per thread", numDocuments, sw.stop());
+
+        sw.start();
+        const xml::lite::ValidatorPool pool(schemaPaths);
+        runThreads(numThreads, numDocuments, [&](size_t, std::atomic<size_t>& next, size_t n)
+        {
+            validateAll(pool, xml, next, n);
+        });
+        report("ValidatorPool", numDocuments, sw.stop());
+        std::cout << "    " << pool.getNumValidators() << " parsers created" << std::endl;
+    }
+    catch (const except::Throwable& t)
+    {
+        std::cout << "Caught Throwable: " << t.toString() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cout << "Caught std::exception: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
+
+#else
+int main()
+{
+}
+#endif
@@ -0,0 +1,121 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Compares Element::prettyPrint() with XMLWriter.
+ *
+ *    ./XMLWriterBenchmark large_benchmark1.xml [iterations]
+ *
+ * The output goes to a stream that only counts, so the times are
+ * the cost of serializing; the number of write() calls is what a
+ * real (file, socket) stream would pay for on top of that.
+ */
+
+#if defined(USE_XERCES)
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <string>
+
+#include <import/except.h>
+#include <import/io.h>
+#include <import/sys.h>
+#include <import/str.h>
+#include <xml/lite/MinidomParser.h>
+#include <xml/lite/XMLWriter.h>
+
+namespace
+{
+struct CountingOutputStream final : public io::OutputStream
+{
+    uint64_t numBytes = 0;
+    uint64_t numWrites = 0;
+
+    void write(const void*, size_t size) override
+    {
+        numBytes += size;
+        ++numWrites;
+    }
+    using io::OutputStream::write;
+};
+
+template <typename TPrint>
+void benchmark(const std::string& name, size_t numIterations, TPrint print)
+{
+    CountingOutputStream stream;
+    sys::RealTimeStopWatch sw;
+    sw.start();
+    for (size_t ii = 0; ii < numIterations; ++ii)
+    {
+        print(stream);
+    }
+    const double elapsedTimeMS = sw.stop();
+
+    const double megabytes = static_cast<double>(stream.numBytes) / (1024.0 * 1024.0);
+    std::cout << name << ": " << elapsedTimeMS / numIterations << " ms/iteration, "
+              << megabytes / (elapsedTimeMS / 1000.0) << " MB/s, "
+              << stream.numWrites / numIterations << " writes/iteration" << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        if (argc < 2 || argc > 3)
+        {
+            throw except::Exception(Ctxt(str::Format("Usage: %s <xml file> [iterations]\n", argv[0])));
+        }
+        const size_t numIterations = argc == 3 ? str::toType<size_t>(argv[2]) : 10;
+
+        io::FileInputStream xmlFile(argv[1]);
+        xml::lite::MinidomParser parser;
+        parser.parse(xmlFile);
+        const xml::lite::Element& root = *parser.getDocument()->getRootElement();
+
+        benchmark("Element::prettyPrint()", numIterations, [&](io::OutputStream& stream)
+        {
+            root.prettyPrint(stream, "   ");
+        });
+        benchmark("XMLWriter", numIterations, [&](io::OutputStream& stream)
+        {
+            xml::lite::XMLWriter writer(stream, "   ");
+            writer.write(root);
+            writer.write("\n");
+            writer.flush();
+        });
+    }
+    catch (const except::Throwable& t)
+    {
+        std::cout << "Caught Throwable: " << t.toString() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
+
+#else
+int main()
+{
+}
+#endif
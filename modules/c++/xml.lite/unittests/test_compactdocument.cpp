@@ -0,0 +1,124 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <std/string>
+
+#include "io/StringStream.h"
+#include <TestCase.h>
+
+#include "xml/lite/CompactDomParser.h"
+#include "xml/lite/MinidomParser.h"
+#include "xml/lite/QName.h"
+
+static const std::string& strXml()
+{
+    static const std::string retval =
+        "<root xmlns=\"urn:root\" xmlns:y=\"urn:y\">\n"
+        "  leading\n"
+        "  <child id=\"1\">  1.5  </child>\n"
+        "  <y:child y:id=\"2\"><child>deep</child></y:child>\n"
+        "  trailing\n"
+        "</root>";
+    return retval;
+}
+
+static xml::lite::CompactDocument parse(bool preserve = false)
+{
+    io::StringStream ss;
+    ss.stream() << strXml();
+
+    xml::lite::CompactDomParser parser;
+    parser.preserveCharacterData(preserve);
+    parser.parse(ss);
+    return parser.releaseDocument();
+}
+
+TEST_CASE(testCompactQueries)
+{
+    const auto doc = parse();
+    TEST_ASSERT_EQ(doc.getNumElements(), static_cast<size_t>(4));
+
+    const auto root = doc.getRootElement();
+    TEST_ASSERT(root);
+    TEST_ASSERT_EQ(root.getLocalName(), "root");
+    TEST_ASSERT_EQ(root.getUri(), "urn:root");
+    TEST_ASSERT_EQ(root.getNumChildren(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(root.getCharacterData(), "leading\n  \n  \n  trailing");
+
+    TEST_ASSERT_EQ(root.getElementsByTagName("child").size(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(root.getElementsByTagName("child", true /*recurse*/).size(), static_cast<size_t>(3));
+    TEST_ASSERT_EQ(root.getElementsByTagNameNS("y:child").size(), static_cast<size_t>(1));
+    TEST_ASSERT(root.getElementsByTagName("missing", true /*recurse*/).empty());
+    TEST_ASSERT_FALSE(root.getElementByTagName(std::nothrow, "child"));
+    TEST_EXCEPTION(root.getElementByTagName("child"));
+
+    const auto child = root.getElementByTagName(xml::lite::QName(xml::lite::Uri("urn:root"), "child"));
+    TEST_ASSERT_EQ(xml::lite::getValue<double>(child), 1.5);
+    TEST_ASSERT_EQ(child.attribute("id"), "1");
+    TEST_ASSERT(child.getParent() == root);
+    TEST_EXCEPTION(child.attribute("missing"));
+
+    const auto yChild = root.getElementByTagNameNS("y:child");
+    TEST_ASSERT_EQ(yChild.getUri(), "urn:y");
+    std::string value;
+    TEST_ASSERT(yChild.getAttributeValue(xml::lite::QName(xml::lite::Uri("urn:y"), "id"), value));
+    TEST_ASSERT_EQ(value, "2");
+    TEST_ASSERT_EQ(yChild.getElementByTagName("child").getCharacterData(), "deep");
+}
+
+TEST_CASE(testCompactMatchesMinidom)
+{
+    io::StringStream ss;
+    ss.stream() << strXml();
+    xml::lite::MinidomParser minidom;
+    minidom.parse(ss);
+    const auto& expected = getRootElement(getDocument(minidom));
+
+    const auto doc = parse();
+    const auto actual = doc.getRootElement().toElement();
+
+    const auto expectedElements = expected.getElementsByTagName("child", true /*recurse*/);
+    const auto actualElements = actual->getElementsByTagName("child", true /*recurse*/);
+    TEST_ASSERT_EQ(actualElements.size(), expectedElements.size());
+    for (size_t ii = 0; ii < actualElements.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(actualElements[ii]->getQName(), expectedElements[ii]->getQName());
+        TEST_ASSERT_EQ(actualElements[ii]->getUri(), expectedElements[ii]->getUri());
+        TEST_ASSERT_EQ(actualElements[ii]->getCharacterData(), expectedElements[ii]->getCharacterData());
+        TEST_ASSERT_EQ(actualElements[ii]->getAttributes().size(),
+                       expectedElements[ii]->getAttributes().size());
+    }
+    TEST_ASSERT_EQ(actual->getCharacterData(), expected.getCharacterData());
+}
+
+TEST_CASE(testCompactPreserveCharacterData)
+{
+    const auto doc = parse(true /*preserve*/);
+    const auto child = doc.getRootElement().getFirstChild();
+    TEST_ASSERT_EQ(child.getCharacterData(), "  1.5  ");
+}
+
+TEST_MAIN(
+    TEST_CHECK(testCompactQueries);
+    TEST_CHECK(testCompactMatchesMinidom);
+    TEST_CHECK(testCompactPreserveCharacterData);
+    )
@@ -0,0 +1,191 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <std/string>
+#include <thread>
+#include <vector>
+
+#include "io/StringStream.h"
+#include <TestCase.h>
+
+#include "xml/lite/ElementIndex.h"
+#include "xml/lite/ElementPath.h"
+#include "xml/lite/MinidomParser.h"
+
+static const std::string& strXml()
+{
+    static const std::string retval =
+        "<root xmlns=\"urn:root\" xmlns:y=\"urn:y\">"
+        "<a><b>1</b><a><b>2</b></a><b>3</b></a>"
+        "<y:a><b>4</b></y:a>"
+        "<c><d><b>5</b></d></c>"
+        "</root>";
+    return retval;
+}
+
+static void parse(xml::lite::MinidomParser& parser)
+{
+    io::StringStream ss;
+    ss.stream() << strXml();
+    parser.parse(ss);
+}
+
+TEST_CASE(testMatchesElement)
+{
+    xml::lite::MinidomParser parser;
+    parse(parser);
+    const auto& doc = *parser.getDocument();
+    const auto& root = getRootElement(doc);
+    const auto& index = doc.getIndex();
+    TEST_ASSERT_EQ(index.size(), static_cast<size_t>(11));
+    TEST_ASSERT_EQ(&index.getRoot(), &root);
+
+    // Every query, from every element, gives what Element does
+    std::vector<xml::lite::Element*> all{ const_cast<xml::lite::Element*>(&root) };
+    root.getElementsByTagName("a", all, true /*recurse*/);
+    root.getElementsByTagName("c", all, true /*recurse*/);
+    const std::vector<std::string> names{ "a", "b", "c", "d", "missing" };
+    for (const auto& base : all)
+    {
+        for (const auto& name : names)
+        {
+            for (const auto recurse : { false, true })
+            {
+                TEST_ASSERT(index.getElementsByTagName(*base, name, recurse) == base->getElementsByTagName(name, recurse));
+                TEST_ASSERT(index.getElementsByTagNameNS(*base, "y:" + name, recurse) ==
+                            base->getElementsByTagNameNS("y:" + name, recurse));
+                const xml::lite::QName qname(xml::lite::Uri("urn:y"), name);
+                TEST_ASSERT(index.getElementsByTagName(*base, qname, recurse) == base->getElementsByTagName(qname, recurse));
+            }
+        }
+    }
+
+    const auto bs = index.getElementsByTagName(root, "b", true /*recurse*/);
+    TEST_ASSERT_EQ(bs.size(), static_cast<size_t>(5));
+    for (size_t ii = 0; ii < bs.size(); ii++)
+    {
+        TEST_ASSERT_EQ(bs[ii]->getCharacterData(), std::to_string(ii + 1));  // document order
+    }
+
+    const xml::lite::Element other("other");
+    TEST_ASSERT_FALSE(index.contains(other));
+    TEST_EXCEPTION(index.getElementsByTagName(other, "b"));
+}
+
+TEST_CASE(testInvalidation)
+{
+    xml::lite::MinidomParser parser;
+    parse(parser);
+    auto& doc = *parser.getDocument();
+    auto& root = getRootElement(doc);
+
+    const auto* pIndex = &doc.getIndex();
+    TEST_ASSERT_FALSE(pIndex->isStale());
+    TEST_ASSERT_EQ(&doc.getIndex(), pIndex);  // not rebuilt
+    TEST_ASSERT_EQ(doc.getIndex().getElementsByTagName(root, "e").size(), static_cast<size_t>(0));
+
+    addChild(root, "e");
+    TEST_ASSERT_TRUE(pIndex->isStale());
+    TEST_ASSERT_EQ(doc.getIndex().getElementsByTagName(root, "e").size(), static_cast<size_t>(1));
+
+    root.getElementByTagName("c").setLocalName("e");
+    TEST_ASSERT_EQ(doc.getIndex().getElementsByTagName(root, "e").size(), static_cast<size_t>(2));
+
+    doc.remove(root.getElementsByTagName("e")[0]);
+    TEST_ASSERT_EQ(doc.getIndex().getElementsByTagName(root, "e").size(), static_cast<size_t>(1));
+
+    // Changing some other tree leaves this index alone
+    pIndex = &doc.getIndex();
+    xml::lite::Element other;
+    addChild(other, "e");
+    other.setLocalName("f");
+    TEST_ASSERT_FALSE(pIndex->isStale());
+    TEST_ASSERT_EQ(&doc.getIndex(), pIndex);
+}
+
+TEST_CASE(testIndexFromThreads)
+{
+    xml::lite::MinidomParser parser;
+    parse(parser);
+    const auto& doc = *parser.getDocument();
+
+    // The first use builds the index; everyone must see that one.
+    std::vector<const xml::lite::ElementIndex*> indexes(4);
+    std::vector<std::thread> threads;
+    for (auto& pIndex : indexes)
+    {
+        threads.emplace_back([&]() { pIndex = &doc.getIndex(); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto pIndex : indexes)
+    {
+        TEST_ASSERT_EQ(pIndex, &doc.getIndex());
+    }
+    TEST_ASSERT_EQ(doc.getIndex().size(), static_cast<size_t>(11));
+}
+
+TEST_CASE(testElementPath)
+{
+    xml::lite::MinidomParser parser;
+    parse(parser);
+    const auto& doc = *parser.getDocument();
+    const auto& root = getRootElement(doc);
+
+    auto check = [&](const std::string& path, const std::string& expected)
+    {
+        const xml::lite::ElementPath elementPath(path);
+        for (const auto pIndex : { static_cast<const xml::lite::ElementIndex*>(nullptr), &doc.getIndex() })
+        {
+            std::string actual;
+            for (const auto& element : elementPath.select(root, pIndex))
+            {
+                actual += element->getCharacterData().empty() ? element->getLocalName() : element->getCharacterData();
+            }
+            TEST_ASSERT_EQ(actual, expected);
+        }
+    };
+    check("a/b", "134");  // y:a has local name "a"
+    check("a/a/b", "2");
+    check("//b", "12345");
+    check("//a/b", "1234");  // nested a's, still in document order
+    check("c//b", "5");
+    check("*/*/b", "25");
+    check("missing/b", "");
+
+    TEST_ASSERT_EQ(xml::lite::ElementPath("c/d/b").selectOne(root).getCharacterData(), "5");
+    TEST_EXCEPTION(xml::lite::ElementPath("a/b").selectOne(root, &doc.getIndex()));
+
+    TEST_EXCEPTION(xml::lite::ElementPath(""));
+    TEST_EXCEPTION(xml::lite::ElementPath("/a"));
+    TEST_EXCEPTION(xml::lite::ElementPath("a/"));
+    TEST_EXCEPTION(xml::lite::ElementPath("a///b"));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testMatchesElement);
+    TEST_CHECK(testInvalidation);
+    TEST_CHECK(testIndexFromThreads);
+    TEST_CHECK(testElementPath);
+    )
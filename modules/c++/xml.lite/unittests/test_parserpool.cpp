@@ -0,0 +1,149 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <std/string>
+#include <vector>
+
+#include "io/StringStream.h"
+#include <TestCase.h>
+
+#include "xml/lite/ParserPool.h"
+
+namespace
+{
+constexpr size_t NUM_DOCUMENTS = 25;
+
+std::vector<std::unique_ptr<io::StringStream>> makeStreams()
+{
+    std::vector<std::unique_ptr<io::StringStream>> retval;
+    for (size_t ii = 0; ii < NUM_DOCUMENTS; ++ii)
+    {
+        retval.push_back(std::make_unique<io::StringStream>());
+        retval.back()->stream() << "<doc" << ii << "><value>" << ii << "</value></doc" << ii << ">";
+    }
+    return retval;
+}
+
+std::vector<io::InputStream*> toInputs(const std::vector<std::unique_ptr<io::StringStream>>& streams)
+{
+    std::vector<io::InputStream*> retval;
+    for (const auto& stream : streams)
+    {
+        retval.push_back(stream.get());
+    }
+    return retval;
+}
+}
+
+TEST_CASE(testParseInOrder)
+{
+    xml::lite::ParserPool pool(4);
+    TEST_ASSERT_EQ(pool.getNumThreads(), static_cast<size_t>(4));
+
+    // The second batch reuses the parsers from the first.
+    for (size_t batch = 0; batch < 2; ++batch)
+    {
+        const auto streams = makeStreams();
+        const auto docs = pool.parse(toInputs(streams));
+        TEST_ASSERT_EQ(docs.size(), NUM_DOCUMENTS);
+        for (size_t ii = 0; ii < docs.size(); ++ii)
+        {
+            const auto& root = *docs[ii]->getRootElement();
+            TEST_ASSERT_EQ(root.getLocalName(), "doc" + std::to_string(ii));
+            TEST_ASSERT_EQ(root.getElementByTagName("value").getCharacterData(), std::to_string(ii));
+        }
+        TEST_ASSERT_EQ(pool.getNumParsers(), static_cast<size_t>(4));
+
+        const auto& timings = pool.getTimings();
+        TEST_ASSERT_EQ(timings.size(), NUM_DOCUMENTS);
+        for (const auto& timing : timings)
+        {
+            TEST_ASSERT(timing.setupTimeMS >= 0.0);
+            TEST_ASSERT(timing.parseTimeMS >= 0.0);
+        }
+    }
+}
+
+TEST_CASE(testParseCompact)
+{
+    xml::lite::ParserPool pool(3);
+    const auto streams = makeStreams();
+    const auto docs = pool.parseCompact(toInputs(streams));
+    TEST_ASSERT_EQ(docs.size(), NUM_DOCUMENTS);
+    for (size_t ii = 0; ii < docs.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(docs[ii].getRootElement().getLocalName(), "doc" + std::to_string(ii));
+    }
+    TEST_ASSERT_EQ(pool.getNumParsers(), static_cast<size_t>(3));
+}
+
+TEST_CASE(testParseErrors)
+{
+    xml::lite::ParserPool pool;
+    TEST_ASSERT(pool.getNumThreads() > 0);
+    TEST_ASSERT(pool.parse({}).empty());
+    TEST_ASSERT(pool.getTimings().empty());
+
+    auto streams = makeStreams();
+    auto inputs = toInputs(streams);
+    inputs[3] = nullptr;
+    TEST_EXCEPTION(pool.parse(inputs));
+}
+
+TEST_CASE(testParseAfterMalformed)
+{
+    // One thread, so the valid documents go through the parser that failed
+    xml::lite::ParserPool pool(1);
+    for (size_t batch = 0; batch < 2; ++batch)
+    {
+        io::StringStream malformed;
+        malformed.stream() << "<doc><value>1</doc>";
+        TEST_EXCEPTION(pool.parse({ &malformed }));
+
+        const auto streams = makeStreams();
+        const auto docs = pool.parse(toInputs(streams));
+        TEST_ASSERT_EQ(docs.size(), NUM_DOCUMENTS);
+        for (size_t ii = 0; ii < docs.size(); ++ii)
+        {
+            const auto& root = *docs[ii]->getRootElement();
+            TEST_ASSERT_EQ(root.getLocalName(), "doc" + std::to_string(ii));
+            TEST_ASSERT_EQ(root.getChildren().size(), static_cast<size_t>(1));
+            TEST_ASSERT_EQ(root.getElementByTagName("value").getCharacterData(), std::to_string(ii));
+        }
+    }
+
+    io::StringStream malformed;
+    malformed.stream() << "<doc><value>1</doc>";
+    TEST_EXCEPTION(pool.parseCompact({ &malformed }));
+    const auto streams = makeStreams();
+    const auto docs = pool.parseCompact(toInputs(streams));
+    TEST_ASSERT_EQ(docs.size(), NUM_DOCUMENTS);
+    TEST_ASSERT_EQ(docs[0].getRootElement().getLocalName(), "doc0");
+}
+
+TEST_MAIN(
+    TEST_CHECK(testParseInOrder);
+    TEST_CHECK(testParseCompact);
+    TEST_CHECK(testParseErrors);
+    TEST_CHECK(testParseAfterMalformed);
+    )
@@ -24,6 +24,8 @@
 #include <std/filesystem>
 #include <std/optional>
 #include <std/span>
+#include <thread>
+#include <vector>
 
 #include "io/StringStream.h"
 #include "io/FileInputStream.h"
@@ -504,6 +506,49 @@ TEST_CASE(testValidateXmlFile)
     testValidateXmlFile(testName, "encoding_windows-1252.xml", io::W1252StringStream());
 }
 
+TEST_CASE(testValidatorPool)
+{
+    static const auto xsd = find_unittest_file("doc.xsd");
+    const std::vector<std::filesystem::path> schemaPaths{xsd.parent_path()};
+    const xml::lite::ValidatorPool validator(schemaPaths);
+
+    io::FileInputStream fis(find_unittest_file("ascii.xml"));
+    io::StringStream oss;
+    fis.streamTo(oss);
+    const auto xml = oss.stream().str();
+    const std::string badXml = "<root><doc><b/></doc></root>";
+
+    constexpr size_t numThreads = 4;
+    std::vector<size_t> numFailures(numThreads);
+    std::vector<std::thread> threads;
+    for (size_t ii = 0; ii < numThreads; ++ii)
+    {
+        threads.emplace_back([&, ii]()
+        {
+            for (size_t jj = 0; jj < 10; ++jj)
+            {
+                std::vector<xml::lite::ValidationInfo> errors;
+                const bool good = !validator.validate(xml, "ascii.xml", errors) && errors.empty();
+                const bool bad = validator.validate(badXml, "bad.xml", errors) && !errors.empty();
+                if (!good || !bad)
+                {
+                    ++numFailures[ii];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto numFailed : numFailures)
+    {
+        TEST_ASSERT_EQ(numFailed, static_cast<size_t>(0));
+    }
+    TEST_ASSERT(validator.getNumValidators() > 0);
+    TEST_ASSERT(validator.getNumValidators() <= numThreads);
+}
+
 int main(int, char**)
 {
     TEST_CHECK(testXmlParseSimple);
@@ -522,4 +567,5 @@ int main(int, char**)
     TEST_CHECK(testReadEmbeddedXml);
 
     TEST_CHECK(testValidateXmlFile);
+    TEST_CHECK(testValidatorPool);
 }
@@ -0,0 +1,158 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <std/string>
+#include <vector>
+
+#include "io/StringStream.h"
+#include <TestCase.h>
+
+#include "xml/lite/XMLStreamReader.h"
+
+static const std::string& strXml()
+{
+    static const std::string retval =
+        "<SICD>"
+        "<CollectionInfo><CollectorName>ABC</CollectorName></CollectionInfo>"
+        "<ImageData><NumRows> 10 </NumRows><NumCols>20</NumCols></ImageData>"
+        "<Other a=\"1\">text<ImageData>nested</ImageData>more</Other>"
+        "</SICD>";
+    return retval;
+}
+
+TEST_CASE(testEvents)
+{
+    io::StringStream ss;
+    ss.stream() << "<a x=\"1\">hello<b/>world</a>";
+    xml::lite::XMLStreamReader reader(ss);
+    TEST_ASSERT(reader.getEvent() == xml::lite::XMLStreamReader::Event::None);
+
+    using Event = xml::lite::XMLStreamReader::Event;
+    TEST_ASSERT_TRUE(reader.next());
+    TEST_ASSERT(reader.getEvent() == Event::StartElement);
+    TEST_ASSERT_EQ(reader.getLocalName(), "a");
+    TEST_ASSERT_EQ(reader.getDepth(), static_cast<size_t>(1));
+    TEST_ASSERT_EQ(reader.getAttributes().getValue("x"), "1");
+
+    TEST_ASSERT_TRUE(reader.next());
+    TEST_ASSERT(reader.getEvent() == Event::Characters);
+    TEST_ASSERT(reader.getCharacterData() == str::u8FromNative("hello"));
+
+    TEST_ASSERT_TRUE(reader.next());
+    TEST_ASSERT(reader.getEvent() == Event::StartElement);
+    TEST_ASSERT_EQ(reader.getLocalName(), "b");
+    TEST_ASSERT_EQ(reader.getDepth(), static_cast<size_t>(2));
+    TEST_ASSERT_TRUE(reader.next());
+    TEST_ASSERT(reader.getEvent() == Event::EndElement);
+    TEST_ASSERT_EQ(reader.getDepth(), static_cast<size_t>(2));
+
+    TEST_ASSERT_TRUE(reader.next());
+    TEST_ASSERT(reader.getEvent() == Event::Characters);
+    TEST_ASSERT_TRUE(reader.next());
+    TEST_ASSERT(reader.getEvent() == Event::EndElement);
+    TEST_ASSERT_EQ(reader.getLocalName(), "a");
+
+    TEST_ASSERT_FALSE(reader.next());
+    TEST_ASSERT(reader.getEvent() == Event::EndDocument);
+    TEST_ASSERT_FALSE(reader.next());
+}
+
+TEST_CASE(testPathFilter)
+{
+    io::StringStream ss;
+    ss.stream() << strXml();
+    xml::lite::XMLStreamReader reader(ss);
+    reader.addPathFilter("/SICD/ImageData");
+    reader.addPathFilter("/SICD/*/CollectorName");
+
+    auto element = reader.readNextElement();
+    TEST_ASSERT_NOT_EQ(element.get(), nullptr);
+    TEST_ASSERT_EQ(element->getLocalName(), "CollectorName");
+    TEST_ASSERT_EQ(element->getCharacterData(), "ABC");
+
+    element = reader.readNextElement();
+    TEST_ASSERT_NOT_EQ(element.get(), nullptr);
+    TEST_ASSERT_EQ(element->getLocalName(), "ImageData");
+    TEST_ASSERT_EQ(element->getChildren().size(), static_cast<size_t>(2));
+    TEST_ASSERT_EQ(element->getElementByTagName("NumRows").getCharacterData(), "10");  // trimmed
+    TEST_ASSERT_EQ(element->getElementByTagName("NumCols").getCharacterData(), "20");
+
+    // /SICD/Other/ImageData doesn't match
+    TEST_ASSERT_EQ(reader.readNextElement().get(), nullptr);
+
+    TEST_EXCEPTION(reader.addPathFilter("/SICD"));  // too late
+}
+
+TEST_CASE(testSkipElement)
+{
+    io::StringStream ss;
+    ss.stream() << strXml();
+    xml::lite::XMLStreamReader reader(ss);
+    reader.preserveCharacterData(true);
+
+    TEST_EXCEPTION(reader.skipElement());  // not at a StartElement
+
+    std::vector<std::string> names;
+    while (reader.next())
+    {
+        if (reader.getEvent() != xml::lite::XMLStreamReader::Event::StartElement)
+        {
+            continue;
+        }
+        names.push_back(reader.getLocalName());
+        if (reader.getLocalName() == "CollectionInfo")
+        {
+            reader.skipElement();
+            TEST_ASSERT_EQ(reader.getLocalName(), "CollectionInfo");
+        }
+        else if (reader.getLocalName() == "ImageData")
+        {
+            const auto imageData = reader.readElement();
+            if (reader.getDepth() == 2)
+            {
+                TEST_ASSERT_EQ(imageData->getElementByTagName("NumRows").getCharacterData(), " 10 ");
+            }
+            else
+            {
+                TEST_ASSERT_EQ(imageData->getCharacterData(), "nested");
+            }
+        }
+    }
+    const std::vector<std::string> expected{ "SICD", "CollectionInfo", "ImageData", "Other", "ImageData" };
+    TEST_ASSERT(names == expected);
+}
+
+TEST_CASE(testBadPathFilter)
+{
+    io::StringStream ss;
+    ss.stream() << strXml();
+    xml::lite::XMLStreamReader reader(ss);
+    TEST_EXCEPTION(reader.addPathFilter("SICD"));
+    TEST_EXCEPTION(reader.addPathFilter("/SICD//ImageData"));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testEvents);
+    TEST_CHECK(testPathFilter);
+    TEST_CHECK(testSkipElement);
+    TEST_CHECK(testBadPathFilter);
+    )
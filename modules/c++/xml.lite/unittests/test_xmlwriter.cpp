@@ -0,0 +1,130 @@
+/* =========================================================================
+ * This file is part of xml.lite-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2023, Maxar Technologies, Inc.
+ *
+ * xml.lite-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <std/string>
+#include <memory>
+
+#include "io/StringStream.h"
+#include <TestCase.h>
+
+#include "xml/lite/CompactDocument.h"
+#include "xml/lite/Element.h"
+#include "xml/lite/XMLWriter.h"
+
+static std::unique_ptr<xml::lite::Element> makeTree()
+{
+    std::unique_ptr<xml::lite::Element> root(new xml::lite::Element("root", "urn:root"));
+    root->attribute("xmlns") = "urn:root";
+    root->attribute("version") = "1.0";
+
+    auto& child = root->addChild(std::unique_ptr<xml::lite::Element>(new xml::lite::Element("child", "", "text")));
+    child.attribute("id") = "1";
+    child.addChild(std::unique_ptr<xml::lite::Element>(new xml::lite::Element("empty")));
+    root->addChild(std::unique_ptr<xml::lite::Element>(new xml::lite::Element("y:other", "urn:y", "more")));
+    return root;
+}
+
+static std::string print(const xml::lite::Element& element, const std::string& formatter, size_t bufferSize)
+{
+    io::StringStream ss;
+    {
+        xml::lite::XMLWriter writer(ss, formatter, bufferSize);
+        writer.write(element);
+    }  // flushed by the destructor
+    return ss.stream().str();
+}
+
+TEST_CASE(testMatchesPrint)
+{
+    const auto root = makeTree();
+
+    io::StringStream expected;
+    root->print(expected);
+    TEST_ASSERT_EQ(print(*root, "", xml::lite::XMLWriter::DEFAULT_BUFFER_SIZE), expected.stream().str());
+
+    io::StringStream expectedPretty;
+    root->prettyPrint(expectedPretty, "  ");
+    auto strExpected = expectedPretty.stream().str();
+    strExpected.pop_back();  // prettyPrint() adds a newline
+    TEST_ASSERT_EQ(print(*root, "  ", xml::lite::XMLWriter::DEFAULT_BUFFER_SIZE), strExpected);
+
+    // A tiny buffer is flushed over and over, with the same result
+    TEST_ASSERT_EQ(print(*root, "  ", 3), strExpected);
+}
+
+TEST_CASE(testEscaping)
+{
+    xml::lite::Element element("e", "", "a < b && c > d");
+    element.attribute("q") = "say \"<hi>\"";
+    TEST_ASSERT_EQ(print(element, "", 16),
+                   "<e q=\"say &quot;&lt;hi>&quot;\">a &lt; b &amp;&amp; c &gt; d</e>");
+
+    io::StringStream ss;
+    xml::lite::XMLWriter writer(ss);
+    writer.setEscape(false);
+    writer.write(element);
+    writer.flush();
+    TEST_ASSERT_EQ(ss.stream().str(), "<e q=\"say \"<hi>\"\">a < b && c > d</e>");
+}
+
+TEST_CASE(testCompactElement)
+{
+    xml::lite::CompactDocument doc;
+    const auto root = doc.addElement(xml::lite::CompactDocument::npos, "", "root");
+    const auto child = doc.addElement(root, "", "child");
+    doc.addAttribute("", "id", "1&2");
+    const std::string text = "x<y";
+    doc.setCharacterData(child, text.data(), text.size());
+    doc.addElement(root, "", "empty");
+
+    io::StringStream ss;
+    xml::lite::XMLWriter writer(ss, " ");
+    writer.write(doc.getRootElement());
+    writer.write("\n");
+    writer.flush();
+    TEST_ASSERT_EQ(ss.stream().str(),
+                   "<root>\n <child id=\"1&amp;2\">x&lt;y</child>\n <empty/>\n</root>\n");
+}
+
+TEST_CASE(testCompactPrefixes)
+{
+    xml::lite::CompactDocument doc;
+    const auto root = doc.addElement(xml::lite::CompactDocument::npos, "urn:a", "a:root");
+    doc.addAttribute("", "xmlns:a", "urn:a");
+    doc.addElement(root, "urn:a", "a:child");
+    doc.addAttribute("urn:a", "a:id", "7");
+    doc.addAttribute("", "n", "8");
+
+    io::StringStream ss;
+    xml::lite::XMLWriter writer(ss);
+    writer.write(doc.getRootElement());
+    writer.flush();
+    TEST_ASSERT_EQ(ss.stream().str(),
+                   "<a:root xmlns:a=\"urn:a\"><a:child a:id=\"7\" n=\"8\"/></a:root>");
+}
+
+TEST_MAIN(
+    TEST_CHECK(testMatchesPrint);
+    TEST_CHECK(testEscaping);
+    TEST_CHECK(testCompactElement);
+    TEST_CHECK(testCompactPrefixes);
+    )
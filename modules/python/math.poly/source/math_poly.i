@@ -8,6 +8,19 @@
 %ignore math::poly::OneD<Vector3>::transformInput;
 %ignore math::poly::OneD<Vector3>::integrate;
 %ignore math::poly::OneD<Vector3>::power;
+%ignore math::poly::OneD::evaluate;
+%ignore math::poly::TwoD::evaluate;
+%ignore math::poly::TwoD::evaluateGrid;
+%ignore math::poly::fit(coda_oss::span<const double>, coda_oss::span<const double>,
+                        coda_oss::span<const double>, size_t);
+%ignore math::poly::fit(coda_oss::span<const double>, coda_oss::span<const double>,
+                        coda_oss::span<const double>, coda_oss::span<const double>,
+                        size_t, size_t, size_t);
+%ignore math::poly::details::getNormalization;
+%ignore math::poly::details::FitBlocks;
+%ignore math::poly::details::fitNormalized;
+%ignore math::poly::details::unnormalize;
+%ignore math::poly::details::checkWeights;
 
 
 %{